@@ -0,0 +1,76 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#include "benchmarkenvironment.h"
+
+#include "definitions/definitions.h"
+#include "core/parsingfactory.h"
+
+#include <QFile>
+
+
+BenchmarkEnvironment::BenchmarkEnvironment() {
+}
+
+QString BenchmarkEnvironment::corpusFile(const QString &file_name) {
+  QFile file(QSL(BENCHMARKS_DATA_PATH) + QL1C('/') + file_name);
+
+  if (!file.open(QIODevice::ReadOnly)) {
+    qWarning("Cannot open corpus file '%s'.", qPrintable(file.fileName()));
+    return QString();
+  }
+
+  return QString::fromUtf8(file.readAll());
+}
+
+QString BenchmarkEnvironment::enlargedFeed(const QString &feed, const QString &item_start,
+                                           const QString &footer_start, int factor) {
+  const int items_start = feed.indexOf(item_start);
+  const int items_end = feed.lastIndexOf(footer_start);
+
+  if (items_start < 0 || items_end < items_start) {
+    return feed;
+  }
+
+  return feed.left(items_start) + feed.mid(items_start, items_end - items_start).repeated(factor) + feed.mid(items_end);
+}
+
+QList<Message> BenchmarkEnvironment::messages(int count, int feed_custom_id, int account_id) {
+  const QList<Message> prototypes = ParsingFactory::parseAsRSS20(corpusFile(QSL("rss20-medium.xml")));
+  QList<Message> messages;
+
+  if (prototypes.isEmpty()) {
+    return messages;
+  }
+
+  messages.reserve(count);
+
+  for (int i = 0; i < count; i++) {
+    Message message = prototypes.at(i % prototypes.size());
+
+    // Standard account recognizes messages by their URL, title and author.
+    message.m_url += QL1C('/') + QString::number(i);
+    message.m_title += QL1C(' ') + QString::number(i);
+    message.m_created = message.m_created.addSecs(-i);
+    message.m_feedId = QString::number(feed_custom_id);
+    message.m_accountId = account_id;
+
+    messages.append(message);
+  }
+
+  return messages;
+}
@@ -0,0 +1,47 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef BENCHMARKENVIRONMENT_H
+#define BENCHMARKENVIRONMENT_H
+
+#include "core/message.h"
+
+#include <QList>
+#include <QString>
+
+
+// Shared setup of benchmarks, bundled feed corpus, throwaway
+// profile is prepared via TestData.
+class BenchmarkEnvironment {
+  public:
+    // Returns contents of file from "data" folder.
+    static QString corpusFile(const QString &file_name);
+
+    // Returns feed with all its items repeated given number of times.
+    // Items span from first occurrence of "item_start" to "footer_start".
+    static QString enlargedFeed(const QString &feed, const QString &item_start,
+                                const QString &footer_start, int factor);
+
+    // Returns given number of distinct messages made of messages
+    // of bundled RSS 2.0 feed, ready to be stored into given feed.
+    static QList<Message> messages(int count, int feed_custom_id, int account_id);
+
+  private:
+    explicit BenchmarkEnvironment();
+};
+
+#endif // BENCHMARKENVIRONMENT_H
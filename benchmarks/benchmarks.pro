@@ -0,0 +1,102 @@
+#################################################################
+#
+# This file is part of RSS Guard.
+#
+# Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+#
+# RSS Guard is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# RSS Guard is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with RSS Guard. If not, see <http:# www.gnu.org/licenses/>.
+#
+#
+#  This is RSS Guard benchmarks compilation script for qmake.
+#
+#  Benchmarks link the same sources as application and measure parsing
+#  of bundled feeds (see "data" folder), parsing of dates, HTML stripping
+#  and entity escaping, storing of 1k/10k/100k messages, count queries
+#  and loading of messages into the model. Former implementations from
+#  "tests/legacy" are measured too, so that speedups can be compared.
+#
+# Usage:
+#     cd ../build-dir-benchmarks
+#     qmake ../rssguard-dir/benchmarks/benchmarks.pro CONFIG+=release
+#     make
+#     ../rssguard-dir/benchmarks/run-benchmarks.py --binary bin/rssguard-benchmarks \
+#       --output results.json --baseline baseline.json
+#
+#  Benchmarks always run with throwaway profile in temporary folder.
+#  JSON results of some run can be stored and used as baseline of
+#  later runs, see "run-benchmarks.py --help".
+#
+#################################################################
+
+TEMPLATE    = app
+TARGET      = rssguard-benchmarks
+
+message(rssguard-benchmarks: Welcome RSS Guard benchmarks qmake script.)
+
+# Internal web browser is not needed, text previewer is linked instead.
+USE_WEBENGINE = false
+
+include(../rssguard.pri)
+
+QT += testlib
+
+CONFIG -= debug_and_release app_bundle
+CONFIG += console
+
+DESTDIR = $$OUT_PWD/bin
+MOC_DIR = $$OUT_PWD/moc
+RCC_DIR = $$OUT_PWD/rcc
+UI_DIR = $$OUT_PWD/ui
+
+DEFINES += BENCHMARKS_DATA_PATH='"\\\"$$PWD/data\\\""'
+DEFINES += TESTS_DATA_PATH='"\\\"$$PWD/../tests/data\\\""'
+
+# Former implementations and corpora are shared with tests.
+INCLUDEPATH +=  $$PWD/../tests
+
+# Database initialization scripts are looked up relatively
+# to executable, see APP_MISC_PATH.
+win32 {
+  misc_sql.path = $$DESTDIR/misc
+}
+
+mac {
+  misc_sql.path = $$OUT_PWD/Resources/misc
+}
+
+unix:!mac {
+  misc_sql.path = $$OUT_PWD/share/rssguard/misc
+}
+
+misc_sql.files = $$files($$PWD/../resources/misc/*.sql)
+
+CONFIG += file_copies
+COPIES += misc_sql
+
+HEADERS +=  $$PWD/benchmarkenvironment.h \
+            $$PWD/databasebenchmark.h \
+            $$PWD/parsingbenchmark.h \
+            $$PWD/textbenchmark.h \
+            $$PWD/../tests/legacy/legacytextfactory.h \
+            $$PWD/../tests/legacy/legacywebfactory.h \
+            $$PWD/../tests/testdata.h
+
+SOURCES +=  $$PWD/benchmarkenvironment.cpp \
+            $$PWD/databasebenchmark.cpp \
+            $$PWD/main.cpp \
+            $$PWD/parsingbenchmark.cpp \
+            $$PWD/textbenchmark.cpp \
+            $$PWD/../tests/legacy/legacytextfactory.cpp \
+            $$PWD/../tests/legacy/legacywebfactory.cpp \
+            $$PWD/../tests/testdata.cpp
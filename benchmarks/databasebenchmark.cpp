@@ -0,0 +1,173 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#include "databasebenchmark.h"
+
+#include "definitions/definitions.h"
+#include "core/messagesmodel.h"
+#include "miscellaneous/application.h"
+#include "miscellaneous/databasefactory.h"
+#include "miscellaneous/databasequeries.h"
+#include "services/standard/standardfeed.h"
+#include "services/standard/standardserviceroot.h"
+#include "benchmarkenvironment.h"
+
+#include <QtTest>
+
+
+void DatabaseBenchmark::initTestCase() {
+  bool ok = false;
+
+  m_database = qApp->database()->connection(metaObject()->className(), DatabaseFactory::FromSettings);
+  m_accountId = DatabaseQueries::createAccount(m_database, SERVICE_CODE_STD_RSS, &ok);
+  QVERIFY(ok);
+
+  m_root = new StandardServiceRoot();
+  m_root->setAccountId(m_accountId);
+}
+
+void DatabaseBenchmark::cleanupTestCase() {
+  delete m_root;
+  m_root = nullptr;
+  m_filledFeeds.clear();
+}
+
+void DatabaseBenchmark::addSizes() {
+  QTest::addColumn<int>("count");
+
+  QTest::newRow("1k") << 1000;
+  QTest::newRow("10k") << 10000;
+  QTest::newRow("100k") << 100000;
+}
+
+StandardFeed *DatabaseBenchmark::createFeed() {
+  StandardFeed *feed = new StandardFeed();
+
+  feed->setCustomId(m_root->childCount() + 1);
+  m_root->appendChild(feed);
+  return feed;
+}
+
+void DatabaseBenchmark::storeNewMessages_data() {
+  addSizes();
+}
+
+void DatabaseBenchmark::storeNewMessages() {
+  QFETCH(int, count);
+
+  StandardFeed *feed = createFeed();
+  const QList<Message> messages = BenchmarkEnvironment::messages(count, feed->customId(), m_accountId);
+  bool any_message_changed = false;
+  bool ok = false;
+  int updated_messages = -1;
+
+  QVERIFY(messages.size() == count);
+
+  // Messages can be inserted only once, so single run is measured.
+  QBENCHMARK_ONCE {
+    updated_messages = DatabaseQueries::updateMessages(m_database, messages, feed->customId(), m_accountId,
+                                                       QString(), &any_message_changed, &ok);
+  }
+
+  QVERIFY(ok);
+  QCOMPARE(updated_messages, count);
+
+  m_filledFeeds.insert(count, feed);
+}
+
+void DatabaseBenchmark::storeUnchangedMessages_data() {
+  addSizes();
+}
+
+void DatabaseBenchmark::storeUnchangedMessages() {
+  QFETCH(int, count);
+
+  if (!m_filledFeeds.contains(count)) {
+    QSKIP("Messages were not stored by previous benchmark.");
+  }
+
+  const int feed_custom_id = m_filledFeeds.value(count)->customId();
+  const QList<Message> messages = BenchmarkEnvironment::messages(count, feed_custom_id, m_accountId);
+  bool any_message_changed = false;
+  bool ok = false;
+  int updated_messages = -1;
+
+  // All messages are already stored, so they are only looked up.
+  QBENCHMARK_ONCE {
+    updated_messages = DatabaseQueries::updateMessages(m_database, messages, feed_custom_id, m_accountId,
+                                                       QString(), &any_message_changed, &ok);
+  }
+
+  QVERIFY(ok);
+  QCOMPARE(updated_messages, 0);
+}
+
+void DatabaseBenchmark::countMessagesOfAccount() {
+  QMap<int,QPair<int,int> > counts;
+  bool ok = false;
+
+  QBENCHMARK {
+    counts = DatabaseQueries::getMessageCountsForAccount(m_database, m_accountId, true, &ok);
+  }
+
+  QVERIFY(ok);
+  QCOMPARE(counts.size(), m_filledFeeds.size());
+}
+
+void DatabaseBenchmark::countMessagesOfFeed_data() {
+  addSizes();
+}
+
+void DatabaseBenchmark::countMessagesOfFeed() {
+  QFETCH(int, count);
+
+  if (!m_filledFeeds.contains(count)) {
+    QSKIP("Messages were not stored by previous benchmark.");
+  }
+
+  const int feed_custom_id = m_filledFeeds.value(count)->customId();
+  int total_count = -1;
+  bool ok = false;
+
+  QBENCHMARK {
+    total_count = DatabaseQueries::getMessageCountsForFeed(m_database, feed_custom_id, m_accountId, true, &ok);
+  }
+
+  QVERIFY(ok);
+  QCOMPARE(total_count, count);
+}
+
+void DatabaseBenchmark::loadMessages_data() {
+  addSizes();
+}
+
+void DatabaseBenchmark::loadMessages() {
+  QFETCH(int, count);
+
+  if (!m_filledFeeds.contains(count)) {
+    QSKIP("Messages were not stored by previous benchmark.");
+  }
+
+  StandardFeed *feed = m_filledFeeds.value(count);
+  MessagesModel model;
+
+  QBENCHMARK {
+    model.loadMessages(feed);
+  }
+
+  QCOMPARE(model.rowCount(), count);
+}
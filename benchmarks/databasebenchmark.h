@@ -0,0 +1,67 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef DATABASEBENCHMARK_H
+#define DATABASEBENCHMARK_H
+
+#include <QObject>
+
+#include <QMap>
+#include <QSqlDatabase>
+
+
+class StandardServiceRoot;
+class StandardFeed;
+
+// Measures storing of messages, count queries and loading
+// of messages into MessagesModel on database of growing size.
+class DatabaseBenchmark : public QObject {
+    Q_OBJECT
+
+  private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void storeNewMessages_data();
+    void storeNewMessages();
+
+    void storeUnchangedMessages_data();
+    void storeUnchangedMessages();
+
+    void countMessagesOfAccount();
+
+    void countMessagesOfFeed_data();
+    void countMessagesOfFeed();
+
+    void loadMessages_data();
+    void loadMessages();
+
+  private:
+    void addSizes();
+
+    // Returns new feed which is attached to benchmark account.
+    StandardFeed *createFeed();
+
+    QSqlDatabase m_database;
+    StandardServiceRoot *m_root;
+    int m_accountId;
+
+    // Feeds filled by "storeNewMessages", mapped by their message counts.
+    QMap<int,StandardFeed*> m_filledFeeds;
+};
+
+#endif // DATABASEBENCHMARK_H
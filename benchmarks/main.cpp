@@ -0,0 +1,72 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#include "definitions/definitions.h"
+#include "miscellaneous/application.h"
+#include "miscellaneous/settings.h"
+#include "databasebenchmark.h"
+#include "parsingbenchmark.h"
+#include "testdata.h"
+#include "textbenchmark.h"
+
+#include <QTemporaryDir>
+#include <QtTest>
+
+
+// Runs all benchmarks, each test object gets the same arguments,
+// so results of all of them are printed one after another.
+// Pass "-o -,xml" to get output readable by "run-benchmarks.py".
+int main(int argc, char *argv[]) {
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+  }
+
+  QTemporaryDir home_folder;
+
+  if (!home_folder.isValid() || !TestData::prepareProfile(home_folder.path())) {
+    qWarning("Cannot prepare temporary profile for benchmarks.");
+    return EXIT_FAILURE;
+  }
+
+  Application application(QSL(APP_LOW_NAME "-benchmarks"), argc, argv);
+
+  Application::setApplicationName(APP_NAME);
+  Application::setApplicationVersion(APP_VERSION);
+  Application::setOrganizationName(APP_AUTHOR);
+  Application::setOrganizationDomain(APP_URL);
+
+  // Never touch real profile of the user.
+  if (!TestData::usesProfile(home_folder.path())) {
+    qWarning("Application does not use temporary profile '%s', benchmarks are not started.",
+             qPrintable(home_folder.path()));
+    return EXIT_FAILURE;
+  }
+
+  // Without transactions each stored message is synced to disk separately.
+  qApp->settings()->setValue(GROUP(Database), Database::UseTransactions, true);
+
+  ParsingBenchmark parsing_benchmark;
+  TextBenchmark text_benchmark;
+  DatabaseBenchmark database_benchmark;
+  int result = 0;
+
+  result |= QTest::qExec(&parsing_benchmark, argc, argv);
+  result |= QTest::qExec(&text_benchmark, argc, argv);
+  result |= QTest::qExec(&database_benchmark, argc, argv);
+
+  return result;
+}
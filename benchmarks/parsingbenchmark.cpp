@@ -0,0 +1,71 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#include "parsingbenchmark.h"
+
+#include "definitions/definitions.h"
+#include "core/parsingfactory.h"
+#include "benchmarkenvironment.h"
+
+#include <QtTest>
+
+
+// How many times items of medium-sized feeds are repeated in large feeds.
+#define LARGE_FEED_FACTOR 10
+
+void ParsingBenchmark::parse_data() {
+  QTest::addColumn<QString>("format");
+  QTest::addColumn<QString>("data");
+
+  const QStringList formats = QStringList() << QSL("rss20") << QSL("rdf") << QSL("atom10");
+  const QStringList item_starts = QStringList() << QSL("  <item>") << QSL("  <item ") << QSL("  <entry>");
+  const QStringList footer_starts = QStringList() << QSL("</channel>") << QSL("</rdf:RDF>") << QSL("</feed>");
+
+  for (int i = 0; i < formats.size(); i++) {
+    const QString &format = formats.at(i);
+    const QString medium = BenchmarkEnvironment::corpusFile(format + QSL("-medium.xml"));
+
+    QTest::newRow(qPrintable(format + QSL("-small")))
+        << format << BenchmarkEnvironment::corpusFile(format + QSL("-small.xml"));
+    QTest::newRow(qPrintable(format + QSL("-medium"))) << format << medium;
+    QTest::newRow(qPrintable(format + QSL("-large")))
+        << format << BenchmarkEnvironment::enlargedFeed(medium, item_starts.at(i), footer_starts.at(i), LARGE_FEED_FACTOR);
+  }
+}
+
+void ParsingBenchmark::parse() {
+  QFETCH(QString, format);
+  QFETCH(QString, data);
+
+  QVERIFY(!data.isEmpty());
+
+  QList<Message> messages;
+
+  QBENCHMARK {
+    if (format == QL1S("rss20")) {
+      messages = ParsingFactory::parseAsRSS20(data);
+    }
+    else if (format == QL1S("rdf")) {
+      messages = ParsingFactory::parseAsRDF(data);
+    }
+    else {
+      messages = ParsingFactory::parseAsATOM10(data);
+    }
+  }
+
+  QVERIFY(!messages.isEmpty());
+}
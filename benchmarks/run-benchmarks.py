@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+
+# This file is part of RSS Guard.
+#
+# Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+#
+# RSS Guard is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# RSS Guard is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+# Runs RSS Guard benchmarks and converts their results to JSON.
+#
+# Benchmark binary is started with "-o -,xml", QtTest XML output of all its
+# test objects is read and each BenchmarkResult is stored as
+# "Class::function(tag)" -> per-iteration value. Saved XML output can be
+# converted too. If baseline JSON (some earlier output of this script) is
+# given, results are compared with it and script fails when some benchmark
+# got slower by more than given threshold.
+#
+# Usage:
+#   run-benchmarks.py --binary bin/rssguard-benchmarks --output baseline.json
+#   run-benchmarks.py --binary bin/rssguard-benchmarks --output results.json --baseline baseline.json
+#   run-benchmarks.py --input results.xml --baseline baseline.json --threshold 20
+#
+# NOTE: Compare only results measured on the same machine and with
+# the same build type.
+
+import argparse
+import json
+import re
+import subprocess
+import sys
+import xml.etree.ElementTree as ElementTree
+
+
+def parse_results(xml_output):
+  results = {}
+
+  # Each test object prints its own XML document.
+  for document in re.split(r"(?=<\?xml )", xml_output):
+    if not document.strip():
+      continue
+
+    test_case = ElementTree.fromstring(document.encode("utf-8"))
+
+    for function in test_case.iter("TestFunction"):
+      for result in function.iter("BenchmarkResult"):
+        name = "{0}::{1}".format(test_case.get("name"), function.get("name"))
+        iterations = max(int(result.get("iterations", "1")), 1)
+
+        if result.get("tag"):
+          name += "({0})".format(result.get("tag"))
+
+        results[name] = {
+          "metric": result.get("metric"),
+          "value": float(result.get("value")) / iterations,
+          "iterations": iterations
+        }
+
+  return results
+
+
+def compare(results, baseline, threshold):
+  regressions = []
+
+  print("{0:<60} {1:>14} {2:>14} {3:>8}".format("benchmark", "baseline", "current", "change"))
+
+  for name in sorted(set(results) | set(baseline)):
+    if name not in baseline or name not in results:
+      print("{0:<60} {1}".format(name, "only in current run" if name in results else "missing in current run"))
+      continue
+
+    old_value = baseline[name]["value"]
+    new_value = results[name]["value"]
+    change = (new_value - old_value) / old_value * 100.0 if old_value > 0 else 0.0
+
+    print("{0:<60} {1:>14.4f} {2:>14.4f} {3:>+7.1f}%".format(name, old_value, new_value, change))
+
+    if change > threshold:
+      regressions.append(name)
+
+  return regressions
+
+
+def main():
+  parser = argparse.ArgumentParser(description="Runs RSS Guard benchmarks and compares their results with baseline.")
+  source = parser.add_mutually_exclusive_group(required=True)
+  source.add_argument("--binary", help="benchmark binary to run")
+  source.add_argument("--input", help="saved XML output of benchmark binary (\"-o file.xml,xml\")")
+  parser.add_argument("--output", help="JSON file to write results to")
+  parser.add_argument("--baseline", help="JSON file with results of earlier run")
+  parser.add_argument("--threshold", type=float, default=10.0, help="allowed slowdown against baseline in percent")
+  parser.add_argument("arguments", nargs="*", help="extra QtTest arguments for benchmark binary, for example \"-minimumvalue 50\"")
+  options = parser.parse_args()
+  failed = False
+
+  if options.binary:
+    process = subprocess.run([options.binary, "-o", "-,xml"] + options.arguments, stdout=subprocess.PIPE)
+    xml_output = process.stdout.decode("utf-8", "replace")
+
+    if process.returncode != 0:
+      print("Benchmark binary failed with code {0}.".format(process.returncode), file=sys.stderr)
+      failed = True
+  else:
+    with open(options.input, encoding="utf-8", errors="replace") as input_file:
+      xml_output = input_file.read()
+
+  results = parse_results(xml_output)
+
+  if not results:
+    print("No benchmark results were found.", file=sys.stderr)
+    sys.exit(1)
+
+  if options.output:
+    with open(options.output, "w", encoding="utf-8") as output_file:
+      json.dump({"results": results}, output_file, indent=2, sort_keys=True)
+
+  if options.baseline:
+    with open(options.baseline, encoding="utf-8") as baseline_file:
+      regressions = compare(results, json.load(baseline_file)["results"], options.threshold)
+
+    if regressions:
+      print("{0} benchmark(s) got slower by more than {1}%.".format(len(regressions), options.threshold), file=sys.stderr)
+      failed = True
+  elif not options.output:
+    print(json.dumps({"results": results}, indent=2, sort_keys=True))
+
+  if failed:
+    sys.exit(1)
+
+
+if __name__ == "__main__":
+  main()
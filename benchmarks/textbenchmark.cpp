@@ -0,0 +1,165 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#include "textbenchmark.h"
+
+#include "definitions/definitions.h"
+#include "core/parsingfactory.h"
+#include "miscellaneous/textfactory.h"
+#include "network-web/webfactory.h"
+#include "legacy/legacytextfactory.h"
+#include "legacy/legacywebfactory.h"
+#include "benchmarkenvironment.h"
+#include "testdata.h"
+
+#include <QtTest>
+
+
+void TextBenchmark::initTestCase() {
+  foreach (const Message &message, ParsingFactory::parseAsRSS20(BenchmarkEnvironment::corpusFile(QSL("rss20-medium.xml")))) {
+    m_contents.append(message.m_contents);
+  }
+
+  QVERIFY(!m_contents.isEmpty());
+}
+
+void TextBenchmark::parseDateTime_data() {
+  QTest::addColumn<QStringList>("dates");
+  QTest::addColumn<bool>("legacy");
+
+  // Dates of conformance corpus grouped by their category.
+  QMap<QString,QStringList> categories;
+
+  foreach (const QStringList &row, TestData::rows(QSL("datetimes.txt"))) {
+    categories[row.at(0).section(QL1C('-'), 0, 0)].append(row.at(1));
+  }
+
+  foreach (const QString &category, categories.keys()) {
+    QTest::newRow(qPrintable(category)) << categories.value(category) << false;
+    QTest::newRow(qPrintable(category + QSL("-legacy"))) << categories.value(category) << true;
+  }
+}
+
+void TextBenchmark::parseDateTime() {
+  QFETCH(QStringList, dates);
+  QFETCH(bool, legacy);
+
+  QVERIFY(!dates.isEmpty());
+
+  if (legacy) {
+    QBENCHMARK {
+      foreach (const QString &date, dates) {
+        LegacyTextFactory::parseDateTime(date);
+      }
+    }
+  }
+  else {
+    QBENCHMARK {
+      foreach (const QString &date, dates) {
+        TextFactory::parseDateTime(date);
+      }
+    }
+  }
+}
+
+// Adds rows measuring current and former implementation.
+static void addLegacyRows() {
+  QTest::addColumn<bool>("legacy");
+
+  QTest::newRow("current") << false;
+  QTest::newRow("legacy") << true;
+}
+
+void TextBenchmark::stripTags_data() {
+  addLegacyRows();
+}
+
+void TextBenchmark::stripTags() {
+  QFETCH(bool, legacy);
+
+  WebFactory *web = WebFactory::instance();
+
+  if (legacy) {
+    QBENCHMARK {
+      foreach (const QString &contents, m_contents) {
+        LegacyWebFactory::stripTags(contents);
+      }
+    }
+  }
+  else {
+    QBENCHMARK {
+      foreach (const QString &contents, m_contents) {
+        web->stripTags(contents);
+      }
+    }
+  }
+}
+
+void TextBenchmark::escapeHtml_data() {
+  addLegacyRows();
+}
+
+void TextBenchmark::escapeHtml() {
+  QFETCH(bool, legacy);
+
+  WebFactory *web = WebFactory::instance();
+
+  if (legacy) {
+    QBENCHMARK {
+      foreach (const QString &contents, m_contents) {
+        LegacyWebFactory::escapeHtml(contents);
+      }
+    }
+  }
+  else {
+    QBENCHMARK {
+      foreach (const QString &contents, m_contents) {
+        web->escapeHtml(contents);
+      }
+    }
+  }
+}
+
+void TextBenchmark::deEscapeHtml_data() {
+  addLegacyRows();
+}
+
+void TextBenchmark::deEscapeHtml() {
+  QFETCH(bool, legacy);
+
+  WebFactory *web = WebFactory::instance();
+  QStringList texts;
+
+  foreach (const QString &contents, m_contents) {
+    texts.append(web->escapeHtml(web->stripTags(contents)));
+  }
+
+  if (legacy) {
+    QBENCHMARK {
+      foreach (const QString &text, texts) {
+        LegacyWebFactory::deEscapeHtml(text);
+      }
+    }
+  }
+  else {
+    QBENCHMARK {
+      foreach (const QString &text, texts) {
+        web->deEscapeHtml(text);
+      }
+    }
+  }
+}
@@ -0,0 +1,51 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef TEXTBENCHMARK_H
+#define TEXTBENCHMARK_H
+
+#include <QObject>
+
+#include <QStringList>
+
+
+// Measures per-message text processing, parsing of dates
+// and stripping/escaping of HTML.
+class TextBenchmark : public QObject {
+    Q_OBJECT
+
+  private slots:
+    void initTestCase();
+
+    void parseDateTime_data();
+    void parseDateTime();
+
+    void stripTags_data();
+    void stripTags();
+
+    void escapeHtml_data();
+    void escapeHtml();
+
+    void deEscapeHtml_data();
+    void deEscapeHtml();
+
+  private:
+    // Contents of messages of bundled RSS 2.0 feed.
+    QStringList m_contents;
+};
+
+#endif // TEXTBENCHMARK_H
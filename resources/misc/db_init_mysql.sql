@@ -12,7 +12,7 @@ CREATE TABLE IF NOT EXISTS Information (
   inf_value       TEXT        NOT NULL
 );
 -- !
-INSERT INTO Information VALUES (1, 'schema_version', '6');
+INSERT INTO Information VALUES (1, 'schema_version', '10');
 -- !
 CREATE TABLE IF NOT EXISTS Accounts (
   id              INTEGER     PRIMARY KEY,
@@ -38,9 +38,18 @@ CREATE TABLE IF NOT EXISTS OwnCloudAccounts (
   password        TEXT,
   url             TEXT        NOT NULL,
   force_update    INTEGER(1)  NOT NULL DEFAULT 0 CHECK (force_update >= 0 AND force_update <= 1),
+  last_modified   BIGINT      NOT NULL DEFAULT 0,
   
   FOREIGN KEY (id) REFERENCES Accounts (id)
 );
+-- !
+DROP TABLE IF EXISTS Icons;
+-- !
+CREATE TABLE IF NOT EXISTS Icons (
+  hash            VARCHAR(40)   PRIMARY KEY,
+  data            MEDIUMBLOB    NOT NULL
+);
+-- !
 DROP TABLE IF EXISTS Categories;
 -- !
 CREATE TABLE IF NOT EXISTS Categories (
@@ -52,6 +61,9 @@ CREATE TABLE IF NOT EXISTS Categories (
   icon            BLOB,
   account_id      INTEGER       NOT NULL,
   custom_id       TEXT,
+  retention_max_count     INTEGER     NOT NULL DEFAULT -1,
+  retention_max_age       INTEGER     NOT NULL DEFAULT 0 CHECK (retention_max_age >= 0),
+  retention_keep_starred  INTEGER(1)  NOT NULL DEFAULT 1 CHECK (retention_keep_starred >= 0 AND retention_keep_starred <= 1),
   
   FOREIGN KEY (account_id) REFERENCES Accounts (id)
 );
@@ -75,6 +87,9 @@ CREATE TABLE IF NOT EXISTS Feeds (
   type            INTEGER,
   account_id      INTEGER       NOT NULL,
   custom_id       TEXT,
+  retention_max_count     INTEGER     NOT NULL DEFAULT -1,
+  retention_max_age       INTEGER     NOT NULL DEFAULT 0 CHECK (retention_max_age >= 0),
+  retention_keep_starred  INTEGER(1)  NOT NULL DEFAULT 1 CHECK (retention_keep_starred >= 0 AND retention_keep_starred <= 1),
   
   FOREIGN KEY (account_id) REFERENCES Accounts (id)
 );
@@ -99,4 +114,6 @@ CREATE TABLE IF NOT EXISTS Messages (
   custom_hash     TEXT,
   
   FOREIGN KEY (account_id) REFERENCES Accounts (id)
-);
\ No newline at end of file
+);
+-- !
+CREATE INDEX idx_Messages_feed ON Messages (account_id, feed(40), date_created);
\ No newline at end of file
@@ -0,0 +1,20 @@
+CREATE TABLE IF NOT EXISTS ArchivedMessages (
+  id              INTEGER     AUTO_INCREMENT PRIMARY KEY,
+  is_read         INTEGER(1)  NOT NULL DEFAULT 0 CHECK (is_read >= 0 AND is_read <= 1),
+  is_deleted      INTEGER(1)  NOT NULL DEFAULT 0 CHECK (is_deleted >= 0 AND is_deleted <= 1),
+  is_important    INTEGER(1)  NOT NULL DEFAULT 0 CHECK (is_important >= 0 AND is_important <= 1),
+  feed            TEXT        NOT NULL,
+  title           TEXT        NOT NULL CHECK (title != ''),
+  url             TEXT,
+  author          TEXT,
+  date_created    BIGINT      NOT NULL CHECK (date_created != 0),
+  contents        TEXT,
+  is_pdeleted     INTEGER(1)  NOT NULL DEFAULT 0 CHECK (is_pdeleted >= 0 AND is_pdeleted <= 1),
+  enclosures      TEXT,
+  account_id      INTEGER     NOT NULL,
+  custom_id       TEXT,
+  custom_hash     TEXT,
+  
+  INDEX idx_ArchivedMessages_feed (account_id, feed(40), url(40)),
+  INDEX idx_ArchivedMessages_custom_id (account_id, custom_id(40))
+);
\ No newline at end of file
@@ -0,0 +1,21 @@
+CREATE TABLE IF NOT EXISTS archive.ArchivedMessages (
+  id              INTEGER     PRIMARY KEY,
+  is_read         INTEGER(1)  NOT NULL CHECK (is_read >= 0 AND is_read <= 1) DEFAULT 0,
+  is_deleted      INTEGER(1)  NOT NULL CHECK (is_deleted >= 0 AND is_deleted <= 1) DEFAULT 0,
+  is_important    INTEGER(1)  NOT NULL CHECK (is_important >= 0 AND is_important <= 1) DEFAULT 0,
+  feed            TEXT        NOT NULL,
+  title           TEXT        NOT NULL CHECK (title != ''),
+  url             TEXT,
+  author          TEXT,
+  date_created    INTEGER     NOT NULL CHECK (date_created != 0),
+  contents        TEXT,
+  is_pdeleted     INTEGER(1)  NOT NULL CHECK (is_pdeleted >= 0 AND is_pdeleted <= 1) DEFAULT 0,
+  enclosures      TEXT,
+  account_id      INTEGER     NOT NULL,
+  custom_id       TEXT,
+  custom_hash     TEXT
+);
+-- !
+CREATE INDEX IF NOT EXISTS archive.idx_ArchivedMessages_feed ON ArchivedMessages (account_id, feed, url);
+-- !
+CREATE INDEX IF NOT EXISTS archive.idx_ArchivedMessages_custom_id ON ArchivedMessages (account_id, custom_id);
\ No newline at end of file
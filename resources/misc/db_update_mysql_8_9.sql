@@ -0,0 +1,4 @@
+CREATE TABLE IF NOT EXISTS Icons (
+  hash            VARCHAR(40)   PRIMARY KEY,
+  data            MEDIUMBLOB    NOT NULL
+);
\ No newline at end of file
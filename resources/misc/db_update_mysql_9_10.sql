@@ -0,0 +1,13 @@
+ALTER TABLE Categories
+ADD COLUMN retention_max_count INTEGER NOT NULL DEFAULT -1,
+ADD COLUMN retention_max_age INTEGER NOT NULL DEFAULT 0 CHECK (retention_max_age >= 0),
+ADD COLUMN retention_keep_starred INTEGER(1) NOT NULL DEFAULT 1 CHECK (retention_keep_starred >= 0 AND retention_keep_starred <= 1);
+-- !
+ALTER TABLE Feeds
+ADD COLUMN retention_max_count INTEGER NOT NULL DEFAULT -1,
+ADD COLUMN retention_max_age INTEGER NOT NULL DEFAULT 0 CHECK (retention_max_age >= 0),
+ADD COLUMN retention_keep_starred INTEGER(1) NOT NULL DEFAULT 1 CHECK (retention_keep_starred >= 0 AND retention_keep_starred <= 1);
+-- !
+CREATE INDEX idx_Messages_feed ON Messages (account_id, feed(40), date_created);
+-- !
+UPDATE Information SET inf_value = '10' WHERE inf_key = 'schema_version';
\ No newline at end of file
@@ -0,0 +1,4 @@
+CREATE TABLE IF NOT EXISTS Icons (
+  hash            TEXT        PRIMARY KEY,
+  data            BLOB        NOT NULL
+);
\ No newline at end of file
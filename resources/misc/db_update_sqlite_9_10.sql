@@ -0,0 +1,21 @@
+ALTER TABLE Categories
+ADD COLUMN retention_max_count INTEGER NOT NULL DEFAULT -1;
+-- !
+ALTER TABLE Categories
+ADD COLUMN retention_max_age INTEGER NOT NULL CHECK (retention_max_age >= 0) DEFAULT 0;
+-- !
+ALTER TABLE Categories
+ADD COLUMN retention_keep_starred INTEGER(1) NOT NULL CHECK (retention_keep_starred >= 0 AND retention_keep_starred <= 1) DEFAULT 1;
+-- !
+ALTER TABLE Feeds
+ADD COLUMN retention_max_count INTEGER NOT NULL DEFAULT -1;
+-- !
+ALTER TABLE Feeds
+ADD COLUMN retention_max_age INTEGER NOT NULL CHECK (retention_max_age >= 0) DEFAULT 0;
+-- !
+ALTER TABLE Feeds
+ADD COLUMN retention_keep_starred INTEGER(1) NOT NULL CHECK (retention_keep_starred >= 0 AND retention_keep_starred <= 1) DEFAULT 1;
+-- !
+CREATE INDEX IF NOT EXISTS idx_Messages_feed ON Messages (account_id, feed, date_created);
+-- !
+UPDATE Information SET inf_value = '10' WHERE inf_key = 'schema_version';
\ No newline at end of file
@@ -0,0 +1,255 @@
+#!/usr/bin/env python3
+
+# This file is part of RSS Guard.
+#
+# Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+#
+# RSS Guard is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# RSS Guard is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+# Benchmark of compressed storage of message contents.
+#
+# Takes copy of existing SQLite database (or generates synthetic one) and
+# produces two variants of it - one with plain contents and one with contents
+# compressed exactly like RSS Guard does it ("RGZ:" + qCompress() data as BLOB).
+# Then it compares file sizes and times typical read patterns with limited
+# SQLite page cache:
+#   list    - loading all messages of random feeds (SELECT * like messages list),
+#   preview - loading and decompressing contents of random single messages,
+#   scan    - reading all contents of all messages.
+#
+# Usage:
+#   contents-compression-benchmark.py --database ~/.config/RSS\ Guard/database/local/database.db
+#   contents-compression-benchmark.py --generate 200000 --item-size 4000
+#
+# NOTE: Operating system file cache is dropped before each read pattern only
+# with --drop-caches, which needs root privileges on Linux. Otherwise, results
+# show mostly savings of SQLite page cache and CPU cost of decompression.
+
+import argparse
+import os
+import random
+import shutil
+import sqlite3
+import struct
+import subprocess
+import tempfile
+import time
+import zlib
+
+COMPRESSED_PREFIX = b"RGZ:"
+COMPRESSION_MIN_SIZE = 256
+INIT_SCRIPT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "misc", "db_init_sqlite.sql")
+WORDS = ("feed", "message", "server", "update", "release", "kernel", "network", "storage", "browser", "article",
+         "performance", "database", "compression", "window", "desktop", "library", "version", "security")
+
+
+def q_compress(data):
+  # Same layout as qCompress(): big-endian size of uncompressed data followed by zlib stream.
+  return struct.pack(">I", len(data)) + zlib.compress(data, 6)
+
+
+def q_uncompress(data):
+  return zlib.decompress(data[4:])
+
+
+def encode(contents):
+  plain = contents.encode("utf-8")
+
+  if len(plain) < COMPRESSION_MIN_SIZE:
+    return contents
+
+  stored = COMPRESSED_PREFIX + q_compress(plain)
+  return stored if len(stored) < len(plain) else contents
+
+
+def decode(stored):
+  if isinstance(stored, bytes) and stored.startswith(COMPRESSED_PREFIX):
+    return q_uncompress(stored[len(COMPRESSED_PREFIX):]).decode("utf-8")
+  elif isinstance(stored, bytes):
+    return stored.decode("utf-8")
+  else:
+    return stored or ""
+
+
+def synthetic_contents(rnd, size):
+  paragraphs = []
+  length = 0
+
+  while length < size:
+    sentence = " ".join(rnd.choice(WORDS) for _ in range(rnd.randint(8, 20))).capitalize() + "."
+    paragraph = "<p class=\"entry\">{0} <a href=\"https://example.com/{1}\">{2}</a></p>\n".format(
+      sentence, rnd.randint(1, 100000), rnd.choice(WORDS))
+    paragraphs.append(paragraph)
+    length += len(paragraph)
+
+  return "<div>\n" + "".join(paragraphs) + "</div>"
+
+
+def generate_database(path, options):
+  rnd = random.Random(options.seed)
+  connection = sqlite3.connect(path)
+
+  with open(INIT_SCRIPT, encoding="utf-8") as script:
+    for statement in script.read().split("-- !"):
+      if statement.strip():
+        connection.execute(statement)
+
+  connection.execute("INSERT INTO Accounts (id, type) VALUES (1, 'std-rss');")
+
+  for number in range(options.generate):
+    connection.execute("INSERT INTO Messages (feed, title, url, author, date_created, contents, enclosures, account_id) "
+                       "VALUES (?, ?, ?, ?, ?, ?, '', 1);",
+                       (str(number % options.feeds), "Message {0}".format(number), "https://example.com/{0}".format(number),
+                        "author", 1000 + number, synthetic_contents(rnd, options.item_size)))
+
+  connection.commit()
+  connection.close()
+
+
+def convert_database(path, compress):
+  connection = sqlite3.connect(path)
+  rows = connection.execute("SELECT id, contents FROM Messages;").fetchall()
+
+  for message_id, stored in rows:
+    contents = decode(stored)
+    connection.execute("UPDATE Messages SET contents = ? WHERE id = ?;", (encode(contents) if compress else contents, message_id))
+
+  connection.commit()
+  connection.execute("VACUUM;")
+  connection.close()
+
+
+def contents_sizes(path):
+  connection = sqlite3.connect(path)
+  stored_size = plain_size = compressed = count = 0
+
+  for (stored,) in connection.execute("SELECT contents FROM Messages;"):
+    count += 1
+    stored_size += len(stored) if isinstance(stored, bytes) else len((stored or "").encode("utf-8"))
+
+    if isinstance(stored, bytes) and stored.startswith(COMPRESSED_PREFIX):
+      compressed += 1
+      plain_size += struct.unpack(">I", stored[len(COMPRESSED_PREFIX):len(COMPRESSED_PREFIX) + 4])[0]
+    else:
+      plain_size += len((stored or "").encode("utf-8")) if not isinstance(stored, bytes) else len(stored)
+
+  page_count = connection.execute("PRAGMA page_count;").fetchone()[0]
+  connection.close()
+  return count, compressed, stored_size, plain_size, page_count
+
+
+def drop_caches(options):
+  if options.drop_caches:
+    subprocess.call(["sync"])
+
+    with open("/proc/sys/vm/drop_caches", "w") as caches:
+      caches.write("3\n")
+
+
+def timed(path, options, work):
+  drop_caches(options)
+  connection = sqlite3.connect(path)
+  connection.execute("PRAGMA cache_size = -{0};".format(options.cache_kb))
+  started = time.perf_counter()
+  work(connection)
+  elapsed = time.perf_counter() - started
+  connection.close()
+  return elapsed
+
+
+def benchmark(path, options):
+  rnd = random.Random(options.seed)
+  connection = sqlite3.connect(path)
+  feeds = [row[0] for row in connection.execute("SELECT DISTINCT feed FROM Messages;")]
+  max_id = connection.execute("SELECT max(id) FROM Messages;").fetchone()[0] or 0
+  connection.close()
+
+  list_feeds = [rnd.choice(feeds) for _ in range(options.lists)] if feeds else []
+  preview_ids = [rnd.randint(1, max_id) for _ in range(options.previews)] if max_id else []
+
+  def list_work(connection):
+    for feed in list_feeds:
+      connection.execute("SELECT * FROM Messages WHERE account_id = 1 AND feed = ? AND is_deleted = 0;", (feed,)).fetchall()
+
+  def preview_work(connection):
+    for message_id in preview_ids:
+      row = connection.execute("SELECT contents FROM Messages WHERE id = ?;", (message_id,)).fetchone()
+
+      if row is not None:
+        decode(row[0])
+
+  def scan_work(connection):
+    for (stored,) in connection.execute("SELECT contents FROM Messages;"):
+      decode(stored)
+
+  return {"list": timed(path, options, list_work),
+          "preview": timed(path, options, preview_work),
+          "scan": timed(path, options, scan_work)}
+
+
+def main():
+  parser = argparse.ArgumentParser(description="Benchmark of compressed storage of message contents in RSS Guard database.")
+  source = parser.add_mutually_exclusive_group(required=True)
+  source.add_argument("--database", help="existing SQLite database, it is copied and never modified")
+  source.add_argument("--generate", type=int, help="number of synthetic messages to generate")
+  parser.add_argument("--feeds", type=int, default=200, help="number of feeds for synthetic messages")
+  parser.add_argument("--item-size", type=int, default=3000, help="size of synthetic contents in characters")
+  parser.add_argument("--cache-kb", type=int, default=2000, help="SQLite page cache size in KiB")
+  parser.add_argument("--lists", type=int, default=200, help="number of loaded feed lists")
+  parser.add_argument("--previews", type=int, default=2000, help="number of previewed messages")
+  parser.add_argument("--seed", type=int, default=42)
+  parser.add_argument("--drop-caches", action="store_true", help="drop OS file cache before each pattern (root only)")
+  parser.add_argument("--keep", action="store_true", help="keep working directory with both databases")
+  options = parser.parse_args()
+
+  work_dir = tempfile.mkdtemp(prefix="rssguard-contents-")
+  plain_path = os.path.join(work_dir, "plain.db")
+  compressed_path = os.path.join(work_dir, "compressed.db")
+
+  try:
+    if options.database:
+      shutil.copyfile(options.database, plain_path)
+    else:
+      generate_database(plain_path, options)
+
+    shutil.copyfile(plain_path, compressed_path)
+    convert_database(plain_path, False)
+    convert_database(compressed_path, True)
+
+    results = {}
+
+    for name, path in (("plain", plain_path), ("compressed", compressed_path)):
+      count, compressed, stored_size, plain_size, page_count = contents_sizes(path)
+      timings = benchmark(path, options)
+      results[name] = timings
+
+      print("{0:>10}: file {1:8.1f} MB, {2} pages, {3} of {4} messages compressed, "
+            "contents stored {5:8.1f} MB / plain {6:8.1f} MB (ratio {7:.2f})".format(
+              name, os.path.getsize(path) / 1000000.0, page_count, compressed, count,
+              stored_size / 1000000.0, plain_size / 1000000.0, plain_size / float(stored_size or 1)))
+      print("{0:>10}  list {1:7.3f} s, preview {2:7.3f} s, scan {3:7.3f} s".format(
+        "", timings["list"], timings["preview"], timings["scan"]))
+
+    for pattern in ("list", "preview", "scan"):
+      print("{0:>10}: compressed takes {1:.0%} of plain time".format(
+        pattern, results["compressed"][pattern] / max(results["plain"][pattern], 1e-9)))
+  finally:
+    if options.keep:
+      print("Databases kept in '{0}'.".format(work_dir))
+    else:
+      shutil.rmtree(work_dir)
+
+
+if __name__ == "__main__":
+  main()
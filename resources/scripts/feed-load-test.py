@@ -0,0 +1,545 @@
+#!/usr/bin/env python3
+
+# This file is part of RSS Guard.
+#
+# Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+#
+# RSS Guard is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# RSS Guard is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+# Load-test harness for feed updates.
+#
+# Generates synthetic RSS 2.0/RDF/ATOM feeds and serves them from local HTTP
+# server with configurable latency, ETag/304 behavior, gzip and error injection.
+# Driver creates throwaway profile (HOME is pointed to temporary folder), adds
+# the feeds into its database and runs "rssguard --headless --update-all" in
+# several rounds, measuring throughput and peak memory of each round.
+#
+# Usage:
+#   feed-load-test.py generate --feeds 100 --output-dir /tmp/feeds
+#   feed-load-test.py serve --feeds 1000 --latency 50 --error-rate 0.05
+#   feed-load-test.py run --binary ./rssguard --feeds 1000 --rounds 3 --threads 12
+#
+# NOTE: Driver needs Linux (os.wait4) and no other RSS Guard instance
+# of the same user may run, because instances are single per user.
+
+import argparse
+import gzip
+import hashlib
+import json
+import os
+import random
+import shutil
+import sqlite3
+import statistics
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+from email.utils import formatdate
+from http.server import BaseHTTPRequestHandler, HTTPServer
+from socketserver import ThreadingMixIn
+from xml.sax.saxutils import escape
+
+FORMATS = ("rss", "rdf", "atom")
+FEED_TYPES = {"rss": 1, "rdf": 2, "atom": 3}
+MALFORMATIONS = ("truncated", "bad-entity", "wrong-encoding", "no-dates")
+SERVICE_CODE_STD_RSS = "std-rss"
+PROFILE_FOLDER = os.path.join(".rssguard", "data")
+DATABASE_FILE = os.path.join("database", "local", "database.db")
+
+
+class FeedSpec(object):
+  # Deterministic properties of single synthetic feed.
+
+  def __init__(self, index, options):
+    rnd = random.Random("%s-%d" % (options.seed, index))
+
+    self.index = index
+    self.format = options.formats[index % len(options.formats)]
+    self.encoding = rnd.choice(options.encodings)
+    self.malformation = rnd.choice(MALFORMATIONS) if rnd.random() < options.malformed_rate else None
+    self.items = options.items
+    self.item_size = options.item_size
+
+    # How many items are replaced by new ones in each round.
+    self.churn = max(0, min(self.items, int(round(options.churn * self.items))))
+    self.title = "Synthetic %s feed %d" % (self.format.upper(), index)
+
+  def url(self, base_url):
+    return "%s/feed/%d" % (base_url, self.index)
+
+
+class FeedGenerator(object):
+  # Renders feeds, each round shifts window of items by "churn" items.
+
+  LOREM = ("lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor "
+           "incididunt ut labore et dolore magna aliqua ut enim ad minim veniam quis nostrud ")
+
+  def __init__(self, options):
+    self.options = options
+    self.specs = [FeedSpec(i, options) for i in range(options.feeds)]
+
+  def render(self, index, round_number):
+    spec = self.specs[index]
+    first_item = round_number * spec.churn
+    items = [self.item(spec, number) for number in range(first_item + spec.items - 1, first_item - 1, -1)]
+
+    if spec.format == "rss":
+      text = self.render_rss(spec, items)
+    elif spec.format == "rdf":
+      text = self.render_rdf(spec, items)
+    else:
+      text = self.render_atom(spec, items)
+
+    if spec.malformation == "truncated":
+      text = text[:len(text) * 2 // 3]
+    elif spec.malformation == "bad-entity":
+      text = text.replace("</title>", " &undefinedentity;</title>", 1)
+
+    # Characters which cannot be represented by the encoding are escaped.
+    data = text.encode(spec.encoding, "xmlcharrefreplace")
+
+    if spec.malformation == "wrong-encoding":
+      # Declared encoding does not match the actual one.
+      data = text.encode("utf-16")
+
+    return data
+
+  def item(self, spec, number):
+    rnd = random.Random("%s-%d-%d" % (self.options.seed, spec.index, number))
+    words = (self.LOREM * (spec.item_size // len(self.LOREM) + 1))[:spec.item_size]
+
+    return {
+      "title": "Item %d of feed %d éšč" % (number, spec.index),
+      "link": "http://example.com/feed/%d/item/%d" % (spec.index, number),
+      "description": "<p>%s</p>" % words,
+      "author": "author%d@example.com" % rnd.randint(1, 20),
+      "date": None if spec.malformation == "no-dates" else 1400000000 + number * 3600
+    }
+
+  def render_rss(self, spec, items):
+    parts = ['<?xml version="1.0" encoding="%s"?>\n<rss version="2.0"><channel>' % spec.encoding,
+             "<title>%s</title><link>http://example.com/feed/%d</link>" % (escape(spec.title), spec.index),
+             "<description>Synthetic feed for load testing.</description>"]
+
+    for item in items:
+      parts.append("<item><title>%s</title><link>%s</link><description>%s</description><author>%s</author>%s"
+                   "<guid>%s</guid></item>" % (escape(item["title"]), escape(item["link"]),
+                                               escape(item["description"]), item["author"],
+                                               "" if item["date"] is None else
+                                               "<pubDate>%s</pubDate>" % formatdate(item["date"], usegmt=True),
+                                               escape(item["link"])))
+
+    parts.append("</channel></rss>")
+    return "\n".join(parts)
+
+  def render_rdf(self, spec, items):
+    parts = ['<?xml version="1.0" encoding="%s"?>' % spec.encoding,
+             '<rdf:RDF xmlns:rdf="http://www.w3.org/1999/02/22-rdf-syntax-ns#" '
+             'xmlns="http://purl.org/rss/1.0/" xmlns:dc="http://purl.org/dc/elements/1.1/">',
+             '<channel rdf:about="http://example.com/feed/%d"><title>%s</title>'
+             '<link>http://example.com/feed/%d</link><description>Synthetic feed for load testing.</description>'
+             '</channel>' % (spec.index, escape(spec.title), spec.index)]
+
+    for item in items:
+      parts.append('<item rdf:about="%s"><title>%s</title><link>%s</link><description>%s</description>'
+                   '<dc:creator>%s</dc:creator>%s</item>' % (escape(item["link"]), escape(item["title"]),
+                                                             escape(item["link"]), escape(item["description"]),
+                                                             item["author"],
+                                                             "" if item["date"] is None else
+                                                             "<dc:date>%s</dc:date>" % iso_date(item["date"])))
+
+    parts.append("</rdf:RDF>")
+    return "\n".join(parts)
+
+  def render_atom(self, spec, items):
+    parts = ['<?xml version="1.0" encoding="%s"?>' % spec.encoding,
+             '<feed xmlns="http://www.w3.org/2005/Atom"><title>%s</title>'
+             '<link href="http://example.com/feed/%d"/><id>urn:synthetic:%d</id>' % (escape(spec.title),
+                                                                                   spec.index, spec.index)]
+
+    for item in items:
+      parts.append('<entry><title>%s</title><link href="%s"/><id>%s</id><author><name>%s</name></author>'
+                   '<content type="html">%s</content>%s</entry>' % (escape(item["title"]), escape(item["link"]),
+                                                                    escape(item["link"]), item["author"],
+                                                                    escape(item["description"]),
+                                                                    "" if item["date"] is None else
+                                                                    "<updated>%s</updated>" % iso_date(item["date"])))
+
+    parts.append("</feed>")
+    return "\n".join(parts)
+
+
+def iso_date(timestamp):
+  return time.strftime("%Y-%m-%dT%H:%M:%SZ", time.gmtime(timestamp))
+
+
+class ThreadingServer(ThreadingMixIn, HTTPServer):
+  daemon_threads = True
+
+
+class FeedServer(object):
+  # Local HTTP server with latency, ETag/304, gzip and error injection.
+
+  def __init__(self, generator, options):
+    self.generator = generator
+    self.options = options
+    self.round = 0
+    self.lock = threading.Lock()
+    self.counters = {"requests": 0, "not_modified": 0, "errors": 0, "bytes": 0}
+    self.httpd = ThreadingServer(("127.0.0.1", options.port), self.handler_class())
+    self.base_url = "http://127.0.0.1:%d" % self.httpd.server_address[1]
+
+  def start(self):
+    thread = threading.Thread(target=self.httpd.serve_forever)
+    thread.daemon = True
+    thread.start()
+
+  def stop(self):
+    self.httpd.shutdown()
+    self.httpd.server_close()
+
+  def advance(self):
+    with self.lock:
+      self.round += 1
+
+  def count(self, key, value=1):
+    with self.lock:
+      self.counters[key] += value
+
+  def snapshot(self):
+    with self.lock:
+      return dict(self.counters, round=self.round)
+
+  def handler_class(self):
+    server = self
+
+    class Handler(BaseHTTPRequestHandler):
+      protocol_version = "HTTP/1.1"
+
+      def log_message(self, format, *args):
+        pass
+
+      def do_GET(self):
+        server.count("requests")
+
+        if self.path == "/control/advance":
+          server.advance()
+          return self.reply(200, json.dumps(server.snapshot()).encode(), "application/json")
+        elif self.path == "/control/stats":
+          return self.reply(200, json.dumps(server.snapshot()).encode(), "application/json")
+
+        parts = self.path.strip("/").split("/")
+
+        if len(parts) != 2 or parts[0] != "feed" or not parts[1].isdigit() or int(parts[1]) >= len(server.generator.specs):
+          return self.reply(404, b"Not found.", "text/plain")
+
+        index = int(parts[1])
+        rnd = random.Random()
+
+        if server.options.latency > 0 or server.options.jitter > 0:
+          time.sleep(max(0, server.options.latency + rnd.uniform(-server.options.jitter, server.options.jitter)) / 1000.0)
+
+        if rnd.random() < server.options.error_rate:
+          return self.inject_error(rnd)
+
+        with server.lock:
+          round_number = server.round
+
+        spec = server.generator.specs[index]
+        etag = '"%s"' % hashlib.sha1(("%d-%d" % (index, round_number if spec.churn > 0 else 0)).encode()).hexdigest()
+
+        if server.options.etag and self.headers.get("If-None-Match") == etag:
+          server.count("not_modified")
+          self.send_response(304)
+          self.send_header("ETag", etag)
+          self.send_header("Content-Length", "0")
+          self.end_headers()
+          return
+
+        data = server.generator.render(index, round_number)
+        headers = {}
+
+        if server.options.etag:
+          headers["ETag"] = etag
+
+        if server.options.gzip and "gzip" in self.headers.get("Accept-Encoding", ""):
+          data = gzip.compress(data)
+          headers["Content-Encoding"] = "gzip"
+
+        content_type = {"rss": "application/rss+xml", "rdf": "application/rdf+xml",
+                        "atom": "application/atom+xml"}[spec.format]
+        self.reply(200, data, "%s; charset=%s" % (content_type, spec.encoding), headers)
+
+      def inject_error(self, rnd):
+        server.count("errors")
+        kind = rnd.choice(("500", "404", "stall", "reset"))
+
+        if kind == "stall":
+          # Longer than any sane download timeout.
+          time.sleep(server.options.stall / 1000.0)
+          self.reply(503, b"Stalled.", "text/plain")
+        elif kind == "reset":
+          self.close_connection = True
+          self.connection.close()
+        else:
+          self.reply(int(kind), b"Injected error.", "text/plain")
+
+      def reply(self, code, data, content_type, headers=None):
+        server.count("bytes", len(data))
+
+        self.send_response(code)
+        self.send_header("Content-Type", content_type)
+        self.send_header("Content-Length", str(len(data)))
+
+        for name, value in (headers or {}).items():
+          self.send_header(name, value)
+
+        self.end_headers()
+        self.wfile.write(data)
+
+    return Handler
+
+
+def write_opml(path, specs, base_url):
+  with open(path, "w", encoding="utf-8") as opml:
+    opml.write('<?xml version="1.0" encoding="UTF-8"?>\n<opml version="2.0"><head><title>Synthetic feeds</title></head><body>\n')
+
+    for spec in specs:
+      opml.write('<outline type="rss" text="%s" xmlUrl="%s"/>\n' % (escape(spec.title), escape(spec.url(base_url))))
+
+    opml.write("</body></opml>\n")
+
+
+def command_generate(options):
+  generator = FeedGenerator(options)
+  base_url = "http://127.0.0.1:%d" % options.port
+  extensions = {"rss": "xml", "rdf": "rdf", "atom": "atom"}
+
+  os.makedirs(options.output_dir, exist_ok=True)
+
+  for spec in generator.specs:
+    with open(os.path.join(options.output_dir, "feed-%d.%s" % (spec.index, extensions[spec.format])), "wb") as feed:
+      feed.write(generator.render(spec.index, 0))
+
+  write_opml(os.path.join(options.output_dir, "feeds.opml"), generator.specs, base_url)
+  print("Generated %d feeds into '%s'." % (len(generator.specs), options.output_dir))
+
+
+def command_serve(options):
+  generator = FeedGenerator(options)
+  server = FeedServer(generator, options)
+
+  print("Serving %d feeds at %s/feed/<0..%d>, advance items by %s/control/advance."
+        % (len(generator.specs), server.base_url, len(generator.specs) - 1, server.base_url))
+
+  try:
+    server.httpd.serve_forever()
+  except KeyboardInterrupt:
+    server.httpd.server_close()
+
+
+def prepare_profile(home, options):
+  config_folder = os.path.join(home, PROFILE_FOLDER, "config")
+  os.makedirs(config_folder, exist_ok=True)
+
+  # Existing non-portable settings make RSS Guard use profile in (fake) home folder.
+  with open(os.path.join(config_folder, "config.ini"), "w") as config:
+    config.write("[database]\nuse_in_memory_db=false\ndatabase_driver=QSQLITE\n\n")
+    config.write("[feeds]\nfeed_update_timeout=%d\n" % options.timeout)
+
+
+def populate_database(home, specs, base_url):
+  database = sqlite3.connect(os.path.join(home, PROFILE_FOLDER, DATABASE_FILE))
+  cursor = database.cursor()
+
+  cursor.execute("INSERT INTO Accounts (type) VALUES (?);", (SERVICE_CODE_STD_RSS,))
+  account_id = cursor.lastrowid
+
+  for spec in specs:
+    cursor.execute("INSERT INTO Feeds (title, date_created, category, encoding, url, protected, update_type, "
+                   "update_interval, type, account_id) VALUES (?, ?, -1, ?, ?, 0, 1, 15, ?, ?);",
+                   (spec.title, int(time.time() * 1000), spec.encoding.upper(), spec.url(base_url),
+                    FEED_TYPES[spec.format], account_id))
+    cursor.execute("UPDATE Feeds SET custom_id = id WHERE id = ?;", (cursor.lastrowid,))
+
+  database.commit()
+  database.close()
+
+
+def run_headless(options, home, threads):
+  environment = dict(os.environ, HOME=home)
+  command = [options.binary, "--headless", "--update-all", "--threads", str(threads)]
+  started = time.time()
+
+  with tempfile.TemporaryFile() as output:
+    process = subprocess.Popen(command, env=environment, stdout=output, stderr=subprocess.DEVNULL)
+    _, status, usage = os.wait4(process.pid, 0)
+    process.returncode = os.waitstatus_to_exitcode(status) if hasattr(os, "waitstatus_to_exitcode") else status
+    output.seek(0)
+    text = output.read().decode("utf-8", "replace")
+
+  wall_time = time.time() - started
+
+  try:
+    results = json.loads(text[text.index("{"):])
+  except ValueError:
+    results = None
+
+  # "ru_maxrss" is in kilobytes on Linux.
+  return results, wall_time, usage.ru_maxrss, process.returncode
+
+
+def percentile(values, fraction):
+  if not values:
+    return 0
+
+  values = sorted(values)
+  return values[min(len(values) - 1, int(round(fraction * (len(values) - 1))))]
+
+
+def summarize(round_number, results, wall_time, max_rss, exit_code, server_counters):
+  feeds = results["feeds"] if results is not None else []
+  totals = [feed["total_ms"] for feed in feeds]
+  downloaded = sum(feed["bytes"] for feed in feeds)
+  duration = (results["duration_ms"] / 1000.0) if results is not None and results["duration_ms"] > 0 else wall_time
+
+  return {
+    "round": round_number,
+    "exit_code": exit_code,
+    "wall_time_s": round(wall_time, 3),
+    "update_time_s": round(duration, 3),
+    "feeds": len(feeds),
+    "failed_feeds": sum(1 for feed in feeds if feed["error"]),
+    "new_messages": sum(feed["new_messages"] for feed in feeds),
+    "feeds_per_s": round(len(feeds) / duration, 2) if duration > 0 else 0,
+    "bytes_per_s": int(downloaded / duration) if duration > 0 else 0,
+    "feed_total_ms_p50": percentile(totals, 0.5),
+    "feed_total_ms_p95": percentile(totals, 0.95),
+    "feed_total_ms_max": max(totals) if totals else 0,
+    "parsing_ms_sum": sum(max(0, feed["parsing_ms"]) for feed in feeds),
+    "storing_ms_sum": sum(max(0, feed["storing_ms"]) for feed in feeds),
+    "max_rss_kb": max_rss,
+    "server": server_counters
+  }
+
+
+def command_run(options):
+  if not os.access(options.binary, os.X_OK):
+    sys.exit("Binary '%s' is not executable." % options.binary)
+
+  generator = FeedGenerator(options)
+  server = FeedServer(generator, options)
+  home = tempfile.mkdtemp(prefix="rssguard-load-test-")
+  report = {"options": vars(options), "rounds": []}
+
+  server.start()
+
+  try:
+    prepare_profile(home, options)
+
+    # First run initializes database of the throwaway profile.
+    run_headless(options, home, 1)
+    populate_database(home, generator.specs, server.base_url)
+
+    for round_number in range(options.rounds):
+      before = server.snapshot()
+      results, wall_time, max_rss, exit_code = run_headless(options, home, options.threads)
+      after = server.snapshot()
+      counters = dict((key, after[key] - before[key]) for key in ("requests", "not_modified", "errors", "bytes"))
+      summary = summarize(round_number, results, wall_time, max_rss, exit_code, counters)
+
+      report["rounds"].append(summary)
+      print(json.dumps(summary))
+      sys.stdout.flush()
+
+      # Next round gets new items according to churn rate.
+      server.advance()
+
+    if options.report:
+      with open(options.report, "w") as report_file:
+        json.dump(report, report_file, indent=2)
+
+    rates = [item["feeds_per_s"] for item in report["rounds"]]
+    print("Median throughput %.2f feeds/s, peak memory %d kB." %
+          (statistics.median(rates) if rates else 0, max(item["max_rss_kb"] for item in report["rounds"]) if rates else 0))
+  finally:
+    server.stop()
+
+    if options.keep_profile:
+      print("Profile kept in '%s'." % home)
+    else:
+      shutil.rmtree(home, ignore_errors=True)
+
+
+def csv_list(value):
+  return [item.strip() for item in value.split(",") if item.strip()]
+
+
+def main():
+  parser = argparse.ArgumentParser(description="Synthetic feed generator and load-test harness for RSS Guard.")
+  subparsers = parser.add_subparsers(dest="command")
+
+  feed_options = argparse.ArgumentParser(add_help=False)
+  feed_options.add_argument("--feeds", type=int, default=100, help="number of generated feeds")
+  feed_options.add_argument("--items", type=int, default=20, help="number of items in each feed")
+  feed_options.add_argument("--item-size", type=int, default=1000, help="size of item description in characters")
+  feed_options.add_argument("--churn", type=float, default=0.25, help="fraction of items replaced in each round")
+  feed_options.add_argument("--formats", type=csv_list, default=list(FORMATS), help="comma-separated: rss,rdf,atom")
+  feed_options.add_argument("--encodings", type=csv_list, default=["utf-8"], help="comma-separated, e.g. utf-8,iso-8859-2")
+  feed_options.add_argument("--malformed-rate", type=float, default=0.0, help="fraction of malformed feeds")
+  feed_options.add_argument("--seed", default="rssguard", help="seed which makes generated data reproducible")
+  feed_options.add_argument("--port", type=int, default=0, help="port of HTTP server, 0 picks free one")
+
+  server_options = argparse.ArgumentParser(add_help=False)
+  server_options.add_argument("--latency", type=int, default=0, help="mean response latency in ms")
+  server_options.add_argument("--jitter", type=int, default=0, help="maximal deviation of latency in ms")
+  server_options.add_argument("--etag", action="store_true", help="send ETag and answer 304 for unchanged feeds")
+  server_options.add_argument("--gzip", action="store_true", help="compress responses if client accepts gzip")
+  server_options.add_argument("--error-rate", type=float, default=0.0, help="fraction of requests failing with "
+                                                                            "500/404/stall/connection reset")
+  server_options.add_argument("--stall", type=int, default=30000, help="duration of stalled responses in ms")
+
+  generate = subparsers.add_parser("generate", parents=[feed_options], help="write feeds and OPML into folder")
+  generate.add_argument("--output-dir", required=True)
+
+  subparsers.add_parser("serve", parents=[feed_options, server_options], help="serve feeds until interrupted")
+
+  run = subparsers.add_parser("run", parents=[feed_options, server_options], help="serve feeds and measure updates")
+  run.add_argument("--binary", required=True, help="path to rssguard executable")
+  run.add_argument("--rounds", type=int, default=3)
+  run.add_argument("--threads", type=int, default=6)
+  run.add_argument("--timeout", type=int, default=5000, help="feed download timeout in ms")
+  run.add_argument("--report", help="write JSON report of all rounds into this file")
+  run.add_argument("--keep-profile", action="store_true", help="do not delete throwaway profile")
+
+  options = parser.parse_args()
+
+  for feed_format in getattr(options, "formats", []):
+    if feed_format not in FORMATS:
+      parser.error("Unknown format '%s'." % feed_format)
+
+  if options.command == "generate":
+    command_generate(options)
+  elif options.command == "serve":
+    command_serve(options)
+  elif options.command == "run":
+    command_run(options)
+  else:
+    parser.print_help()
+
+
+if __name__ == "__main__":
+  main()
@@ -33,11 +33,25 @@
 #     make
 #     make install
 #
+#   c) Benchmarks of parsing, storing and loading of messages, see "benchmarks/benchmarks.pro".
+#     cd ../build-dir-benchmarks
+#     qmake ../rssguard-dir/benchmarks/benchmarks.pro CONFIG+=release
+#     make
+#
+#   d) Tests of parsing and text processing, see "tests/tests.pro".
+#     cd ../build-dir-tests
+#     qmake ../rssguard-dir/tests/tests.pro
+#     make check
+#
 # Variables:
 #   USE_WEBENGINE - if specified, then QtWebEngine module for internal web browser is used.
 #                   Otherwise simple text component is used and some features will be disabled.
 #                   Default value is "false". If QtWebEngine is installed during compilation, then
 #                   value of this variable is tweaked automatically.
+#   USE_SQLITE_BACKUP - if "true", then application links SQLite library and uses its online
+#                       backup API to back up database in small steps while it is in use.
+#                       Otherwise database file is simply copied. Enable it only if Qt SQL
+#                       driver uses the same (system) SQLite library. Default value is "false".
 #   PREFIX - specifies base folder to which files are copied during "make install"
 #            step, defaults to "$$OUT_PWD/usr" on Linux and to "$$OUT_PWD/app" on Windows.
 #   LRELEASE_EXECUTABLE - specifies the name/path of "lrelease" executable, defaults to "lrelease".
@@ -68,20 +82,7 @@ lessThan(QT_MAJOR_VERSION, 5)|lessThan(QT_MINOR_VERSION, 7) {
   warning(rssguard: You have Qt \"$$QT_VERSION\". Some features will be disabled.)
 }
 
-APP_NAME                      = "RSS Guard"
-APP_LOW_NAME                  = "rssguard"
-APP_LOW_H_NAME                = ".rssguard"
-APP_AUTHOR                    = "Martin Rotter"
-APP_COPYRIGHT                 = "(C) 2011-2016 $$APP_AUTHOR"
-APP_VERSION                   = "3.3.7"
-APP_LONG_NAME                 = "$$APP_NAME $$APP_VERSION"
-APP_EMAIL                     = "rotter.martinos@gmail.com"
-APP_URL                       = "https://github.com/martinrotter/rssguard"
-APP_URL_ISSUES                = "https://github.com/martinrotter/rssguard/issues"
-APP_URL_ISSUES_NEW            = "https://github.com/martinrotter/rssguard/issues/new"
-APP_URL_WIKI                  = "https://github.com/martinrotter/rssguard/wiki"
-APP_USERAGENT                 = "RSS Guard/$$APP_VERSION (github.com/martinrotter/rssguard)"
-APP_DONATE_URL                = "https://goo.gl/YFVJ0j"
+include(rssguard.pri)
 
 isEmpty(PREFIX) {
   message(rssguard: PREFIX variable is not set. This might indicate error.)
@@ -101,20 +102,6 @@ isEmpty(DESTDIR) {
   }
 }
 
-isEmpty(USE_WEBENGINE) {
-  USE_WEBENGINE = false
-  message(rssguard: USE_WEBENGINE variable is not set.)
-
-  qtHaveModule(webenginewidgets) {
-    USE_WEBENGINE = true
-    message("rssguard: WebEngine component IS installed, enabling it.")
-  }
-  else {
-    USE_WEBENGINE = false
-    message("rssguard: WebEngine component is probably NOT installed, disabling it.")
-  }
-}
-
 message(rssguard: Shadow copy build directory \"$$OUT_PWD\".)
 
 isEmpty(LRELEASE_EXECUTABLE) {
@@ -122,41 +109,6 @@ isEmpty(LRELEASE_EXECUTABLE) {
   message(rssguard: LRELEASE_EXECUTABLE variable is not set.)
 }
 
-# Custom definitions.
-DEFINES += APP_VERSION='"\\\"$$APP_VERSION\\\""'
-DEFINES += APP_NAME='"\\\"$$APP_NAME\\\""'
-DEFINES += APP_LOW_NAME='"\\\"$$APP_LOW_NAME\\\""'
-DEFINES += APP_LOW_H_NAME='"\\\"$$APP_LOW_H_NAME\\\""'
-DEFINES += APP_LONG_NAME='"\\\"$$APP_LONG_NAME\\\""'
-DEFINES += APP_AUTHOR='"\\\"$$APP_AUTHOR\\\""'
-DEFINES += APP_EMAIL='"\\\"$$APP_EMAIL\\\""'
-DEFINES += APP_URL='"\\\"$$APP_URL\\\""'
-DEFINES += APP_URL_ISSUES='"\\\"$$APP_URL_ISSUES\\\""'
-DEFINES += APP_URL_ISSUES_NEW='"\\\"$$APP_URL_ISSUES_NEW\\\""'
-DEFINES += APP_URL_WIKI='"\\\"$$APP_URL_WIKI\\\""'
-DEFINES += APP_USERAGENT='"\\\"$$APP_USERAGENT\\\""'
-DEFINES += APP_DONATE_URL='"\\\"$$APP_DONATE_URL\\\""'
-DEFINES += APP_SYSTEM_NAME='"\\\"$$QMAKE_HOST.os\\\""'
-DEFINES += APP_SYSTEM_VERSION='"\\\"$$QMAKE_HOST.arch\\\""'
-
-CODECFORTR  = UTF-8
-CODECFORSRC = UTF-8
-
-exists(.git) {
-  APP_REVISION = $$system(git rev-parse --short HEAD)
-}
-
-isEmpty(APP_REVISION) {
-  APP_REVISION = ""
-}
-
-equals(USE_WEBENGINE, false) {
-  # Add extra revision naming when building without webengine.
-  APP_REVISION = $$sprintf('%1-%2', $$APP_REVISION, nowebengine)
-}
-
-DEFINES += APP_REVISION='"\\\"$$APP_REVISION\\\""'
-
 message(rssguard: RSS Guard version is: \"$$APP_VERSION\".)
 message(rssguard: Detected Qt version: \"$$QT_VERSION\".)
 message(rssguard: Build destination directory: \"$$DESTDIR\".)
@@ -164,12 +116,6 @@ message(rssguard: Prefix directory: \"$$PREFIX\".)
 message(rssguard: Build revision: \"$$APP_REVISION\".)
 message(rssguard: lrelease executable name: \"$$LRELEASE_EXECUTABLE\".)
 
-QT += core gui widgets sql network xml
-
-CONFIG *= c++11 debug_and_release warn_on
-DEFINES *= QT_USE_QSTRINGBUILDER QT_USE_FAST_CONCATENATION QT_USE_FAST_OPERATOR_PLUS UNICODE _UNICODE
-VERSION = $$APP_VERSION
-
 win32 {
   # Makes sure we use correct subsystem on Windows.
   !contains(QMAKE_TARGET.arch, x86_64) {
@@ -185,15 +131,6 @@ MOC_DIR = $$OUT_PWD/moc
 RCC_DIR = $$OUT_PWD/rcc
 UI_DIR = $$OUT_PWD/ui
 
-equals(USE_WEBENGINE, true) {
-  message(rssguard: Application will be compiled WITH QtWebEngine module.)
-  QT += webenginewidgets
-  DEFINES += USE_WEBENGINE
-}
-else {
-  message(rssguard: Application will be compiled without QtWebEngine module. Some features will be disabled.)
-}
-
 # Make needed tweaks for RC file getting generated on Windows.
 win32 {
   RC_ICONS = resources/graphics/rssguard.ico
@@ -203,291 +140,7 @@ win32 {
   QMAKE_TARGET_PRODUCT = $$APP_NAME
 }
 
-HEADERS +=  src/core/feeddownloader.h \
-            src/core/feedsmodel.h \
-            src/core/feedsproxymodel.h \
-            src/core/message.h \
-            src/core/messagesmodel.h \
-            src/core/messagesproxymodel.h \
-            src/core/parsingfactory.h \
-            src/definitions/definitions.h \
-            src/dynamic-shortcuts/dynamicshortcuts.h \
-            src/dynamic-shortcuts/dynamicshortcutswidget.h \
-            src/dynamic-shortcuts/shortcutbutton.h \
-            src/dynamic-shortcuts/shortcutcatcher.h \
-            src/exceptions/applicationexception.h \
-            src/exceptions/ioexception.h \
-            src/gui/baselineedit.h \
-            src/gui/basetoolbar.h \
-            src/gui/colorlabel.h \
-            src/gui/comboboxwithstatus.h \
-            src/gui/dialogs/formabout.h \
-            src/gui/dialogs/formaddaccount.h \
-            src/gui/dialogs/formbackupdatabasesettings.h \
-            src/gui/dialogs/formdatabasecleanup.h \
-            src/gui/dialogs/formmain.h \
-            src/gui/dialogs/formrestoredatabasesettings.h \
-            src/gui/dialogs/formsettings.h \
-            src/gui/dialogs/formupdate.h \
-            src/gui/edittableview.h \
-            src/gui/feedmessageviewer.h \
-            src/gui/feedstoolbar.h \
-            src/gui/feedsview.h \
-            src/gui/labelwithstatus.h \
-            src/gui/lineeditwithstatus.h \
-            src/gui/messagebox.h \
-            src/gui/messagessearchlineedit.h \
-            src/gui/messagestoolbar.h \
-            src/gui/messagesview.h \
-            src/gui/plaintoolbutton.h \
-            src/gui/squeezelabel.h \
-            src/gui/statusbar.h \
-            src/gui/styleditemdelegatewithoutfocus.h \
-            src/gui/systemtrayicon.h \
-            src/gui/tabbar.h \
-            src/gui/tabcontent.h \
-            src/gui/tabwidget.h \
-            src/gui/timespinbox.h \
-            src/gui/toolbareditor.h \
-            src/gui/widgetwithstatus.h \
-            src/miscellaneous/application.h \
-            src/miscellaneous/autosaver.h \
-            src/miscellaneous/databasecleaner.h \
-            src/miscellaneous/databasefactory.h \
-            src/miscellaneous/databasequeries.h \
-            src/miscellaneous/debugging.h \
-            src/miscellaneous/iconfactory.h \
-            src/miscellaneous/iofactory.h \
-            src/miscellaneous/localization.h \
-            src/miscellaneous/mutex.h \
-            src/miscellaneous/settings.h \
-            src/miscellaneous/settingsproperties.h \
-            src/miscellaneous/simplecrypt/simplecrypt.h \
-            src/miscellaneous/skinfactory.h \
-            src/miscellaneous/systemfactory.h \
-            src/miscellaneous/textfactory.h \
-            src/network-web/basenetworkaccessmanager.h \
-            src/network-web/downloader.h \
-            src/network-web/downloadmanager.h \
-            src/network-web/networkfactory.h \
-            src/network-web/silentnetworkaccessmanager.h \
-            src/network-web/webfactory.h \
-            src/qtsingleapplication/qtlocalpeer.h \
-            src/qtsingleapplication/qtlockedfile.h \
-            src/qtsingleapplication/qtsingleapplication.h \
-            src/qtsingleapplication/qtsinglecoreapplication.h \
-            src/services/abstract/accountcheckmodel.h \
-            src/services/abstract/category.h \
-            src/services/abstract/feed.h \
-            src/services/abstract/gui/formfeeddetails.h \
-            src/services/abstract/recyclebin.h \
-            src/services/abstract/rootitem.h \
-            src/services/abstract/serviceentrypoint.h \
-            src/services/abstract/serviceroot.h \
-            src/services/owncloud/definitions.h \
-            src/services/owncloud/gui/formeditowncloudaccount.h \
-            src/services/owncloud/gui/formowncloudfeeddetails.h \
-            src/services/owncloud/network/owncloudnetworkfactory.h \
-            src/services/owncloud/owncloudcategory.h \
-            src/services/owncloud/owncloudfeed.h \
-            src/services/owncloud/owncloudrecyclebin.h \
-            src/services/owncloud/owncloudserviceentrypoint.h \
-            src/services/owncloud/owncloudserviceroot.h \
-            src/services/standard/gui/formstandardcategorydetails.h \
-            src/services/standard/gui/formstandardfeeddetails.h \
-            src/services/standard/gui/formstandardimportexport.h \
-            src/services/standard/standardcategory.h \
-            src/services/standard/standardfeed.h \
-            src/services/standard/standardfeedsimportexportmodel.h \
-            src/services/standard/standardserviceentrypoint.h \
-            src/services/standard/standardserviceroot.h \
-            src/services/tt-rss/definitions.h \
-            src/services/tt-rss/gui/formeditaccount.h \
-            src/services/tt-rss/gui/formttrssfeeddetails.h \
-            src/services/tt-rss/network/ttrssnetworkfactory.h \
-            src/services/tt-rss/ttrsscategory.h \
-            src/services/tt-rss/ttrssfeed.h \
-            src/services/tt-rss/ttrssrecyclebin.h \
-            src/services/tt-rss/ttrssserviceentrypoint.h \
-            src/services/tt-rss/ttrssserviceroot.h \
-            src/gui/settings/settingspanel.h \
-            src/gui/settings/settingsgeneral.h \
-            src/gui/settings/settingsdatabase.h \
-            src/gui/settings/settingsshortcuts.h \
-            src/gui/settings/settingsgui.h \
-            src/gui/settings/settingslocalization.h \
-            src/gui/settings/settingsbrowsermail.h \
-            src/gui/settings/settingsfeedsmessages.h \
-            src/gui/settings/settingsdownloads.h \
-            src/miscellaneous/feedreader.h
-
-SOURCES +=  src/core/feeddownloader.cpp \
-            src/core/feedsmodel.cpp \
-            src/core/feedsproxymodel.cpp \
-            src/core/message.cpp \
-            src/core/messagesmodel.cpp \
-            src/core/messagesproxymodel.cpp \
-            src/core/parsingfactory.cpp \
-            src/dynamic-shortcuts/dynamicshortcuts.cpp \
-            src/dynamic-shortcuts/dynamicshortcutswidget.cpp \
-            src/dynamic-shortcuts/shortcutbutton.cpp \
-            src/dynamic-shortcuts/shortcutcatcher.cpp \
-            src/exceptions/applicationexception.cpp \
-            src/exceptions/ioexception.cpp \
-            src/gui/baselineedit.cpp \
-            src/gui/basetoolbar.cpp \
-            src/gui/colorlabel.cpp \
-            src/gui/comboboxwithstatus.cpp \
-            src/gui/dialogs/formabout.cpp \
-            src/gui/dialogs/formaddaccount.cpp \
-            src/gui/dialogs/formbackupdatabasesettings.cpp \
-            src/gui/dialogs/formdatabasecleanup.cpp \
-            src/gui/dialogs/formmain.cpp \
-            src/gui/dialogs/formrestoredatabasesettings.cpp \
-            src/gui/dialogs/formsettings.cpp \
-            src/gui/dialogs/formupdate.cpp \
-            src/gui/edittableview.cpp \
-            src/gui/feedmessageviewer.cpp \
-            src/gui/feedstoolbar.cpp \
-            src/gui/feedsview.cpp \
-            src/gui/labelwithstatus.cpp \
-            src/gui/lineeditwithstatus.cpp \
-            src/gui/messagebox.cpp \
-            src/gui/messagessearchlineedit.cpp \
-            src/gui/messagestoolbar.cpp \
-            src/gui/messagesview.cpp \
-            src/gui/plaintoolbutton.cpp \
-            src/gui/squeezelabel.cpp \
-            src/gui/statusbar.cpp \
-            src/gui/styleditemdelegatewithoutfocus.cpp \
-            src/gui/systemtrayicon.cpp \
-            src/gui/tabbar.cpp \
-            src/gui/tabcontent.cpp \
-            src/gui/tabwidget.cpp \
-            src/gui/timespinbox.cpp \
-            src/gui/toolbareditor.cpp \
-            src/gui/widgetwithstatus.cpp \
-            src/main.cpp \
-            src/miscellaneous/application.cpp \
-            src/miscellaneous/autosaver.cpp \
-            src/miscellaneous/databasecleaner.cpp \
-            src/miscellaneous/databasefactory.cpp \
-            src/miscellaneous/databasequeries.cpp \
-            src/miscellaneous/debugging.cpp \
-            src/miscellaneous/iconfactory.cpp \
-            src/miscellaneous/iofactory.cpp \
-            src/miscellaneous/localization.cpp \
-            src/miscellaneous/mutex.cpp \
-            src/miscellaneous/settings.cpp \
-            src/miscellaneous/simplecrypt/simplecrypt.cpp \
-            src/miscellaneous/skinfactory.cpp \
-            src/miscellaneous/systemfactory.cpp \
-            src/miscellaneous/textfactory.cpp \
-            src/network-web/basenetworkaccessmanager.cpp \
-            src/network-web/downloader.cpp \
-            src/network-web/downloadmanager.cpp \
-            src/network-web/networkfactory.cpp \
-            src/network-web/silentnetworkaccessmanager.cpp \
-            src/network-web/webfactory.cpp \
-            src/qtsingleapplication/qtlocalpeer.cpp \
-            src/qtsingleapplication/qtlockedfile.cpp \
-            src/qtsingleapplication/qtsingleapplication.cpp \
-            src/qtsingleapplication/qtsinglecoreapplication.cpp \
-            src/services/abstract/accountcheckmodel.cpp \
-            src/services/abstract/category.cpp \
-            src/services/abstract/feed.cpp \
-            src/services/abstract/gui/formfeeddetails.cpp \
-            src/services/abstract/recyclebin.cpp \
-            src/services/abstract/rootitem.cpp \
-            src/services/abstract/serviceentrypoint.cpp \
-            src/services/abstract/serviceroot.cpp \
-            src/services/owncloud/gui/formeditowncloudaccount.cpp \
-            src/services/owncloud/gui/formowncloudfeeddetails.cpp \
-            src/services/owncloud/network/owncloudnetworkfactory.cpp \
-            src/services/owncloud/owncloudcategory.cpp \
-            src/services/owncloud/owncloudfeed.cpp \
-            src/services/owncloud/owncloudrecyclebin.cpp \
-            src/services/owncloud/owncloudserviceentrypoint.cpp \
-            src/services/owncloud/owncloudserviceroot.cpp \
-            src/services/standard/gui/formstandardcategorydetails.cpp \
-            src/services/standard/gui/formstandardfeeddetails.cpp \
-            src/services/standard/gui/formstandardimportexport.cpp \
-            src/services/standard/standardcategory.cpp \
-            src/services/standard/standardfeed.cpp \
-            src/services/standard/standardfeedsimportexportmodel.cpp \
-            src/services/standard/standardserviceentrypoint.cpp \
-            src/services/standard/standardserviceroot.cpp \
-            src/services/tt-rss/gui/formeditaccount.cpp \
-            src/services/tt-rss/gui/formttrssfeeddetails.cpp \
-            src/services/tt-rss/network/ttrssnetworkfactory.cpp \
-            src/services/tt-rss/ttrsscategory.cpp \
-            src/services/tt-rss/ttrssfeed.cpp \
-            src/services/tt-rss/ttrssrecyclebin.cpp \
-            src/services/tt-rss/ttrssserviceentrypoint.cpp \
-            src/services/tt-rss/ttrssserviceroot.cpp \
-            src/gui/settings/settingspanel.cpp \
-            src/gui/settings/settingsgeneral.cpp \
-            src/gui/settings/settingsdatabase.cpp \
-            src/gui/settings/settingsshortcuts.cpp \
-            src/gui/settings/settingsgui.cpp \
-            src/gui/settings/settingslocalization.cpp \
-            src/gui/settings/settingsbrowsermail.cpp \
-            src/gui/settings/settingsfeedsmessages.cpp \
-            src/gui/settings/settingsdownloads.cpp \
-            src/miscellaneous/feedreader.cpp
-
-FORMS +=    src/gui/toolbareditor.ui \
-            src/network-web/downloaditem.ui \
-            src/network-web/downloadmanager.ui \
-            src/gui/dialogs/formabout.ui \
-            src/gui/dialogs/formaddaccount.ui \
-            src/gui/dialogs/formbackupdatabasesettings.ui \
-            src/gui/dialogs/formdatabasecleanup.ui \
-            src/gui/dialogs/formmain.ui \
-            src/gui/dialogs/formrestoredatabasesettings.ui \
-            src/gui/dialogs/formsettings.ui \
-            src/gui/dialogs/formupdate.ui \
-            src/services/abstract/gui/formfeeddetails.ui \
-            src/services/owncloud/gui/formeditowncloudaccount.ui \
-            src/services/standard/gui/formstandardcategorydetails.ui \
-            src/services/standard/gui/formstandardimportexport.ui \
-            src/services/tt-rss/gui/formeditaccount.ui \
-            src/gui/settings/settingsgeneral.ui \
-            src/gui/settings/settingsdatabase.ui \
-            src/gui/settings/settingsshortcuts.ui \
-            src/gui/settings/settingsgui.ui \
-            src/gui/settings/settingslocalization.ui \
-            src/gui/settings/settingsbrowsermail.ui \
-            src/gui/settings/settingsfeedsmessages.ui \
-            src/gui/settings/settingsdownloads.ui
-
-equals(USE_WEBENGINE, true) {
-  HEADERS +=    src/gui/locationlineedit.h \
-                src/gui/webviewer.h \
-                src/gui/webbrowser.h \
-                src/gui/discoverfeedsbutton.h \
-                src/network-web/googlesuggest.h \
-                src/network-web/webpage.h
-
-  SOURCES +=    src/gui/locationlineedit.cpp \
-                src/gui/webviewer.cpp \
-                src/gui/webbrowser.cpp \
-                src/gui/discoverfeedsbutton.cpp \
-                src/network-web/googlesuggest.cpp \
-                src/network-web/webpage.cpp
-}
-else {
-  HEADERS +=    src/gui/messagepreviewer.h \
-                src/gui/messagetextbrowser.h \
-                src/gui/newspaperpreviewer.h
-
-  SOURCES +=    src/gui/messagepreviewer.cpp \
-                src/gui/messagetextbrowser.cpp \
-                src/gui/newspaperpreviewer.cpp
-
-  FORMS +=      src/gui/messagepreviewer.ui \
-                src/gui/newspaperpreviewer.ui
-}
+SOURCES +=  src/main.cpp
 
 TRANSLATIONS += localization/qtbase-cs.ts \
                 localization/qtbase-da.ts \
@@ -529,12 +182,6 @@ TRANSLATIONS_WO_QT += $$PWD/localization/rssguard-cs.ts \
                       $$PWD/localization/rssguard-pt.ts \
                       $$PWD/localization/rssguard-sv.ts
 
-INCLUDEPATH +=  $$PWD/. \
-                $$PWD/src \
-                $$PWD/src/gui \
-                $$PWD/src/gui/dialogs \
-                $$PWD/src/dynamic-shortcuts
-
 TEXTS = resources/text/CHANGELOG \
         resources/text/COPYING_BSD \
         resources/text/COPYING_GNU_GPL \
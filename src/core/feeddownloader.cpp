@@ -25,6 +25,8 @@
 #include <QThreadPool>
 #include <QMutexLocker>
 #include <QString>
+#include <QJsonDocument>
+#include <QJsonArray>
 
 
 FeedDownloader::FeedDownloader(QObject *parent)
@@ -47,6 +49,10 @@ bool FeedDownloader::isUpdateRunning() const {
   return !m_feeds.isEmpty() || m_feedsUpdating > 0;
 }
 
+void FeedDownloader::setMaxThreadCount(int thread_count) {
+  m_threadPool->setMaxThreadCount(thread_count);
+}
+
 void FeedDownloader::updateAvailableFeeds() {
   while (!m_feeds.isEmpty()) {
     connect(m_feeds.first(), &Feed::messagesObtained, this, &FeedDownloader::oneFeedUpdateFinished,
@@ -76,6 +82,11 @@ void FeedDownloader::updateFeeds(const QList<Feed*> &feeds) {
     m_feedsOriginalCount = m_feeds.size();
     m_results.clear();
     m_feedsUpdated = m_feedsUpdating = 0;
+    m_updateTimer.start();
+
+    foreach (Feed *feed, m_feeds) {
+      feed->markQueuedForUpdate();
+    }
 
     // Job starts now.
     emit updateStarted();
@@ -118,6 +129,8 @@ void FeedDownloader::oneFeedUpdateFinished(const QList<Message> &messages, bool
     m_results.appendUpdatedFeed(QPair<QString,int>(feed->title(), updated_messages));
   }
 
+  m_results.appendStatistics(feed->updateStatistics());
+
   qDebug("Made progress in feed updates, total feeds count %d/%d (id of feed is %d).", m_feedsUpdated, m_feedsOriginalCount, feed->id());
   emit updateProgress(feed, m_feedsUpdated, m_feedsOriginalCount);
 
@@ -130,6 +143,7 @@ void FeedDownloader::finalizeUpdate() {
   qDebug().nospace() << "Finished feed updates in thread: \'" << QThread::currentThreadId() << "\'.";
 
   m_results.sort();
+  m_results.setDuration(m_updateTimer.isValid() ? m_updateTimer.elapsed() : 0);
 
   // Update of feeds has finished.
   // NOTE: This means that now "update lock" can be unlocked
@@ -138,7 +152,8 @@ void FeedDownloader::finalizeUpdate() {
   emit updateFinished(m_results);
 }
 
-FeedDownloadResults::FeedDownloadResults() : m_updatedFeeds(QList<QPair<QString,int> >()) {
+FeedDownloadResults::FeedDownloadResults()
+  : m_updatedFeeds(QList<QPair<QString,int> >()), m_statistics(QList<FeedUpdateStatistics>()), m_duration(0) {
 }
 
 QString FeedDownloadResults::overview(int how_many_feeds) const {
@@ -171,6 +186,58 @@ bool FeedDownloadResults::lessThan(const QPair<QString, int> &lhs, const QPair<Q
 
 void FeedDownloadResults::clear() {
   m_updatedFeeds.clear();
+  m_statistics.clear();
+  m_duration = 0;
+}
+
+QList<FeedUpdateStatistics> FeedDownloadResults::statistics() const {
+  return m_statistics;
+}
+
+void FeedDownloadResults::appendStatistics(const FeedUpdateStatistics &statistics) {
+  m_statistics.append(statistics);
+}
+
+qint64 FeedDownloadResults::duration() const {
+  return m_duration;
+}
+
+void FeedDownloadResults::setDuration(qint64 duration) {
+  m_duration = duration;
+}
+
+QByteArray FeedDownloadResults::toJson() const {
+  QJsonObject run;
+  QJsonArray feeds;
+  int failed_feeds = 0;
+  int new_messages = 0;
+
+  foreach (const FeedUpdateStatistics &statistics, m_statistics) {
+    feeds.append(statistics.toJson());
+
+    failed_feeds += statistics.m_error ? 1 : 0;
+    new_messages += statistics.m_newMessages;
+  }
+
+  run.insert(QSL("duration_ms"), m_duration);
+  run.insert(QSL("feeds_count"), m_statistics.size());
+  run.insert(QSL("failed_feeds_count"), failed_feeds);
+  run.insert(QSL("new_messages_count"), new_messages);
+  run.insert(QSL("feeds"), feeds);
+
+  return QJsonDocument(run).toJson(QJsonDocument::Indented);
+}
+
+QByteArray FeedDownloadResults::toCsv() const {
+  QStringList lines;
+
+  lines.append(FeedUpdateStatistics::csvHeader());
+
+  foreach (const FeedUpdateStatistics &statistics, m_statistics) {
+    lines.append(statistics.toCsv());
+  }
+
+  return lines.join(QL1C('\n')).toUtf8() + '\n';
 }
 
 QList<QPair<QString,int> > FeedDownloadResults::updatedFeeds() const {
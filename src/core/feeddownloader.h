@@ -21,8 +21,10 @@
 #include <QObject>
 
 #include <QPair>
+#include <QElapsedTimer>
 
 #include "core/message.h"
+#include "core/feedupdatestatistics.h"
 
 
 class Feed;
@@ -41,11 +43,25 @@ class FeedDownloadResults {
     void sort();
     void clear();
 
+    // Measurements of all feeds processed in the update run.
+    QList<FeedUpdateStatistics> statistics() const;
+    void appendStatistics(const FeedUpdateStatistics &statistics);
+
+    // Duration of whole update run in milliseconds.
+    qint64 duration() const;
+    void setDuration(qint64 duration);
+
+    // Exports statistics of the update run.
+    QByteArray toJson() const;
+    QByteArray toCsv() const;
+
     static bool lessThan(const QPair<QString,int> &lhs, const QPair<QString,int> &rhs);
 
   private:
     // QString represents title if the feed, int represents count of newly downloaded messages.
     QList<QPair<QString,int> > m_updatedFeeds;
+    QList<FeedUpdateStatistics> m_statistics;
+    qint64 m_duration;
 };
 
 // This class offers means to "update" feeds and "special" categories.
@@ -60,6 +76,9 @@ class FeedDownloader : public QObject {
 
     bool isUpdateRunning() const;
 
+    // Sets how many feeds are downloaded in parallel.
+    void setMaxThreadCount(int thread_count);
+
   public slots:
     // Performs update of all feeds from the "feeds" parameter.
     // New messages are downloaded for each feed and they
@@ -95,6 +114,7 @@ class FeedDownloader : public QObject {
     QMutex *m_mutex;
     QThreadPool *m_threadPool;
     FeedDownloadResults m_results;
+    QElapsedTimer m_updateTimer;
 
     int m_feedsUpdated;
     int m_feedsUpdating;
@@ -28,7 +28,11 @@
 #include "miscellaneous/databasefactory.h"
 #include "miscellaneous/iconfactory.h"
 #include "miscellaneous/feedreader.h"
+#include "miscellaneous/settings.h"
 
+#include <QDataStream>
+#include <QDir>
+#include <QSaveFile>
 #include <QSqlError>
 #include <QSqlRecord>
 #include <QPair>
@@ -496,6 +500,11 @@ bool FeedsModel::addServiceAccount(ServiceRoot *root, bool freshly_activated) {
   connect(root, SIGNAL(itemExpandStateSaveRequested(RootItem*)), this, SIGNAL(itemExpandStateSaveRequested(RootItem*)));
 
   root->start(freshly_activated);
+
+  if (freshly_activated) {
+    root->updateCounts(true);
+  }
+
   return true;
 }
 
@@ -537,6 +546,69 @@ void FeedsModel::loadActivatedServiceAccounts() {
       addServiceAccount(root, false);
     }
   }
+
+  // Show counts from previous session and recount them in background.
+  QFile snapshot_file(qApp->settings()->userSettingsRootFolder() + QDir::separator() + COUNTS_SNAPSHOT_FILE);
+
+  if (snapshot_file.open(QIODevice::ReadOnly)) {
+    QDataStream stream(&snapshot_file);
+    qint32 snapshot_version, account_count;
+
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream >> snapshot_version >> account_count;
+
+    for (int i = 0; snapshot_version == COUNTS_SNAPSHOT_VERSION && i < account_count; i++) {
+      qint32 account_id, bin_unread_count, bin_total_count;
+      MessageCounts feed_counts;
+
+      stream >> account_id >> bin_unread_count >> bin_total_count >> feed_counts;
+
+      if (stream.status() != QDataStream::Ok) {
+        qWarning("Snapshot of message counts is corrupted.");
+        break;
+      }
+
+      foreach (ServiceRoot *root, serviceRoots()) {
+        if (root->accountId() == account_id) {
+          root->setCounts(feed_counts, bin_unread_count, bin_total_count);
+        }
+      }
+    }
+
+    snapshot_file.close();
+  }
+
+  foreach (ServiceRoot *root, serviceRoots()) {
+    root->updateCountsInBackground();
+  }
+}
+
+void FeedsModel::saveCountsSnapshot() {
+  QSaveFile snapshot_file(qApp->settings()->userSettingsRootFolder() + QDir::separator() + COUNTS_SNAPSHOT_FILE);
+
+  if (!snapshot_file.open(QIODevice::WriteOnly)) {
+    qWarning("Cannot save snapshot of message counts: '%s'.", qPrintable(snapshot_file.errorString()));
+    return;
+  }
+
+  QDataStream stream(&snapshot_file);
+  const QList<ServiceRoot*> roots = serviceRoots();
+
+  stream.setVersion(QDataStream::Qt_5_0);
+  stream << (qint32) COUNTS_SNAPSHOT_VERSION << (qint32) roots.size();
+
+  foreach (ServiceRoot *root, roots) {
+    RecycleBin *bin = root->recycleBin();
+
+    stream << (qint32) root->accountId()
+           << (qint32) (bin == nullptr ? 0 : bin->countOfUnreadMessages())
+           << (qint32) (bin == nullptr ? 0 : bin->countOfAllMessages())
+           << root->feedCounts();
+  }
+
+  if (!snapshot_file.commit()) {
+    qWarning("Cannot save snapshot of message counts: '%s'.", qPrintable(snapshot_file.errorString()));
+  }
 }
 
 QList<Feed*> FeedsModel::feedsForIndex(const QModelIndex &index) const {
@@ -107,8 +107,14 @@ class FeedsModel : public QAbstractItemModel {
 
   public slots:
     // Loads feed/categories from the database.
+    // Counts of messages are taken from snapshot saved by previous
+    // session and exact counts are obtained in background.
     void loadActivatedServiceAccounts();
 
+    // Saves counts of messages of all accounts, so that they can be
+    // displayed immediately when application starts next time.
+    void saveCountsSnapshot();
+
     // Reloads counts of all feeds/categories/whatever in the model.
     void reloadCountsOfWholeModel();
 
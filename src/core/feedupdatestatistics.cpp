@@ -0,0 +1,93 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "core/feedupdatestatistics.h"
+
+#include "definitions/definitions.h"
+
+#include <QStringList>
+
+
+FeedUpdateStatistics::FeedUpdateStatistics()
+  : m_feedId(0), m_feedTitle(QString()), m_feedUrl(QString()), m_error(false), m_obtainedMessages(0),
+    m_newMessages(0), m_queueWait(-1), m_obtaining(-1), m_connection(-1), m_firstByte(-1), m_download(-1),
+    m_bytes(0), m_decoding(-1), m_parsing(-1), m_storing(-1), m_countsRefresh(-1) {
+}
+
+qint64 FeedUpdateStatistics::totalTime() const {
+  return qMax(m_queueWait, 0LL) + qMax(m_obtaining, 0LL) + qMax(m_storing, 0LL) + qMax(m_countsRefresh, 0LL);
+}
+
+QJsonObject FeedUpdateStatistics::toJson() const {
+  QJsonObject object;
+
+  object.insert(QSL("id"), m_feedId);
+  object.insert(QSL("title"), m_feedTitle);
+  object.insert(QSL("url"), m_feedUrl);
+  object.insert(QSL("error"), m_error);
+  object.insert(QSL("obtained_messages"), m_obtainedMessages);
+  object.insert(QSL("new_messages"), m_newMessages);
+  object.insert(QSL("queue_wait_ms"), m_queueWait);
+  object.insert(QSL("obtaining_ms"), m_obtaining);
+  object.insert(QSL("connection_ms"), m_connection);
+  object.insert(QSL("first_byte_ms"), m_firstByte);
+  object.insert(QSL("download_ms"), m_download);
+  object.insert(QSL("bytes"), m_bytes);
+  object.insert(QSL("decoding_ms"), m_decoding);
+  object.insert(QSL("parsing_ms"), m_parsing);
+  object.insert(QSL("storing_ms"), m_storing);
+  object.insert(QSL("counts_refresh_ms"), m_countsRefresh);
+  object.insert(QSL("total_ms"), totalTime());
+
+  return object;
+}
+
+QString FeedUpdateStatistics::toCsv() const {
+  QString title = m_feedTitle;
+  QString url = m_feedUrl;
+
+  title.replace(QL1C('"'), QSL("\"\""));
+  url.replace(QL1C('"'), QSL("\"\""));
+
+  QStringList values;
+
+  values << QString::number(m_feedId)
+         << QSL("\"%1\"").arg(title)
+         << QSL("\"%1\"").arg(url)
+         << QString::number(m_error ? 1 : 0)
+         << QString::number(m_obtainedMessages)
+         << QString::number(m_newMessages)
+         << QString::number(m_queueWait)
+         << QString::number(m_obtaining)
+         << QString::number(m_connection)
+         << QString::number(m_firstByte)
+         << QString::number(m_download)
+         << QString::number(m_bytes)
+         << QString::number(m_decoding)
+         << QString::number(m_parsing)
+         << QString::number(m_storing)
+         << QString::number(m_countsRefresh)
+         << QString::number(totalTime());
+
+  return values.join(QL1C(','));
+}
+
+QString FeedUpdateStatistics::csvHeader() {
+  return QSL("id,title,url,error,obtained_messages,new_messages,queue_wait_ms,obtaining_ms,connection_ms,"
+             "first_byte_ms,download_ms,bytes,decoding_ms,parsing_ms,storing_ms,counts_refresh_ms,total_ms");
+}
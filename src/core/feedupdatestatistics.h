@@ -0,0 +1,66 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef FEEDUPDATESTATISTICS_H
+#define FEEDUPDATESTATISTICS_H
+
+#include <QString>
+#include <QJsonObject>
+
+
+// Represents measurements of single feed update, which goes
+// through "queue -> network -> decoding -> parsing -> storing -> counting" stages.
+// All durations are in milliseconds, -1 means that the stage was not
+// measured for the feed (for example online services do not report
+// network phases separately).
+class FeedUpdateStatistics {
+  public:
+    explicit FeedUpdateStatistics();
+
+    // Time spent by the feed in the update pipeline
+    // including waiting in the queue.
+    qint64 totalTime() const;
+
+    QJsonObject toJson() const;
+
+    // Returns single CSV line (without line break) and
+    // the header line with names of columns.
+    QString toCsv() const;
+    static QString csvHeader();
+
+    int m_feedId;
+    QString m_feedTitle;
+    QString m_feedUrl;
+
+    bool m_error;
+    int m_obtainedMessages;
+    int m_newMessages;
+
+    qint64 m_queueWait;
+    qint64 m_obtaining;
+    qint64 m_connection;
+    qint64 m_firstByte;
+    qint64 m_download;
+    qint64 m_bytes;
+    qint64 m_decoding;
+    qint64 m_parsing;
+    qint64 m_storing;
+    qint64 m_countsRefresh;
+};
+
+#endif // FEEDUPDATESTATISTICS_H
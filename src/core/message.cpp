@@ -20,6 +20,7 @@
 #include "miscellaneous/textfactory.h"
 
 #include <QVariant>
+#include <QtEndian>
 
 
 Enclosure::Enclosure(const QString &url, const QString &mime) : m_url(url), m_mimeType(mime) {
@@ -64,6 +65,144 @@ QString Enclosures::encodeEnclosuresToString(const QList<Enclosure> &enclosures)
   return enclosures_str.join(QString(ENCLOSURES_OUTER_SEPARATOR));
 }
 
+QVariant MessageContents::encode(const QString &contents, bool compress, bool binary_storage) {
+  if (!compress) {
+    return contents;
+  }
+
+  const QByteArray plain = contents.toUtf8();
+
+  if (plain.size() < CONTENTS_COMPRESSION_MIN_SIZE) {
+    return contents;
+  }
+
+  const QByteArray compressed = qCompress(plain);
+  const QByteArray stored = QByteArray(CONTENTS_COMPRESSED_PREFIX) + (binary_storage ? compressed : compressed.toBase64());
+
+  if (stored.size() >= plain.size()) {
+    // Some contents (for example those with embedded images) do not compress well.
+    return contents;
+  }
+  else if (binary_storage) {
+    return stored;
+  }
+  else {
+    return QString::fromLatin1(stored);
+  }
+}
+
+QString MessageContents::decode(const QVariant &stored_contents) {
+  const QByteArray compressed = compressedData(stored_contents);
+
+  if (compressed.isEmpty()) {
+    return stored_contents.toString();
+  }
+
+  const QByteArray plain = qUncompress(compressed);
+
+  if (plain.isEmpty() || (quint32) plain.size() != uncompressedSize(compressed)) {
+    // Plain contents which merely look like compressed ones.
+    qWarning("Failed to decompress contents of message, keeping them as they are.");
+    return stored_contents.toString();
+  }
+
+  return QString::fromUtf8(plain);
+}
+
+QVariant MessageContents::convert(const QVariant &stored_contents, Conversion conversion, bool binary_storage) {
+  const bool compressed = isCompressed(stored_contents);
+
+  if ((conversion == Compress && !compressed) || (conversion == Decompress && compressed)) {
+    return encode(decode(stored_contents), conversion == Compress, binary_storage);
+  }
+  else {
+    return stored_contents;
+  }
+}
+
+bool MessageContents::isCompressed(const QVariant &stored_contents) {
+  return !compressedData(stored_contents).isEmpty();
+}
+
+qint64 MessageContents::storedSize(const QVariant &stored_contents) {
+  if (stored_contents.type() == QVariant::ByteArray) {
+    return stored_contents.toByteArray().size();
+  }
+  else {
+    return stored_contents.toString().toUtf8().size();
+  }
+}
+
+qint64 MessageContents::plainSize(const QVariant &stored_contents) {
+  const QByteArray compressed = compressedData(stored_contents);
+
+  if (compressed.isEmpty()) {
+    return stored_contents.toString().toUtf8().size();
+  }
+  else {
+    return uncompressedSize(compressed);
+  }
+}
+
+QByteArray MessageContents::compressedData(const QVariant &stored_contents) {
+  const QByteArray prefix = QByteArray(CONTENTS_COMPRESSED_PREFIX);
+  QByteArray compressed;
+
+  if (stored_contents.type() == QVariant::ByteArray) {
+    const QByteArray data = stored_contents.toByteArray();
+
+    if (data.startsWith(prefix)) {
+      compressed = data.mid(prefix.size());
+    }
+  }
+  else {
+    const QString data = stored_contents.toString();
+
+    if (data.startsWith(QL1S(CONTENTS_COMPRESSED_PREFIX))) {
+      const QByteArray encoded = data.mid(prefix.size()).toLatin1();
+
+      // QByteArray::fromBase64() skips invalid characters, so make sure
+      // that the text really is base64 data produced by encode().
+      compressed = QByteArray::fromBase64(encoded);
+
+      if (compressed.toBase64() != encoded) {
+        compressed.clear();
+      }
+    }
+  }
+
+  // Plain contents may start with the prefix too, only data with
+  // sane qCompress() header are considered compressed. Deflate never
+  // compresses better than CONTENTS_COMPRESSION_MAX_RATIO, so bogus header
+  // cannot make qUncompress() allocate huge buffer.
+  if (compressed.size() <= 4 || uncompressedSize(compressed) == 0 ||
+      uncompressedSize(compressed) > (quint64) compressed.size() * CONTENTS_COMPRESSION_MAX_RATIO) {
+    return QByteArray();
+  }
+  else {
+    return compressed;
+  }
+}
+
+quint32 MessageContents::uncompressedSize(const QByteArray &compressed) {
+  // qCompress() data start with 4-byte big-endian size of plain data.
+  return qFromBigEndian<quint32>(reinterpret_cast<const uchar*>(compressed.constData()));
+}
+
+MessageContentsStatistics::MessageContentsStatistics()
+  : m_messagesCount(0), m_compressedCount(0), m_storedSize(0), m_plainSize(0) {
+}
+
+void MessageContentsStatistics::append(const QVariant &stored_contents) {
+  m_messagesCount++;
+  m_storedSize += MessageContents::storedSize(stored_contents);
+  m_plainSize += MessageContents::plainSize(stored_contents);
+
+  if (MessageContents::isCompressed(stored_contents)) {
+    m_compressedCount++;
+  }
+}
+
 Message::Message() {
   m_title = m_url = m_author = m_contents = m_feedId = m_customId = m_customHash = "";
   m_enclosures = QList<Enclosure>();
@@ -89,7 +228,7 @@ Message Message::fromSqlRecord(const QSqlRecord &record, bool *result) {
   message.m_url = record.value(MSG_DB_URL_INDEX).toString();
   message.m_author = record.value(MSG_DB_AUTHOR_INDEX).toString();
   message.m_created = TextFactory::parseDateTime(record.value(MSG_DB_DCREATED_INDEX).value<qint64>());
-  message.m_contents = record.value(MSG_DB_CONTENTS_INDEX).toString();
+  message.m_contents = MessageContents::decode(record.value(MSG_DB_CONTENTS_INDEX));
   message.m_enclosures = Enclosures::decodeEnclosuresFromString(record.value(MSG_DB_ENCLOSURES_INDEX).toString());
   message.m_accountId = record.value(MSG_DB_ACCOUNT_ID_INDEX).toInt();
   message.m_customId = record.value(MSG_DB_CUSTOM_ID_INDEX).toString();
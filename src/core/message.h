@@ -41,6 +41,57 @@ class Enclosures {
     static QString encodeEnclosuresToString(const QList<Enclosure> &enclosures);
 };
 
+// Converts message contents from/to the form stored in the database.
+// Contents are stored either as plain text or compressed with qCompress(),
+// compressed contents are BLOB (or base64 text if database has no BLOBs)
+// starting with CONTENTS_COMPRESSED_PREFIX.
+class MessageContents {
+  public:
+    enum Conversion {
+      NoConversion,
+      Compress,
+      Decompress
+    };
+
+    // Returns value suitable for "contents" column. Contents are compressed
+    // only if it is requested and if it makes them smaller.
+    static QVariant encode(const QString &contents, bool compress, bool binary_storage);
+
+    // Returns plain contents, decompresses them if needed.
+    static QString decode(const QVariant &stored_contents);
+
+    // Returns stored contents converted to the requested form.
+    static QVariant convert(const QVariant &stored_contents, Conversion conversion, bool binary_storage);
+
+    static bool isCompressed(const QVariant &stored_contents);
+
+    // Returns size of contents in bytes as they are stored and as they
+    // are when decompressed. No decompression is done here, size
+    // of plain contents is read from qCompress() header.
+    static qint64 storedSize(const QVariant &stored_contents);
+    static qint64 plainSize(const QVariant &stored_contents);
+
+  private:
+    // Returns qCompress() data or empty array if contents are not compressed.
+    static QByteArray compressedData(const QVariant &stored_contents);
+
+    // Returns size of plain data stored in header of non-empty qCompress() data.
+    static quint32 uncompressedSize(const QByteArray &compressed);
+};
+
+// Summary of how contents of messages are stored.
+struct MessageContentsStatistics {
+  public:
+    explicit MessageContentsStatistics();
+
+    void append(const QVariant &stored_contents);
+
+    int m_messagesCount;
+    int m_compressedCount;
+    qint64 m_storedSize;
+    qint64 m_plainSize;
+};
+
 // Represents single message.
 class Message {
   public:
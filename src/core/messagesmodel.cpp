@@ -23,12 +23,21 @@
 #include "miscellaneous/databasefactory.h"
 #include "miscellaneous/iconfactory.h"
 #include "miscellaneous/databasequeries.h"
+#include "miscellaneous/sqlstatistics.h"
 #include "services/abstract/serviceroot.h"
 
+#include <QElapsedTimer>
+
 
 MessagesModel::MessagesModel(QObject *parent)
   : QSqlTableModel(parent, qApp->database()->connection(QSL("MessagesModel"), DatabaseFactory::FromSettings)),
-    m_messageHighlighter(NoHighlighting), m_customDateFormat(QString()) {
+    m_messageHighlighter(NoHighlighting), m_showArchived(false), m_sortColumn(-1),
+    m_sortOrder(Qt::AscendingOrder), m_customDateFormat(QString()), m_rowStates(QVector<quint8>()),
+    m_rowCreated(QVector<qint64>()), m_rowCreatedText(QVector<QString>()), m_emptyAuthor(QSL("-")) {
+  connect(this, SIGNAL(modelReset()), this, SLOT(clearRowCache()));
+  connect(this, SIGNAL(rowsInserted(QModelIndex,int,int)), this, SLOT(clearRowCache()));
+  connect(this, SIGNAL(rowsRemoved(QModelIndex,int,int)), this, SLOT(clearRowCache()));
+
   setupFonts();
   setupIcons();
   setupHeaderData();
@@ -53,11 +62,17 @@ void MessagesModel::setupIcons() {
 }
 
 void MessagesModel::fetchAllData() {
+  QElapsedTimer timer;
+
+  timer.start();
   select();
 
   while (canFetchMore()) {
     fetchMore();
   }
+
+  // Model executes its query on its own, so record it here.
+  SqlStatistics::recordQuery(SqlStatistics::normalizeStatement(query().lastQuery()), Q_FUNC_INFO, timer.elapsed(), rowCount());
 }
 
 void MessagesModel::setupFonts() {
@@ -87,6 +102,29 @@ void MessagesModel::loadMessages(RootItem *item) {
   fetchAllData();
 }
 
+bool MessagesModel::showArchived() const {
+  return m_showArchived;
+}
+
+void MessagesModel::setShowArchived(bool show_archived) {
+  if (m_showArchived != show_archived) {
+    // QSqlTableModel::setTable() clears sort and filter.
+    const QString current_filter = filter();
+
+    m_showArchived = show_archived;
+    setTable(show_archived ? QSL("ArchivedMessages") : QSL("Messages"));
+    setSort(m_sortColumn, m_sortOrder);
+    setFilter(current_filter);
+  }
+}
+
+void MessagesModel::setSort(int column, Qt::SortOrder order) {
+  m_sortColumn = column;
+  m_sortOrder = order;
+
+  QSqlTableModel::setSort(column, order);
+}
+
 bool MessagesModel::setMessageImportantById(int id, RootItem::Importance important) {
   for (int i = 0; i < rowCount(); i++) {
     int found_id = data(i, MSG_DB_ID_INDEX, Qt::EditRole).toInt();
@@ -110,6 +148,54 @@ bool MessagesModel::submitAll() {
   return false;
 }
 
+void MessagesModel::clearRowCache() {
+  m_rowStates.clear();
+  m_rowCreated.clear();
+  m_rowCreatedText.clear();
+}
+
+quint8 MessagesModel::rowState(int row) const {
+  if (row >= m_rowStates.size()) {
+    const int row_count = qMax(rowCount(), row + 1);
+
+    m_rowStates.resize(row_count);
+    m_rowCreated.resize(row_count);
+    m_rowCreatedText.resize(row_count);
+  }
+
+  quint8 &state = m_rowStates[row];
+
+  if ((state & RowCached) == 0) {
+    state = RowCached;
+
+    if (QSqlTableModel::data(index(row, MSG_DB_READ_INDEX)).toInt() == 1) {
+      state |= RowRead;
+    }
+
+    if (QSqlTableModel::data(index(row, MSG_DB_IMPORTANT_INDEX)).toInt() == 1) {
+      state |= RowImportant;
+    }
+
+    m_rowCreated[row] = QSqlTableModel::data(index(row, MSG_DB_DCREATED_INDEX)).value<qint64>();
+  }
+
+  return state;
+}
+
+QString MessagesModel::rowCreatedText(int row) const {
+  rowState(row);
+
+  QString &text = m_rowCreatedText[row];
+
+  if (text.isNull()) {
+    const QDateTime created = TextFactory::parseDateTime(m_rowCreated.at(row)).toLocalTime();
+
+    text = m_customDateFormat.isEmpty() ? created.toString(Qt::DefaultLocaleShortDate) : created.toString(m_customDateFormat);
+  }
+
+  return text;
+}
+
 void MessagesModel::highlightMessages(MessagesModel::MessageHighlighter highlight) {
   m_messageHighlighter = highlight;
   emit layoutAboutToBeChanged();
@@ -135,6 +221,9 @@ void MessagesModel::updateDateFormat() {
   else {
     m_customDateFormat = QString();
   }
+
+  // Dates are formatted again when needed.
+  m_rowCreatedText.fill(QString());
 }
 
 void MessagesModel::reloadWholeLayout() {
@@ -179,6 +268,19 @@ Qt::ItemFlags MessagesModel::flags(const QModelIndex &index) const {
   return Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemIsEditable | Qt::ItemNeverHasChildren;
 }
 
+bool MessagesModel::setData(const QModelIndex &index, const QVariant &value, int role) {
+  if (!QSqlTableModel::setData(index, value, role)) {
+    return false;
+  }
+
+  if (index.row() < m_rowStates.size()) {
+    m_rowStates[index.row()] = 0;
+    m_rowCreatedText[index.row()] = QString();
+  }
+
+  return true;
+}
+
 QVariant MessagesModel::data(int row, int column, int role) const {
   return data(index(row, column), role);
 }
@@ -187,21 +289,20 @@ QVariant MessagesModel::data(const QModelIndex &idx, int role) const {
   switch (role) {
     // Human readable data for viewing.
     case Qt::DisplayRole: {
-      int index_column = idx.column();
+      const int index_column = idx.column();
 
       if (index_column == MSG_DB_DCREATED_INDEX) {
-        if (m_customDateFormat.isEmpty()) {
-          return TextFactory::parseDateTime(QSqlTableModel::data(idx,
-                                                                 role).value<qint64>()).toLocalTime().toString(Qt::DefaultLocaleShortDate);
-        }
-        else {
-          return TextFactory::parseDateTime(QSqlTableModel::data(idx, role).value<qint64>()).toLocalTime().toString(m_customDateFormat);
-        }
+        return rowCreatedText(idx.row());
       }
       else if (index_column == MSG_DB_AUTHOR_INDEX) {
-        const QString author_name = QSqlTableModel::data(idx, role).toString();
+        const QVariant author_name = QSqlTableModel::data(idx, role);
 
-        return author_name.isEmpty() ? "-" : author_name;
+        return author_name.toString().isEmpty() ? m_emptyAuthor : author_name;
+      }
+      else if (index_column == MSG_DB_CONTENTS_INDEX) {
+        // Contents may be compressed, they are decompressed only when really needed,
+        // for example when messages are filtered.
+        return MessageContents::decode(QSqlTableModel::data(idx, role));
       }
       else if (index_column != MSG_DB_IMPORTANT_INDEX && index_column != MSG_DB_READ_INDEX) {
         return QSqlTableModel::data(idx, role);
@@ -215,15 +316,15 @@ QVariant MessagesModel::data(const QModelIndex &idx, int role) const {
       return QSqlTableModel::data(idx, role);
 
     case Qt::FontRole:
-      return QSqlTableModel::data(index(idx.row(), MSG_DB_READ_INDEX)).toInt() == 1 ? m_normalFont : m_boldFont;
+      return (rowState(idx.row()) & RowRead) != 0 ? m_normalFont : m_boldFont;
 
     case Qt::ForegroundRole:
       switch (m_messageHighlighter) {
         case HighlightImportant:
-          return QSqlTableModel::data(index(idx.row(), MSG_DB_IMPORTANT_INDEX)).toInt() == 1 ? QColor(Qt::blue) : QVariant();
+          return (rowState(idx.row()) & RowImportant) != 0 ? QColor(Qt::blue) : QVariant();
 
         case HighlightUnread:
-          return QSqlTableModel::data(index(idx.row(), MSG_DB_READ_INDEX)).toInt() == 0 ? QColor(Qt::blue) : QVariant();
+          return (rowState(idx.row()) & RowRead) == 0 ? QColor(Qt::blue) : QVariant();
 
         case NoHighlighting:
         default:
@@ -234,10 +335,10 @@ QVariant MessagesModel::data(const QModelIndex &idx, int role) const {
       const int index_column = idx.column();
 
       if (index_column == MSG_DB_READ_INDEX) {
-        return QSqlTableModel::data(idx).toInt() == 1 ? m_readIcon : m_unreadIcon;
+        return (rowState(idx.row()) & RowRead) != 0 ? m_readIcon : m_unreadIcon;
       }
       else if (index_column == MSG_DB_IMPORTANT_INDEX) {
-        return QSqlTableModel::data(idx).toInt() == 1 ? m_favoriteIcon : QVariant();
+        return (rowState(idx.row()) & RowImportant) != 0 ? m_favoriteIcon : QVariant();
       }
       else {
         return QVariant();
@@ -250,6 +351,11 @@ QVariant MessagesModel::data(const QModelIndex &idx, int role) const {
 }
 
 bool MessagesModel::setMessageRead(int row_index, RootItem::ReadStatus read) {
+  if (m_showArchived) {
+    // Archived messages cannot be changed.
+    return false;
+  }
+
   if (data(row_index, MSG_DB_READ_INDEX, Qt::EditRole).toInt() == read) {
     // Read status is the same is the one currently set.
     // In that case, no extra work is needed.
@@ -299,6 +405,11 @@ bool MessagesModel::setMessageReadById(int id, RootItem::ReadStatus read) {
 }
 
 bool MessagesModel::switchMessageImportance(int row_index) {
+  if (m_showArchived) {
+    // Archived messages cannot be changed.
+    return false;
+  }
+
   const QModelIndex target_index = index(row_index, MSG_DB_IMPORTANT_INDEX);
   const RootItem::Importance current_importance = (RootItem::Importance) data(target_index, Qt::EditRole).toInt();
   const RootItem::Importance next_importance = current_importance == RootItem::Important ?
@@ -331,6 +442,11 @@ bool MessagesModel::switchMessageImportance(int row_index) {
 }
 
 bool MessagesModel::switchBatchMessageImportance(const QModelIndexList &messages) {
+  if (m_showArchived) {
+    // Archived messages cannot be changed.
+    return false;
+  }
+
   QStringList message_ids;
   QList<QPair<Message,RootItem::Importance> > message_states;
 
@@ -359,6 +475,11 @@ bool MessagesModel::switchBatchMessageImportance(const QModelIndexList &messages
 }
 
 bool MessagesModel::setBatchMessagesDeleted(const QModelIndexList &messages) {
+  if (m_showArchived) {
+    // Archived messages cannot be changed.
+    return false;
+  }
+
   QStringList message_ids;
   QList<Message> msgs;
 
@@ -393,6 +514,11 @@ bool MessagesModel::setBatchMessagesDeleted(const QModelIndexList &messages) {
 }
 
 bool MessagesModel::setBatchMessagesRead(const QModelIndexList &messages, RootItem::ReadStatus read) {
+  if (m_showArchived) {
+    // Archived messages cannot be changed.
+    return false;
+  }
+
   QStringList message_ids;
   QList<Message> msgs;
 
@@ -418,6 +544,11 @@ bool MessagesModel::setBatchMessagesRead(const QModelIndexList &messages, RootIt
 }
 
 bool MessagesModel::setBatchMessagesRestored(const QModelIndexList &messages) {
+  if (m_showArchived) {
+    // Archived messages cannot be changed.
+    return false;
+  }
+
   QStringList message_ids;
   QList<Message> msgs;
 
@@ -26,6 +26,7 @@
 
 #include <QFont>
 #include <QIcon>
+#include <QVector>
 
 
 class MessagesModel : public QSqlTableModel {
@@ -48,6 +49,7 @@ class MessagesModel : public QSqlTableModel {
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
     QVariant data(int row, int column, int role = Qt::DisplayRole) const;
     QVariant headerData(int section, Qt::Orientation orientation, int role) const;
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole);
     Qt::ItemFlags flags(const QModelIndex &index) const;
 
     // Returns message at given index.
@@ -86,6 +88,14 @@ class MessagesModel : public QSqlTableModel {
     // Loads messages of given feeds.
     void loadMessages(RootItem *item);
 
+    // Switches model between "Messages" and "ArchivedMessages" tables,
+    // messages must be loaded again then. Archived messages are read-only.
+    bool showArchived() const;
+    void setShowArchived(bool show_archived);
+
+    // Remembers sort, so that it survives switching of tables.
+    void setSort(int column, Qt::SortOrder order);
+
   public slots:
     // NOTE: These methods DO NOT actually change data in the DB, just in the model.
     // These are particularly used by msg browser.
@@ -96,12 +106,31 @@ class MessagesModel : public QSqlTableModel {
     // To disable persistent changes submissions.
     bool submitAll();
 
+    // Drops cached states of all rows.
+    void clearRowCache();
+
   private:
+    // Bits of cached row state.
+    enum RowState {
+      RowCached = 1,
+      RowRead = 2,
+      RowImportant = 4
+    };
+
+    // Returns cached state of given row, loads it if needed.
+    quint8 rowState(int row) const;
+
+    // Returns formatted creation date of message in given row.
+    QString rowCreatedText(int row) const;
+
     void setupHeaderData();
     void setupFonts();
     void setupIcons();
 
     MessageHighlighter m_messageHighlighter;
+    bool m_showArchived;
+    int m_sortColumn;
+    Qt::SortOrder m_sortOrder;
 
     QString m_customDateFormat;
     RootItem *m_selectedItem;
@@ -114,6 +143,13 @@ class MessagesModel : public QSqlTableModel {
     QIcon m_favoriteIcon;
     QIcon m_readIcon;
     QIcon m_unreadIcon;
+
+    // Data needed for painting of rows, cached per row so that painting
+    // does not need to go through SQL records again.
+    mutable QVector<quint8> m_rowStates;
+    mutable QVector<qint64> m_rowCreated;
+    mutable QVector<QString> m_rowCreatedText;
+    QVariant m_emptyAuthor;
 };
 
 Q_DECLARE_METATYPE(MessagesModel::MessageHighlighter)
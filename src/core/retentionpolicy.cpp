@@ -0,0 +1,100 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "core/retentionpolicy.h"
+
+#include "services/abstract/feed.h"
+#include "services/abstract/category.h"
+
+#include <QVariant>
+
+
+RetentionPolicy::RetentionPolicy(int max_count, int max_age, bool keep_starred)
+  : m_maxCount(max_count), m_maxAge(max_age), m_keepStarred(keep_starred) {
+}
+
+bool RetentionPolicy::isInherited() const {
+  return m_maxCount < 0;
+}
+
+bool RetentionPolicy::isEnforced() const {
+  return !isInherited() && (m_maxCount > 0 || m_maxAge > 0);
+}
+
+QDateTime RetentionPolicy::ageBarrier() const {
+  return QDateTime::currentDateTimeUtc().addDays(-m_maxAge);
+}
+
+QList<Message> RetentionPolicy::filterMessages(const QList<Message> &messages) const {
+  if (!isEnforced()) {
+    return messages;
+  }
+
+  QList<Message> filtered;
+  const QDateTime barrier = ageBarrier();
+
+  foreach (const Message &message, messages) {
+    // Only messages with dates from the feed can be
+    // trusted, other messages are just downloaded.
+    if (m_maxAge <= 0 || !message.m_createdFromFeed || message.m_created >= barrier) {
+      filtered.append(message);
+    }
+  }
+
+  if (m_maxCount > 0 && filtered.size() > m_maxCount) {
+    qStableSort(filtered.begin(), filtered.end(), RetentionPolicy::isNewer);
+    filtered = filtered.mid(0, m_maxCount);
+  }
+
+  return filtered;
+}
+
+bool RetentionPolicy::isNewer(const Message &lhs, const Message &rhs) {
+  return lhs.m_created > rhs.m_created;
+}
+
+RetentionPolicy RetentionPolicy::fromRecord(const QSqlRecord &record, int first_column) {
+  return RetentionPolicy(record.value(first_column).toInt(),
+                         record.value(first_column + 1).toInt(),
+                         record.value(first_column + 2).toBool());
+}
+
+RetentionPolicy RetentionPolicy::effectivePolicy(const RootItem *item) {
+  while (item != nullptr) {
+    RetentionPolicy policy;
+
+    if (item->kind() == RootItemKind::Feed) {
+      policy = static_cast<const Feed*>(item)->retentionPolicy();
+    }
+    else if (item->kind() == RootItemKind::Category) {
+      policy = static_cast<const Category*>(item)->retentionPolicy();
+    }
+    else {
+      break;
+    }
+
+    if (!policy.isInherited()) {
+      return policy;
+    }
+
+    item = item->parent();
+  }
+
+  // Nothing is removed by default.
+  return RetentionPolicy(0, 0, true);
+}
@@ -0,0 +1,66 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef RETENTIONPOLICY_H
+#define RETENTIONPOLICY_H
+
+#include "core/message.h"
+
+#include <QList>
+#include <QSqlRecord>
+
+
+class RootItem;
+
+// Describes which messages of a feed are kept in the database,
+// policy can be set for feeds and categories.
+// Negative m_maxCount means that the policy is inherited from parent category,
+// zero m_maxCount or m_maxAge means no limit.
+class RetentionPolicy {
+  public:
+    explicit RetentionPolicy(int max_count = -1, int max_age = 0, bool keep_starred = true);
+
+    bool isInherited() const;
+
+    // Returns true if the policy removes any messages at all.
+    bool isEnforced() const;
+
+    // Returns date, messages created before it are removed.
+    QDateTime ageBarrier() const;
+
+    // Drops messages which would be removed right after they are stored, so that
+    // messages still present in the feed are not downloaded over and over again.
+    QList<Message> filterMessages(const QList<Message> &messages) const;
+
+    // Loads policy from three consecutive columns (max count,
+    // max age, keep starred) starting at given index.
+    static RetentionPolicy fromRecord(const QSqlRecord &record, int first_column);
+
+    // Returns policy which applies to given feed or category,
+    // inherited policies are resolved via parent categories.
+    static RetentionPolicy effectivePolicy(const RootItem *item);
+
+    int m_maxCount;
+    int m_maxAge;
+    bool m_keepStarred;
+
+  private:
+    static bool isNewer(const Message &lhs, const Message &rhs);
+};
+
+#endif // RETENTIONPOLICY_H
@@ -46,7 +46,25 @@
 #define TRAY_ICON_BUBBLE_TIMEOUT              20000
 #define KEY_MESSAGES_VIEW                     "messages_view_column_"
 #define CLOSE_LOCK_TIMEOUT                    500
+#define HEADLESS_LOCK_RETRY_INTERVAL          1000
+#define HEADLESS_LOCK_RETRY_COUNT             300
+#define SLOW_QUERY_THRESHOLD                  250
+#define SQL_STATISTICS_MAX_STATEMENTS         1000
+#define PURGE_CHUNK_SIZE                      1000
+#define PURGE_CHUNK_PAUSE                     25
+#define CONTENTS_COMPRESSED_PREFIX            "RGZ:"
+#define CONTENTS_COMPRESSION_MIN_SIZE         256
+#define CONTENTS_COMPRESSION_MAX_RATIO        1032
+#define MAINTENANCE_INTERVAL                  900000
+#define ARCHIVE_CHUNK_SIZE                    500
+#define DEFAULT_DAYS_TO_ARCHIVE_MSG           90
+#define VACUUM_CHUNK_PAGES                    128
+#define VACUUM_BACKGROUND_PAGES               2048
+#define BACKUP_STEP_PAGES                     256
+#define BACKUP_MAX_RESTARTS                   3
+#define BACKUP_FALLBACK_PAGE_SIZE             4096
 #define DOWNLOAD_TIMEOUT                      5000
+#define SYNC_IN_RETRY_INTERVAL                5000
 #define MESSAGES_VIEW_DEFAULT_COL             170
 #define FEEDS_VIEW_COLUMN_COUNT               2
 #define FEED_DOWNLOADER_MAX_THREADS           6
@@ -74,12 +92,28 @@
 #define GOOGLE_SUGGEST_URL                    "http://suggestqueries.google.com/complete/search?output=toolbar&hl=en&q=%1"
 #define ENCRYPTION_FILE_NAME                  "key.private"
 #define RELOAD_MODEL_BORDER_NUM               10
+#define IMAGE_CACHE_FOLDER                    "cache/images"
+#define IMAGE_CACHE_DISK_SIZE                 (64 * 1024 * 1024)
+#define IMAGE_CACHE_MEMORY_SIZE               (32 * 1024 * 1024)
+#define IMAGE_RETRY_INTERVAL                  60000
+#define COUNTS_SNAPSHOT_FILE                  "counts.snapshot"
+#define COUNTS_SNAPSHOT_VERSION               1
+#define FAVICON_CACHE_FOLDER                  "cache/favicons"
+#define FAVICON_CACHE_INDEX                   "favicons.ini"
+#define FAVICON_CACHE_DISK_SIZE               (8 * 1024 * 1024)
+#define FAVICON_EXPIRY                        (7 * 24 * 3600)
+#define FAVICON_FAILURE_EXPIRY                (24 * 3600)
 
 #define MAX_ZOOM_FACTOR     5.0f
 #define MIN_ZOOM_FACTOR     0.25f
 #define DEFAULT_ZOOM_FACTOR 1.0f
 #define ZOOM_FACTOR_STEP    0.1f
 
+#define NEWSPAPER_MESSAGE_HEIGHT      300
+#define NEWSPAPER_BATCH_SIZE          20
+#define NEWSPAPER_PRELOAD_DISTANCE    1500
+#define NEWSPAPER_CONTAINER_ID        "rssguard-newspaper"
+
 #define INTERNAL_URL_MESSAGE                  "http://rssguard.message"
 #define INTERNAL_URL_BLANK                    "http://rssguard.blank"
 #define INTERNAL_URL_MESSAGE_HOST             "rssguard.message"
@@ -89,6 +123,8 @@
 
 #define FEED_REGEX_MATCHER                    "<link[^>]+type=\\\"application/(atom|rss)\\+xml\\\"[^>]*>"
 #define FEED_HREF_REGEX_MATCHER               "href\\=\\\"[^\\\"]+\\\""
+#define FAVICON_LINK_REGEX_MATCHER            "<link[^>]+rel\\s*=\\s*[\\\"']?[^\\\"'>]*icon[^>]*>"
+#define FAVICON_HREF_REGEX_MATCHER            "href\\s*=\\s*[\\\"']?([^\\\"'\\s>]+)"
 
 #define PLACEHOLDER_UNREAD_COUNTS   "%unread"
 #define PLACEHOLDER_ALL_COUNTS      "%all"
@@ -97,9 +133,11 @@
 #define BACKUP_SUFFIX_SETTINGS  ".ini.backup"
 #define BACKUP_NAME_DATABASE    "database"
 #define BACKUP_SUFFIX_DATABASE  ".db.backup"
+#define BACKUP_SUFFIX_ARCHIVE   ".archive.backup"
 
 #define APP_DB_MYSQL_DRIVER           "QMYSQL"
 #define APP_DB_MYSQL_INIT             "db_init_mysql.sql"
+#define APP_DB_MYSQL_ARCHIVE_INIT     "db_init_mysql_archive.sql"
 #define APP_DB_MYSQL_TEST             "MySQLTest"
 #define APP_DB_MYSQL_PORT             3306
 
@@ -107,9 +145,12 @@
 #define APP_DB_SQLITE_INIT            "db_init_sqlite.sql"
 #define APP_DB_SQLITE_PATH            "database/local"
 #define APP_DB_SQLITE_FILE            "database.db"
+#define APP_DB_SQLITE_ARCHIVE_INIT    "db_init_sqlite_archive.sql"
+#define APP_DB_SQLITE_ARCHIVE_FILE    "archive.db"
+#define APP_DB_SQLITE_ARCHIVE_NAME    "archive"
 
 // Keep this in sync with schema versions declared in SQL initialization code.
-#define APP_DB_SCHEMA_VERSION         "7"
+#define APP_DB_SCHEMA_VERSION         "10"
 #define APP_DB_UPDATE_FILE_PATTERN    "db_update_%1_%2_%3.sql"
 #define APP_DB_COMMENT_SPLIT          "-- !\n"
 #define APP_DB_NAME_PLACEHOLDER       "##"
@@ -118,6 +159,10 @@
 #define APP_CFG_FILE        "config.ini"
 
 #define APP_QUIT_INSTANCE   "-q"
+#define APP_HEADLESS        "--headless"
+#define APP_UPDATE_ALL      "--update-all"
+#define APP_ACCOUNT         "--account"
+#define APP_THREADS         "--threads"
 #define APP_IS_RUNNING      "app_is_running"
 #define APP_SKIN_USER_FOLDER "skins"
 #define APP_SKIN_DEFAULT    "vergilius"
@@ -173,6 +218,7 @@
 #define CAT_DB_ICON_INDEX         5
 #define CAT_DB_ACCOUNT_ID_INDEX   6
 #define CAT_DB_CUSTOM_ID_INDEX    7
+#define CAT_DB_RETENTION_INDEX    8
 
 // Indexes of columns as they are DEFINED IN THE TABLE for FEEDS.
 #define FDS_DB_ID_INDEX               0
@@ -191,6 +237,7 @@
 #define FDS_DB_TYPE_INDEX             13
 #define FDS_DB_ACCOUNT_ID_INDEX       14
 #define FDS_DB_CUSTOM_ID_INDEX        15
+#define FDS_DB_RETENTION_INDEX        16
 
 // Indexes of columns for feed models.
 #define FDS_MODEL_TITLE_INDEX           0
@@ -19,6 +19,8 @@
 
 #include "miscellaneous/application.h"
 #include "miscellaneous/iconfactory.h"
+#include "miscellaneous/feedreader.h"
+#include "miscellaneous/databasecleaner.h"
 #include "exceptions/applicationexception.h"
 
 #include <QDialogButtonBox>
@@ -50,6 +52,12 @@ FormBackupDatabaseSettings::FormBackupDatabaseSettings(QWidget *parent) : QDialo
       qApp->database()->activeDatabaseDriver() != DatabaseFactory::SQLITE_MEMORY) {
     m_ui->m_checkBackupDatabase->setDisabled(true);
   }
+  else {
+    DatabaseCleaner *cleaner = qApp->feedReader()->databaseCleaner();
+
+    connect(cleaner, SIGNAL(backupProgress(int,QString)), this, SLOT(onBackupProgress(int,QString)));
+    connect(cleaner, SIGNAL(backupFinished(bool,QString)), this, SLOT(onBackupFinished(bool,QString)));
+  }
 }
 
 FormBackupDatabaseSettings::~FormBackupDatabaseSettings() {
@@ -57,15 +65,49 @@ FormBackupDatabaseSettings::~FormBackupDatabaseSettings() {
 }
 
 void FormBackupDatabaseSettings::performBackup() {
+  const bool backup_database = m_ui->m_checkBackupDatabase->isEnabled() && m_ui->m_checkBackupDatabase->isChecked();
+
   try {
-    qApp->backupDatabaseSettings(m_ui->m_checkBackupDatabase->isChecked(), m_ui->m_checkBackupSettings->isChecked(),
+    qApp->backupDatabaseSettings(backup_database, m_ui->m_checkBackupSettings->isChecked(),
                                  m_ui->m_lblSelectFolder->label()->text(), m_ui->m_txtBackupName->lineEdit()->text());
+
+    if (backup_database) {
+      // Database is backed up in the background, result is reported later.
+      m_ui->m_buttonBox->button(QDialogButtonBox::Ok)->setEnabled(false);
+      m_ui->m_progressBar->setValue(0);
+      m_ui->m_progressBar->setEnabled(true);
+      m_ui->m_lblResult->setStatus(WidgetWithStatus::Progress, tr("Database backup is running."), tr("Database backup is running."));
+    }
+    else {
+      m_ui->m_lblResult->setStatus(WidgetWithStatus::Ok,
+                                   tr("Backup was created successfully and stored in target directory."),
+                                   tr("Backup was created successfully."));
+    }
+  }
+  catch (const ApplicationException &ex) {
+    m_ui->m_lblResult->setStatus(WidgetWithStatus::Error, ex.message(), tr("Backup failed."));
+  }
+}
+
+void FormBackupDatabaseSettings::onBackupProgress(int progress, const QString &description) {
+  m_ui->m_progressBar->setValue(progress);
+  m_ui->m_lblResult->setStatus(WidgetWithStatus::Progress, description, description);
+}
+
+void FormBackupDatabaseSettings::onBackupFinished(bool result, const QString &error_string) {
+  m_ui->m_progressBar->setEnabled(false);
+  m_ui->m_progressBar->setValue(0);
+  checkOkButton();
+
+  if (result) {
     m_ui->m_lblResult->setStatus(WidgetWithStatus::Ok,
                                  tr("Backup was created successfully and stored in target directory."),
                                  tr("Backup was created successfully."));
   }
-  catch (const ApplicationException &ex) {
-    m_ui->m_lblResult->setStatus(WidgetWithStatus::Error, ex.message(), tr("Backup failed."));
+  else {
+    m_ui->m_lblResult->setStatus(WidgetWithStatus::Error,
+                                 tr("Database file not copied to output directory successfully: %1").arg(error_string),
+                                 tr("Backup failed."));
   }
 }
 
@@ -37,6 +37,8 @@ class FormBackupDatabaseSettings : public QDialog {
     void selectFolder(QString path = QString());
     void checkBackupNames(const QString &name);
     void checkOkButton();
+    void onBackupProgress(int progress, const QString &description);
+    void onBackupFinished(bool result, const QString &error_string);
 
   private:
     QScopedPointer<Ui::FormBackupDatabaseSettings> m_ui;
@@ -22,11 +22,19 @@
 #include "miscellaneous/databasefactory.h"
 
 #include <QCloseEvent>
+#include <QPushButton>
 
 
-FormDatabaseCleanup::FormDatabaseCleanup(QWidget *parent) : QDialog(parent), m_ui(new Ui::FormDatabaseCleanup), m_cleaner(nullptr) {
+FormDatabaseCleanup::FormDatabaseCleanup(QWidget *parent)
+  : QDialog(parent), m_ui(new Ui::FormDatabaseCleanup), m_cleaner(nullptr), m_dryRun(false), m_cancelled(false) {
   m_ui->setupUi(this);
 
+  m_btnEstimate = m_ui->m_btnBox->addButton(tr("&Estimate"), QDialogButtonBox::ActionRole);
+  m_btnEstimate->setToolTip(tr("Count messages which would be removed and measure how contents of messages are stored without changing anything."));
+  m_btnCancel = m_ui->m_btnBox->addButton(tr("Stop &cleanup"), QDialogButtonBox::ActionRole);
+  m_btnCancel->setToolTip(tr("Stop cleanup, messages removed so far stay removed."));
+  m_btnCancel->setEnabled(false);
+
   // Set flags and attributes.
   setWindowFlags(Qt::MSWindowsFixedSizeDialogHint | Qt::Dialog | Qt::WindowSystemMenuHint | Qt::WindowTitleHint);
   setWindowIcon(qApp->icons()->fromTheme(QSL("edit-clear")));
@@ -34,6 +42,7 @@ FormDatabaseCleanup::FormDatabaseCleanup(QWidget *parent) : QDialog(parent), m_u
   connect(m_ui->m_spinDays, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), this, &FormDatabaseCleanup::updateDaysSuffix);
   m_ui->m_spinDays->setValue(DEFAULT_DAYS_TO_DELETE_MSG);
   m_ui->m_lblResult->setStatus(WidgetWithStatus::Information, tr("I am ready."), tr("I am ready."));
+  m_ui->m_txtContents->setText(tr("unknown, use \"Estimate\" to measure"));
   loadDatabaseInfo();
 }
 
@@ -49,10 +58,14 @@ void FormDatabaseCleanup::setCleaner(DatabaseCleaner *cleaner) {
 
   m_cleaner = cleaner;
 
-  connect(m_ui->m_btnBox->button(QDialogButtonBox::Ok), SIGNAL(clicked()), this, SLOT(startPurging()));
+  connect(m_ui->m_btnBox->button(QDialogButtonBox::Ok), SIGNAL(clicked()), this, SLOT(startPurging()), Qt::UniqueConnection);
+  connect(m_btnEstimate, SIGNAL(clicked()), this, SLOT(estimatePurging()), Qt::UniqueConnection);
+  connect(m_btnCancel, SIGNAL(clicked()), this, SLOT(cancelPurging()), Qt::UniqueConnection);
   connect(this, SIGNAL(purgeRequested(CleanerOrders)), m_cleaner, SLOT(purgeDatabaseData(CleanerOrders)));
   connect(m_cleaner, SIGNAL(purgeStarted()), this, SLOT(onPurgeStarted()));
   connect(m_cleaner, SIGNAL(purgeProgress(int,QString)), this, SLOT(onPurgeProgress(int,QString)));
+  connect(m_cleaner, SIGNAL(purgeEstimated(int)), this, SLOT(onPurgeEstimated(int)));
+  connect(m_cleaner, SIGNAL(contentsMeasured(int,int,qint64,qint64)), this, SLOT(onContentsMeasured(int,int,qint64,qint64)));
   connect(m_cleaner, SIGNAL(purgeFinished(bool)), this, SLOT(onPurgeFinished(bool)));
 }
 
@@ -79,6 +92,21 @@ void FormDatabaseCleanup::updateDaysSuffix(int number) {
 }
 
 void FormDatabaseCleanup::startPurging() {
+  requestPurge(false);
+}
+
+void FormDatabaseCleanup::estimatePurging() {
+  requestPurge(true);
+}
+
+void FormDatabaseCleanup::cancelPurging() {
+  m_cancelled = true;
+  m_btnCancel->setEnabled(false);
+  m_cleaner->cancelPurge();
+  m_ui->m_lblResult->setStatus(WidgetWithStatus::Information, tr("Stopping database cleanup..."), tr("Stopping database cleanup..."));
+}
+
+void FormDatabaseCleanup::requestPurge(bool dry_run) {
   CleanerOrders orders;
 
   orders.m_removeRecycleBin = m_ui->m_checkRemoveRecycleBin->isChecked();
@@ -87,14 +115,26 @@ void FormDatabaseCleanup::startPurging() {
   orders.m_removeReadMessages = m_ui->m_checkRemoveReadMessages->isChecked();
   orders.m_shrinkDatabase = m_ui->m_checkShrink->isEnabled() && m_ui->m_checkShrink->isChecked();
   orders.m_removeStarredMessages = m_ui->m_checkRemoveStarredMessages->isChecked();
+  orders.m_convertContents = m_ui->m_checkConvertContents->isChecked();
+  orders.m_dryRun = dry_run;
+
+  m_dryRun = dry_run;
+  m_cancelled = false;
 
   emit purgeRequested(orders);
 }
 
+void FormDatabaseCleanup::setButtonsEnabled(bool purge_running) {
+  m_ui->m_btnBox->button(QDialogButtonBox::Ok)->setEnabled(!purge_running);
+  m_ui->m_btnBox->button(QDialogButtonBox::Close)->setEnabled(!purge_running);
+  m_btnEstimate->setEnabled(!purge_running);
+  m_btnCancel->setEnabled(purge_running && !m_dryRun);
+}
+
 void FormDatabaseCleanup::onPurgeStarted() {
   m_ui->m_progressBar->setValue(0);
   m_ui->m_progressBar->setEnabled(true);
-  m_ui->m_btnBox->setEnabled(false);
+  setButtonsEnabled(true);
   m_ui->m_lblResult->setStatus(WidgetWithStatus::Information, tr("Database cleanup is running."), tr("Database cleanup is running."));
 }
 
@@ -103,12 +143,35 @@ void FormDatabaseCleanup::onPurgeProgress(int progress, const QString &descripti
   m_ui->m_lblResult->setStatus(WidgetWithStatus::Information, description, description);
 }
 
+void FormDatabaseCleanup::onPurgeEstimated(int messages_count) {
+  const QString description = tr("%n message(s) would be removed.", 0, messages_count);
+
+  m_ui->m_lblResult->setStatus(WidgetWithStatus::Ok, description, description);
+}
+
+void FormDatabaseCleanup::onContentsMeasured(int messages_count, int compressed_count, qint64 stored_size, qint64 plain_size) {
+  const double ratio = stored_size > 0 ? double(plain_size) / stored_size : 1.0;
+
+  m_ui->m_txtContents->setText(tr("%1 of %2 compressed, stored: %3 MB, plain: %4 MB, ratio: %5").arg(QString::number(compressed_count),
+                                                                                                    QString::number(messages_count),
+                                                                                                    QString::number(stored_size / 1000000.0),
+                                                                                                    QString::number(plain_size / 1000000.0),
+                                                                                                    QString::number(ratio, 'f', 2)));
+}
+
 void FormDatabaseCleanup::onPurgeFinished(bool finished) {
   m_ui->m_progressBar->setEnabled(false);
   m_ui->m_progressBar->setValue(0);
-  m_ui->m_btnBox->setEnabled(true);
+  setButtonsEnabled(false);
 
-  if (finished) {
+  if (m_dryRun && finished) {
+    // Estimation is already displayed.
+    return;
+  }
+  else if (m_cancelled && finished) {
+    m_ui->m_lblResult->setStatus(WidgetWithStatus::Warning, tr("Database cleanup was stopped."), tr("Database cleanup was stopped."));
+  }
+  else if (finished) {
     m_ui->m_lblResult->setStatus(WidgetWithStatus::Ok, tr("Database cleanup is completed."), tr("Database cleanup is completed."));
   }
   else {
@@ -130,4 +193,7 @@ void FormDatabaseCleanup::loadDatabaseInfo() {
   m_ui->m_checkShrink->setEnabled(qApp->database()->activeDatabaseDriver() == DatabaseFactory::SQLITE ||
                                   qApp->database()->activeDatabaseDriver() == DatabaseFactory::SQLITE_MEMORY);
   m_ui->m_checkShrink->setChecked(m_ui->m_checkShrink->isEnabled());
+  m_ui->m_checkConvertContents->setText(qApp->settings()->value(GROUP(Database), SETTING(Database::CompressContents)).toBool() ?
+                                          tr("Compress contents of all messages") :
+                                          tr("Decompress contents of all messages"));
 }
@@ -42,8 +42,12 @@ class FormDatabaseCleanup : public QDialog {
   private slots:
     void updateDaysSuffix(int number);
     void startPurging();
+    void estimatePurging();
+    void cancelPurging();
     void onPurgeStarted();
     void onPurgeProgress(int progress, const QString &description);
+    void onPurgeEstimated(int messages_count);
+    void onContentsMeasured(int messages_count, int compressed_count, qint64 stored_size, qint64 plain_size);
     void onPurgeFinished(bool finished);
 
   signals:
@@ -51,10 +55,16 @@ class FormDatabaseCleanup : public QDialog {
 
   private:
     void loadDatabaseInfo();
+    void requestPurge(bool dry_run);
+    void setButtonsEnabled(bool purge_running);
 
   private:
     QScopedPointer<Ui::FormDatabaseCleanup> m_ui;
+    QPushButton *m_btnEstimate;
+    QPushButton *m_btnCancel;
     DatabaseCleaner *m_cleaner;
+    bool m_dryRun;
+    bool m_cancelled;
 };
 
 #endif // FORMDATABASECLEANUP_H
@@ -40,6 +40,7 @@
 #include "gui/dialogs/formsettings.h"
 #include "gui/dialogs/formupdate.h"
 #include "gui/dialogs/formdatabasecleanup.h"
+#include "gui/dialogs/formupdatestatistics.h"
 #include "gui/dialogs/formbackupdatabasesettings.h"
 #include "gui/dialogs/formrestoredatabasesettings.h"
 #include "gui/dialogs/formaddaccount.h"
@@ -124,12 +125,18 @@ void FormMain::showDbCleanupAssistant() {
   }
 }
 
+void FormMain::showUpdateStatistics() {
+  QScopedPointer<FormUpdateStatistics> form_pointer(new FormUpdateStatistics(qApp->feedReader()->lastUpdateResults(), this));
+  form_pointer.data()->exec();
+}
+
 QList<QAction*> FormMain::allActions() const {
   QList<QAction*> actions;
 
   // Add basic actions.
   actions << m_ui->m_actionSettings;
   actions << m_ui->m_actionDownloadManager;
+  actions << m_ui->m_actionUpdateStatistics;
   actions << m_ui->m_actionRestoreDatabaseSettings;
   actions << m_ui->m_actionBackupDatabaseSettings;
   actions << m_ui->m_actionQuit;
@@ -152,6 +159,7 @@ QList<QAction*> FormMain::allActions() const {
   actions << m_ui->m_actionClearSelectedItems;
   actions << m_ui->m_actionClearAllItems;
   actions << m_ui->m_actionShowOnlyUnreadItems;
+  actions << m_ui->m_actionShowArchivedMessages;
   actions << m_ui->m_actionMarkSelectedMessagesAsRead;
   actions << m_ui->m_actionMarkSelectedMessagesAsUnread;
   actions << m_ui->m_actionSwitchImportanceOfSelectedMessages;
@@ -450,6 +458,7 @@ void FormMain::setupIcons() {
   m_ui->m_actionAboutGuard->setIcon(icon_theme_factory->fromTheme(QSL("help-about")));
   m_ui->m_actionCheckForUpdates->setIcon(icon_theme_factory->fromTheme(QSL("system-upgrade")));
   m_ui->m_actionCleanupDatabase->setIcon(icon_theme_factory->fromTheme(QSL("edit-clear")));
+  m_ui->m_actionUpdateStatistics->setIcon(icon_theme_factory->fromTheme(QSL("view-refresh")));
   m_ui->m_actionReportBug->setIcon(icon_theme_factory->fromTheme(QSL("call-start")));
   m_ui->m_actionBackupDatabaseSettings->setIcon(icon_theme_factory->fromTheme(QSL("document-export")));
   m_ui->m_actionRestoreDatabaseSettings->setIcon(icon_theme_factory->fromTheme(QSL("document-import")));
@@ -493,6 +502,7 @@ void FormMain::setupIcons() {
   m_ui->m_actionSelectPreviousMessage->setIcon(icon_theme_factory->fromTheme(QSL("go-up")));
   m_ui->m_actionSelectNextUnreadMessage->setIcon(icon_theme_factory->fromTheme(QSL("mail-mark-unread")));
   m_ui->m_actionShowOnlyUnreadItems->setIcon(icon_theme_factory->fromTheme(QSL("mail-mark-unread")));
+  m_ui->m_actionShowArchivedMessages->setIcon(icon_theme_factory->fromTheme(QSL("document-open-recent")));
   m_ui->m_actionExpandCollapseItem->setIcon(icon_theme_factory->fromTheme(QSL("format-indent-more")));
   m_ui->m_actionRestoreSelectedMessages->setIcon(icon_theme_factory->fromTheme(QSL("view-refresh")));
   m_ui->m_actionRestoreAllRecycleBins->setIcon(icon_theme_factory->fromTheme(QSL("view-refresh")));
@@ -605,6 +615,7 @@ void FormMain::createConnections() {
   connect(m_ui->m_actionDownloadManager, SIGNAL(triggered()), m_ui->m_tabWidget, SLOT(showDownloadManager()));
 
   connect(m_ui->m_actionCleanupDatabase, SIGNAL(triggered()), this, SLOT(showDbCleanupAssistant()));
+  connect(m_ui->m_actionUpdateStatistics, SIGNAL(triggered()), this, SLOT(showUpdateStatistics()));
 
   // Menu "Help" connections.
   connect(m_ui->m_actionAboutGuard, SIGNAL(triggered()), this, SLOT(showAbout()));
@@ -694,6 +705,8 @@ void FormMain::createConnections() {
           tabWidget()->feedMessageViewer(), &FeedMessageViewer::switchMessageSplitterOrientation);
   connect(m_ui->m_actionShowOnlyUnreadItems, &QAction::toggled,
           tabWidget()->feedMessageViewer(), &FeedMessageViewer::toggleShowOnlyUnreadFeeds);
+  connect(m_ui->m_actionShowArchivedMessages, &QAction::toggled,
+          tabWidget()->feedMessageViewer()->messagesView(), &MessagesView::setShowArchived);
   connect(m_ui->m_actionRestoreSelectedMessages, SIGNAL(triggered()),
           tabWidget()->feedMessageViewer()->messagesView(), SLOT(restoreSelectedMessages()));
   connect(m_ui->m_actionRestoreAllRecycleBins, SIGNAL(triggered()),
@@ -86,6 +86,7 @@ class FormMain : public QMainWindow {
     void showWiki();
     void showAddAccountDialog();
     void showDbCleanupAssistant();
+    void showUpdateStatistics();
     void reportABug();
     void donate();
 
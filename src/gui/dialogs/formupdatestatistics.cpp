@@ -0,0 +1,156 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "gui/dialogs/formupdatestatistics.h"
+
+#include "miscellaneous/application.h"
+#include "miscellaneous/iconfactory.h"
+#include "miscellaneous/iofactory.h"
+#include "exceptions/ioexception.h"
+#include "gui/messagebox.h"
+
+#include <QFileDialog>
+#include <QPushButton>
+#include <QHeaderView>
+
+
+FormUpdateStatistics::FormUpdateStatistics(const FeedDownloadResults &results, QWidget *parent)
+  : QDialog(parent), m_ui(new Ui::FormUpdateStatistics), m_results(results) {
+  m_ui->setupUi(this);
+
+  // Set flags and attributes.
+  setWindowFlags(Qt::Dialog | Qt::WindowSystemMenuHint | Qt::WindowTitleHint | Qt::WindowMaximizeButtonHint);
+  setWindowIcon(qApp->icons()->fromTheme(QSL("view-refresh")));
+
+  QPushButton *btn_json = m_ui->m_btnBox->addButton(tr("Export to &JSON"), QDialogButtonBox::ActionRole);
+  QPushButton *btn_csv = m_ui->m_btnBox->addButton(tr("Export to &CSV"), QDialogButtonBox::ActionRole);
+
+  btn_json->setIcon(qApp->icons()->fromTheme(QSL("document-export")));
+  btn_csv->setIcon(qApp->icons()->fromTheme(QSL("document-export")));
+  btn_json->setEnabled(!m_results.statistics().isEmpty());
+  btn_csv->setEnabled(!m_results.statistics().isEmpty());
+
+  connect(btn_json, &QPushButton::clicked, this, &FormUpdateStatistics::exportToJson);
+  connect(btn_csv, &QPushButton::clicked, this, &FormUpdateStatistics::exportToCsv);
+
+  loadStatistics();
+}
+
+FormUpdateStatistics::~FormUpdateStatistics() {
+  qDebug("Destroying FormUpdateStatistics instance.");
+}
+
+void FormUpdateStatistics::loadStatistics() {
+  const QList<FeedUpdateStatistics> statistics = m_results.statistics();
+  int failed_feeds = 0;
+
+  m_ui->m_tableStatistics->setSortingEnabled(false);
+  m_ui->m_tableStatistics->setColumnCount(13);
+  m_ui->m_tableStatistics->setRowCount(statistics.size());
+  m_ui->m_tableStatistics->setHorizontalHeaderLabels(QStringList() << tr("Feed") << tr("Total (ms)") << tr("Queue (ms)")
+                                                     << tr("Connection (ms)") << tr("First byte (ms)")
+                                                     << tr("Download (ms)") << tr("Bytes") << tr("Decoding (ms)")
+                                                     << tr("Parsing (ms)") << tr("Storing (ms)") << tr("Counts (ms)")
+                                                     << tr("Messages") << tr("New messages"));
+
+  for (int i = 0; i < statistics.size(); i++) {
+    const FeedUpdateStatistics &feed = statistics.at(i);
+    QTableWidgetItem *title_item = new QTableWidgetItem(feed.m_feedTitle);
+
+    title_item->setToolTip(feed.m_feedUrl);
+
+    if (feed.m_error) {
+      title_item->setForeground(QColor(Qt::red));
+      failed_feeds++;
+    }
+
+    m_ui->m_tableStatistics->setItem(i, 0, title_item);
+    m_ui->m_tableStatistics->setItem(i, 1, createNumericItem(feed.totalTime()));
+    m_ui->m_tableStatistics->setItem(i, 2, createNumericItem(feed.m_queueWait, feed.m_queueWait >= 0));
+    m_ui->m_tableStatistics->setItem(i, 3, createNumericItem(feed.m_connection, feed.m_connection >= 0));
+    m_ui->m_tableStatistics->setItem(i, 4, createNumericItem(feed.m_firstByte, feed.m_firstByte >= 0));
+    m_ui->m_tableStatistics->setItem(i, 5, createNumericItem(feed.m_download >= 0 ? feed.m_download : feed.m_obtaining,
+                                                             feed.m_download >= 0 || feed.m_obtaining >= 0));
+    m_ui->m_tableStatistics->setItem(i, 6, createNumericItem(feed.m_bytes, feed.m_download >= 0));
+    m_ui->m_tableStatistics->setItem(i, 7, createNumericItem(feed.m_decoding, feed.m_decoding >= 0));
+    m_ui->m_tableStatistics->setItem(i, 8, createNumericItem(feed.m_parsing, feed.m_parsing >= 0));
+    m_ui->m_tableStatistics->setItem(i, 9, createNumericItem(feed.m_storing, feed.m_storing >= 0));
+    m_ui->m_tableStatistics->setItem(i, 10, createNumericItem(feed.m_countsRefresh, feed.m_countsRefresh >= 0));
+    m_ui->m_tableStatistics->setItem(i, 11, createNumericItem(feed.m_obtainedMessages));
+    m_ui->m_tableStatistics->setItem(i, 12, createNumericItem(feed.m_newMessages));
+  }
+
+  m_ui->m_tableStatistics->setSortingEnabled(true);
+  m_ui->m_tableStatistics->sortByColumn(1, Qt::DescendingOrder);
+  m_ui->m_tableStatistics->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+
+  for (int i = 1; i < m_ui->m_tableStatistics->columnCount(); i++) {
+    m_ui->m_tableStatistics->horizontalHeader()->setSectionResizeMode(i, QHeaderView::ResizeToContents);
+  }
+
+  if (statistics.isEmpty()) {
+    m_ui->m_lblSummary->setText(tr("No feeds were updated yet in this session."));
+  }
+  else {
+    m_ui->m_lblSummary->setText(tr("Last update run took %1 ms, %2 feed(s) were processed, %3 of them failed.\n"
+                                   "Download column shows whole obtaining time for feeds of online services.").arg(
+                                  QString::number(m_results.duration()), QString::number(statistics.size()),
+                                  QString::number(failed_feeds)));
+  }
+}
+
+QTableWidgetItem *FormUpdateStatistics::createNumericItem(qint64 value, bool measured) const {
+  QTableWidgetItem *item = new QTableWidgetItem();
+
+  if (measured) {
+    // Numeric data are compared numerically when sorting.
+    item->setData(Qt::DisplayRole, value);
+  }
+
+  item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+  return item;
+}
+
+void FormUpdateStatistics::exportToJson() {
+  exportStatistics(tr("JSON files (*.json)"), QSL(".json"), m_results.toJson());
+}
+
+void FormUpdateStatistics::exportToCsv() {
+  exportStatistics(tr("CSV files (*.csv)"), QSL(".csv"), m_results.toCsv());
+}
+
+void FormUpdateStatistics::exportStatistics(const QString &filter, const QString &suffix, const QByteArray &data) {
+  QString selected_file = QFileDialog::getSaveFileName(this, tr("Select file for statistics export"),
+                                                       qApp->homeFolderPath(), filter);
+
+  if (selected_file.isEmpty()) {
+    return;
+  }
+
+  if (!selected_file.endsWith(suffix)) {
+    selected_file += suffix;
+  }
+
+  try {
+    IOFactory::writeTextFile(selected_file, data);
+  }
+  catch (IOException &ex) {
+    MessageBox::show(this, QMessageBox::Critical, tr("Cannot export statistics"),
+                     tr("Statistics of the update run cannot be written into destination file."), ex.message());
+  }
+}
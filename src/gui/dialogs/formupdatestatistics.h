@@ -0,0 +1,56 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef FORMUPDATESTATISTICS_H
+#define FORMUPDATESTATISTICS_H
+
+#include <QDialog>
+
+#include "ui_formupdatestatistics.h"
+
+#include "core/feeddownloader.h"
+
+
+// Shows per-feed measurements of the last update run
+// so that slow feeds and slow stages can be found.
+class FormUpdateStatistics : public QDialog {
+    Q_OBJECT
+
+  public:
+    // Constructors.
+    explicit FormUpdateStatistics(const FeedDownloadResults &results, QWidget *parent = 0);
+    virtual ~FormUpdateStatistics();
+
+  private slots:
+    void exportToJson();
+    void exportToCsv();
+
+  private:
+    void loadStatistics();
+    void exportStatistics(const QString &filter, const QString &suffix, const QByteArray &data);
+
+    // Creates item which is sorted by numeric value,
+    // unmeasured stages are shown as empty cells.
+    QTableWidgetItem *createNumericItem(qint64 value, bool measured = true) const;
+
+  private:
+    QScopedPointer<Ui::FormUpdateStatistics> m_ui;
+    FeedDownloadResults m_results;
+};
+
+#endif // FORMUPDATESTATISTICS_H
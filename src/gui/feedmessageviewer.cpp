@@ -212,6 +212,7 @@ void FeedMessageViewer::createConnections() {
   // Message changers.
   connect(m_messagesView, SIGNAL(currentMessageRemoved()), m_messagesBrowser, SLOT(clear()));
   connect(m_messagesView, SIGNAL(currentMessageChanged(Message,RootItem*)), m_messagesBrowser, SLOT(loadMessage(Message,RootItem*)));
+  connect(m_messagesView, SIGNAL(showArchivedChanged(bool)), m_messagesBrowser, SLOT(setReadOnly(bool)));
 
   connect(m_messagesBrowser, SIGNAL(markMessageRead(int,RootItem::ReadStatus)),
           m_messagesView->sourceModel(), SLOT(setMessageReadById(int,RootItem::ReadStatus)));
@@ -83,7 +83,7 @@ void MessagePreviewer::createConnections() {
 }
 
 MessagePreviewer::MessagePreviewer(QWidget *parent) : QWidget(parent),
-  m_ui(new Ui::MessagePreviewer), m_pictures(QStringList()) {
+  m_ui(new Ui::MessagePreviewer), m_pictures(QStringList()), m_readOnly(false) {
   m_ui->setupUi(this);
   m_ui->m_txtMessage->viewport()->setAutoFillBackground(true);
   m_toolBar = new QToolBar(this);
@@ -112,6 +112,7 @@ void MessagePreviewer::reloadFontSettings() {
 }
 
 void MessagePreviewer::clear() {
+  m_ui->m_txtMessage->clearPendingImages();
   m_ui->m_txtMessage->clear();
   m_pictures.clear();
   hide();
@@ -121,12 +122,22 @@ void MessagePreviewer::hideToolbar() {
   m_toolBar->setVisible(false);
 }
 
+void MessagePreviewer::setReadOnly(bool read_only) {
+  m_readOnly = read_only;
+
+  m_actionMarkRead->setVisible(!read_only);
+  m_actionMarkUnread->setVisible(!read_only);
+  m_actionSwitchImportance->setVisible(!read_only);
+}
+
 void MessagePreviewer::loadMessage(const Message &message, RootItem *root) {
   m_message = message;
   m_root = root;
+  m_pictures.clear();
 
   if (!m_root.isNull()) {
     m_actionSwitchImportance->setChecked(m_message.m_isImportant);
+    m_ui->m_txtMessage->clearPendingImages();
     m_ui->m_txtMessage->setHtml(prepareHtmlForMessage(m_message));
 
     updateButtons();
@@ -145,7 +156,7 @@ void MessagePreviewer::markMessageAsUnread() {
 }
 
 void MessagePreviewer::markMessageAsReadUnread(RootItem::ReadStatus read) {
-  if (!m_root.isNull()) {
+  if (!m_root.isNull() && !m_readOnly) {
     if (m_root->getParentServiceRoot()->onBeforeSetMessagesRead(m_root.data(),
                                                                 QList<Message>() << m_message,
                                                                 read)) {
@@ -164,7 +175,7 @@ void MessagePreviewer::markMessageAsReadUnread(RootItem::ReadStatus read) {
 }
 
 void MessagePreviewer::switchMessageImportance(bool checked) {
-  if (!m_root.isNull()) {
+  if (!m_root.isNull() && !m_readOnly) {
     if (m_root->getParentServiceRoot()->onBeforeSwitchMessageImportance(m_root.data(),
                                                                         QList<ImportanceChange>() << ImportanceChange(m_message,
                                                                                                                       m_message.m_isImportant ?
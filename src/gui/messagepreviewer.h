@@ -48,6 +48,10 @@ class MessagePreviewer : public QWidget {
     void hideToolbar();
     void loadMessage(const Message &message, RootItem *root);
 
+    // Read-only previewer (for example for archived messages)
+    // does not offer changing of the message.
+    void setReadOnly(bool read_only);
+
   private slots:
     void markMessageAsRead();
     void markMessageAsUnread();
@@ -73,6 +77,7 @@ class MessagePreviewer : public QWidget {
     QAction *m_actionMarkRead;
     QAction *m_actionMarkUnread;
     QAction *m_actionSwitchImportance;
+    bool m_readOnly;
 };
 
 #endif // MESSAGEPREVIEWER_H
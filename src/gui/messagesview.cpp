@@ -278,6 +278,12 @@ void MessagesView::loadItem(RootItem *item) {
   emit currentMessageRemoved();
 }
 
+void MessagesView::setShowArchived(bool show_archived) {
+  m_sourceModel->setShowArchived(show_archived);
+  emit showArchivedChanged(show_archived);
+  loadItem(m_sourceModel->loadedItem());
+}
+
 void MessagesView::openSelectedSourceMessagesExternally() {
   foreach (const QModelIndex &index, selectionModel()->selectedRows()) {
     const QString link = m_sourceModel->messageAt(m_proxyModel->mapToSource(index).row()).m_url;
@@ -57,6 +57,9 @@ class MessagesView : public QTreeView {
     // Loads un-deleted messages from selected feeds.
     void loadItem(RootItem *item);
 
+    // Shows archived messages of selected feeds instead of the regular ones.
+    void setShowArchived(bool show_archived);
+
     // Message manipulators.
     void openSelectedSourceMessagesExternally();
     void openSelectedMessagesInternally();
@@ -98,6 +101,9 @@ class MessagesView : public QTreeView {
     void currentMessageChanged(const Message &message, RootItem *root);
     void currentMessageRemoved();
 
+    // Archived messages are shown or hidden, they cannot be changed.
+    void showArchivedChanged(bool show_archived);
+
   private:
     // Creates needed connections.
     void createConnections();
@@ -20,19 +20,37 @@
 #include "miscellaneous/application.h"
 #include "miscellaneous/iconfactory.h"
 #include "network-web/networkfactory.h"
+#include "network-web/imageloader.h"
 
 
-MessageTextBrowser::MessageTextBrowser(QWidget *parent) : QTextBrowser(parent) {
+MessageTextBrowser::MessageTextBrowser(QWidget *parent) : QTextBrowser(parent), m_pendingImages(QHash<QUrl, QPair<QUrl, int> >()) {
+  connect(ImageLoader::instance(), SIGNAL(imageLoaded(QUrl)), this, SLOT(onImageLoaded(QUrl)));
+  connect(ImageLoader::instance(), SIGNAL(imageFailed(QUrl)), this, SLOT(onImageFailed(QUrl)));
 }
 
 MessageTextBrowser::~MessageTextBrowser() {
 }
 
-QVariant MessageTextBrowser::loadResource(int type, const QUrl &name) {
-  Q_UNUSED(name)
+void MessageTextBrowser::clearPendingImages() {
+  m_pendingImages.clear();
+}
 
+QVariant MessageTextBrowser::loadResource(int type, const QUrl &name) {
   switch (type) {
     case QTextDocument::ImageResource: {
+      const QUrl url = document()->baseUrl().resolved(name);
+      const int width = viewport()->width() - 2 * (int) document()->documentMargin();
+      const QPixmap image = ImageLoader::instance()->image(url, width);
+
+      if (!image.isNull()) {
+        return image;
+      }
+
+      if (!url.isRelative()) {
+        // Image is being loaded, show placeholder until it is ready.
+        m_pendingImages.insert(url, QPair<QUrl, int>(name, width));
+      }
+
       if (m_imagePlaceholder.isNull()) {
         m_imagePlaceholder = qApp->icons()->miscPixmap(QSL("image-placeholder")).scaledToWidth(20, Qt::FastTransformation);
       }
@@ -46,6 +64,20 @@ QVariant MessageTextBrowser::loadResource(int type, const QUrl &name) {
   }
 }
 
+void MessageTextBrowser::onImageLoaded(const QUrl &url) {
+  if (m_pendingImages.contains(url)) {
+    const QPair<QUrl, int> image = m_pendingImages.take(url);
+
+    document()->addResource(QTextDocument::ImageResource, image.first, ImageLoader::instance()->image(url, image.second));
+    document()->markContentsDirty(0, document()->characterCount());
+  }
+}
+
+void MessageTextBrowser::onImageFailed(const QUrl &url) {
+  // Placeholder stays in document.
+  m_pendingImages.remove(url);
+}
+
 void MessageTextBrowser::wheelEvent(QWheelEvent *e) {
   QTextBrowser::wheelEvent(e);
   qApp->settings()->setValue(GROUP(Messages), Messages::PreviewerFontStandard, font().toString());
@@ -20,6 +20,10 @@
 
 #include <QTextBrowser>
 
+#include <QHash>
+#include <QPair>
+#include <QUrl>
+
 
 class MessageTextBrowser : public QTextBrowser {
     Q_OBJECT
@@ -30,14 +34,28 @@ class MessageTextBrowser : public QTextBrowser {
 
     QVariant loadResource(int type, const QUrl &name);
 
+    // Forgets images of current document which are still loading,
+    // must be called before another document is set.
+    void clearPendingImages();
+
   signals:
     void imageRequested(const QString &image_url);
 
   protected:
     void wheelEvent(QWheelEvent *e);
 
+  private slots:
+    // Replaces placeholder of loaded image with the image itself.
+    void onImageLoaded(const QUrl &url);
+    void onImageFailed(const QUrl &url);
+
   private:
     QPixmap m_imagePlaceholder;
+
+    // Images of current document which are not loaded yet, keys are
+    // absolute image URLs, values are image names used in document
+    // and widths of images.
+    QHash<QUrl, QPair<QUrl, int> > m_pendingImages;
 };
 
 #endif // MESSAGETEXTBROWSER_H
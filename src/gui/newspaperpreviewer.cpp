@@ -20,46 +20,118 @@
 #include "gui/messagepreviewer.h"
 #include "gui/dialogs/formmain.h"
 #include "miscellaneous/application.h"
+#include "definitions/definitions.h"
 
 #include <QScrollBar>
 
 
 NewspaperPreviewer::NewspaperPreviewer(RootItem *root, QList<Message> messages, QWidget *parent)
-  : TabContent(parent), m_ui(new Ui::NewspaperPreviewer), m_root(root), m_messages(messages) {
-  m_ui->setupUi(this); 
-  connect(m_ui->m_btnShowMoreMessages, SIGNAL(clicked(bool)), this, SLOT(showMoreMessages()));
-  showMoreMessages();
+  : TabContent(parent), m_ui(new Ui::NewspaperPreviewer), m_root(root), m_messages(messages),
+    m_visiblePreviewers(QHash<int, MessagePreviewer*>()), m_freePreviewers(QList<MessagePreviewer*>()),
+    m_readOnly(false) {
+  m_ui->setupUi(this);
+
+  // All messages have same height, so only previewers for messages near
+  // the viewport are needed, no matter how many messages there are.
+  // NOTE: Height of widget is limited, so for extremely long lists
+  // only some first messages are reachable.
+  m_ui->scrollAreaWidgetContents->setFixedHeight(qMin((qint64) m_messages.size() * NEWSPAPER_MESSAGE_HEIGHT,
+                                                      (qint64) QWIDGETSIZE_MAX));
+  m_ui->scrollArea->verticalScrollBar()->setSingleStep(NEWSPAPER_MESSAGE_HEIGHT / 10);
+
+  connect(m_ui->scrollArea->verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(updateVisibleMessages()));
+
+  if (m_root.isNull()) {
+    qApp->showGuiMessage(tr("Cannot show messages"),
+                         tr("Cannot show messages because parent feed was removed."),
+                         QSystemTrayIcon::Warning,
+                         qApp->mainForm(), true);
+  }
 }
 
 NewspaperPreviewer::~NewspaperPreviewer() {
 }
 
-void NewspaperPreviewer::showMoreMessages() {
-  if (!m_root.isNull()) {
-    int current_scroll = m_ui->scrollArea->verticalScrollBar()->value();
+void NewspaperPreviewer::setReadOnly(bool read_only) {
+  m_readOnly = read_only;
+
+  foreach (MessagePreviewer *previewer, m_visiblePreviewers.values() + m_freePreviewers) {
+    previewer->setReadOnly(read_only);
+  }
+}
+
+void NewspaperPreviewer::resizeEvent(QResizeEvent *event) {
+  TabContent::resizeEvent(event);
+  updateVisibleMessages();
+}
+
+void NewspaperPreviewer::updateVisibleMessages() {
+  if (m_root.isNull() || m_messages.isEmpty()) {
+    return;
+  }
+
+  const int scroll = m_ui->scrollArea->verticalScrollBar()->value();
+  const int first_index = qMax(0, scroll / NEWSPAPER_MESSAGE_HEIGHT - 1);
+  const int last_index = qMin(m_messages.size() - 1,
+                              (scroll + m_ui->scrollArea->viewport()->height()) / NEWSPAPER_MESSAGE_HEIGHT + 1);
+  const int width = m_ui->scrollAreaWidgetContents->width();
+
+  // Release previewers of messages which are not visible anymore.
+  QMutableHashIterator<int, MessagePreviewer*> i(m_visiblePreviewers);
+
+  while (i.hasNext()) {
+    i.next();
 
-    for (int i = 0; i < 10 && !m_messages.isEmpty(); i++) {
-      Message msg = m_messages.takeFirst();
-      MessagePreviewer *prev = new MessagePreviewer(this);
-      QMargins margins = prev->layout()->contentsMargins();
+    if (i.key() < first_index || i.key() > last_index) {
+      i.value()->clear();
+      m_freePreviewers.append(i.value());
+      i.remove();
+    }
+  }
 
-      connect(prev, SIGNAL(requestMessageListReload(bool)), this, SIGNAL(requestMessageListReload(bool)));
+  for (int index = first_index; index <= last_index; index++) {
+    MessagePreviewer *previewer = m_visiblePreviewers.value(index);
 
-      margins.setRight(0);
-      prev->layout()->setContentsMargins(margins);
-      prev->setFixedHeight(300);
-      prev->loadMessage(msg, m_root);
-      m_ui->m_layout->insertWidget(m_ui->m_layout->count() - 2, prev);
+    if (previewer == nullptr) {
+      previewer = m_freePreviewers.isEmpty() ? createPreviewer() : m_freePreviewers.takeLast();
+      previewer->loadMessage(m_messages.at(index), m_root);
+      m_visiblePreviewers.insert(index, previewer);
     }
 
-    m_ui->m_btnShowMoreMessages->setText(tr("Show more messages (%n remaining)", "", m_messages.size()));
-    m_ui->m_btnShowMoreMessages->setEnabled(!m_messages.isEmpty());
-    m_ui->scrollArea->verticalScrollBar()->setValue(current_scroll);
+    previewer->setGeometry(0, index * NEWSPAPER_MESSAGE_HEIGHT, width, NEWSPAPER_MESSAGE_HEIGHT);
   }
-  else {
-    qApp->showGuiMessage(tr("Cannot show more messages"),
-                         tr("Cannot show more messages because parent feed was removed."),
-                         QSystemTrayIcon::Warning,
-                         qApp->mainForm(), true);
+}
+
+void NewspaperPreviewer::onMessageRead(int id, RootItem::ReadStatus read) {
+  for (int i = 0; i < m_messages.size(); i++) {
+    if (m_messages.at(i).m_id == id) {
+      m_messages[i].m_isRead = read == RootItem::Read;
+      break;
+    }
+  }
+}
+
+void NewspaperPreviewer::onMessageImportant(int id, RootItem::Importance important) {
+  for (int i = 0; i < m_messages.size(); i++) {
+    if (m_messages.at(i).m_id == id) {
+      m_messages[i].m_isImportant = important == RootItem::Important;
+      break;
+    }
   }
 }
+
+MessagePreviewer *NewspaperPreviewer::createPreviewer() {
+  MessagePreviewer *previewer = new MessagePreviewer(m_ui->scrollAreaWidgetContents);
+  QMargins margins = previewer->layout()->contentsMargins();
+
+  margins.setRight(0);
+  previewer->layout()->setContentsMargins(margins);
+  previewer->setReadOnly(m_readOnly);
+
+  connect(previewer, SIGNAL(requestMessageListReload(bool)), this, SIGNAL(requestMessageListReload(bool)));
+  connect(previewer, SIGNAL(markMessageRead(int,RootItem::ReadStatus)), this, SLOT(onMessageRead(int,RootItem::ReadStatus)));
+  connect(previewer, SIGNAL(markMessageImportant(int,RootItem::Importance)),
+          this, SLOT(onMessageImportant(int,RootItem::Importance)));
+
+  return previewer;
+}
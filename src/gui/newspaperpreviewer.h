@@ -28,6 +28,7 @@
 #include "services/abstract/rootitem.h"
 
 #include <QPointer>
+#include <QHash>
 
 
 namespace Ui {
@@ -35,6 +36,7 @@ namespace Ui {
 }
 
 class RootItem;
+class MessagePreviewer;
 
 class NewspaperPreviewer : public TabContent {
     Q_OBJECT
@@ -43,16 +45,35 @@ class NewspaperPreviewer : public TabContent {
     explicit NewspaperPreviewer(RootItem *root, QList<Message> messages, QWidget *parent = 0);
     virtual ~NewspaperPreviewer();
 
+    // See MessagePreviewer::setReadOnly().
+    void setReadOnly(bool read_only);
+
+  protected:
+    void resizeEvent(QResizeEvent *event);
+
   private slots:
-    void showMoreMessages();
+    // Loads messages which are in (or near) the viewport into
+    // previewers, previewers of other messages are recycled.
+    void updateVisibleMessages();
+
+    // Keep our copies of messages in sync with previewers.
+    void onMessageRead(int id, RootItem::ReadStatus read);
+    void onMessageImportant(int id, RootItem::Importance important);
 
   signals:
     void requestMessageListReload(bool mark_current_as_read);
 
   private:
+    MessagePreviewer *createPreviewer();
+
     QScopedPointer<Ui::NewspaperPreviewer> m_ui;
     QPointer<RootItem> m_root;
     QList<Message> m_messages;
+
+    // Previewers currently showing messages, keys are message indices.
+    QHash<int, MessagePreviewer*> m_visiblePreviewers;
+    QList<MessagePreviewer*> m_freePreviewers;
+    bool m_readOnly;
 };
 
 #endif // NEWSPAPERPREVIEWER_H
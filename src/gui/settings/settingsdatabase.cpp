@@ -21,6 +21,9 @@
 #include "definitions/definitions.h"
 #include "miscellaneous/application.h"
 #include "miscellaneous/textfactory.h"
+#include "miscellaneous/sqlstatistics.h"
+
+#include <QHeaderView>
 
 
 SettingsDatabase::SettingsDatabase(Settings *settings, QWidget *parent)
@@ -33,8 +36,12 @@ SettingsDatabase::SettingsDatabase(Settings *settings, QWidget *parent)
   connect(m_ui->m_txtMysqlHostname->lineEdit(), &QLineEdit::textChanged, this, &SettingsDatabase::dirtifySettings);
   connect(m_ui->m_txtMysqlPassword->lineEdit(), &QLineEdit::textChanged, this, &SettingsDatabase::dirtifySettings);
   connect(m_ui->m_checkUseTransactions, &QCheckBox::toggled, this, &SettingsDatabase::dirtifySettings);
+  connect(m_ui->m_checkCompressContents, &QCheckBox::toggled, this, &SettingsDatabase::dirtifySettings);
+  connect(m_ui->m_checkArchiveMessages, &QCheckBox::toggled, this, &SettingsDatabase::dirtifySettings);
+  connect(m_ui->m_spinArchiveAfterDays, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), this, &SettingsDatabase::dirtifySettings);
   connect(m_ui->m_txtMysqlUsername->lineEdit(), &QLineEdit::textChanged, this, &SettingsDatabase::dirtifySettings);
   connect(m_ui->m_spinMysqlPort, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), this, &SettingsDatabase::dirtifySettings);
+  connect(m_ui->m_spinSlowQueryThreshold, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), this, &SettingsDatabase::dirtifySettings);
 
   connect(m_ui->m_cmbDatabaseDriver, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, &SettingsDatabase::selectSqlBackend);
   connect(m_ui->m_checkMysqlShowPassword, &QCheckBox::toggled, this, &SettingsDatabase::switchMysqlPasswordVisiblity);
@@ -43,6 +50,10 @@ SettingsDatabase::SettingsDatabase(Settings *settings, QWidget *parent)
   connect(m_ui->m_txtMysqlPassword->lineEdit(), &BaseLineEdit::textChanged, this, &SettingsDatabase::onMysqlPasswordChanged);
   connect(m_ui->m_txtMysqlDatabase->lineEdit(), &BaseLineEdit::textChanged, this, &SettingsDatabase::onMysqlDatabaseChanged);
   connect(m_ui->m_btnMysqlTestSetup, &QPushButton::clicked, this, &SettingsDatabase::mysqlTestConnection);
+  connect(m_ui->m_btnRefreshQueryStatistics, &QPushButton::clicked, this, &SettingsDatabase::loadQueryStatistics);
+  connect(m_ui->m_btnResetQueryStatistics, &QPushButton::clicked, this, &SettingsDatabase::resetQueryStatistics);
+  connect(m_ui->m_checkArchiveMessages, &QCheckBox::toggled, m_ui->m_spinArchiveAfterDays, &QSpinBox::setEnabled);
+  connect(m_ui->m_spinArchiveAfterDays, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), this, &SettingsDatabase::updateArchiveDaysSuffix);
 
   connect(m_ui->m_cmbDatabaseDriver, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, &SettingsDatabase::requireRestart);
   connect(m_ui->m_checkSqliteUseInMemoryDatabase, &QCheckBox::toggled, this, &SettingsDatabase::requireRestart);
@@ -50,6 +61,20 @@ SettingsDatabase::SettingsDatabase(Settings *settings, QWidget *parent)
   connect(m_ui->m_txtMysqlHostname->lineEdit(), &BaseLineEdit::textEdited, this, &SettingsDatabase::requireRestart);
   connect(m_ui->m_txtMysqlPassword->lineEdit(), &BaseLineEdit::textEdited, this, &SettingsDatabase::requireRestart);
   connect(m_ui->m_txtMysqlUsername->lineEdit(), &BaseLineEdit::textEdited, this, &SettingsDatabase::requireRestart);
+
+  m_ui->m_treeQueryStatistics->setHeaderLabels(QStringList()
+                                               << tr("Statement")
+                                               << tr("Caller")
+                                               << tr("Count")
+                                               << tr("Total (ms)")
+                                               << tr("Max (ms)")
+                                               << tr("Rows")
+                                               << tr("< 1 ms")
+                                               << tr("< 10 ms")
+                                               << tr("< 100 ms")
+                                               << tr("< 1 s")
+                                               << tr(">= 1 s"));
+  m_ui->m_treeQueryStatistics->header()->setSectionResizeMode(QHeaderView::ResizeToContents);
 }
 
 SettingsDatabase::~SettingsDatabase() {
@@ -131,10 +156,50 @@ void SettingsDatabase::switchMysqlPasswordVisiblity(bool visible) {
   m_ui->m_txtMysqlPassword->lineEdit()->setEchoMode(visible ? QLineEdit::Normal : QLineEdit::Password);
 }
 
+void SettingsDatabase::updateArchiveDaysSuffix(int number) {
+  m_ui->m_spinArchiveAfterDays->setSuffix(tr(" day(s)", 0, number));
+}
+
+void SettingsDatabase::loadQueryStatistics() {
+  m_ui->m_treeQueryStatistics->setSortingEnabled(false);
+  m_ui->m_treeQueryStatistics->clear();
+
+  foreach (const SqlStatementStatistics &statement, SqlStatistics::statements()) {
+    QTreeWidgetItem *item = new QTreeWidgetItem(m_ui->m_treeQueryStatistics);
+
+    item->setText(0, statement.m_statement);
+    item->setToolTip(0, statement.m_statement);
+    item->setText(1, statement.m_caller);
+    item->setToolTip(1, statement.m_caller);
+    item->setData(2, Qt::DisplayRole, statement.m_count);
+    item->setData(3, Qt::DisplayRole, statement.m_totalTime);
+    item->setData(4, Qt::DisplayRole, statement.m_maxTime);
+    item->setData(5, Qt::DisplayRole, statement.m_rows);
+
+    for (int i = 0; i < statement.m_histogram.size(); i++) {
+      item->setData(6 + i, Qt::DisplayRole, statement.m_histogram.at(i));
+    }
+  }
+
+  m_ui->m_treeQueryStatistics->setSortingEnabled(true);
+  m_ui->m_treeQueryStatistics->sortByColumn(3, Qt::DescendingOrder);
+}
+
+void SettingsDatabase::resetQueryStatistics() {
+  SqlStatistics::reset();
+  loadQueryStatistics();
+}
+
 void SettingsDatabase::loadSettings() {
   onBeginLoadSettings();
 
   m_ui->m_checkUseTransactions->setChecked(qApp->settings()->value(GROUP(Database), SETTING(Database::UseTransactions)).toBool());
+  m_ui->m_checkCompressContents->setChecked(qApp->settings()->value(GROUP(Database), SETTING(Database::CompressContents)).toBool());
+  m_ui->m_checkArchiveMessages->setChecked(qApp->settings()->value(GROUP(Database), SETTING(Database::ArchiveMessages)).toBool());
+  m_ui->m_spinArchiveAfterDays->setValue(qApp->settings()->value(GROUP(Database), SETTING(Database::ArchiveAfterDays)).toInt());
+  updateArchiveDaysSuffix(m_ui->m_spinArchiveAfterDays->value());
+  m_ui->m_spinSlowQueryThreshold->setValue(settings()->value(GROUP(Database), SETTING(Database::SlowQueryThreshold)).toInt());
+  loadQueryStatistics();
   m_ui->m_lblMysqlTestResult->setStatus(WidgetWithStatus::Information,  tr("No connection test triggered so far."), tr("You did not executed any connection test yet."));
 
   // Load SQLite.
@@ -184,6 +249,9 @@ void SettingsDatabase::saveSettings() {
   const bool new_inmemory = m_ui->m_checkSqliteUseInMemoryDatabase->isChecked();
 
   qApp->settings()->setValue(GROUP(Database), Database::UseTransactions, m_ui->m_checkUseTransactions->isChecked());
+  qApp->settings()->setValue(GROUP(Database), Database::CompressContents, m_ui->m_checkCompressContents->isChecked());
+  qApp->settings()->setValue(GROUP(Database), Database::ArchiveMessages, m_ui->m_checkArchiveMessages->isChecked());
+  qApp->settings()->setValue(GROUP(Database), Database::ArchiveAfterDays, m_ui->m_spinArchiveAfterDays->value());
 
   // Save data storage settings.
   QString original_db_driver = settings()->value(GROUP(Database), SETTING(Database::ActiveDriver)).toString();
@@ -202,6 +270,8 @@ void SettingsDatabase::saveSettings() {
   }
 
   settings()->setValue(GROUP(Database), Database::ActiveDriver, selected_db_driver);
+  settings()->setValue(GROUP(Database), Database::SlowQueryThreshold, m_ui->m_spinSlowQueryThreshold->value());
+  SqlStatistics::setSlowQueryThreshold(m_ui->m_spinSlowQueryThreshold->value());
 
   if (original_db_driver != selected_db_driver || original_inmemory != new_inmemory) {
     requireRestart();
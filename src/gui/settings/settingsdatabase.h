@@ -45,6 +45,9 @@ class SettingsDatabase : public SettingsPanel {
     void onMysqlDatabaseChanged(const QString &new_database);
     void selectSqlBackend(int index);
     void switchMysqlPasswordVisiblity(bool visible);
+    void loadQueryStatistics();
+    void resetQueryStatistics();
+    void updateArchiveDaysSuffix(int number);
 
     Ui::SettingsDatabase *m_ui;
 };
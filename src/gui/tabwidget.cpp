@@ -213,6 +213,10 @@ int TabWidget::addNewspaperView(RootItem *root, const QList<Message> &messages)
   NewspaperPreviewer *prev = new NewspaperPreviewer(root, messages, this);
 #endif
 
+  // Messages opened from the message list may be archived ones.
+  prev->setReadOnly(sender() == feedMessageViewer()->messagesView() &&
+                    feedMessageViewer()->messagesView()->sourceModel()->showArchived());
+
   int index = addTab(prev, qApp->icons()->fromTheme(QSL("format-justify-fill")), tr("Newspaper view"), TabBar::Closable);
 
   setCurrentIndex(index);
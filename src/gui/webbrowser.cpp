@@ -76,7 +76,7 @@ WebBrowser::WebBrowser(QWidget *parent) : TabContent(parent),
   m_actionBack(m_webView->pageAction(QWebEnginePage::Back)),
   m_actionForward(m_webView->pageAction(QWebEnginePage::Forward)),
   m_actionReload(m_webView->pageAction(QWebEnginePage::Reload)),
-  m_actionStop(m_webView->pageAction(QWebEnginePage::Stop)) {
+  m_actionStop(m_webView->pageAction(QWebEnginePage::Stop)), m_readOnly(false) {
 
   // Initialize the components and layout.
   initializeLayout();
@@ -152,6 +152,10 @@ void WebBrowser::loadMessage(const Message &message, RootItem *root) {
   loadMessages(QList<Message>() << message, root);
 }
 
+void WebBrowser::setReadOnly(bool read_only) {
+  m_readOnly = read_only;
+}
+
 void WebBrowser::receiveMessageStatusChangeRequest(int message_id, WebPage::MessageStatusChange change) {
   switch (change) {
     case WebPage::MarkRead:
@@ -259,7 +263,7 @@ void WebBrowser::onLoadingFinished(bool success) {
 }
 
 void WebBrowser::markMessageAsRead(int id, bool read) {
-  if (!m_root.isNull()) {
+  if (!m_root.isNull() && !m_readOnly) {
     Message *msg = findMessage(id);
 
     if (msg != nullptr && m_root->getParentServiceRoot()->onBeforeSetMessagesRead(m_root.data(),
@@ -279,7 +283,7 @@ void WebBrowser::markMessageAsRead(int id, bool read) {
 }
 
 void WebBrowser::switchMessageImportance(int id, bool checked) {
-  if (!m_root.isNull()) {
+  if (!m_root.isNull() && !m_readOnly) {
     Message *msg = findMessage(id);
 
     if (msg != nullptr && m_root->getParentServiceRoot()->onBeforeSwitchMessageImportance(m_root.data(),
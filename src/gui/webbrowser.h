@@ -67,6 +67,10 @@ class WebBrowser : public TabContent {
     void loadMessages(const QList<Message> &messages, RootItem *root);
     void loadMessage(const Message &message, RootItem *root);
 
+    // Read-only browser (for example for archived messages)
+    // ignores requests to change messages.
+    void setReadOnly(bool read_only);
+
     // Switches visibility of navigation bar.
     inline void setNavigationBarVisible(bool visible) {
       m_toolBar->setVisible(visible);
@@ -117,6 +121,7 @@ class WebBrowser : public TabContent {
 
     QList<Message> m_messages;
     QPointer<RootItem> m_root;
+    bool m_readOnly;
 };
 
 #endif // WEBBROWSER_H
@@ -26,12 +26,22 @@
 #include "gui/webbrowser.h"
 
 #include <QWheelEvent>
+#include <QJsonArray>
+#include <QJsonDocument>
 
 
-WebViewer::WebViewer(QWidget *parent) : QWebEngineView(parent) {
+WebViewer::WebViewer(QWidget *parent)
+  : QWebEngineView(parent), m_messageContents(QString()), m_messages(QList<Message>()),
+    m_renderedMessages(0), m_appendingMessages(false) {
   WebPage *page = new WebPage(this);
 
   connect(page, &WebPage::messageStatusChangeRequested, this, &WebViewer::messageStatusChangeRequested);
+
+#if QT_VERSION >= 0x050700
+  connect(page, &WebPage::scrollPositionChanged, this, &WebViewer::loadMoreMessagesIfNeeded);
+  connect(page, &WebPage::contentsSizeChanged, this, &WebViewer::loadMoreMessagesIfNeeded);
+#endif
+
   setPage(page);
 }
 
@@ -44,6 +54,9 @@ bool WebViewer::canDecreaseZoom() {
 }
 
 void WebViewer::displayMessage() {
+  // Page is built from scratch, other messages are appended while scrolling.
+  m_renderedMessages = initialMessageCount();
+  m_appendingMessages = false;
   setHtml(m_messageContents, QUrl::fromUserInput(INTERNAL_URL_MESSAGE));
 }
 
@@ -80,48 +93,132 @@ bool WebViewer::resetWebPageZoom() {
 }
 
 void WebViewer::loadMessages(const QList<Message> &messages) {
-  Skin skin = qApp->skins()->currentSkin();
+  const Skin skin = qApp->skins()->currentSkin();
+  QString messages_layout = QSL("<div id=\"" NEWSPAPER_CONTAINER_ID "\">");
+
+  m_messages = messages;
+  renderMessages(skin, 0, initialMessageCount(), messages_layout);
+  messages_layout.append(QL1S("</div>"));
+
+  const QString wrapper_arguments[Skin::WrapperSlotCount] = {
+    messages.size() == 1 ? messages.at(0).m_title : tr("Newspaper view"),
+    messages_layout
+  };
+
+  m_messageContents.clear();
+  m_messageContents.reserve(skin.m_layoutMarkupWrapper.literalSize() + messages_layout.size() +
+                            wrapper_arguments[Skin::WrapperTitle].size());
+  skin.m_layoutMarkupWrapper.render(m_messageContents, wrapper_arguments);
+
+  bool previously_enabled = isEnabled();
+
+  setEnabled(false);
+  displayMessage();
+  setEnabled(previously_enabled);
+}
+
+void WebViewer::loadMoreMessagesIfNeeded() {
+#if QT_VERSION >= 0x050700
+  if (m_appendingMessages || m_renderedMessages >= m_messages.size()) {
+    return;
+  }
+
+  const qreal visible_bottom = page()->scrollPosition().y() + height() / zoomFactor();
+
+  if (visible_bottom + NEWSPAPER_PRELOAD_DISTANCE < page()->contentsSize().height()) {
+    return;
+  }
+
+  const int to = qMin(m_messages.size(), m_renderedMessages + NEWSPAPER_BATCH_SIZE);
   QString messages_layout;
-  QString single_message_layout = skin.m_layoutMarkup;
 
-  foreach (const Message &message, messages) {
-    QString enclosures;
-    QString enclosure_images;
+  renderMessages(qApp->skins()->currentSkin(), m_renderedMessages, to, messages_layout);
+
+  // Markup is passed to JavaScript as JSON string literal.
+  const QString script = QString("document.getElementById('%1').insertAdjacentHTML('beforeend', %2[0]);")
+                         .arg(QSL(NEWSPAPER_CONTAINER_ID),
+                              QString::fromUtf8(QJsonDocument(QJsonArray() << messages_layout).toJson(QJsonDocument::Compact)));
+
+  m_renderedMessages = to;
+  m_appendingMessages = true;
+
+  page()->runJavaScript(script, [this](const QVariant &result) {
+    Q_UNUSED(result)
+
+    m_appendingMessages = false;
+
+    // Page might still be too short to be scrolled.
+    loadMoreMessagesIfNeeded();
+  });
+#endif
+}
+
+int WebViewer::initialMessageCount() const {
+#if QT_VERSION >= 0x050700
+  return qMin(m_messages.size(), NEWSPAPER_BATCH_SIZE);
+#else
+  // Page scrolling cannot be observed, render all messages at once.
+  return m_messages.size();
+#endif
+}
+
+void WebViewer::renderMessages(const Skin &skin, int from, int to, QString &output) const {
+  // Obtain everything which is same for all messages only once per render.
+  const QString image_height = qApp->settings()->value(GROUP(Messages), SETTING(Messages::MessageHeadImageHeight)).toString();
+  const QString attachment_title = tr("Attachment");
+  const QString written_by = tr("Written by ");
+  const QString unknown_author = written_by + tr("unknown author");
+  const QString image_mime_prefix = QSL("image/");
+
+  int expected_size = output.size();
+
+  for (int i = from; i < to; i++) {
+    const Message &message = m_messages.at(i);
+
+    expected_size += skin.m_layoutMarkup.literalSize() + message.m_contents.size() + 2 * message.m_title.size() +
+                     message.m_url.size() + message.m_author.size() + 64;
+  }
+
+  QString arguments[Skin::MessageSlotCount];
+  QString enclosure_arguments[Skin::EnclosureSlotCount];
+  QString image_arguments[Skin::EnclosureImageSlotCount];
+
+  enclosure_arguments[Skin::EnclosureTitle] = attachment_title;
+  image_arguments[Skin::EnclosureImageHeight] = image_height;
+  output.reserve(expected_size);
+
+  for (int i = from; i < to; i++) {
+    const Message &message = m_messages.at(i);
+    QString &enclosures = arguments[Skin::MessageEnclosures];
+    QString &enclosure_images = arguments[Skin::MessageEnclosureImages];
+
+    enclosures.clear();
+    enclosure_images.clear();
 
     foreach (const Enclosure &enclosure, message.m_enclosures) {
-      enclosures += skin.m_enclosureMarkup.arg(enclosure.m_url, tr("Attachment"), enclosure.m_mimeType);
+      enclosure_arguments[Skin::EnclosureUrl] = enclosure.m_url;
+      enclosure_arguments[Skin::EnclosureMimeType] = enclosure.m_mimeType;
+      skin.m_enclosureMarkup.render(enclosures, enclosure_arguments);
 
-      if (enclosure.m_mimeType.startsWith(QSL("image/"))) {
+      if (enclosure.m_mimeType.startsWith(image_mime_prefix)) {
         // Add thumbnail image.
-        enclosure_images += skin.m_enclosureImageMarkup.arg(
-                              enclosure.m_url,
-                              enclosure.m_mimeType,
-                              qApp->settings()->value(GROUP(Messages), SETTING(Messages::MessageHeadImageHeight)).toString());
+        image_arguments[Skin::EnclosureImageUrl] = enclosure.m_url;
+        image_arguments[Skin::EnclosureImageMimeType] = enclosure.m_mimeType;
+        skin.m_enclosureImageMarkup.render(enclosure_images, image_arguments);
       }
     }
 
-    messages_layout.append(single_message_layout
-                           .arg(message.m_title,
-                                tr("Written by ") + (message.m_author.isEmpty() ?
-                                                       tr("unknown author") :
-                                                       message.m_author),
-                                message.m_url,
-                                message.m_contents,
-                                message.m_created.toString(Qt::DefaultLocaleShortDate),
-                                enclosures,
-                                message.m_isRead ? "mark-unread" : "mark-read",
-                                message.m_isImportant ? "mark-unstarred" : "mark-starred",
-                                QString::number(message.m_id))
-                           .arg(enclosure_images));
-  }
-
-  m_messageContents = skin.m_layoutMarkupWrapper.arg(messages.size() == 1 ? messages.at(0).m_title : tr("Newspaper view"),
-                                                     messages_layout);
-  bool previously_enabled = isEnabled();
+    arguments[Skin::MessageTitle] = message.m_title;
+    arguments[Skin::MessageAuthor] = message.m_author.isEmpty() ? unknown_author : written_by + message.m_author;
+    arguments[Skin::MessageUrl] = message.m_url;
+    arguments[Skin::MessageContents] = message.m_contents;
+    arguments[Skin::MessageCreated] = message.m_created.toString(Qt::DefaultLocaleShortDate);
+    arguments[Skin::MessageReadAction] = message.m_isRead ? QSL("mark-unread") : QSL("mark-read");
+    arguments[Skin::MessageImportantAction] = message.m_isImportant ? QSL("mark-unstarred") : QSL("mark-starred");
+    arguments[Skin::MessageId] = QString::number(message.m_id);
 
-  setEnabled(false);
-  displayMessage();
-  setEnabled(previously_enabled);
+    skin.m_layoutMarkup.render(output, arguments);
+  }
 }
 
 void WebViewer::loadMessage(const Message &message) {
@@ -131,6 +228,9 @@ void WebViewer::loadMessage(const Message &message) {
 void WebViewer::clear() {
   bool previously_enabled = isEnabled();
 
+  m_messages.clear();
+  m_renderedMessages = 0;
+
   setEnabled(false);
   setHtml("<!DOCTYPE html><html><body</body></html>", QUrl(INTERNAL_URL_BLANK));
   setEnabled(previously_enabled);
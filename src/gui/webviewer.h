@@ -24,6 +24,8 @@
 #include "network-web/webpage.h"
 
 
+struct Skin;
+
 class WebViewer : public QWebEngineView {
     Q_OBJECT
 
@@ -48,6 +50,11 @@ class WebViewer : public QWebEngineView {
     void loadMessage(const Message &message);
     void clear();
 
+  private slots:
+    // Appends next batch of messages to newspaper view
+    // if user scrolled close to its end.
+    void loadMoreMessagesIfNeeded();
+
   protected:
     QWebEngineView *createWindow(QWebEnginePage::WebWindowType type);
     void wheelEvent(QWheelEvent *event);
@@ -56,7 +63,16 @@ class WebViewer : public QWebEngineView {
     void messageStatusChangeRequested(int message_id, WebPage::MessageStatusChange change);
 
   private:
+    // Number of messages rendered when page is (re)loaded.
+    int initialMessageCount() const;
+
+    // Appends messages in given range rendered with given skin to output.
+    void renderMessages(const Skin &skin, int from, int to, QString &output) const;
+
     QString m_messageContents;
+    QList<Message> m_messages;
+    int m_renderedMessages;
+    bool m_appendingMessages;
 };
 
 #endif // WEBVIEWER_H
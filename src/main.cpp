@@ -21,6 +21,7 @@
 #include "miscellaneous/debugging.h"
 #include "miscellaneous/iconfactory.h"
 #include "miscellaneous/feedreader.h"
+#include "miscellaneous/headlessupdater.h"
 #include "dynamic-shortcuts/dynamicshortcuts.h"
 #include "gui/dialogs/formmain.h"
 #include "gui/feedmessageviewer.h"
@@ -28,6 +29,7 @@
 #include "gui/messagebox.h"
 #include "network-web/silentnetworkaccessmanager.h"
 #include "network-web/webfactory.h"
+#include "services/abstract/serviceroot.h"
 
 // Needed for setting ini file format on Mac OS.
 #ifdef Q_OS_MAC
@@ -40,17 +42,75 @@
 #include <QTimer>
 
 
+// Updates feeds once without GUI and quits, no display server is needed.
+static int runHeadless(int &argc, char *argv[], int account_id, int thread_count) {
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+  }
+
+  Application application(APP_LOW_NAME, argc, argv);
+
+  // Do not touch database which is used by another running instance.
+  if (application.isRunning()) {
+    qWarning("Another instance of the application is already running. Headless update is not possible.");
+    return EXIT_FAILURE;
+  }
+
+  Application::setApplicationName(APP_NAME);
+  Application::setApplicationVersion(APP_VERSION);
+  Application::setOrganizationName(APP_AUTHOR);
+  Application::setOrganizationDomain(APP_URL);
+
+  application.setFeedReader(new FeedReader(&application));
+  qApp->feedReader()->feedsModel()->loadActivatedServiceAccounts();
+
+  HeadlessUpdater updater;
+
+  if (!updater.start(account_id, thread_count)) {
+    return EXIT_FAILURE;
+  }
+
+  return Application::exec();
+}
+
 int main(int argc, char *argv[]) {
+  Debugging::logStartupStage(QSL("process started"));
+
+  bool headless = false;
+  bool update_all = false;
+  int account_id = -1;
+  int thread_count = FEED_DOWNLOADER_MAX_THREADS;
+
   for (int i = 0; i < argc; i++) {
     const QString str = QString::fromLocal8Bit(argv[i]);
 
     if (str == "-h") {
       qDebug("Usage: rssguard [OPTIONS]\n\n"
-             "Option\t\tMeaning\n"
-             "-h\t\tDisplays this help.");
+             "Option\t\t\tMeaning\n"
+             "-h\t\t\tDisplays this help.\n"
+             "--headless --update-all\tUpdates feeds without GUI, prints statistics as JSON and quits.\n"
+             "--account N\t\tUpdates only feeds of account with ID N (headless mode only).\n"
+             "--threads N\t\tDownloads N feeds in parallel (headless mode only).");
 
       return EXIT_SUCCESS;
     }
+    else if (str == APP_HEADLESS) {
+      headless = true;
+    }
+    else if (str == APP_UPDATE_ALL) {
+      update_all = true;
+    }
+    else if (str == APP_ACCOUNT && i + 1 < argc) {
+      account_id = QString::fromLocal8Bit(argv[++i]).toInt();
+    }
+    else if (str == APP_THREADS && i + 1 < argc) {
+      thread_count = qMax(1, QString::fromLocal8Bit(argv[++i]).toInt());
+    }
+  }
+
+  if (headless && !update_all) {
+    qWarning("Headless mode requires '%s' option.", APP_UPDATE_ALL);
+    return EXIT_FAILURE;
   }
 
   //: Abbreviation of language, e.g. en.
@@ -66,9 +126,20 @@ int main(int argc, char *argv[]) {
   // Setup debug output system.
   qInstallMessageHandler(Debugging::debugHandler);
 
+  // Register needed metatypes.
+  qRegisterMetaType<QList<Message> >("QList<Message>");
+  qRegisterMetaType<QList<RootItem*> >("QList<RootItem*>");
+  qRegisterMetaType<RootItem*>("RootItem*");
+  qRegisterMetaType<MessageCounts>("MessageCounts");
+
+  if (headless) {
+    return runHeadless(argc, argv, account_id, thread_count);
+  }
+
   // Instantiate base application object.
   Application application(APP_LOW_NAME, argc, argv);
   qDebug("Instantiated Application class.");
+  Debugging::logStartupStage(QSL("application instantiated"));
 
   // Check if another instance is running.
   if (application.sendMessage((QStringList() << APP_IS_RUNNING << application.arguments().mid(1)).join(ARGUMENTS_LIST_SEPARATOR))) {
@@ -84,10 +155,6 @@ int main(int argc, char *argv[]) {
   QApplication::setAttribute(Qt::AA_UseHighDpiPixmaps);
   QApplication::setAttribute(Qt::AA_EnableHighDpiScaling);
 
-  // Register needed metatypes.
-  qRegisterMetaType<QList<Message> >("QList<Message>");
-  qRegisterMetaType<QList<RootItem*> >("QList<RootItem*>");
-
   // Just call this instance, so that is is created in main GUI thread.
   WebFactory::instance();
 
@@ -104,8 +171,11 @@ int main(int argc, char *argv[]) {
   Application::setOrganizationDomain(APP_URL);
   Application::setWindowIcon(QIcon(APP_ICON_PATH));
 
+  Debugging::logStartupStage(QSL("icon theme and skin loaded"));
+
   // Load activated accounts.
   qApp->feedReader()->feedsModel()->loadActivatedServiceAccounts();
+  Debugging::logStartupStage(QSL("accounts loaded"));
 
   // Setup single-instance behavior.
   QObject::connect(&application, &Application::messageReceived, &application, &Application::processExecutionMessage);
@@ -118,6 +188,8 @@ int main(int argc, char *argv[]) {
   // Set correct information for main window.
   main_window.setWindowTitle(APP_LONG_NAME);
 
+  Debugging::logStartupStage(QSL("main window created"));
+
   // Now is a good time to initialize dynamic keyboard shortcuts.
   DynamicShortcuts::load(qApp->userActions());
 
@@ -150,6 +222,7 @@ int main(int argc, char *argv[]) {
   }
 
   qApp->mainForm()->tabWidget()->feedMessageViewer()->feedsView()->loadAllExpandStates();
+  Debugging::logStartupStage(QSL("main window shown"));
 
   // Enter global event loop.
   return Application::exec();
@@ -21,6 +21,7 @@
 #include "miscellaneous/iofactory.h"
 #include "miscellaneous/mutex.h"
 #include "miscellaneous/feedreader.h"
+#include "miscellaneous/databasecleaner.h"
 #include "gui/feedsview.h"
 #include "gui/feedmessageviewer.h"
 #include "gui/messagebox.h"
@@ -45,7 +46,7 @@
 
 Application::Application(const QString &id, int &argc, char **argv)
   : QtSingleApplication(id, argc, argv),
-    m_feedReader(nullptr),
+    m_feedReader(nullptr), m_headless(false),
     m_updateFeedsLock(nullptr), m_userActions(QList<QAction*>()), m_mainForm(nullptr),
     m_trayIcon(nullptr), m_settings(nullptr), m_system(nullptr), m_skins(nullptr),
     m_localization(nullptr), m_icons(nullptr), m_database(nullptr), m_downloadManager(nullptr) {
@@ -53,9 +54,13 @@ Application::Application(const QString &id, int &argc, char **argv)
   connect(this, SIGNAL(commitDataRequest(QSessionManager&)), this, SLOT(onCommitData(QSessionManager&)));
   connect(this, SIGNAL(saveStateRequest(QSessionManager&)), this, SLOT(onSaveState(QSessionManager&)));
 
+  m_headless = arguments().contains(QSL(APP_HEADLESS));
+
 #if defined(USE_WEBENGINE)
-  connect(QWebEngineProfile::defaultProfile(), &QWebEngineProfile::downloadRequested,
-          this, &Application::downloadRequested);
+  if (!m_headless) {
+    connect(QWebEngineProfile::defaultProfile(), &QWebEngineProfile::downloadRequested,
+            this, &Application::downloadRequested);
+  }
 #endif
 }
 
@@ -67,6 +72,10 @@ FeedReader *Application::feedReader() {
   return m_feedReader;
 }
 
+bool Application::isHeadless() const {
+  return m_headless;
+}
+
 QList<QAction*> Application::userActions() {
   if (m_mainForm != nullptr && m_userActions.isEmpty()) {
     m_userActions = m_mainForm->allActions();
@@ -215,12 +224,11 @@ void Application::backupDatabaseSettings(bool backup_database, bool backup_setti
   if (backup_database &&
       (database()->activeDatabaseDriver() == DatabaseFactory::SQLITE ||
        database()->activeDatabaseDriver() == DatabaseFactory::SQLITE_MEMORY)) {
-    // We need to save the database first.
+    // We need to save the database first. Database file is then copied in small steps
+    // in the background, see DatabaseCleaner::backupProgress() and backupFinished().
     database()->saveDatabase();
-
-    if (!IOFactory::copyFile(database()->sqliteDatabaseFilePath(), target_path + QDir::separator() + backup_name + BACKUP_SUFFIX_DATABASE)) {
-      throw ApplicationException(tr("Database file not copied to output directory successfully."));
-    }
+    QMetaObject::invokeMethod(feedReader()->databaseCleaner(), "backupDatabase",
+                              Q_ARG(QString, target_path), Q_ARG(QString, backup_name));
   }
 }
 
@@ -302,7 +310,10 @@ void Application::showGuiMessage(const QString &title, const QString &message,
                                  QSystemTrayIcon::MessageIcon message_type, QWidget *parent,
                                  bool show_at_least_msgbox, QObject *invokation_target,
                                  const char *invokation_slot) {
-  if (SystemTrayIcon::areNotificationsEnabled() && SystemTrayIcon::isSystemTrayActivated()) {
+  if (m_headless) {
+    qDebug("Headless mode, not showing GUI message '%s': '%s'.", qPrintable(title), qPrintable(message));
+  }
+  else if (SystemTrayIcon::areNotificationsEnabled() && SystemTrayIcon::isSystemTrayActivated()) {
     trayIcon()->showMessage(title, message, message_type, TRAY_ICON_BUBBLE_TIMEOUT, invokation_target, invokation_slot);
   }
   else if (show_at_least_msgbox) {
@@ -329,8 +340,12 @@ void Application::onSaveState(QSessionManager &manager) {
 }
 
 void Application::onAboutToQuit() {
-  eliminateFirstRun();
-  eliminateFirstRun(APP_VERSION);
+  // Headless run does not show anything, so first-run
+  // tasks are left for next start of GUI.
+  if (!isHeadless()) {
+    eliminateFirstRun();
+    eliminateFirstRun(APP_VERSION);
+  }
 
   // Make sure that we obtain close lock BEFORE even trying to quit the application.
   const bool locked_safely = feedUpdateLock()->tryLock(4 * CLOSE_LOCK_TIMEOUT);
@@ -59,6 +59,10 @@ class Application : public QtSingleApplication {
     FeedReader *feedReader();
     void setFeedReader(FeedReader *feed_reader);
 
+    // Returns true if application was started with "--headless",
+    // in that case no GUI is constructed and no GUI messages are shown.
+    bool isHeadless() const;
+
     // Globally accessible actions.
     QList<QAction*> userActions();
 
@@ -86,6 +90,7 @@ class Application : public QtSingleApplication {
 
     void setMainForm(FormMain *main_form);
 
+    // Settings are copied right away, database is backed up asynchronously.
     void backupDatabaseSettings(bool backup_database, bool backup_settings,
                                 const QString &target_path, const QString &backup_name);
     void restoreDatabaseSettings(bool restore_database, bool restore_settings,
@@ -129,6 +134,7 @@ class Application : public QtSingleApplication {
     void eliminateFirstRun(const QString &version);
 
     FeedReader *m_feedReader;
+    bool m_headless;
 
     // This read-write lock is used by application on its close.
     // Application locks this lock for WRITING.
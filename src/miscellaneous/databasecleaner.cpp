@@ -19,87 +19,295 @@
 
 #include "miscellaneous/application.h"
 #include "miscellaneous/databasequeries.h"
+#include "miscellaneous/sqlitebackup.h"
 
 #include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
 #include <QThread>
 
 
-DatabaseCleaner::DatabaseCleaner(QObject *parent) : QObject(parent) {
+DatabaseCleaner::DatabaseCleaner(QObject *parent) : QObject(parent), m_cancelRequested(0) {
 }
 
 DatabaseCleaner::~DatabaseCleaner() {
 }
 
+void DatabaseCleaner::cancelPurge() {
+  m_cancelRequested.storeRelease(1);
+}
+
 void DatabaseCleaner::purgeDatabaseData(const CleanerOrders &which_data) {
   qDebug().nospace() << "Performing database cleanup in thread: \'" << QThread::currentThreadId() << "\'.";
 
+  m_cancelRequested.storeRelease(0);
+
   // Inform everyone about the start of the process.
   emit purgeStarted();
 
   bool result = true;
-  const int difference = 99 / 8;
-  int progress = 0;
+  const bool shrink = which_data.m_shrinkDatabase && !which_data.m_dryRun;
+  const bool measure_contents = which_data.m_convertContents || which_data.m_dryRun;
+  const int max_progress = shrink ? 90 : 100;
+  const int purge_progress = measure_contents ? max_progress / 2 : max_progress;
   QSqlDatabase database = qApp->database()->connection(metaObject()->className(), DatabaseFactory::FromSettings);
+  const QString condition = DatabaseQueries::purgeMessagesCondition(which_data);
 
-  if (which_data.m_removeReadMessages) {
-    progress += difference;
-    emit purgeProgress(progress, tr("Removing read messages..."));
+  if (!condition.isEmpty()) {
+    emit purgeProgress(0, tr("Counting messages to remove..."));
 
-    // Remove read messages.
-    result &= purgeReadMessages(database);
+    const int total_count = DatabaseQueries::countMessagesToPurge(database, condition, &result);
+
+    if (which_data.m_dryRun) {
+      emit purgeEstimated(total_count);
+    }
+    else if (result) {
+      result = purgeMessages(database, condition, total_count, purge_progress);
+    }
+  }
 
-    progress += difference;
-    emit purgeProgress(progress, tr("Read messages purged..."));
+  if (result && measure_contents && m_cancelRequested.loadAcquire() == 0) {
+    result = convertContents(database, which_data.m_convertContents, which_data.m_dryRun, purge_progress, max_progress);
   }
 
-  if (which_data.m_removeRecycleBin) {
-    progress += difference;
-    emit purgeProgress(progress, tr("Purging recycle bin..."));
+  if (result && shrink && m_cancelRequested.loadAcquire() == 0) {
+    emit purgeProgress(max_progress, tr("Shrinking database file..."));
 
-    // Remove read messages.
-    result &= purgeRecycleBin(database);
+    // Remove icons which are not used by any feed or category
+    // and release free pages of database file.
+    result &= DatabaseQueries::purgeUnusedIcons(database);
+    result &= shrinkDatabase(database, max_progress);
 
-    progress += difference;
-    emit purgeProgress(progress, tr("Recycle bin purged..."));
+    emit purgeProgress(100, tr("Database file shrinked..."));
   }
 
-  if (which_data.m_removeOldMessages) {
-    progress += difference;
-    emit purgeProgress(progress, tr("Removing old messages..."));
+  emit purgeFinished(result);
+}
+
+void DatabaseCleaner::archiveMessages(int archive_after_days) {
+  qDebug().nospace() << "Archiving messages in thread: \'" << QThread::currentThreadId() << "\'.";
+
+  m_cancelRequested.storeRelease(0);
 
-    // Remove old messages.
-    result &= purgeOldMessages(database, which_data.m_barrierForRemovingOldMessagesInDays);
+  QSqlDatabase database = qApp->database()->connection(metaObject()->className(), DatabaseFactory::FromSettings);
+  const QString condition = DatabaseQueries::archiveMessagesCondition(archive_after_days);
+  int last_id = 0;
+  int archived_count = 0;
+  bool result = true;
+
+  while (m_cancelRequested.loadAcquire() == 0) {
+    const int chunk_count = DatabaseQueries::archiveMessagesChunk(database, condition, ARCHIVE_CHUNK_SIZE, &last_id, &result);
+
+    if (!result || chunk_count == 0) {
+      break;
+    }
+
+    archived_count += chunk_count;
 
-    progress += difference;
-    emit purgeProgress(progress, tr("Old messages purged..."));
+    // Feed updates must not wait for the archiving.
+    QThread::msleep(PURGE_CHUNK_PAUSE);
   }
 
-  if (which_data.m_shrinkDatabase) {
-    progress += difference;
-    emit purgeProgress(progress, tr("Shrinking database file..."));
+  qDebug("Database cleaner archived %d messages, cancelled: %d.", archived_count, m_cancelRequested.loadAcquire());
+  emit archiveFinished(result, archived_count);
+}
+
+void DatabaseCleaner::releaseFreePages(int max_pages) {
+  if (qApp->database()->activeDatabaseDriver() != DatabaseFactory::SQLITE) {
+    // In-memory database is shrinked when it is saved, MySQL does it itself.
+    return;
+  }
 
-    // Call driver-specific vacuuming function.
-    result &= qApp->database()->vacuumDatabase();
+  m_cancelRequested.storeRelease(0);
 
-    progress += difference;
-    emit purgeProgress(progress, tr("Database file shrinked..."));
+  QSqlDatabase database = qApp->database()->connection(metaObject()->className(), DatabaseFactory::FromSettings);
+  int released_count = 0;
+  int free_pages = qApp->database()->sqliteIncrementalVacuum(database, 0);
+
+  while (free_pages > 0 && released_count < max_pages && m_cancelRequested.loadAcquire() == 0) {
+    const int chunk_pages = qMin(VACUUM_CHUNK_PAGES, max_pages - released_count);
+
+    free_pages = qApp->database()->sqliteIncrementalVacuum(database, chunk_pages);
+    released_count += chunk_pages;
+
+    // Feed updates must not wait for the vacuum.
+    QThread::msleep(PURGE_CHUNK_PAUSE);
   }
 
-  emit purgeFinished(result);
+  qDebug("Database cleaner released free pages in budget of %d pages, %d free pages remain.", max_pages, free_pages);
 }
 
-bool DatabaseCleaner::purgeStarredMessages(const QSqlDatabase &database) {  
-  return DatabaseQueries::purgeImportantMessages(database);
+void DatabaseCleaner::backupDatabase(const QString &target_path, const QString &backup_name) {
+  qDebug().nospace() << "Backing up database in thread: \'" << QThread::currentThreadId() << "\'.";
+
+  m_cancelRequested.storeRelease(0);
+
+  const QString target_database_file = target_path + QDir::separator() + backup_name + BACKUP_SUFFIX_DATABASE;
+  const QString target_archive_file = target_path + QDir::separator() + backup_name + BACKUP_SUFFIX_ARCHIVE;
+  const QString archive_file = qApp->database()->sqliteArchiveFilePath();
+  const bool backup_archive = QFile::exists(archive_file);
+  QSqlDatabase database;
+  QString error_string;
+
+  if (qApp->database()->activeDatabaseDriver() == DatabaseFactory::SQLITE) {
+    // Files are used by this connection, so it can keep them unchanged while they are copied.
+    database = qApp->database()->connection(metaObject()->className(), DatabaseFactory::FromSettings);
+  }
+
+  bool result = backupFile(qApp->database()->sqliteDatabaseFilePath(), target_database_file,
+                           database, QSL("main"), 0, backup_archive ? 80 : 100, &error_string);
+
+  if (result && backup_archive) {
+    result = backupFile(archive_file, target_archive_file, database, QSL(APP_DB_SQLITE_ARCHIVE_NAME),
+                        80, 100, &error_string);
+  }
+
+  if (!result) {
+    // Do not leave incomplete backup behind.
+    QFile::remove(target_database_file);
+    QFile::remove(target_archive_file);
+  }
+
+  emit backupFinished(result, error_string);
+}
+
+bool DatabaseCleaner::purgeMessages(QSqlDatabase database, const QString &condition, int total_count, int max_progress) {
+  int last_id = 0;
+  int removed_count = 0;
+
+  emit purgeProgress(0, tr("Removing messages (%1 of %2)...").arg(QString::number(removed_count), QString::number(total_count)));
+
+  while (m_cancelRequested.loadAcquire() == 0) {
+    bool ok;
+    const int chunk_count = DatabaseQueries::purgeMessagesChunk(database, condition, PURGE_CHUNK_SIZE, &last_id, &ok);
+
+    if (!ok) {
+      return false;
+    }
+    else if (chunk_count == 0) {
+      break;
+    }
+
+    // Messages may appear during the purge, do not overflow.
+    removed_count += chunk_count;
+    total_count = qMax(total_count, removed_count);
+
+    emit purgeProgress(int(qint64(max_progress) * removed_count / total_count),
+                       tr("Removing messages (%1 of %2)...").arg(QString::number(removed_count), QString::number(total_count)));
+
+    // Give other connections chance to write into database.
+    QThread::msleep(PURGE_CHUNK_PAUSE);
+  }
+
+  qDebug("Database cleaner removed %d messages, cancelled: %d.", removed_count, m_cancelRequested.loadAcquire());
+  return true;
 }
 
-bool DatabaseCleaner::purgeReadMessages(const QSqlDatabase &database) {  
-  return DatabaseQueries::purgeReadMessages(database);
+bool DatabaseCleaner::convertContents(QSqlDatabase database, bool convert, bool dry_run, int min_progress, int max_progress) {
+  const bool compress = qApp->settings()->value(GROUP(Database), SETTING(Database::CompressContents)).toBool();
+  const MessageContents::Conversion conversion = !convert ? MessageContents::NoConversion :
+                                                 (compress ? MessageContents::Compress : MessageContents::Decompress);
+  const QString description = conversion == MessageContents::NoConversion ? tr("Measuring contents of messages (%1 of %2)...") :
+                              (compress ? tr("Compressing contents of messages (%1 of %2)...") :
+                                          tr("Decompressing contents of messages (%1 of %2)..."));
+  MessageContentsStatistics statistics;
+  int last_id = 0;
+  int processed_count = 0;
+  bool ok;
+  int total_count = DatabaseQueries::countAllMessages(database, &ok);
+
+  if (!ok) {
+    return false;
+  }
+
+  emit purgeProgress(min_progress, description.arg(QString::number(processed_count), QString::number(total_count)));
+
+  while (m_cancelRequested.loadAcquire() == 0) {
+    const int chunk_count = DatabaseQueries::convertMessageContentsChunk(database, conversion, dry_run, PURGE_CHUNK_SIZE,
+                                                                         &last_id, &statistics, &ok);
+
+    if (!ok) {
+      return false;
+    }
+    else if (chunk_count == 0) {
+      break;
+    }
+
+    processed_count += chunk_count;
+    total_count = qMax(total_count, processed_count);
+
+    emit purgeProgress(min_progress + int(qint64(max_progress - min_progress) * processed_count / total_count),
+                       description.arg(QString::number(processed_count), QString::number(total_count)));
+
+    if (!dry_run) {
+      QThread::msleep(PURGE_CHUNK_PAUSE);
+    }
+  }
+
+  qDebug("Database cleaner processed contents of %d messages, %d of them are compressed, stored size is %lld bytes, plain size is %lld bytes.",
+         statistics.m_messagesCount, statistics.m_compressedCount, statistics.m_storedSize, statistics.m_plainSize);
+
+  if (m_cancelRequested.loadAcquire() == 0) {
+    emit contentsMeasured(statistics.m_messagesCount, statistics.m_compressedCount, statistics.m_storedSize, statistics.m_plainSize);
+  }
+
+  return true;
 }
 
-bool DatabaseCleaner::purgeOldMessages(const QSqlDatabase &database, int days) {
-  return DatabaseQueries::purgeOldMessages(database, days);
+bool DatabaseCleaner::shrinkDatabase(QSqlDatabase database, int min_progress) {
+  int free_pages = qApp->database()->activeDatabaseDriver() == DatabaseFactory::SQLITE ?
+                   qApp->database()->sqliteIncrementalVacuum(database, 0) : -1;
+
+  if (free_pages < 0) {
+    // Database file cannot be shrinked incrementally (yet).
+    return qApp->database()->vacuumDatabase();
+  }
+
+  const int total_pages = qMax(free_pages, 1);
+
+  while (free_pages > 0 && m_cancelRequested.loadAcquire() == 0) {
+    free_pages = qApp->database()->sqliteIncrementalVacuum(database, VACUUM_CHUNK_PAGES);
+
+    if (free_pages < 0) {
+      return false;
+    }
+
+    emit purgeProgress(min_progress + (100 - min_progress) * qMax(total_pages - free_pages, 0) / total_pages,
+                       tr("Shrinking database file (%n free page(s) left)...", 0, free_pages));
+
+    // Give other connections chance to write into database.
+    QThread::msleep(PURGE_CHUNK_PAUSE);
+  }
+
+  return true;
 }
 
-bool DatabaseCleaner::purgeRecycleBin(const QSqlDatabase &database) {
-  return DatabaseQueries::purgeRecycleBin(database);
+bool DatabaseCleaner::backupFile(const QString &source_file_path, const QString &target_file_path,
+                                 QSqlDatabase database, const QString &schema,
+                                 int min_progress, int max_progress, QString *error_string) {
+  const QString description = tr("Backing up file '%1' (%2 %)...").arg(QFileInfo(source_file_path).fileName());
+  SqliteBackup backup(source_file_path, target_file_path, database, schema);
+
+  emit backupProgress(min_progress, description.arg(0));
+
+  while (!backup.isFinished()) {
+    if (m_cancelRequested.loadAcquire() != 0) {
+      *error_string = tr("Backup was cancelled.");
+      return false;
+    }
+    else if (!backup.step(BACKUP_STEP_PAGES)) {
+      *error_string = backup.errorString();
+      return false;
+    }
+
+    emit backupProgress(min_progress + (max_progress - min_progress) * backup.progress() / 100, description.arg(backup.progress()));
+
+    if (!backup.isFinished()) {
+      // Database stays unlocked between steps, so feed updates can write into it.
+      QThread::msleep(PURGE_CHUNK_PAUSE);
+    }
+  }
+
+  return true;
 }
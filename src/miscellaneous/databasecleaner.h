@@ -21,6 +21,7 @@
 #include <QObject>
 
 #include <QSqlDatabase>
+#include <QAtomicInt>
 
 
 struct CleanerOrders {
@@ -30,6 +31,13 @@ struct CleanerOrders {
   bool m_removeRecycleBin;
   bool m_removeStarredMessages;
   int m_barrierForRemovingOldMessagesInDays;
+
+  // Convert contents of messages to the form selected in settings.
+  bool m_convertContents;
+
+  // Only count messages which would be removed and measure
+  // how contents of messages are (or would be) stored.
+  bool m_dryRun;
 };
 
 class DatabaseCleaner : public QObject {
@@ -40,19 +48,57 @@ class DatabaseCleaner : public QObject {
     explicit DatabaseCleaner(QObject *parent = 0);
     virtual ~DatabaseCleaner();
 
+    // Asks running purge to stop after current chunk of messages,
+    // messages removed so far stay removed.
+    // NOTE: This is thread-safe and can be called from any thread.
+    void cancelPurge();
+
   signals:
     void purgeStarted();
     void purgeProgress(int progress, const QString &description);
+    void purgeEstimated(int messages_count);
+    void contentsMeasured(int messages_count, int compressed_count, qint64 stored_size, qint64 plain_size);
+    void archiveFinished(bool result, int archived_count);
+    void backupProgress(int progress, const QString &description);
+    void backupFinished(bool result, const QString &error_string);
     void purgeFinished(bool result);
 
   public slots:
     void purgeDatabaseData(const CleanerOrders &which_data);
 
+    // Moves read messages older than given number of days into archive,
+    // it is meant to be run periodically in the background.
+    void archiveMessages(int archive_after_days);
+
+    // Releases at most given number of free pages of SQLite database
+    // file, it is meant to be run periodically in the background.
+    void releaseFreePages(int max_pages);
+
+    // Copies SQLite database and archive into target path in small steps,
+    // so that feed updates can write into database meanwhile.
+    void backupDatabase(const QString &target_path, const QString &backup_name);
+
   private:
-    bool purgeStarredMessages(const QSqlDatabase &database);
-    bool purgeReadMessages(const QSqlDatabase &database);
-    bool purgeOldMessages(const QSqlDatabase &database, int days);
-    bool purgeRecycleBin(const QSqlDatabase &database);
+    // Removes messages in small chunks so that database is not
+    // locked for long time, progress is reported in range <0, max_progress>.
+    bool purgeMessages(QSqlDatabase database, const QString &condition, int total_count, int max_progress);
+
+    // Walks all messages and compresses/decompresses their contents as set in settings,
+    // progress is reported in range <min_progress, max_progress>.
+    bool convertContents(QSqlDatabase database, bool convert, bool dry_run, int min_progress, int max_progress);
+
+    // Releases free pages of SQLite database file in small chunks, falls back to full vacuum
+    // if database file does not allow it, progress is reported in range <min_progress, 100>.
+    bool shrinkDatabase(QSqlDatabase database, int min_progress);
+
+    // Copies single database file, progress is reported in range <min_progress, max_progress>.
+    // If given, "database" keeps "schema" (file attached to it) unchanged during copying,
+    // see SqliteBackup.
+    bool backupFile(const QString &source_file_path, const QString &target_file_path,
+                    QSqlDatabase database, const QString &schema,
+                    int min_progress, int max_progress, QString *error_string);
+
+    QAtomicInt m_cancelRequested;
 };
 
 #endif // DATABASECLEANER_H
@@ -20,10 +20,12 @@
 #include "miscellaneous/iofactory.h"
 #include "miscellaneous/application.h"
 #include "miscellaneous/textfactory.h"
+#include "miscellaneous/databasequeries.h"
+#include "miscellaneous/sqlquery.h"
+#include "miscellaneous/sqlitebackup.h"
 #include "gui/messagebox.h"
 
 #include <QDir>
-#include <QSqlQuery>
 #include <QSqlError>
 #include <QVariant>
 
@@ -53,7 +55,7 @@ qint64 DatabaseFactory::getDatabaseDataSize() const {
   if (m_activeDatabaseDriver == SQLITE || m_activeDatabaseDriver == SQLITE_MEMORY) {
     QSqlDatabase database = qApp->database()->connection(metaObject()->className(), DatabaseFactory::FromSettings);
     qint64 result = 1;
-    QSqlQuery query(database);
+    SqlQuery query(database, Q_FUNC_INFO);
 
     if (query.exec(QSL("PRAGMA page_count;"))) {
       query.next();
@@ -76,7 +78,7 @@ qint64 DatabaseFactory::getDatabaseDataSize() const {
   else if (m_activeDatabaseDriver == MYSQL) {
     QSqlDatabase database = qApp->database()->connection(metaObject()->className(), DatabaseFactory::FromSettings);
     qint64 result = 1;
-    QSqlQuery query(database);
+    SqlQuery query(database, Q_FUNC_INFO);
 
     if (query.exec("SELECT Round(Sum(data_length + index_length), 1) "
                    "FROM information_schema.tables "
@@ -107,7 +109,7 @@ DatabaseFactory::MySQLError DatabaseFactory::mysqlTestConnection(const QString &
   database.setDatabaseName(w_database);
 
   if (database.open() && !database.lastError().isValid()) {
-    QSqlQuery query(QSL("SELECT version();"), database);
+    SqlQuery query(QSL("SELECT version();"), database, Q_FUNC_INFO);
 
     if (!query.lastError().isValid() && query.next()) {
       qDebug("Checked MySQL database, version is '%s'.", qPrintable(query.value(0).toString()));
@@ -156,10 +158,23 @@ QString DatabaseFactory::mysqlInterpretErrorCode(MySQLError error_code) const {
 bool DatabaseFactory::initiateRestoration(const QString &database_backup_file_path) {
   switch (m_activeDatabaseDriver) {
     case SQLITE:
-    case SQLITE_MEMORY:
+    case SQLITE_MEMORY: {
+      // Archive is restored too if it was backed up together with the database.
+      QString archive_backup_file_path = database_backup_file_path;
+
+      archive_backup_file_path.chop(QString(BACKUP_SUFFIX_DATABASE).size());
+      archive_backup_file_path += BACKUP_SUFFIX_ARCHIVE;
+
+      if (database_backup_file_path.endsWith(BACKUP_SUFFIX_DATABASE) && QFile::exists(archive_backup_file_path) &&
+          !IOFactory::copyFile(archive_backup_file_path,
+                               m_sqliteDatabaseFilePath + QDir::separator() + BACKUP_NAME_DATABASE + BACKUP_SUFFIX_ARCHIVE)) {
+        return false;
+      }
+
       return IOFactory::copyFile(database_backup_file_path,
                                  m_sqliteDatabaseFilePath + QDir::separator() +
                                  BACKUP_NAME_DATABASE + BACKUP_SUFFIX_DATABASE);
+    }
 
     default:
       return false;
@@ -172,11 +187,15 @@ void DatabaseFactory::finishRestoration() {
   }
 
   const QString backup_database_file = m_sqliteDatabaseFilePath + QDir::separator() + BACKUP_NAME_DATABASE + BACKUP_SUFFIX_DATABASE;
+  const QString backup_archive_file = m_sqliteDatabaseFilePath + QDir::separator() + BACKUP_NAME_DATABASE + BACKUP_SUFFIX_ARCHIVE;
 
   if (QFile::exists(backup_database_file)) {
     qWarning("Backup database file '%s' was detected. Restoring it.", qPrintable(QDir::toNativeSeparators(backup_database_file)));
 
-    if (IOFactory::copyFile(backup_database_file, m_sqliteDatabaseFilePath + QDir::separator() + APP_DB_SQLITE_FILE)) {
+    // Database is not opened yet, so all pages are copied at once.
+    SqliteBackup backup(backup_database_file, sqliteDatabaseFilePath());
+
+    if (backup.step(-1)) {
       QFile::remove(backup_database_file);
       qDebug("Database file was restored successully.");
     }
@@ -184,6 +203,18 @@ void DatabaseFactory::finishRestoration() {
       qCritical("Database file was NOT restored due to error when copying the file.");
     }
   }
+
+  if (QFile::exists(backup_archive_file)) {
+    SqliteBackup backup(backup_archive_file, sqliteArchiveFilePath());
+
+    if (backup.step(-1)) {
+      QFile::remove(backup_archive_file);
+      qDebug("Archive of messages was restored successully.");
+    }
+    else {
+      qCritical("Archive of messages was NOT restored due to error when copying the file.");
+    }
+  }
 }
 
 void DatabaseFactory::sqliteAssemblyDatabaseFilePath()  {
@@ -199,7 +230,7 @@ QSqlDatabase DatabaseFactory::sqliteInitializeInMemoryDatabase() {
     qFatal("In-memory SQLite database was NOT opened. Delivered error message: '%s'", qPrintable(database.lastError().text()));
   }
   else {
-    QSqlQuery query_db(database);
+    SqlQuery query_db(database, Q_FUNC_INFO);
 
     query_db.setForwardOnly(true);
     query_db.exec(QSL("PRAGMA encoding = \"UTF-8\""));
@@ -248,7 +279,7 @@ QSqlDatabase DatabaseFactory::sqliteInitializeInMemoryDatabase() {
 
     // Loading messages from file-based database.
     QSqlDatabase file_database = sqliteConnection(objectName(), StrictlyFileBased);
-    QSqlQuery copy_contents(database);
+    SqlQuery copy_contents(database, Q_FUNC_INFO);
 
     // Attach database.
     copy_contents.exec(QString("ATTACH DATABASE '%1' AS 'storage';").arg(file_database.databaseName()));
@@ -277,6 +308,7 @@ QSqlDatabase DatabaseFactory::sqliteInitializeInMemoryDatabase() {
     copy_contents.finish();
 
     query_db.finish();
+    sqliteAttachArchive(database);
   }
 
   // Everything is initialized now.
@@ -314,7 +346,7 @@ QSqlDatabase DatabaseFactory::sqliteInitializeFileBasedDatabase(const QString &c
            qPrintable(database.lastError().text()));
   }
   else {
-    QSqlQuery query_db(database);
+    SqlQuery query_db(database, Q_FUNC_INFO);
 
     query_db.setForwardOnly(true);
     query_db.exec(QSL("PRAGMA encoding = \"UTF-8\""));
@@ -325,6 +357,10 @@ QSqlDatabase DatabaseFactory::sqliteInitializeFileBasedDatabase(const QString &c
     query_db.exec(QSL("PRAGMA count_changes = OFF"));
     query_db.exec(QSL("PRAGMA temp_store = MEMORY"));
 
+    // Free pages are released in small portions in the background instead of full "VACUUM",
+    // this has effect only for new database files, existing ones are switched by next "VACUUM".
+    query_db.exec(QSL("PRAGMA auto_vacuum = INCREMENTAL"));
+
     // Sample query which checks for existence of tables.
     if (!query_db.exec(QSL("SELECT inf_value FROM Information WHERE inf_key = 'schema_version'"))) {
       qWarning("Error occurred. File-based SQLite database is not initialized. Initializing now.");
@@ -359,7 +395,7 @@ QSqlDatabase DatabaseFactory::sqliteInitializeFileBasedDatabase(const QString &c
       const QString installed_db_schema = query_db.value(0).toString();
       query_db.finish();
 
-      if (installed_db_schema < APP_DB_SCHEMA_VERSION) {
+      if (QString(installed_db_schema).remove('.').toInt() < QString(APP_DB_SCHEMA_VERSION).toInt()) {
         if (sqliteUpdateDatabaseSchema(database, installed_db_schema)) {
           qDebug("Database schema was updated from '%s' to '%s' successully or it is already up to date.",
                  qPrintable(installed_db_schema),
@@ -377,6 +413,8 @@ QSqlDatabase DatabaseFactory::sqliteInitializeFileBasedDatabase(const QString &c
              qPrintable(QDir::toNativeSeparators(database.databaseName())));
       qDebug("File-based SQLite database has version '%s'.", qPrintable(installed_db_schema));
     }
+
+    sqliteAttachArchive(database);
   }
 
   // Everything is initialized now.
@@ -389,6 +427,79 @@ QString DatabaseFactory::sqliteDatabaseFilePath() const {
   return m_sqliteDatabaseFilePath + QDir::separator() + APP_DB_SQLITE_FILE;
 }
 
+QString DatabaseFactory::sqliteArchiveFilePath() const {
+  return m_sqliteDatabaseFilePath + QDir::separator() + APP_DB_SQLITE_ARCHIVE_FILE;
+}
+
+int DatabaseFactory::sqliteIncrementalVacuum(QSqlDatabase database, int max_pages) {
+  SqlQuery query_schemas(database, Q_FUNC_INFO);
+  int budget = max_pages;
+  int free_pages = sqliteIncrementalVacuumSchema(database, QSL("main"), &budget);
+
+  if (free_pages < 0) {
+    return -1;
+  }
+
+  query_schemas.setForwardOnly(true);
+
+  // Archive of messages is attached to connections, it is shrinked
+  // with budget which remains after main database.
+  if (query_schemas.exec(QSL("PRAGMA database_list"))) {
+    bool archive_attached = false;
+
+    while (query_schemas.next()) {
+      archive_attached |= query_schemas.value(1).toString() == QL1S(APP_DB_SQLITE_ARCHIVE_NAME);
+    }
+
+    if (archive_attached) {
+      free_pages += qMax(sqliteIncrementalVacuumSchema(database, QSL(APP_DB_SQLITE_ARCHIVE_NAME), &budget), 0);
+    }
+  }
+
+  return free_pages;
+}
+
+int DatabaseFactory::sqliteIncrementalVacuumSchema(QSqlDatabase database, const QString &schema, int *max_pages) {
+  SqlQuery query_vacuum(database, Q_FUNC_INFO);
+
+  query_vacuum.setForwardOnly(true);
+
+  if (!query_vacuum.exec(QString("PRAGMA %1.auto_vacuum").arg(schema)) || !query_vacuum.next() || query_vacuum.value(0).toInt() != 2) {
+    // Database file is not in incremental mode yet.
+    return -1;
+  }
+
+  if (!query_vacuum.exec(QString("PRAGMA %1.freelist_count").arg(schema)) || !query_vacuum.next()) {
+    return -1;
+  }
+
+  const int free_pages = query_vacuum.value(0).toInt();
+  const int release_pages = qMin(free_pages, *max_pages);
+
+  if (release_pages > 0) {
+    // NOTE: Pragma releases one page each time its statement is stepped, but
+    // driver steps statements without result columns only once, so pages are
+    // released one by one. Whole chunk is done in single transaction.
+    database.transaction();
+    query_vacuum.prepare(QString("PRAGMA %1.incremental_vacuum(1)").arg(schema));
+
+    for (int i = 0; i < release_pages; i++) {
+      if (!query_vacuum.exec()) {
+        database.rollback();
+        return -1;
+      }
+    }
+
+    if (!database.commit()) {
+      return -1;
+    }
+
+    *max_pages -= release_pages;
+  }
+
+  return free_pages - qMax(release_pages, 0);
+}
+
 bool DatabaseFactory::sqliteUpdateDatabaseSchema(QSqlDatabase database, const QString &source_db_schema_version) {
   int working_version = QString(source_db_schema_version).remove('.').toInt();
   const int current_version = QString(APP_DB_SCHEMA_VERSION).remove('.').toInt();
@@ -420,13 +531,17 @@ bool DatabaseFactory::sqliteUpdateDatabaseSchema(QSqlDatabase database, const QS
     const QStringList statements = QString(update_file_handle.readAll()).split(APP_DB_COMMENT_SPLIT, QString::SkipEmptyParts);
 
     foreach (const QString &statement, statements) {
-      QSqlQuery query = database.exec(statement);
+      SqlQuery query(statement, database, Q_FUNC_INFO);
 
       if (query.lastError().isValid()) {
         qFatal("Query for updating database schema failed: '%s'.", qPrintable(query.lastError().text()));
       }
     }
 
+    if (!finishSchemaUpdate(database, working_version + 1)) {
+      qFatal("Conversion of data for database schema '%d' failed.", working_version + 1);
+    }
+
     // Increment the version.
     qDebug("Updating database schema: '%d' -> '%d'.", working_version, working_version + 1);
     working_version++;
@@ -458,13 +573,17 @@ bool DatabaseFactory::mysqlUpdateDatabaseSchema(QSqlDatabase database, const QSt
     QStringList statements = QString(update_file_handle.readAll()).split(APP_DB_COMMENT_SPLIT, QString::SkipEmptyParts);
 
     foreach (QString statement, statements) {
-      QSqlQuery query = database.exec(statement.replace(APP_DB_NAME_PLACEHOLDER, db_name));
+      SqlQuery query(statement.replace(APP_DB_NAME_PLACEHOLDER, db_name), database, Q_FUNC_INFO);
 
       if (query.lastError().isValid()) {
         qFatal("Query for updating database schema failed: '%s'.", qPrintable(query.lastError().text()));
       }
     }
 
+    if (!finishSchemaUpdate(database, working_version + 1)) {
+      qFatal("Conversion of data for database schema '%d' failed.", working_version + 1);
+    }
+
     // Increment the version.
     qDebug("Updating database schema: '%d' -> '%d'.", working_version, working_version + 1);
     working_version++;
@@ -473,6 +592,54 @@ bool DatabaseFactory::mysqlUpdateDatabaseSchema(QSqlDatabase database, const QSt
   return true;
 }
 
+void DatabaseFactory::initializeArchive(QSqlDatabase database, const QString &init_script) {
+  QFile file_init(APP_MISC_PATH + QDir::separator() + init_script);
+
+  if (!file_init.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    qCritical("Archive initialization file '%s' from directory '%s' was not found. Messages cannot be archived.",
+              qPrintable(init_script),
+              qPrintable(APP_MISC_PATH));
+    return;
+  }
+
+  const QStringList statements = QString(file_init.readAll()).split(APP_DB_COMMENT_SPLIT, QString::SkipEmptyParts);
+  SqlQuery query_db(database, Q_FUNC_INFO);
+
+  foreach (const QString &statement, statements) {
+    if (!query_db.exec(statement)) {
+      qCritical("Archive initialization failed. Error: '%s'.", qPrintable(query_db.lastError().text()));
+      return;
+    }
+  }
+}
+
+void DatabaseFactory::sqliteAttachArchive(QSqlDatabase database) {
+  const QDir db_path(m_sqliteDatabaseFilePath);
+  SqlQuery query_attach(database, Q_FUNC_INFO);
+
+  if (!query_attach.exec(QString("ATTACH DATABASE '%1' AS '%2';").arg(db_path.absoluteFilePath(APP_DB_SQLITE_ARCHIVE_FILE),
+                                                                      APP_DB_SQLITE_ARCHIVE_NAME))) {
+    qCritical("Archive of messages was not attached. Error: '%s'.", qPrintable(query_attach.lastError().text()));
+  }
+  else {
+    // Has effect only if archive file is created right now.
+    query_attach.exec(QString("PRAGMA %1.auto_vacuum = INCREMENTAL;").arg(APP_DB_SQLITE_ARCHIVE_NAME));
+    initializeArchive(database, APP_DB_SQLITE_ARCHIVE_INIT);
+  }
+}
+
+bool DatabaseFactory::finishSchemaUpdate(QSqlDatabase database, int new_version) {
+  switch (new_version) {
+    case 9:
+      // Icons are stored in separate table, feeds and categories only refer to them.
+      // Update script does not set the version, it is set once icons are moved.
+      return DatabaseQueries::moveIconsToIconTable(database, new_version);
+
+    default:
+      return true;
+  }
+}
+
 QSqlDatabase DatabaseFactory::connection(const QString &connection_name, DesiredType desired_type) {
   switch (m_activeDatabaseDriver) {
     case MYSQL:
@@ -528,7 +695,7 @@ void DatabaseFactory::sqliteSaveMemoryDatabase() {
 
   QSqlDatabase database = sqliteConnection(objectName(), StrictlyInMemory);
   QSqlDatabase file_database = sqliteConnection(objectName(), StrictlyFileBased);
-  QSqlQuery copy_contents(database);
+  SqlQuery copy_contents(database, Q_FUNC_INFO);
 
   // Attach database.
   copy_contents.exec(QString(QSL("ATTACH DATABASE '%1' AS 'storage';")).arg(file_database.databaseName()));
@@ -654,7 +821,7 @@ QSqlDatabase DatabaseFactory::mysqlInitializeDatabase(const QString &connection_
     return connection(objectName(), FromSettings);
   }
   else {
-    QSqlQuery query_db(database);
+    SqlQuery query_db(database, Q_FUNC_INFO);
     query_db.setForwardOnly(true);
 
     if (!query_db.exec(QString("USE %1").arg(database_name)) || !query_db.exec(QSL("SELECT inf_value FROM Information WHERE inf_key = 'schema_version'"))) {
@@ -692,7 +859,7 @@ QSqlDatabase DatabaseFactory::mysqlInitializeDatabase(const QString &connection_
 
       const QString installed_db_schema = query_db.value(0).toString();
 
-      if (installed_db_schema < APP_DB_SCHEMA_VERSION) {
+      if (QString(installed_db_schema).remove('.').toInt() < QString(APP_DB_SCHEMA_VERSION).toInt()) {
         if (mysqlUpdateDatabaseSchema(database, installed_db_schema, database_name)) {
           qDebug("Database schema was updated from '%s' to '%s' successully or it is already up to date.",
                  qPrintable(installed_db_schema),
@@ -708,6 +875,7 @@ QSqlDatabase DatabaseFactory::mysqlInitializeDatabase(const QString &connection_
     }
 
     query_db.finish();
+    initializeArchive(database, APP_DB_MYSQL_ARCHIVE_INIT);
   }
 
   // Everything is initialized now.
@@ -718,7 +886,7 @@ QSqlDatabase DatabaseFactory::mysqlInitializeDatabase(const QString &connection_
 
 bool DatabaseFactory::mysqlVacuumDatabase() {
   QSqlDatabase database = mysqlConnection(objectName());
-  QSqlQuery query_vacuum(database);
+  SqlQuery query_vacuum(database, Q_FUNC_INFO);
 
   return query_vacuum.exec(QSL("OPTIMIZE TABLE rssguard.feeds;")) && query_vacuum.exec(QSL("OPTIMIZE TABLE rssguard.messages;"));
 }
@@ -734,6 +902,7 @@ QSqlDatabase DatabaseFactory::sqliteConnection(const QString &connection_name, D
     }
     else {
       QSqlDatabase database = QSqlDatabase::database();
+      const bool attach_archive = !database.isOpen();
 
       database.setDatabaseName(QSL(":memory:"));
 
@@ -745,6 +914,10 @@ QSqlDatabase DatabaseFactory::sqliteConnection(const QString &connection_name, D
         qDebug("In-memory SQLite database connection seems to be established.");
       }
 
+      if (attach_archive) {
+        sqliteAttachArchive(database);
+      }
+
       return database;
     }
   }
@@ -776,6 +949,8 @@ QSqlDatabase DatabaseFactory::sqliteConnection(const QString &connection_name, D
         database.setDatabaseName(db_file.fileName());
       }
 
+      const bool attach_archive = !database.isOpen();
+
       if (!database.isOpen() && !database.open()) {
         qFatal("File-based SQLite database was NOT opened. Delivered error message: '%s'.",
                qPrintable(database.lastError().text()));
@@ -786,6 +961,10 @@ QSqlDatabase DatabaseFactory::sqliteConnection(const QString &connection_name, D
                qPrintable(QDir::toNativeSeparators(database.databaseName())));
       }
 
+      if (attach_archive) {
+        sqliteAttachArchive(database);
+      }
+
       return database;
     }
   }
@@ -805,8 +984,11 @@ bool DatabaseFactory::sqliteVacuumDatabase() {
     return false;
   }
 
-  QSqlQuery query_vacuum(database);
+  SqlQuery query_vacuum(database, Q_FUNC_INFO);
 
+  // Full vacuum also switches older database files to incremental auto-vacuum,
+  // afterwards free pages are released by sqliteIncrementalVacuum().
+  query_vacuum.exec(QSL("PRAGMA main.auto_vacuum = INCREMENTAL"));
   return query_vacuum.exec(QSL("VACUUM"));
 }
 
@@ -90,7 +90,8 @@ class DatabaseFactory : public QObject {
     // Returns identification of currently active database driver.
     UsedDriver activeDatabaseDriver() const;
 
-    // Copies selected backup database (file) to active database path.
+    // Copies selected backup database (file) and archive backed up
+    // together with it to active database path.
     bool initiateRestoration(const QString &database_backup_file_path);
 
     // Finishes restoration from backup file.
@@ -100,6 +101,12 @@ class DatabaseFactory : public QObject {
     // SQLITE stuff.
     //
     QString sqliteDatabaseFilePath() const;
+    QString sqliteArchiveFilePath() const;
+
+    // Releases at most "max_pages" free pages of database file and of attached archive
+    // and returns count of free pages which remain. Returns -1 if database file does
+    // not use incremental auto-vacuum yet, full vacuumDatabase() is needed to shrink it then.
+    int sqliteIncrementalVacuum(QSqlDatabase database, int max_pages);
 
     //
     // MySQL stuff.
@@ -123,6 +130,13 @@ class DatabaseFactory : public QObject {
     // application session.
     void determineDriver();
 
+    // Converts data which cannot be converted by update scripts,
+    // called after database is updated to given schema version.
+    bool finishSchemaUpdate(QSqlDatabase database, int new_version);
+
+    // Creates table for archived messages if it does not exist yet.
+    void initializeArchive(QSqlDatabase database, const QString &init_script);
+
     // Holds the type of currently activated database backend.
     UsedDriver m_activeDatabaseDriver;
 
@@ -152,6 +166,15 @@ class DatabaseFactory : public QObject {
 
     QSqlDatabase sqliteConnection(const QString &connection_name, DesiredType desired_type);
 
+    // Attaches file with archived messages to given connection,
+    // this must be done for each newly opened connection.
+    void sqliteAttachArchive(QSqlDatabase database);
+
+    // Releases at most "max_pages" free pages of given schema and lowers "max_pages"
+    // by count of released pages. Returns count of free pages which remain, -1 if schema
+    // does not use incremental auto-vacuum.
+    int sqliteIncrementalVacuumSchema(QSqlDatabase database, const QString &schema, int *max_pages);
+
     // Runs "VACUUM" on the database.
     bool sqliteVacuumDatabase();
 
@@ -32,6 +32,7 @@
 #include "miscellaneous/textfactory.h"
 #include "miscellaneous/application.h"
 #include "miscellaneous/iconfactory.h"
+#include "miscellaneous/sqlquery.h"
 
 #include <QVariant>
 #include <QUrl>
@@ -39,7 +40,7 @@
 
 
 bool DatabaseQueries::markMessagesReadUnread(QSqlDatabase db, const QStringList &ids, RootItem::ReadStatus read) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   q.setForwardOnly(true);
 
   return q.exec(QString(QSL("UPDATE Messages SET is_read = %2 WHERE id IN (%1);"))
@@ -47,7 +48,7 @@ bool DatabaseQueries::markMessagesReadUnread(QSqlDatabase db, const QStringList
 }
 
 bool DatabaseQueries::markMessageImportant(QSqlDatabase db, int id, RootItem::Importance importance) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   q.setForwardOnly(true);
 
   if (!q.prepare(QSL("UPDATE Messages SET is_important = :important WHERE id = :id;"))) {
@@ -63,7 +64,7 @@ bool DatabaseQueries::markMessageImportant(QSqlDatabase db, int id, RootItem::Im
 }
 
 bool DatabaseQueries::markFeedsReadUnread(QSqlDatabase db, const QStringList &ids, int account_id, RootItem::ReadStatus read) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   q.setForwardOnly(true);
   q.prepare(QString("UPDATE Messages SET is_read = :read "
                     "WHERE feed IN (%1) AND is_deleted = 0 AND is_pdeleted = 0 AND account_id = :account_id;").arg(ids.join(QSL(", "))));
@@ -75,7 +76,7 @@ bool DatabaseQueries::markFeedsReadUnread(QSqlDatabase db, const QStringList &id
 }
 
 bool DatabaseQueries::markBinReadUnread(QSqlDatabase db, int account_id, RootItem::ReadStatus read) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   q.setForwardOnly(true);
   q.prepare("UPDATE Messages SET is_read = :read "
             "WHERE is_deleted = 1 AND is_pdeleted = 0 AND account_id = :account_id;");
@@ -87,7 +88,7 @@ bool DatabaseQueries::markBinReadUnread(QSqlDatabase db, int account_id, RootIte
 }
 
 bool DatabaseQueries::markAccountReadUnread(QSqlDatabase db, int account_id, RootItem::ReadStatus read) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   q.setForwardOnly(true);
   q.prepare(QSL("UPDATE Messages SET is_read = :read WHERE is_pdeleted = 0 AND account_id = :account_id;"));
 
@@ -98,21 +99,21 @@ bool DatabaseQueries::markAccountReadUnread(QSqlDatabase db, int account_id, Roo
 }
 
 bool DatabaseQueries::switchMessagesImportance(QSqlDatabase db, const QStringList &ids) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   q.setForwardOnly(true);
 
   return q.exec(QString(QSL("UPDATE Messages SET is_important = NOT is_important WHERE id IN (%1);")).arg(ids.join(QSL(", "))));
 }
 
 bool DatabaseQueries::permanentlyDeleteMessages(QSqlDatabase db, const QStringList &ids) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   q.setForwardOnly(true);
 
   return q.exec(QString(QSL("UPDATE Messages SET is_pdeleted = 1 WHERE id IN (%1);")).arg(ids.join(QSL(", "))));
 }
 
 bool DatabaseQueries::deleteOrRestoreMessagesToFromBin(QSqlDatabase db, const QStringList &ids, bool deleted) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   q.setForwardOnly(true);
 
   return q.exec(QString(QSL("UPDATE Messages SET is_deleted = %2 WHERE id IN (%1);")).arg(ids.join(QSL(", ")),
@@ -120,7 +121,7 @@ bool DatabaseQueries::deleteOrRestoreMessagesToFromBin(QSqlDatabase db, const QS
 }
 
 bool DatabaseQueries::restoreBin(QSqlDatabase db, int account_id) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   q.setForwardOnly(true);
   q.prepare("UPDATE Messages SET is_deleted = 0 "
             "WHERE is_deleted = 1 AND is_pdeleted = 0 AND account_id = :account_id;");
@@ -129,60 +130,290 @@ bool DatabaseQueries::restoreBin(QSqlDatabase db, int account_id) {
   return q.exec();
 }
 
-bool DatabaseQueries::purgeImportantMessages(QSqlDatabase db) {
-  QSqlQuery q(db);
+QString DatabaseQueries::purgeMessagesCondition(const CleanerOrders &orders) {
+  QStringList conditions;
+
+  // Orders remove only messages which are NOT starred, as purging always did.
+  if (orders.m_removeReadMessages) {
+    // Remove only messages which are NOT in recycle bin.
+    conditions.append(QSL("(is_important = 0 AND is_deleted = 0 AND is_read = 1)"));
+  }
+
+  if (orders.m_removeOldMessages) {
+    const qint64 since_epoch = QDateTime::currentDateTimeUtc().addDays(-orders.m_barrierForRemovingOldMessagesInDays).toMSecsSinceEpoch();
+
+    conditions.append(QString("(is_important = 0 AND date_created < %1)").arg(since_epoch));
+  }
+
+  if (orders.m_removeRecycleBin) {
+    conditions.append(QSL("(is_important = 0 AND is_deleted = 1)"));
+  }
+
+  return conditions.join(QSL(" OR "));
+}
+
+int DatabaseQueries::countMessagesToPurge(QSqlDatabase db, const QString &condition, bool *ok) {
+  SqlQuery q(db, Q_FUNC_INFO);
+
   q.setForwardOnly(true);
-  q.prepare(QSL("DELETE FROM Messages WHERE is_important = 1;"));
 
-  return q.exec();
+  if (q.exec(QString("SELECT count(*) FROM Messages WHERE %1;").arg(condition)) && q.next()) {
+    if (ok != NULL) {
+      *ok = true;
+    }
+
+    return q.value(0).toInt();
+  }
+  else {
+    qWarning("Counting of messages to purge failed: '%s'.", qPrintable(q.lastError().text()));
+
+    if (ok != NULL) {
+      *ok = false;
+    }
+
+    return 0;
+  }
 }
 
-bool DatabaseQueries::purgeReadMessages(QSqlDatabase db) {
-  QSqlQuery q(db);
+int DatabaseQueries::purgeMessagesChunk(QSqlDatabase db, const QString &condition, int chunk_size, int *last_id, bool *ok) {
+  SqlQuery q(db, Q_FUNC_INFO);
+  QStringList ids;
+
+  if (ok != NULL) {
+    *ok = false;
+  }
+
   q.setForwardOnly(true);
-  q.prepare(QSL("DELETE FROM Messages WHERE is_important = :is_important AND is_deleted = :is_deleted AND is_read = :is_read;"));
-  q.bindValue(QSL(":is_read"), 1);
 
-  // Remove only messages which are NOT in recycle bin.
-  q.bindValue(QSL(":is_deleted"), 0);
+  if (!db.transaction()) {
+    qWarning("Failed to start transaction for purging messages: '%s'.", qPrintable(db.lastError().text()));
+    return 0;
+  }
 
-  // Remove only messages which are NOT starred.
-  q.bindValue(QSL(":is_important"), 0);
+  q.prepare(QString("SELECT id FROM Messages WHERE id > :last_id AND (%1) ORDER BY id LIMIT %2;").arg(condition,
+                                                                                                     QString::number(chunk_size)));
+  q.bindValue(QSL(":last_id"), *last_id);
 
-  return q.exec();
+  if (!q.exec()) {
+    qWarning("Selecting of messages to purge failed: '%s'.", qPrintable(q.lastError().text()));
+    db.rollback();
+    return 0;
+  }
+
+  while (q.next()) {
+    ids.append(q.value(0).toString());
+  }
+
+  if (!ids.isEmpty() && !q.exec(QString("DELETE FROM Messages WHERE id IN (%1);").arg(ids.join(QSL(", "))))) {
+    qWarning("Purging of messages failed: '%s'.", qPrintable(q.lastError().text()));
+    db.rollback();
+    return 0;
+  }
+
+  if (!db.commit()) {
+    qWarning("Failed to commit purged messages: '%s'.", qPrintable(db.lastError().text()));
+    db.rollback();
+    return 0;
+  }
+
+  if (!ids.isEmpty()) {
+    *last_id = ids.last().toInt();
+  }
+
+  if (ok != NULL) {
+    *ok = true;
+  }
+
+  return ids.size();
 }
 
-bool DatabaseQueries::purgeOldMessages(QSqlDatabase db, int older_than_days) {
-  QSqlQuery q(db);
-  const qint64 since_epoch = QDateTime::currentDateTimeUtc().addDays(-older_than_days).toMSecsSinceEpoch();
+int DatabaseQueries::countAllMessages(QSqlDatabase db, bool *ok) {
+  SqlQuery q(db, Q_FUNC_INFO);
 
   q.setForwardOnly(true);
-  q.prepare(QSL("DELETE FROM Messages WHERE is_important = :is_important AND date_created < :date_created;"));
-  q.bindValue(QSL(":date_created"), since_epoch);
 
-  // Remove only messages which are NOT starred.
-  q.bindValue(QSL(":is_important"), 0);
+  if (q.exec(QSL("SELECT count(*) FROM Messages;")) && q.next()) {
+    if (ok != NULL) {
+      *ok = true;
+    }
 
-  return q.exec();
+    return q.value(0).toInt();
+  }
+  else {
+    qWarning("Counting of messages failed: '%s'.", qPrintable(q.lastError().text()));
+
+    if (ok != NULL) {
+      *ok = false;
+    }
+
+    return 0;
+  }
 }
 
-bool DatabaseQueries::purgeRecycleBin(QSqlDatabase db) {
-  QSqlQuery q(db);
+int DatabaseQueries::convertMessageContentsChunk(QSqlDatabase db, MessageContents::Conversion conversion, bool dry_run, int chunk_size,
+                                                 int *last_id, MessageContentsStatistics *statistics, bool *ok) {
+  SqlQuery q(db, Q_FUNC_INFO);
+  SqlQuery query_update(db, Q_FUNC_INFO);
+  const bool binary_storage = db.driverName() == APP_DB_SQLITE_DRIVER;
+  const bool write_changes = conversion != MessageContents::NoConversion && !dry_run;
+  QList<QPair<int,QVariant> > converted_contents;
+  int processed_count = 0;
+
+  if (ok != NULL) {
+    *ok = false;
+  }
 
   q.setForwardOnly(true);
-  q.prepare(QSL("DELETE FROM Messages WHERE is_important = :is_important AND is_deleted = :is_deleted;"));
-  q.bindValue(QSL(":is_deleted"), 1);
+  query_update.prepare(QSL("UPDATE Messages SET contents = :contents WHERE id = :id;"));
 
-  // Remove only messages which are NOT starred.
-  q.bindValue(QSL(":is_important"), 0);
+  if (write_changes && !db.transaction()) {
+    qWarning("Failed to start transaction for converting messages: '%s'.", qPrintable(db.lastError().text()));
+    return 0;
+  }
 
-  return q.exec();
+  q.prepare(QString("SELECT id, contents FROM Messages WHERE id > :last_id ORDER BY id LIMIT %1;").arg(chunk_size));
+  q.bindValue(QSL(":last_id"), *last_id);
+
+  if (!q.exec()) {
+    qWarning("Selecting of messages to convert failed: '%s'.", qPrintable(q.lastError().text()));
+
+    if (write_changes) {
+      db.rollback();
+    }
+
+    return 0;
+  }
+
+  while (q.next()) {
+    const QVariant stored_contents = q.value(1);
+    const QVariant new_contents = MessageContents::convert(stored_contents, conversion, binary_storage);
+
+    *last_id = q.value(0).toInt();
+    processed_count++;
+    statistics->append(new_contents);
+
+    if (write_changes && MessageContents::isCompressed(new_contents) != MessageContents::isCompressed(stored_contents)) {
+      converted_contents.append(QPair<int,QVariant>(*last_id, new_contents));
+    }
+  }
+
+  // Rows are not updated while they are being read.
+  q.finish();
+
+  for (int i = 0; i < converted_contents.size(); i++) {
+    query_update.bindValue(QSL(":contents"), converted_contents.at(i).second);
+    query_update.bindValue(QSL(":id"), converted_contents.at(i).first);
+
+    if (!query_update.exec()) {
+      qWarning("Converting of message contents failed: '%s'.", qPrintable(query_update.lastError().text()));
+      db.rollback();
+      return 0;
+    }
+  }
+
+  if (write_changes && !db.commit()) {
+    qWarning("Failed to commit converted messages: '%s'.", qPrintable(db.lastError().text()));
+    db.rollback();
+    return 0;
+  }
+
+  if (ok != NULL) {
+    *ok = true;
+  }
+
+  return processed_count;
+}
+
+QString DatabaseQueries::archiveMessagesCondition(int archive_after_days) {
+  const qint64 since_epoch = QDateTime::currentDateTimeUtc().addDays(-archive_after_days).toMSecsSinceEpoch();
+
+  // Starred messages and messages in recycle bin are never archived.
+  return QString("is_read = 1 AND is_important = 0 AND is_deleted = 0 AND is_pdeleted = 0 AND date_created < %1").arg(since_epoch);
+}
+
+int DatabaseQueries::archiveMessagesChunk(QSqlDatabase db, const QString &condition, int chunk_size, int *last_id, bool *ok) {
+  const QString columns = QSL("is_read, is_deleted, is_important, feed, title, url, author, date_created, contents, "
+                              "is_pdeleted, enclosures, account_id, custom_id, custom_hash");
+  SqlQuery q(db, Q_FUNC_INFO);
+  QStringList ids;
+
+  if (ok != NULL) {
+    *ok = false;
+  }
+
+  q.setForwardOnly(true);
+
+  if (!db.transaction()) {
+    qWarning("Failed to start transaction for archiving messages: '%s'.", qPrintable(db.lastError().text()));
+    return 0;
+  }
+
+  q.prepare(QString("SELECT id FROM Messages WHERE id > :last_id AND (%1) ORDER BY id LIMIT %2;").arg(condition,
+                                                                                                     QString::number(chunk_size)));
+  q.bindValue(QSL(":last_id"), *last_id);
+
+  if (!q.exec()) {
+    qWarning("Selecting of messages to archive failed: '%s'.", qPrintable(q.lastError().text()));
+    db.rollback();
+    return 0;
+  }
+
+  while (q.next()) {
+    ids.append(q.value(0).toString());
+  }
+
+  if (!ids.isEmpty()) {
+    const QString id_list = ids.join(QSL(", "));
+    QStringList kept_ids = ids;
+    QStringList taken_ids;
+
+    // Messages keep their IDs in archive. SQLite may reuse ID of deleted
+    // message though, such rare messages get new ID in archive.
+    if (!q.exec(QString("SELECT id FROM ArchivedMessages WHERE id IN (%1);").arg(id_list))) {
+      qWarning("Checking of archived IDs failed: '%s'.", qPrintable(q.lastError().text()));
+      db.rollback();
+      return 0;
+    }
+
+    while (q.next()) {
+      taken_ids.append(q.value(0).toString());
+      kept_ids.removeOne(taken_ids.last());
+    }
+
+    if ((!kept_ids.isEmpty() &&
+         !q.exec(QString("INSERT INTO ArchivedMessages (id, %1) SELECT id, %1 FROM Messages WHERE id IN (%2) ORDER BY id;").arg(columns,
+                                                                                                                        kept_ids.join(QSL(", "))))) ||
+        (!taken_ids.isEmpty() &&
+         !q.exec(QString("INSERT INTO ArchivedMessages (%1) SELECT %1 FROM Messages WHERE id IN (%2) ORDER BY id;").arg(columns,
+                                                                                                                taken_ids.join(QSL(", "))))) ||
+        !q.exec(QString("DELETE FROM Messages WHERE id IN (%1);").arg(id_list))) {
+      qWarning("Archiving of messages failed: '%s'.", qPrintable(q.lastError().text()));
+      db.rollback();
+      return 0;
+    }
+  }
+
+  if (!db.commit()) {
+    qWarning("Failed to commit archived messages: '%s'.", qPrintable(db.lastError().text()));
+    db.rollback();
+    return 0;
+  }
+
+  if (!ids.isEmpty()) {
+    *last_id = ids.last().toInt();
+  }
+
+  if (ok != NULL) {
+    *ok = true;
+  }
+
+  return ids.size();
 }
 
 QMap<int,QPair<int,int> > DatabaseQueries::getMessageCountsForCategory(QSqlDatabase db, int custom_id, int account_id,
                                                                        bool including_total_counts, bool *ok) {
   QMap<int, QPair<int,int> > counts;
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   q.setForwardOnly(true);
 
   if (including_total_counts) {
@@ -230,7 +461,7 @@ QMap<int,QPair<int,int> > DatabaseQueries::getMessageCountsForCategory(QSqlDatab
 QMap<int,QPair<int,int> > DatabaseQueries::getMessageCountsForAccount(QSqlDatabase db, int account_id,
                                                                       bool including_total_counts, bool *ok) {
   QMap<int,QPair<int,int> > counts;
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   q.setForwardOnly(true);
 
   if (including_total_counts) {
@@ -276,7 +507,7 @@ QMap<int,QPair<int,int> > DatabaseQueries::getMessageCountsForAccount(QSqlDataba
 
 int DatabaseQueries::getMessageCountsForFeed(QSqlDatabase db, int feed_custom_id,
                                              int account_id, bool including_total_counts, bool *ok) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   q.setForwardOnly(true);
 
   if (including_total_counts) {
@@ -308,7 +539,7 @@ int DatabaseQueries::getMessageCountsForFeed(QSqlDatabase db, int feed_custom_id
 }
 
 int DatabaseQueries::getMessageCountsForBin(QSqlDatabase db, int account_id, bool including_total_counts, bool *ok) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   q.setForwardOnly(true);
 
   if (including_total_counts) {
@@ -340,7 +571,7 @@ int DatabaseQueries::getMessageCountsForBin(QSqlDatabase db, int account_id, boo
 
 QList<Message> DatabaseQueries::getUndeletedMessagesForFeed(QSqlDatabase db, int feed_custom_id, int account_id, bool *ok) {
   QList<Message> messages;
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   q.setForwardOnly(true);
   q.prepare("SELECT * "
             "FROM Messages "
@@ -374,7 +605,7 @@ QList<Message> DatabaseQueries::getUndeletedMessagesForFeed(QSqlDatabase db, int
 
 QList<Message> DatabaseQueries::getUndeletedMessagesForBin(QSqlDatabase db, int account_id, bool *ok) {
   QList<Message> messages;
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   q.setForwardOnly(true);
   q.prepare("SELECT * "
             "FROM Messages "
@@ -407,7 +638,7 @@ QList<Message> DatabaseQueries::getUndeletedMessagesForBin(QSqlDatabase db, int
 
 QList<Message> DatabaseQueries::getUndeletedMessagesForAccount(QSqlDatabase db, int account_id, bool *ok) {
   QList<Message> messages;
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   q.setForwardOnly(true);
   q.prepare("SELECT * "
             "FROM Messages "
@@ -451,17 +682,21 @@ int DatabaseQueries::updateMessages(QSqlDatabase db,
   }
 
   bool use_transactions = qApp->settings()->value(GROUP(Database), SETTING(Database::UseTransactions)).toBool();
+  const bool compress_contents = qApp->settings()->value(GROUP(Database), SETTING(Database::CompressContents)).toBool();
+  const bool binary_storage = db.driverName() == APP_DB_SQLITE_DRIVER;
 
   // Does not make any difference, since each feed now has
   // its own "custom ID" (standard feeds have their custom ID equal to primary key ID).
   int updated_messages = 0;
 
   // Prepare queries.
-  QSqlQuery query_select_with_url(db);
-  QSqlQuery query_select_with_id(db);
-  QSqlQuery query_update(db);
-  QSqlQuery query_insert(db);
-  QSqlQuery query_begin_transaction(db);
+  SqlQuery query_select_with_url(db, Q_FUNC_INFO);
+  SqlQuery query_select_with_id(db, Q_FUNC_INFO);
+  SqlQuery query_archived_with_url(db, Q_FUNC_INFO);
+  SqlQuery query_archived_with_id(db, Q_FUNC_INFO);
+  SqlQuery query_update(db, Q_FUNC_INFO);
+  SqlQuery query_insert(db, Q_FUNC_INFO);
+  SqlQuery query_begin_transaction(db, Q_FUNC_INFO);
 
   // Here we have query which will check for existence of the "same" message in given feed.
   // The two message are the "same" if:
@@ -478,6 +713,13 @@ int DatabaseQueries::updateMessages(QSqlDatabase db,
   query_select_with_id.prepare("SELECT id, date_created, is_read, is_important FROM Messages "
                                "WHERE custom_id = :custom_id AND account_id = :account_id;");
 
+  // Messages which were already moved to archive are not stored again.
+  query_archived_with_url.setForwardOnly(true);
+  query_archived_with_url.prepare("SELECT id FROM ArchivedMessages "
+                                  "WHERE feed = :feed AND title = :title AND url = :url AND author = :author AND account_id = :account_id;");
+  query_archived_with_id.setForwardOnly(true);
+  query_archived_with_id.prepare("SELECT id FROM ArchivedMessages WHERE custom_id = :custom_id AND account_id = :account_id;");
+
   // Used to insert new messages.
   query_insert.setForwardOnly(true);
   query_insert.prepare("INSERT INTO Messages "
@@ -512,6 +754,7 @@ int DatabaseQueries::updateMessages(QSqlDatabase db,
     }
 
     int id_existing_message = -1;
+    bool is_archived_message = false;
     qint64 date_existing_message;
     bool is_read_existing_message;
     bool is_important_existing_message;
@@ -556,6 +799,26 @@ int DatabaseQueries::updateMessages(QSqlDatabase db,
       query_select_with_id.finish();
     }
 
+    if (id_existing_message < 0) {
+      if (message.m_customId.isEmpty()) {
+        query_archived_with_url.bindValue(QSL(":feed"), feed_custom_id);
+        query_archived_with_url.bindValue(QSL(":title"), message.m_title);
+        query_archived_with_url.bindValue(QSL(":url"), message.m_url);
+        query_archived_with_url.bindValue(QSL(":author"), message.m_author);
+        query_archived_with_url.bindValue(QSL(":account_id"), account_id);
+
+        is_archived_message = query_archived_with_url.exec() && query_archived_with_url.next();
+        query_archived_with_url.finish();
+      }
+      else {
+        query_archived_with_id.bindValue(QSL(":account_id"), account_id);
+        query_archived_with_id.bindValue(QSL(":custom_id"), message.m_customId);
+
+        is_archived_message = query_archived_with_id.exec() && query_archived_with_id.next();
+        query_archived_with_id.finish();
+      }
+    }
+
     // Now, check if this message is already in the DB.
     if (id_existing_message >= 0) {
       // Message is already in the DB.
@@ -572,7 +835,7 @@ int DatabaseQueries::updateMessages(QSqlDatabase db,
         query_update.bindValue(QSL(":url"), message.m_url);
         query_update.bindValue(QSL(":author"), message.m_author);
         query_update.bindValue(QSL(":date_created"), message.m_created.toMSecsSinceEpoch());
-        query_update.bindValue(QSL(":contents"), message.m_contents);
+        query_update.bindValue(QSL(":contents"), MessageContents::encode(message.m_contents, compress_contents, binary_storage));
         query_update.bindValue(QSL(":enclosures"), Enclosures::encodeEnclosuresToString(message.m_enclosures));
         query_update.bindValue(QSL(":id"), id_existing_message);
 
@@ -589,7 +852,7 @@ int DatabaseQueries::updateMessages(QSqlDatabase db,
         qDebug("Updating message '%s' in DB.", qPrintable(message.m_title));
       }
     }
-    else {
+    else if (!is_archived_message) {
       // Message with this URL is not fetched in this feed yet.
       query_insert.bindValue(QSL(":feed"), feed_custom_id);
       query_insert.bindValue(QSL(":title"), message.m_title);
@@ -598,7 +861,7 @@ int DatabaseQueries::updateMessages(QSqlDatabase db,
       query_insert.bindValue(QSL(":url"), message.m_url);
       query_insert.bindValue(QSL(":author"), message.m_author);
       query_insert.bindValue(QSL(":date_created"), message.m_created.toMSecsSinceEpoch());
-      query_insert.bindValue(QSL(":contents"), message.m_contents);
+      query_insert.bindValue(QSL(":contents"), MessageContents::encode(message.m_contents, compress_contents, binary_storage));
       query_insert.bindValue(QSL(":enclosures"), Enclosures::encodeEnclosuresToString(message.m_enclosures));
       query_insert.bindValue(QSL(":custom_id"), message.m_customId);
       query_insert.bindValue(QSL(":custom_hash"), message.m_customHash);
@@ -645,7 +908,7 @@ int DatabaseQueries::updateMessages(QSqlDatabase db,
 }
 
 bool DatabaseQueries::purgeMessagesFromBin(QSqlDatabase db, bool clear_only_read, int account_id) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   q.setForwardOnly(true);
 
   if (clear_only_read) {
@@ -661,11 +924,12 @@ bool DatabaseQueries::purgeMessagesFromBin(QSqlDatabase db, bool clear_only_read
 }
 
 bool DatabaseQueries::deleteAccount(QSqlDatabase db, int account_id) {
-  QSqlQuery query(db);
+  SqlQuery query(db, Q_FUNC_INFO);
   query.setForwardOnly(true);
 
   QStringList queries;
   queries << QSL("DELETE FROM Messages WHERE account_id = :account_id;") <<
+             QSL("DELETE FROM ArchivedMessages WHERE account_id = :account_id;") <<
              QSL("DELETE FROM Feeds WHERE account_id = :account_id;") <<
              QSL("DELETE FROM Categories WHERE account_id = :account_id;") <<
              QSL("DELETE FROM Accounts WHERE id = :account_id;");
@@ -688,7 +952,7 @@ bool DatabaseQueries::deleteAccount(QSqlDatabase db, int account_id) {
 
 bool DatabaseQueries::deleteAccountData(QSqlDatabase db, int account_id, bool delete_messages_too) {
   bool result = true;
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   q.setForwardOnly(true);
 
   if (delete_messages_too) {
@@ -696,6 +960,11 @@ bool DatabaseQueries::deleteAccountData(QSqlDatabase db, int account_id, bool de
     q.bindValue(QSL(":account_id"), account_id);
 
     result &= q.exec();
+
+    q.prepare(QSL("DELETE FROM ArchivedMessages WHERE account_id = :account_id;"));
+    q.bindValue(QSL(":account_id"), account_id);
+
+    result &= q.exec();
   }
 
   q.prepare(QSL("DELETE FROM Feeds WHERE account_id = :account_id;"));
@@ -712,7 +981,7 @@ bool DatabaseQueries::deleteAccountData(QSqlDatabase db, int account_id, bool de
 }
 
 bool DatabaseQueries::cleanFeeds(QSqlDatabase db, const QStringList &ids, bool clean_read_only, int account_id) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   q.setForwardOnly(true);
 
   if (clean_read_only) {
@@ -739,12 +1008,20 @@ bool DatabaseQueries::cleanFeeds(QSqlDatabase db, const QStringList &ids, bool c
 }
 
 bool DatabaseQueries::purgeLeftoverMessages(QSqlDatabase db, int account_id) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
 
   q.setForwardOnly(true);
   q.prepare(QSL("DELETE FROM Messages WHERE account_id = :account_id AND feed NOT IN (SELECT custom_id FROM Feeds WHERE account_id = :account_id);"));
   q.bindValue(QSL(":account_id"), account_id);
 
+  if (!q.exec()) {
+    qWarning("Removing of left over messages failed: '%s'.", qPrintable(q.lastError().text()));
+    return false;
+  }
+
+  q.prepare(QSL("DELETE FROM ArchivedMessages WHERE account_id = :account_id AND feed NOT IN (SELECT custom_id FROM Feeds WHERE account_id = :account_id);"));
+  q.bindValue(QSL(":account_id"), account_id);
+
   if (!q.exec()) {
     qWarning("Removing of left over messages failed: '%s'.", qPrintable(q.lastError().text()));
     return false;
@@ -754,57 +1031,140 @@ bool DatabaseQueries::purgeLeftoverMessages(QSqlDatabase db, int account_id) {
   }
 }
 
-bool DatabaseQueries::storeAccountTree(QSqlDatabase db, RootItem *tree_root, int account_id) {
-  QSqlQuery query_category(db);
-  QSqlQuery query_feed(db);
+int DatabaseQueries::parentCategoryId(const RootItem *item) {
+  if (item->parent() == NULL || item->parent()->kind() == RootItemKind::ServiceRoot) {
+    return NO_PARENT_CATEGORY;
+  }
+  else {
+    return item->parent()->id();
+  }
+}
+
+int DatabaseQueries::parentCategoryCustomId(const RootItem *item) {
+  if (item->parent() == NULL || item->parent()->kind() == RootItemKind::ServiceRoot) {
+    return NO_PARENT_CATEGORY;
+  }
+  else {
+    return item->parent()->customId();
+  }
+}
+
+bool DatabaseQueries::updateAccountTree(QSqlDatabase db, const QList<RootItem*> &added_items,
+                                        const QList<RootItem*> &changed_items, const QList<RootItem*> &removed_items,
+                                        int account_id) {
+  SqlQuery query_begin_transaction(db, Q_FUNC_INFO);
+
+  if (!query_begin_transaction.exec(qApp->database()->obtainBeginTransactionSql())) {
+    qCritical("Transaction start for account tree update failed: '%s'.", qPrintable(query_begin_transaction.lastError().text()));
+    return false;
+  }
+
+  SqlQuery query_category(db, Q_FUNC_INFO);
+  SqlQuery query_feed(db, Q_FUNC_INFO);
+  bool result = true;
+
   query_category.setForwardOnly(true);
   query_feed.setForwardOnly(true);
+
+  // Insert new items first, so that their children obtain valid parent IDs.
   query_category.prepare("INSERT INTO Categories (parent_id, title, account_id, custom_id) "
                          "VALUES (:parent_id, :title, :account_id, :custom_id);");
   query_feed.prepare("INSERT INTO Feeds (title, icon, category, protected, update_type, update_interval, account_id, custom_id) "
                      "VALUES (:title, :icon, :category, :protected, :update_type, :update_interval, :account_id, :custom_id);");
 
-  // Iterate all children.
-  foreach (RootItem *child, tree_root->getSubTree()) {
-    if (child->kind() == RootItemKind::Category) {
-      query_category.bindValue(QSL(":parent_id"), child->parent()->id());
-      query_category.bindValue(QSL(":title"), child->title());
+  foreach (RootItem *item, added_items) {
+    if (item->kind() == RootItemKind::Category) {
+      query_category.bindValue(QSL(":parent_id"), parentCategoryId(item));
+      query_category.bindValue(QSL(":title"), item->title());
       query_category.bindValue(QSL(":account_id"), account_id);
-      query_category.bindValue(QSL(":custom_id"), QString::number(child->toCategory()->customId()));
+      query_category.bindValue(QSL(":custom_id"), QString::number(item->customId()));
 
-      if (query_category.exec()) {
-        child->setId(query_category.lastInsertId().toInt());
-      }
-      else {
-        return false;
+      if ((result = query_category.exec())) {
+        item->setId(query_category.lastInsertId().toInt());
       }
     }
-    else if (child->kind() == RootItemKind::Feed) {
-      Feed *feed = child->toFeed();
+    else if (item->kind() == RootItemKind::Feed) {
+      Feed *feed = item->toFeed();
 
       query_feed.bindValue(QSL(":title"), feed->title());
-      query_feed.bindValue(QSL(":icon"), qApp->icons()->toByteArray(feed->icon()));
-      query_feed.bindValue(QSL(":category"), feed->parent()->customId());
+      query_feed.bindValue(QSL(":icon"), storeIcon(db, feed->icon()));
+      query_feed.bindValue(QSL(":category"), parentCategoryCustomId(feed));
       query_feed.bindValue(QSL(":protected"), 0);
       query_feed.bindValue(QSL(":update_type"), (int) feed->autoUpdateType());
       query_feed.bindValue(QSL(":update_interval"), feed->autoUpdateInitialInterval());
       query_feed.bindValue(QSL(":account_id"), account_id);
       query_feed.bindValue(QSL(":custom_id"), feed->customId());
 
-      if (query_feed.exec()) {
+      if ((result = query_feed.exec())) {
         feed->setId(query_feed.lastInsertId().toInt());
       }
-      else {
-        return false;
+    }
+
+    if (!result) {
+      break;
+    }
+  }
+
+  // Existing items could be renamed or moved.
+  query_category.prepare(QSL("UPDATE Categories SET parent_id = :parent_id, title = :title WHERE id = :id;"));
+  query_feed.prepare(QSL("UPDATE Feeds SET title = :title, icon = :icon, category = :category WHERE id = :id;"));
+
+  for (int i = 0; result && i < changed_items.size(); i++) {
+    RootItem *item = changed_items.at(i);
+
+    if (item->kind() == RootItemKind::Category) {
+      query_category.bindValue(QSL(":parent_id"), parentCategoryId(item));
+      query_category.bindValue(QSL(":title"), item->title());
+      query_category.bindValue(QSL(":id"), item->id());
+
+      result = query_category.exec();
+    }
+    else if (item->kind() == RootItemKind::Feed) {
+      query_feed.bindValue(QSL(":title"), item->title());
+      query_feed.bindValue(QSL(":icon"), storeIcon(db, item->icon()));
+      query_feed.bindValue(QSL(":category"), parentCategoryCustomId(item));
+      query_feed.bindValue(QSL(":id"), item->id());
+
+      result = query_feed.exec();
+    }
+  }
+
+  // Remove items (including their sub-items) which are not present anymore.
+  query_category.prepare(QSL("DELETE FROM Categories WHERE id = :id;"));
+  query_feed.prepare(QSL("DELETE FROM Feeds WHERE id = :id;"));
+
+  for (int i = 0; result && i < removed_items.size(); i++) {
+    foreach (RootItem *item, removed_items.at(i)->getSubTree()) {
+      if (item->kind() == RootItemKind::Category) {
+        query_category.bindValue(QSL(":id"), item->id());
+        result &= query_category.exec();
+      }
+      else if (item->kind() == RootItemKind::Feed) {
+        query_feed.bindValue(QSL(":id"), item->id());
+        result &= query_feed.exec();
       }
     }
   }
 
-  return true;
+  if (!result) {
+    qCritical("Updating of account tree failed: '%s', '%s'.",
+              qPrintable(query_category.lastError().text()),
+              qPrintable(query_feed.lastError().text()));
+    db.rollback();
+    return false;
+  }
+  else if (!db.commit()) {
+    qCritical("Transaction commit for account tree update failed: '%s'.", qPrintable(db.lastError().text()));
+    db.rollback();
+    return false;
+  }
+  else {
+    return true;
+  }
 }
 
 QStringList DatabaseQueries::customIdsOfMessagesFromAccount(QSqlDatabase db, int account_id, bool *ok) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   QStringList ids;
   q.setForwardOnly(true);
   q.prepare(QSL("SELECT custom_id FROM Messages WHERE is_deleted = 0 AND is_pdeleted = 0 AND account_id = :account_id;"));
@@ -825,7 +1185,7 @@ QStringList DatabaseQueries::customIdsOfMessagesFromAccount(QSqlDatabase db, int
 }
 
 QStringList DatabaseQueries::customIdsOfMessagesFromBin(QSqlDatabase db, int account_id, bool *ok) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   QStringList ids;
   q.setForwardOnly(true);
   q.prepare(QSL("SELECT custom_id FROM Messages WHERE is_deleted = 1 AND is_pdeleted = 0 AND account_id = :account_id;"));
@@ -846,7 +1206,7 @@ QStringList DatabaseQueries::customIdsOfMessagesFromBin(QSqlDatabase db, int acc
 }
 
 QStringList DatabaseQueries::customIdsOfMessagesFromFeed(QSqlDatabase db, int feed_custom_id, int account_id, bool *ok) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   QStringList ids;
   q.setForwardOnly(true);
   q.prepare(QSL("SELECT custom_id FROM Messages WHERE is_deleted = 0 AND is_pdeleted = 0 AND feed = :feed AND account_id = :account_id;"));
@@ -868,7 +1228,7 @@ QStringList DatabaseQueries::customIdsOfMessagesFromFeed(QSqlDatabase db, int fe
 }
 
 QList<ServiceRoot*> DatabaseQueries::getOwnCloudAccounts(QSqlDatabase db, bool *ok) {
-  QSqlQuery query(db);
+  SqlQuery query(db, Q_FUNC_INFO);
   QList<ServiceRoot*> roots;
 
   if (query.exec("SELECT * FROM OwnCloudAccounts;")) {
@@ -877,9 +1237,10 @@ QList<ServiceRoot*> DatabaseQueries::getOwnCloudAccounts(QSqlDatabase db, bool *
       root->setId(query.value(0).toInt());
       root->setAccountId(query.value(0).toInt());
       root->network()->setAuthUsername(query.value(1).toString());
-      root->network()->setAuthPassword(TextFactory::decrypt(query.value(2).toString()));
+      root->network()->setEncryptedAuthPassword(query.value(2).toString());
       root->network()->setUrl(query.value(3).toString());
       root->network()->setForceServerSideUpdate(query.value(4).toBool());
+      root->setLastModified(query.value(5).value<qint64>());
 
       root->updateTitle();
       roots.append(root);
@@ -901,7 +1262,7 @@ QList<ServiceRoot*> DatabaseQueries::getOwnCloudAccounts(QSqlDatabase db, bool *
 }
 
 QList<ServiceRoot*> DatabaseQueries::getTtRssAccounts(QSqlDatabase db, bool *ok) {
-  QSqlQuery query(db);
+  SqlQuery query(db, Q_FUNC_INFO);
   QList<ServiceRoot*> roots;
 
   if (query.exec("SELECT * FROM TtRssAccounts;")) {
@@ -910,10 +1271,10 @@ QList<ServiceRoot*> DatabaseQueries::getTtRssAccounts(QSqlDatabase db, bool *ok)
       root->setId(query.value(0).toInt());
       root->setAccountId(query.value(0).toInt());
       root->network()->setUsername(query.value(1).toString());
-      root->network()->setPassword(TextFactory::decrypt(query.value(2).toString()));
+      root->network()->setEncryptedPassword(query.value(2).toString());
       root->network()->setAuthIsUsed(query.value(3).toBool());
       root->network()->setAuthUsername(query.value(4).toString());
-      root->network()->setAuthPassword(TextFactory::decrypt(query.value(5).toString()));
+      root->network()->setEncryptedAuthPassword(query.value(5).toString());
       root->network()->setUrl(query.value(6).toString());
       root->network()->setForceServerSideUpdate(query.value(7).toBool());
 
@@ -937,7 +1298,7 @@ QList<ServiceRoot*> DatabaseQueries::getTtRssAccounts(QSqlDatabase db, bool *ok)
 }
 
 bool DatabaseQueries::deleteOwnCloudAccount(QSqlDatabase db, int account_id) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
 
   q.setForwardOnly(true);
   q.prepare(QSL("DELETE FROM OwnCloudAccounts WHERE id = :id;"));
@@ -948,7 +1309,7 @@ bool DatabaseQueries::deleteOwnCloudAccount(QSqlDatabase db, int account_id) {
 
 bool DatabaseQueries::overwriteOwnCloudAccount(QSqlDatabase db, const QString &username, const QString &password,
                                                const QString &url, bool force_server_side_feed_update, int account_id) {
-  QSqlQuery query(db);
+  SqlQuery query(db, Q_FUNC_INFO);
 
   query.prepare("UPDATE OwnCloudAccounts "
                 "SET username = :username, password = :password, url = :url, force_update = :force_update "
@@ -971,7 +1332,7 @@ bool DatabaseQueries::overwriteOwnCloudAccount(QSqlDatabase db, const QString &u
 bool DatabaseQueries::createOwnCloudAccount(QSqlDatabase db, int id_to_assign, const QString &username,
                                             const QString &password, const QString &url,
                                             bool force_server_side_feed_update) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
 
   q.prepare("INSERT INTO OwnCloudAccounts (id, username, password, url, force_update) "
             "VALUES (:id, :username, :password, :url, :force_update);");
@@ -990,8 +1351,25 @@ bool DatabaseQueries::createOwnCloudAccount(QSqlDatabase db, int id_to_assign, c
   }
 }
 
+bool DatabaseQueries::overwriteOwnCloudLastModified(QSqlDatabase db, qint64 last_modified, int account_id) {
+  SqlQuery q(db, Q_FUNC_INFO);
+
+  q.setForwardOnly(true);
+  q.prepare(QSL("UPDATE OwnCloudAccounts SET last_modified = :last_modified WHERE id = :id;"));
+  q.bindValue(QSL(":last_modified"), last_modified);
+  q.bindValue(QSL(":id"), account_id);
+
+  if (q.exec()) {
+    return true;
+  }
+  else {
+    qWarning("ownCloud: Updating last-modified stamp of account failed: '%s'.", qPrintable(q.lastError().text()));
+    return false;
+  }
+}
+
 int DatabaseQueries::createAccount(QSqlDatabase db, const QString &code, bool *ok) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
 
   // First obtain the ID, which can be assigned to this new account.
   if (!q.exec("SELECT max(id) FROM Accounts;") || !q.next()) {
@@ -1031,7 +1409,7 @@ Assignment DatabaseQueries::getOwnCloudCategories(QSqlDatabase db, int account_i
   Assignment categories;
 
   // Obtain data for categories from the database.
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   q.setForwardOnly(true);
   q.prepare(QSL("SELECT * FROM Categories WHERE account_id = :account_id;"));
   q.bindValue(QSL(":account_id"), account_id);
@@ -1062,7 +1440,7 @@ Assignment DatabaseQueries::getOwnCloudCategories(QSqlDatabase db, int account_i
 Assignment DatabaseQueries::getOwnCloudFeeds(QSqlDatabase db, int account_id, bool *ok) {
   Assignment feeds;
 
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   q.setForwardOnly(true);
   q.prepare(QSL("SELECT * FROM Feeds WHERE account_id = :account_id;"));
   q.bindValue(QSL(":account_id"), account_id);
@@ -1091,7 +1469,7 @@ Assignment DatabaseQueries::getOwnCloudFeeds(QSqlDatabase db, int account_id, bo
 }
 
 bool DatabaseQueries::deleteFeed(QSqlDatabase db, int feed_custom_id, int account_id) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   q.setForwardOnly(true);
 
   // Remove all messages from this feed.
@@ -1103,6 +1481,14 @@ bool DatabaseQueries::deleteFeed(QSqlDatabase db, int feed_custom_id, int accoun
     return false;
   }
 
+  q.prepare(QSL("DELETE FROM ArchivedMessages WHERE feed = :feed AND account_id = :account_id;"));
+  q.bindValue(QSL(":feed"), feed_custom_id);
+  q.bindValue(QSL(":account_id"), account_id);
+
+  if (!q.exec()) {
+    return false;
+  }
+
   // Remove feed itself.
   q.prepare(QSL("DELETE FROM Feeds WHERE custom_id = :feed AND account_id = :account_id;"));
   q.bindValue(QSL(":feed"), feed_custom_id);
@@ -1112,7 +1498,7 @@ bool DatabaseQueries::deleteFeed(QSqlDatabase db, int feed_custom_id, int accoun
 }
 
 bool DatabaseQueries::deleteCategory(QSqlDatabase db, int id) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
 
   // Remove this category from database.
   q.setForwardOnly(true);
@@ -1125,7 +1511,7 @@ bool DatabaseQueries::deleteCategory(QSqlDatabase db, int id) {
 int DatabaseQueries::addCategory(QSqlDatabase db, int parent_id, int account_id, const QString &title,
                                  const QString &description, QDateTime creation_date, const QIcon &icon,
                                  bool *ok) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
 
   q.setForwardOnly(true);
   q.prepare("INSERT INTO Categories "
@@ -1135,7 +1521,7 @@ int DatabaseQueries::addCategory(QSqlDatabase db, int parent_id, int account_id,
   q.bindValue(QSL(":title"), title);
   q.bindValue(QSL(":description"), description);
   q.bindValue(QSL(":date_created"), creation_date.toMSecsSinceEpoch());
-  q.bindValue(QSL(":icon"), qApp->icons()->toByteArray(icon));
+  q.bindValue(QSL(":icon"), storeIcon(db, icon));
   q.bindValue(QSL(":account_id"), account_id);
 
   if (!q.exec()) {
@@ -1167,7 +1553,7 @@ int DatabaseQueries::addCategory(QSqlDatabase db, int parent_id, int account_id,
 
 bool DatabaseQueries::editCategory(QSqlDatabase db, int parent_id, int category_id,
                                    const QString &title, const QString &description, const QIcon &icon) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
 
   q.setForwardOnly(true);
   q.prepare("UPDATE Categories "
@@ -1175,7 +1561,7 @@ bool DatabaseQueries::editCategory(QSqlDatabase db, int parent_id, int category_
             "WHERE id = :id;");
   q.bindValue(QSL(":title"), title);
   q.bindValue(QSL(":description"), description);
-  q.bindValue(QSL(":icon"), qApp->icons()->toByteArray(icon));
+  q.bindValue(QSL(":icon"), storeIcon(db, icon));
   q.bindValue(QSL(":parent_id"), parent_id);
   q.bindValue(QSL(":id"), category_id);
 
@@ -1188,7 +1574,7 @@ int DatabaseQueries::addFeed(QSqlDatabase db, int parent_id, int account_id, con
                              const QString &username, const QString &password,
                              Feed::AutoUpdateType auto_update_type,
                              int auto_update_interval, StandardFeed::Type feed_format, bool *ok) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
 
   q.setForwardOnly(true);
   q.prepare("INSERT INTO Feeds "
@@ -1197,7 +1583,7 @@ int DatabaseQueries::addFeed(QSqlDatabase db, int parent_id, int account_id, con
   q.bindValue(QSL(":title"), title);
   q.bindValue(QSL(":description"), description);
   q.bindValue(QSL(":date_created"), creation_date.toMSecsSinceEpoch());
-  q.bindValue(QSL(":icon"), qApp->icons()->toByteArray(icon));
+  q.bindValue(QSL(":icon"), storeIcon(db, icon));
   q.bindValue(QSL(":category"), parent_id);
   q.bindValue(QSL(":encoding"), encoding);
   q.bindValue(QSL(":url"), url);
@@ -1247,7 +1633,7 @@ bool DatabaseQueries::editFeed(QSqlDatabase db, int parent_id, int feed_id, cons
                                const QString &username, const QString &password,
                                Feed::AutoUpdateType auto_update_type,
                                int auto_update_interval, StandardFeed::Type feed_format) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   q.setForwardOnly(true);
 
   q.prepare("UPDATE Feeds "
@@ -1255,7 +1641,7 @@ bool DatabaseQueries::editFeed(QSqlDatabase db, int parent_id, int feed_id, cons
             "WHERE id = :id;");
   q.bindValue(QSL(":title"), title);
   q.bindValue(QSL(":description"), description);
-  q.bindValue(QSL(":icon"), qApp->icons()->toByteArray(icon));
+  q.bindValue(QSL(":icon"), storeIcon(db, icon));
   q.bindValue(QSL(":category"), parent_id);
   q.bindValue(QSL(":encoding"), encoding);
   q.bindValue(QSL(":url"), url);
@@ -1277,9 +1663,123 @@ bool DatabaseQueries::editFeed(QSqlDatabase db, int parent_id, int feed_id, cons
   return q.exec();
 }
 
+bool DatabaseQueries::editFeedIcon(QSqlDatabase db, int feed_id, const QString &icon_hash) {
+  SqlQuery q(db, Q_FUNC_INFO);
+  q.setForwardOnly(true);
+
+  q.prepare(QSL("UPDATE Feeds SET icon = :icon WHERE id = :id;"));
+  q.bindValue(QSL(":icon"), icon_hash);
+  q.bindValue(QSL(":id"), feed_id);
+
+  return q.exec();
+}
+
+bool DatabaseQueries::editFeedRetentionPolicy(QSqlDatabase db, int feed_id, const RetentionPolicy &policy) {
+  SqlQuery q(db, Q_FUNC_INFO);
+
+  q.setForwardOnly(true);
+  q.prepare("UPDATE Feeds "
+            "SET retention_max_count = :retention_max_count, retention_max_age = :retention_max_age, "
+            "retention_keep_starred = :retention_keep_starred "
+            "WHERE id = :id;");
+
+  q.bindValue(QSL(":retention_max_count"), policy.m_maxCount);
+  q.bindValue(QSL(":retention_max_age"), policy.m_maxAge);
+  q.bindValue(QSL(":retention_keep_starred"), policy.m_keepStarred ? 1 : 0);
+  q.bindValue(QSL(":id"), feed_id);
+
+  return q.exec();
+}
+
+bool DatabaseQueries::editCategoryRetentionPolicy(QSqlDatabase db, int category_id, const RetentionPolicy &policy) {
+  SqlQuery q(db, Q_FUNC_INFO);
+
+  q.setForwardOnly(true);
+  q.prepare("UPDATE Categories "
+            "SET retention_max_count = :retention_max_count, retention_max_age = :retention_max_age, "
+            "retention_keep_starred = :retention_keep_starred "
+            "WHERE id = :id;");
+
+  q.bindValue(QSL(":retention_max_count"), policy.m_maxCount);
+  q.bindValue(QSL(":retention_max_age"), policy.m_maxAge);
+  q.bindValue(QSL(":retention_keep_starred"), policy.m_keepStarred ? 1 : 0);
+  q.bindValue(QSL(":id"), category_id);
+
+  return q.exec();
+}
+
+int DatabaseQueries::enforceRetentionPolicy(QSqlDatabase db, int feed_custom_id, int account_id,
+                                            const RetentionPolicy &policy, bool *ok) {
+  SqlQuery q(db, Q_FUNC_INFO);
+  const QString starred_condition = policy.m_keepStarred ? QSL(" AND is_important = 0") : QString();
+  int removed_messages = 0;
+
+  if (ok != NULL) {
+    *ok = false;
+  }
+
+  q.setForwardOnly(true);
+
+  // All queries go through (account_id, feed, date_created) index.
+  if (policy.m_maxAge > 0) {
+    q.prepare(QSL("DELETE FROM Messages WHERE account_id = :account_id AND feed = :feed AND date_created < :date_created") +
+              starred_condition + QL1C(';'));
+    q.bindValue(QSL(":account_id"), account_id);
+    q.bindValue(QSL(":feed"), feed_custom_id);
+    q.bindValue(QSL(":date_created"), policy.ageBarrier().toMSecsSinceEpoch());
+
+    if (!q.exec()) {
+      qWarning("Removing of old messages of feed '%d' failed: '%s'.", feed_custom_id, qPrintable(q.lastError().text()));
+      return removed_messages;
+    }
+
+    removed_messages += q.numRowsAffected();
+  }
+
+  if (policy.m_maxCount > 0) {
+    // Find newest message which is not kept anymore, it is removed along with all older messages.
+    q.prepare(QString("SELECT date_created, id FROM Messages WHERE account_id = :account_id AND feed = :feed%1 "
+                      "ORDER BY date_created DESC, id DESC LIMIT 1 OFFSET %2;").arg(starred_condition,
+                                                                                   QString::number(policy.m_maxCount)));
+    q.bindValue(QSL(":account_id"), account_id);
+    q.bindValue(QSL(":feed"), feed_custom_id);
+
+    if (!q.exec()) {
+      qWarning("Selecting of surplus messages of feed '%d' failed: '%s'.", feed_custom_id, qPrintable(q.lastError().text()));
+      return removed_messages;
+    }
+
+    if (q.next()) {
+      const qint64 date_created = q.value(0).value<qint64>();
+      const int id = q.value(1).toInt();
+
+      q.prepare(QSL("DELETE FROM Messages WHERE account_id = :account_id AND feed = :feed AND "
+                    "(date_created < :date_created OR (date_created = :date_created AND id <= :id))") +
+                starred_condition + QL1C(';'));
+      q.bindValue(QSL(":account_id"), account_id);
+      q.bindValue(QSL(":feed"), feed_custom_id);
+      q.bindValue(QSL(":date_created"), date_created);
+      q.bindValue(QSL(":id"), id);
+
+      if (!q.exec()) {
+        qWarning("Removing of surplus messages of feed '%d' failed: '%s'.", feed_custom_id, qPrintable(q.lastError().text()));
+        return removed_messages;
+      }
+
+      removed_messages += q.numRowsAffected();
+    }
+  }
+
+  if (ok != NULL) {
+    *ok = true;
+  }
+
+  return removed_messages;
+}
+
 bool DatabaseQueries::editBaseFeed(QSqlDatabase db, int feed_id, Feed::AutoUpdateType auto_update_type,
                                    int auto_update_interval) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
 
   q.setForwardOnly(true);
   q.prepare("UPDATE Feeds "
@@ -1294,7 +1794,7 @@ bool DatabaseQueries::editBaseFeed(QSqlDatabase db, int feed_id, Feed::AutoUpdat
 }
 
 QList<ServiceRoot*> DatabaseQueries::getAccounts(QSqlDatabase db, bool *ok) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   QList<ServiceRoot*> roots;
 
   q.setForwardOnly(true);
@@ -1325,7 +1825,7 @@ Assignment DatabaseQueries::getCategories(QSqlDatabase db, int account_id, bool
   Assignment categories;
 
   // Obtain data for categories from the database.
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
   q.setForwardOnly(true);
   q.prepare(QSL("SELECT * FROM Categories WHERE account_id = :account_id;"));
   q.bindValue(QSL(":account_id"), account_id);
@@ -1357,7 +1857,7 @@ Assignment DatabaseQueries::getCategories(QSqlDatabase db, int account_id, bool
 
 Assignment DatabaseQueries::getFeeds(QSqlDatabase db, int account_id, bool *ok) {
   Assignment feeds;
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
 
   q.setForwardOnly(true);
   q.prepare(QSL("SELECT * FROM Feeds WHERE account_id = :account_id;"));
@@ -1403,7 +1903,7 @@ Assignment DatabaseQueries::getFeeds(QSqlDatabase db, int account_id, bool *ok)
 }
 
 bool DatabaseQueries::deleteTtRssAccount(QSqlDatabase db, int account_id) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
 
   q.setForwardOnly(true);
   q.prepare(QSL("DELETE FROM TtRssAccounts WHERE id = :id;"));
@@ -1417,7 +1917,7 @@ bool DatabaseQueries::deleteTtRssAccount(QSqlDatabase db, int account_id) {
 bool DatabaseQueries::overwriteTtRssAccount(QSqlDatabase db, const QString &username, const QString &password,
                                             bool auth_protected, const QString &auth_username, const QString &auth_password,
                                             const QString &url, bool force_server_side_feed_update, int account_id) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
 
   q.prepare("UPDATE TtRssAccounts "
             "SET username = :username, password = :password, url = :url, auth_protected = :auth_protected, "
@@ -1445,7 +1945,7 @@ bool DatabaseQueries::createTtRssAccount(QSqlDatabase db, int id_to_assign, cons
                                          const QString &password, bool auth_protected, const QString &auth_username,
                                          const QString &auth_password, const QString &url,
                                          bool force_server_side_feed_update) {
-  QSqlQuery q(db);
+  SqlQuery q(db, Q_FUNC_INFO);
 
   q.prepare("INSERT INTO TtRssAccounts (id, username, password, auth_protected, auth_username, auth_password, url, force_update) "
             "VALUES (:id, :username, :password, :auth_protected, :auth_username, :auth_password, :url, :force_update);");
@@ -1471,7 +1971,7 @@ Assignment DatabaseQueries::getTtRssCategories(QSqlDatabase db, int account_id,
   Assignment categories;
 
   // Obtain data for categories from the database.
-  QSqlQuery query_categories(db);
+  SqlQuery query_categories(db, Q_FUNC_INFO);
   query_categories.setForwardOnly(true);
   query_categories.prepare(QSL("SELECT * FROM Categories WHERE account_id = :account_id;"));
   query_categories.bindValue(QSL(":account_id"), account_id);
@@ -1504,7 +2004,7 @@ Assignment DatabaseQueries::getTtRssFeeds(QSqlDatabase db, int account_id, bool
   Assignment feeds;
 
   // All categories are now loaded.
-  QSqlQuery query_feeds(db);
+  SqlQuery query_feeds(db, Q_FUNC_INFO);
   query_feeds.setForwardOnly(true);
   query_feeds.prepare(QSL("SELECT * FROM Feeds WHERE account_id = :account_id;"));
   query_feeds.bindValue(QSL(":account_id"), account_id);
@@ -1535,3 +2035,142 @@ Assignment DatabaseQueries::getTtRssFeeds(QSqlDatabase db, int account_id, bool
 
 DatabaseQueries::DatabaseQueries() {
 }
+
+QString DatabaseQueries::storeIcon(QSqlDatabase db, const QIcon &icon, bool *ok) {
+  if (icon.isNull()) {
+    if (ok != nullptr) {
+      *ok = true;
+    }
+
+    return QString();
+  }
+
+  const QString stored_hash = qApp->icons()->storedIconHash(icon);
+
+  if (!stored_hash.isEmpty()) {
+    // This icon was loaded from database, so it is stored already.
+    if (ok != nullptr) {
+      *ok = true;
+    }
+
+    return stored_hash;
+  }
+  else {
+    return storeIconData(db, qApp->icons()->toByteArray(icon), ok);
+  }
+}
+
+QString DatabaseQueries::storeIconData(QSqlDatabase db, const QByteArray &data, bool *ok) {
+  const QString hash = IconFactory::iconHash(data);
+  SqlQuery q(db, Q_FUNC_INFO);
+
+  q.setForwardOnly(true);
+  q.prepare(QSL("SELECT COUNT(*) FROM Icons WHERE hash = :hash;"));
+  q.bindValue(QSL(":hash"), hash);
+
+  bool result = q.exec() && q.next();
+
+  if (result && q.value(0).toInt() == 0) {
+    q.prepare(QSL("INSERT INTO Icons (hash, data) VALUES (:hash, :data);"));
+    q.bindValue(QSL(":hash"), hash);
+    q.bindValue(QSL(":data"), data);
+    result = q.exec();
+  }
+
+  if (ok != nullptr) {
+    *ok = result;
+  }
+
+  if (result) {
+    return hash;
+  }
+  else {
+    qWarning("Failed to store icon: '%s'.", qPrintable(q.lastError().text()));
+    return QString();
+  }
+}
+
+QByteArray DatabaseQueries::getIconData(QSqlDatabase db, const QString &hash, bool *ok) {
+  SqlQuery q(db, Q_FUNC_INFO);
+
+  q.setForwardOnly(true);
+  q.prepare(QSL("SELECT data FROM Icons WHERE hash = :hash;"));
+  q.bindValue(QSL(":hash"), hash);
+
+  if (q.exec() && q.next()) {
+    if (ok != nullptr) {
+      *ok = true;
+    }
+
+    return q.value(0).toByteArray();
+  }
+  else {
+    if (ok != nullptr) {
+      *ok = false;
+    }
+
+    qWarning("Icon '%s' was not found in database.", qPrintable(hash));
+    return QByteArray();
+  }
+}
+
+bool DatabaseQueries::purgeUnusedIcons(QSqlDatabase db) {
+  SqlQuery q(db, Q_FUNC_INFO);
+
+  q.setForwardOnly(true);
+  return q.exec(QSL("DELETE FROM Icons WHERE "
+                    "hash NOT IN (SELECT icon FROM Feeds WHERE icon IS NOT NULL) AND "
+                    "hash NOT IN (SELECT icon FROM Categories WHERE icon IS NOT NULL);"));
+}
+
+bool DatabaseQueries::moveIconsToIconTable(QSqlDatabase db, int schema_version) {
+  SqlQuery q(db, Q_FUNC_INFO);
+
+  q.setForwardOnly(true);
+
+  if (!db.transaction()) {
+    qWarning("Failed to start transaction for moving icons: '%s'.", qPrintable(db.lastError().text()));
+    return false;
+  }
+
+  foreach (const QString &table, QStringList() << QSL("Categories") << QSL("Feeds")) {
+    QList<QPair<int, QByteArray> > icons;
+
+    if (!q.exec(QString("SELECT id, icon FROM %1;").arg(table))) {
+      db.rollback();
+      return false;
+    }
+
+    while (q.next()) {
+      icons.append(QPair<int, QByteArray>(q.value(0).toInt(), q.value(1).toByteArray()));
+    }
+
+    q.prepare(QString("UPDATE %1 SET icon = :icon WHERE id = :id;").arg(table));
+
+    for (int i = 0; i < icons.size(); i++) {
+      bool ok = true;
+      const QString hash = icons.at(i).second.isEmpty() ? QString() : storeIconData(db, icons.at(i).second, &ok);
+
+      q.bindValue(QSL(":icon"), hash);
+      q.bindValue(QSL(":id"), icons.at(i).first);
+
+      if (!ok || !q.exec()) {
+        qWarning("Failed to move icon of item '%d' in table '%s'.", icons.at(i).first, qPrintable(table));
+        db.rollback();
+        return false;
+      }
+    }
+  }
+
+  // Schema is updated only if icons are moved, otherwise they are moved again on next start.
+  q.prepare(QSL("UPDATE Information SET inf_value = :version WHERE inf_key = 'schema_version';"));
+  q.bindValue(QSL(":version"), QString::number(schema_version));
+
+  if (!q.exec()) {
+    qWarning("Failed to set schema version '%d': '%s'.", schema_version, qPrintable(q.lastError().text()));
+    db.rollback();
+    return false;
+  }
+
+  return db.commit();
+}
@@ -22,6 +22,8 @@
 
 #include "services/abstract/serviceroot.h"
 #include "services/standard/standardfeed.h"
+#include "miscellaneous/databasecleaner.h"
+#include "core/retentionpolicy.h"
 
 #include <QSqlQuery>
 
@@ -40,13 +42,26 @@ class DatabaseQueries {
     static bool restoreBin(QSqlDatabase db, int account_id);
 
     // Purge database.
-    static bool purgeImportantMessages(QSqlDatabase db);
-    static bool purgeReadMessages(QSqlDatabase db);
-    static bool purgeOldMessages(QSqlDatabase db, int older_than_days);
-    static bool purgeRecycleBin(QSqlDatabase db);
+    // Messages are removed in chunks ordered by their ID, each chunk in its own
+    // transaction, "last_id" is the highest ID processed so far.
+    static QString purgeMessagesCondition(const CleanerOrders &orders);
+    static int countMessagesToPurge(QSqlDatabase db, const QString &condition, bool *ok = NULL);
+    static int purgeMessagesChunk(QSqlDatabase db, const QString &condition, int chunk_size, int *last_id, bool *ok = NULL);
     static bool purgeMessagesFromBin(QSqlDatabase db, bool clear_only_read, int account_id);
     static bool purgeLeftoverMessages(QSqlDatabase db, int account_id);
 
+    // Converts contents of messages between plain and compressed form,
+    // messages are processed in chunks ordered by their ID just like when purging.
+    // Statistics describe contents after conversion, nothing is written in dry run.
+    static int countAllMessages(QSqlDatabase db, bool *ok = NULL);
+    static int convertMessageContentsChunk(QSqlDatabase db, MessageContents::Conversion conversion, bool dry_run, int chunk_size,
+                                           int *last_id, MessageContentsStatistics *statistics, bool *ok = NULL);
+
+    // Moves old read messages from "Messages" into "ArchivedMessages",
+    // messages are moved in chunks, each chunk in its own transaction.
+    static QString archiveMessagesCondition(int archive_after_days);
+    static int archiveMessagesChunk(QSqlDatabase db, const QString &condition, int chunk_size, int *last_id, bool *ok = NULL);
+
     // Obtain counts of unread/all messages.
     static QMap<int,QPair<int,int> > getMessageCountsForCategory(QSqlDatabase db, int custom_id, int account_id,
                                                                  bool including_total_counts, bool *ok = NULL);
@@ -73,7 +88,11 @@ class DatabaseQueries {
     static bool deleteAccountData(QSqlDatabase db, int account_id, bool delete_messages_too);
     static bool cleanFeeds(QSqlDatabase db, const QStringList &ids, bool clean_read_only, int account_id);
 
-    static bool storeAccountTree(QSqlDatabase db, RootItem *tree_root, int account_id);
+    // Stores changes of account tree. Added items must be ordered so that
+    // parents precede their children, removed items are deleted with their subtrees.
+    static bool updateAccountTree(QSqlDatabase db, const QList<RootItem*> &added_items,
+                                  const QList<RootItem*> &changed_items, const QList<RootItem*> &removed_items,
+                                  int account_id);
     static bool editBaseFeed(QSqlDatabase db, int feed_id, Feed::AutoUpdateType auto_update_type,
                              int auto_update_interval);
 
@@ -84,6 +103,7 @@ class DatabaseQueries {
                                          const QString &url, bool force_server_side_feed_update, int account_id);
     static bool createOwnCloudAccount(QSqlDatabase db, int id_to_assign, const QString &username, const QString &password,
                                       const QString &url, bool force_server_side_feed_update);
+    static bool overwriteOwnCloudLastModified(QSqlDatabase db, qint64 last_modified, int account_id);
     static int createAccount(QSqlDatabase db, const QString &code, bool *ok = NULL);
     static Assignment getOwnCloudCategories(QSqlDatabase db, int account_id, bool *ok = NULL);
     static Assignment getOwnCloudFeeds(QSqlDatabase db, int account_id, bool *ok = NULL);
@@ -106,6 +126,14 @@ class DatabaseQueries {
                          const QString &encoding, const QString &url, bool is_protected,
                          const QString &username, const QString &password, Feed::AutoUpdateType auto_update_type,
                          int auto_update_interval, StandardFeed::Type feed_format);
+    static bool editFeedIcon(QSqlDatabase db, int feed_id, const QString &icon_hash);
+
+    // Retention policies of feeds and categories, enforcing removes
+    // messages of single feed which are not kept by the policy.
+    static bool editFeedRetentionPolicy(QSqlDatabase db, int feed_id, const RetentionPolicy &policy);
+    static bool editCategoryRetentionPolicy(QSqlDatabase db, int category_id, const RetentionPolicy &policy);
+    static int enforceRetentionPolicy(QSqlDatabase db, int feed_custom_id, int account_id,
+                                      const RetentionPolicy &policy, bool *ok = NULL);
     static QList<ServiceRoot*> getAccounts(QSqlDatabase db, bool *ok = NULL);
     static Assignment getCategories(QSqlDatabase db, int account_id, bool *ok = NULL);
     static Assignment getFeeds(QSqlDatabase db, int account_id, bool *ok = NULL);
@@ -123,7 +151,24 @@ class DatabaseQueries {
     static Assignment getTtRssCategories(QSqlDatabase db, int account_id, bool *ok = NULL);
     static Assignment getTtRssFeeds(QSqlDatabase db, int account_id, bool *ok = NULL);
 
+    // Icons, feeds and categories refer to them via hashes of their data.
+    static QString storeIcon(QSqlDatabase db, const QIcon &icon, bool *ok = NULL);
+    static QByteArray getIconData(QSqlDatabase db, const QString &hash, bool *ok = NULL);
+    static bool purgeUnusedIcons(QSqlDatabase db);
+
+    // Moves icons which are saved directly in feeds and categories
+    // to icon table and sets given schema version in the same transaction,
+    // used when updating database schema.
+    static bool moveIconsToIconTable(QSqlDatabase db, int schema_version);
+
   private:
+    // Returns (custom) ID of category which contains given item,
+    // items placed directly in account root have no parent category.
+    static int parentCategoryId(const RootItem *item);
+    static int parentCategoryCustomId(const RootItem *item);
+
+    static QString storeIconData(QSqlDatabase db, const QByteArray &data, bool *ok = NULL);
+
     explicit DatabaseQueries();
 };
 
@@ -25,9 +25,19 @@
 #include <cstdlib>
 
 
+QElapsedTimer Debugging::s_startupTimer;
+
 Debugging::Debugging() {
 }
 
+void Debugging::logStartupStage(const QString &stage) {
+  if (!s_startupTimer.isValid()) {
+    s_startupTimer.start();
+  }
+
+  qDebug("Startup timeline: %s after %lld ms.", qPrintable(stage), s_startupTimer.elapsed());
+}
+
 void Debugging::performLog(const char *message, QtMsgType type, const char *file, const char *function, int line) {
   const char *type_string = typeToString(type);
 
@@ -19,6 +19,8 @@
 #define DEBUGGING_H
 
 #include <QtGlobal>
+#include <QElapsedTimer>
+#include <QString>
 
 
 class Debugging {
@@ -29,9 +31,15 @@ class Debugging {
     static void performLog(const char *message, QtMsgType type, const char *file = 0, const char *function = 0, int line = -1);
     static const char *typeToString(QtMsgType type);
 
+    // Logs given stage of application startup together with time elapsed
+    // since the first logged stage, so that startup can be measured.
+    static void logStartupStage(const QString &stage);
+
   private:
     // Constructor.
     explicit Debugging();
+
+    static QElapsedTimer s_startupTimer;
 };
 
 #endif // DEBUGGING_H
@@ -36,7 +36,8 @@
 
 FeedReader::FeedReader(QObject *parent)
   : QObject(parent), m_feedServices(QList<ServiceEntryPoint*>()), m_autoUpdateTimer(new QTimer(this)),
-    m_feedDownloaderThread(nullptr), m_feedDownloader(nullptr),
+    m_maintenanceTimer(new QTimer(this)), m_feedDownloaderThread(nullptr), m_feedDownloader(nullptr), m_feedDownloaderThreads(FEED_DOWNLOADER_MAX_THREADS),
+    m_lastUpdateResults(FeedDownloadResults()),
     m_dbCleanerThread(nullptr), m_dbCleaner(nullptr) {
   m_feedsModel = new FeedsModel(this);
   m_feedsProxyModel = new FeedsProxyModel(m_feedsModel, this);
@@ -46,6 +47,11 @@ FeedReader::FeedReader(QObject *parent)
   connect(m_autoUpdateTimer, &QTimer::timeout, this, &FeedReader::executeNextAutoUpdate);
   updateAutoUpdateStatus();
 
+  // Archiving and releasing of free database pages run periodically in the background.
+  connect(m_maintenanceTimer, &QTimer::timeout, this, &FeedReader::executeMaintenance);
+  m_maintenanceTimer->setInterval(MAINTENANCE_INTERVAL);
+  m_maintenanceTimer->start();
+
   if (qApp->settings()->value(GROUP(Feeds), SETTING(Feeds::FeedsUpdateOnStartup)).toBool()) {
     qDebug("Requesting update for all feeds on application startup.");
     QTimer::singleShot(STARTUP_UPDATE_DELAY, this, SLOT(updateAllFeeds()));
@@ -68,16 +74,17 @@ QList<ServiceEntryPoint*> FeedReader::feedServices() {
   return m_feedServices;
 }
 
-void FeedReader::updateFeeds(const QList<Feed*> &feeds) {
+bool FeedReader::updateFeeds(const QList<Feed*> &feeds) {
   if (!qApp->feedUpdateLock()->tryLock()) {
     qApp->showGuiMessage(tr("Cannot update all items"),
                          tr("You cannot update all items because another critical operation is ongoing."),
                          QSystemTrayIcon::Warning, qApp->mainFormWidget(), true);
-    return;
+    return false;
   }
 
   if (m_feedDownloader == nullptr) {
     m_feedDownloader = new FeedDownloader();
+    m_feedDownloader->setMaxThreadCount(m_feedDownloaderThreads);
     m_feedDownloaderThread = new QThread();
 
     // Downloader setup.
@@ -85,6 +92,7 @@ void FeedReader::updateFeeds(const QList<Feed*> &feeds) {
     m_feedDownloader->moveToThread(m_feedDownloaderThread);
 
     connect(m_feedDownloaderThread, &QThread::finished, m_feedDownloaderThread, &QThread::deleteLater);
+    connect(m_feedDownloader, &FeedDownloader::updateFinished, this, &FeedReader::rememberUpdateResults);
     connect(m_feedDownloader, &FeedDownloader::updateFinished, this, &FeedReader::feedUpdatesFinished);
     connect(m_feedDownloader, &FeedDownloader::updateProgress, this, &FeedReader::feedUpdatesProgress);
     connect(m_feedDownloader, &FeedDownloader::updateStarted, this, &FeedReader::feedUpdatesStarted);
@@ -95,6 +103,7 @@ void FeedReader::updateFeeds(const QList<Feed*> &feeds) {
   }
 
   QMetaObject::invokeMethod(m_feedDownloader, "updateFeeds", Q_ARG(QList<Feed*>, feeds));
+  return true;
 }
 
 void FeedReader::updateAutoUpdateStatus() {
@@ -132,6 +141,14 @@ bool FeedReader::isFeedUpdateRunning() const {
   return m_feedDownloader != nullptr && m_feedDownloader->isUpdateRunning();
 }
 
+void FeedReader::setFeedDownloaderThreads(int thread_count) {
+  m_feedDownloaderThreads = thread_count;
+
+  if (m_feedDownloader != nullptr) {
+    m_feedDownloader->setMaxThreadCount(thread_count);
+  }
+}
+
 DatabaseCleaner *FeedReader::databaseCleaner() {
   if (m_dbCleaner == nullptr) {
     m_dbCleaner = new DatabaseCleaner();
@@ -141,6 +158,7 @@ DatabaseCleaner *FeedReader::databaseCleaner() {
     qRegisterMetaType<CleanerOrders>("CleanerOrders");
     m_dbCleaner->moveToThread(m_dbCleanerThread);
     connect(m_dbCleanerThread, SIGNAL(finished()), m_dbCleanerThread, SLOT(deleteLater()));
+    connect(m_dbCleaner, &DatabaseCleaner::archiveFinished, this, &FeedReader::onArchiveFinished);
 
     // Connections are made, start the feed downloader thread.
     m_dbCleanerThread->start();
@@ -153,6 +171,14 @@ FeedDownloader *FeedReader::feedDownloader() const {
   return m_feedDownloader;
 }
 
+FeedDownloadResults FeedReader::lastUpdateResults() const {
+  return m_lastUpdateResults;
+}
+
+void FeedReader::rememberUpdateResults(FeedDownloadResults results) {
+  m_lastUpdateResults = results;
+}
+
 FeedsModel *FeedReader::feedsModel() const {
   return m_feedsModel;
 }
@@ -197,11 +223,35 @@ void FeedReader::executeNextAutoUpdate() {
   }
 }
 
+void FeedReader::executeMaintenance() {
+  if (qApp->settings()->value(GROUP(Database), SETTING(Database::ArchiveMessages)).toBool()) {
+    const int archive_after_days = qApp->settings()->value(GROUP(Database), SETTING(Database::ArchiveAfterDays)).toInt();
+
+    QMetaObject::invokeMethod(databaseCleaner(), "archiveMessages", Q_ARG(int, archive_after_days));
+  }
+
+  // Database file is shrinked in small portions instead of full vacuum.
+  QMetaObject::invokeMethod(databaseCleaner(), "releaseFreePages", Q_ARG(int, VACUUM_BACKGROUND_PAGES));
+}
+
+void FeedReader::onArchiveFinished(bool result, int archived_count) {
+  if (!result) {
+    qWarning("Archiving of messages failed, %d messages were archived.", archived_count);
+  }
+
+  if (archived_count > 0) {
+    // Archived messages are not counted anymore.
+    m_feedsModel->reloadCountsOfWholeModel();
+  }
+}
+
 void FeedReader::stop() {
   if (m_autoUpdateTimer->isActive()) {
     m_autoUpdateTimer->stop();
   }
 
+  m_maintenanceTimer->stop();
+
   // Close worker threads.
   if (m_feedDownloaderThread != nullptr && m_feedDownloaderThread->isRunning()) {
     m_feedDownloader->stopRunningUpdate();
@@ -223,6 +273,7 @@ void FeedReader::stop() {
 
   if (m_dbCleanerThread != nullptr && m_dbCleanerThread->isRunning()) {
     qDebug("Quitting database cleaner thread.");
+    m_dbCleaner->cancelPurge();
     m_dbCleanerThread->quit();
 
     if (!m_dbCleanerThread->wait(CLOSE_LOCK_TIMEOUT)) {
@@ -245,6 +296,8 @@ void FeedReader::stop() {
   if (qApp->settings()->value(GROUP(Messages), SETTING(Messages::ClearReadOnExit)).toBool()) {
     m_feedsModel->markItemCleared(m_feedsModel->rootItem(), true);
   }
+
+  m_feedsModel->saveCountsSnapshot();
 }
 
 MessagesProxyModel *FeedReader::messagesProxyModel() const {
@@ -52,11 +52,18 @@ class FeedReader : public QObject {
     FeedsProxyModel *feedsProxyModel() const;
     MessagesProxyModel *messagesProxyModel() const;
 
-    // Schedules given feeds for update.
-    void updateFeeds(const QList<Feed*> &feeds);
+    // Schedules given feeds for update. Returns false if the update
+    // was not started because another critical operation is ongoing.
+    bool updateFeeds(const QList<Feed*> &feeds);
 
     bool isFeedUpdateRunning() const;
 
+    // Sets how many feeds are downloaded in parallel.
+    void setFeedDownloaderThreads(int thread_count);
+
+    // Results (including per-feed statistics) of the last finished update run.
+    FeedDownloadResults lastUpdateResults() const;
+
     // Resets global auto-update intervals according to settings
     // and starts/stop the timer as needed.
     void updateAutoUpdateStatus();
@@ -71,6 +78,13 @@ class FeedReader : public QObject {
     // Is executed when next auto-update round could be done.
     void executeNextAutoUpdate();
 
+    void rememberUpdateResults(FeedDownloadResults results);
+
+    // Asks database cleaner to move old messages into archive if it is enabled
+    // and to release part of free pages of database file.
+    void executeMaintenance();
+    void onArchiveFinished(bool result, int archived_count);
+
   signals:
     void feedUpdatesStarted();
     void feedUpdatesFinished(FeedDownloadResults updated_feeds);
@@ -90,8 +104,12 @@ class FeedReader : public QObject {
     int m_globalAutoUpdateInitialInterval;
     int m_globalAutoUpdateRemainingInterval;
 
+    QTimer *m_maintenanceTimer;
+
     QThread *m_feedDownloaderThread;
     FeedDownloader *m_feedDownloader;
+    int m_feedDownloaderThreads;
+    FeedDownloadResults m_lastUpdateResults;
 
     QThread *m_dbCleanerThread;
     DatabaseCleaner *m_dbCleaner;
@@ -0,0 +1,114 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "miscellaneous/headlessupdater.h"
+
+#include "miscellaneous/application.h"
+#include "miscellaneous/feedreader.h"
+#include "core/feedsmodel.h"
+#include "services/abstract/serviceroot.h"
+
+#include <QTimer>
+#include <QTextStream>
+
+
+HeadlessUpdater::HeadlessUpdater(QObject *parent)
+  : QObject(parent), m_accountId(-1), m_exitCode(EXIT_SUCCESS), m_lockRetries(0), m_updateRunning(false) {
+}
+
+HeadlessUpdater::~HeadlessUpdater() {
+  qDebug("Destroying HeadlessUpdater instance.");
+}
+
+bool HeadlessUpdater::start(int account_id, int thread_count) {
+  bool account_found = account_id < 0;
+
+  foreach (const ServiceRoot *root, qApp->feedReader()->feedsModel()->serviceRoots()) {
+    account_found |= root->accountId() == account_id;
+  }
+
+  if (!account_found) {
+    QTextStream(stderr) << QSL("Account with ID %1 does not exist.").arg(account_id) << endl;
+    return false;
+  }
+
+  m_accountId = account_id;
+
+  qApp->feedReader()->setFeedDownloaderThreads(thread_count);
+
+  QTimer::singleShot(0, this, SLOT(startUpdate()));
+  return true;
+}
+
+void HeadlessUpdater::startUpdate() {
+  QList<Feed*> feeds;
+
+  // NOTE: Feeds are collected only now, because initial synchronization
+  // of online accounts replaces their whole subtrees.
+  foreach (ServiceRoot *root, qApp->feedReader()->feedsModel()->serviceRoots()) {
+    if (m_accountId < 0 || root->accountId() == m_accountId) {
+      feeds.append(root->getSubTreeFeeds());
+    }
+  }
+
+  // NOTE: Results of any previous run are already delivered, because
+  // the lock is released only after them.
+  if (qApp->feedReader()->updateFeeds(feeds)) {
+    qDebug("Started headless update of %d feeds.", feeds.size());
+    m_updateRunning = true;
+    connect(qApp->feedReader(), &FeedReader::feedUpdatesFinished, this, &HeadlessUpdater::onUpdateFinished,
+            Qt::UniqueConnection);
+  }
+  else if (++m_lockRetries < HEADLESS_LOCK_RETRY_COUNT) {
+    qDebug("Another critical operation is running, postponing headless update.");
+    QTimer::singleShot(HEADLESS_LOCK_RETRY_INTERVAL, this, SLOT(startUpdate()));
+  }
+  else {
+    QTextStream(stderr) << QSL("Update was not started because another critical operation is still running.") << endl;
+    m_exitCode = EXIT_FAILURE;
+    QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+  }
+}
+
+void HeadlessUpdater::onUpdateFinished(FeedDownloadResults results) {
+  if (!m_updateRunning) {
+    return;
+  }
+
+  m_updateRunning = false;
+  disconnect(qApp->feedReader(), &FeedReader::feedUpdatesFinished, this, &HeadlessUpdater::onUpdateFinished);
+
+  QTextStream output(stdout);
+
+  output << results.toJson();
+  output.flush();
+
+  foreach (const FeedUpdateStatistics &statistics, results.statistics()) {
+    if (statistics.m_error) {
+      m_exitCode = EXIT_FAILURE;
+    }
+  }
+
+  // Quit after "update lock" is unlocked, it is unlocked
+  // by event which is already queued.
+  QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+}
+
+void HeadlessUpdater::quit() {
+  qApp->exit(m_exitCode);
+}
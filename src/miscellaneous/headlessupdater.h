@@ -0,0 +1,60 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADLESSUPDATER_H
+#define HEADLESSUPDATER_H
+
+#include <QObject>
+
+#include "core/feeddownloader.h"
+
+
+// Performs single update of feeds without any GUI, prints
+// statistics of the update run to standard output and quits
+// the application. Used by "--headless --update-all" mode.
+class HeadlessUpdater : public QObject {
+    Q_OBJECT
+
+  public:
+    // Constructors and destructors.
+    explicit HeadlessUpdater(QObject *parent = 0);
+    virtual ~HeadlessUpdater();
+
+    // Schedules update of feeds of all accounts or of single
+    // account if "account_id" is not negative.
+    // Returns false if given account does not exist.
+    bool start(int account_id, int thread_count);
+
+  private slots:
+    // Starts the update once no other critical operation
+    // (for example initial synchronization of online account) runs.
+    // Quits with failure if the update cannot be started for too long.
+    void startUpdate();
+    void onUpdateFinished(FeedDownloadResults results);
+    void quit();
+
+  private:
+    int m_accountId;
+    int m_exitCode;
+    int m_lockRetries;
+
+    // Only results of update run started by this updater are reported.
+    bool m_updateRunning;
+};
+
+#endif // HEADLESSUPDATER_H
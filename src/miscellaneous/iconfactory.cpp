@@ -18,11 +18,60 @@
 #include "miscellaneous/iconfactory.h"
 
 #include "miscellaneous/settings.h"
+#include "miscellaneous/databasequeries.h"
 
 #include <QBuffer>
+#include <QCryptographicHash>
+#include <QIconEngine>
+#include <QPainter>
 
 
-IconFactory::IconFactory(QObject *parent) : QObject(parent) {
+// Icon engine of icons stored in database. Icon data are loaded
+// and decoded on first use.
+class StoredIconEngine : public QIconEngine {
+  public:
+    explicit StoredIconEngine(const QString &hash) : QIconEngine(), m_hash(hash), m_icon(QIcon()), m_loaded(false) {
+    }
+
+    void paint(QPainter *painter, const QRect &rect, QIcon::Mode mode, QIcon::State state) {
+      icon().paint(painter, rect, Qt::AlignCenter, mode, state);
+    }
+
+    QSize actualSize(const QSize &size, QIcon::Mode mode, QIcon::State state) {
+      return icon().actualSize(size, mode, state);
+    }
+
+    QPixmap pixmap(const QSize &size, QIcon::Mode mode, QIcon::State state) {
+      return icon().pixmap(size, mode, state);
+    }
+
+    QList<QSize> availableSizes(QIcon::Mode mode, QIcon::State state) const {
+      return icon().availableSizes(mode, state);
+    }
+
+    QIconEngine *clone() const {
+      return new StoredIconEngine(m_hash);
+    }
+
+  private:
+    const QIcon &icon() const {
+      if (!m_loaded) {
+        m_icon = IconFactory::fromByteArray(DatabaseQueries::getIconData(qApp->database()->connection(QSL("IconFactory"),
+                                                                                                      DatabaseFactory::FromSettings),
+                                                                          m_hash));
+        m_loaded = true;
+      }
+
+      return m_icon;
+    }
+
+    QString m_hash;
+    mutable QIcon m_icon;
+    mutable bool m_loaded;
+};
+
+IconFactory::IconFactory(QObject *parent)
+  : QObject(parent), m_storedIcons(QHash<QString, QIcon>()), m_storedIconHashes(QHash<qint64, QString>()) {
 }
 
 IconFactory::~IconFactory() {
@@ -45,6 +94,14 @@ QIcon IconFactory::fromByteArray(QByteArray array) {
 }
 
 QByteArray IconFactory::toByteArray(const QIcon &icon) {
+  const QString stored_hash = storedIconHash(icon);
+
+  if (!stored_hash.isEmpty()) {
+    // Icon is already serialized in database.
+    return DatabaseQueries::getIconData(qApp->database()->connection(metaObject()->className(), DatabaseFactory::FromSettings),
+                                        stored_hash);
+  }
+
   QByteArray array;
   QBuffer buffer(&array);
   buffer.open(QIODevice::WriteOnly);
@@ -57,6 +114,32 @@ QByteArray IconFactory::toByteArray(const QIcon &icon) {
   return array.toBase64();
 }
 
+QString IconFactory::iconHash(const QByteArray &array) {
+  return QString::fromLatin1(QCryptographicHash::hash(array, QCryptographicHash::Sha1).toHex());
+}
+
+QIcon IconFactory::storedIcon(const QString &hash) {
+  if (hash.isEmpty()) {
+    return QIcon();
+  }
+
+  QMutexLocker locker(&m_storedIconsMutex);
+
+  if (!m_storedIcons.contains(hash)) {
+    const QIcon icon(new StoredIconEngine(hash));
+
+    m_storedIcons.insert(hash, icon);
+    m_storedIconHashes.insert(icon.cacheKey(), hash);
+  }
+
+  return m_storedIcons.value(hash);
+}
+
+QString IconFactory::storedIconHash(const QIcon &icon) {
+  QMutexLocker locker(&m_storedIconsMutex);
+  return m_storedIconHashes.value(icon.cacheKey());
+}
+
 QPixmap IconFactory::pixmap(const QString &name) {
   if (QIcon::themeName() == APP_NO_THEME) {
     return QPixmap();
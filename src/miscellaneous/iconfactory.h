@@ -27,6 +27,7 @@
 #include <QIcon>
 #include <QHash>
 #include <QDir>
+#include <QMutex>
 
 
 class IconFactory : public QObject {
@@ -42,7 +43,19 @@ class IconFactory : public QObject {
     // Used to store/retrieve QIcons from/to Base64-encoded
     // byte array.
     static QIcon fromByteArray(QByteArray array);
-    static QByteArray toByteArray(const QIcon &icon);
+    QByteArray toByteArray(const QIcon &icon);
+
+    // Returns hash under which given Base64-encoded icon is stored in database.
+    static QString iconHash(const QByteArray &array);
+
+    // Returns icon stored in database under given hash. All callers share
+    // one icon instance per hash and icon data are loaded and decoded
+    // only when the icon is painted for the first time.
+    QIcon storedIcon(const QString &hash);
+
+    // Returns hash of given icon if it was obtained via storedIcon(),
+    // otherwise returns empty string.
+    QString storedIconHash(const QIcon &icon);
 
     QPixmap pixmap(const QString &name);
 
@@ -71,6 +84,13 @@ class IconFactory : public QObject {
 
     // Sets icon theme with given name as the active one and loads it.
     void setCurrentIconTheme(const QString &theme_name);
+
+  private:
+    QMutex m_storedIconsMutex;
+    QHash<QString, QIcon> m_storedIcons;
+
+    // Hashes of stored icons, keys are cache keys of the icons.
+    QHash<qint64, QString> m_storedIconHashes;
 };
 
 #endif // ICONFACTORY_H
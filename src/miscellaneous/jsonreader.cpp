@@ -0,0 +1,418 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "miscellaneous/jsonreader.h"
+
+#include "definitions/definitions.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+
+#include <cstring>
+
+
+JsonReader::JsonReader(const QByteArray &data)
+  : m_data(data), m_position(m_data.constData()), m_end(m_data.constData() + m_data.size()),
+    m_containers(QVector<char>()), m_afterValue(false), m_documentRead(false), m_tokenType(NoToken),
+    m_nameBegin(nullptr), m_nameLength(0), m_nameEscaped(false),
+    m_valueBegin(nullptr), m_valueLength(0), m_valueEscaped(false), m_errorString(QString()) {
+  m_containers.reserve(16);
+}
+
+JsonReader::~JsonReader() {
+}
+
+JsonReader::TokenType JsonReader::readNext() {
+  if (m_tokenType == Invalid || m_tokenType == EndDocument) {
+    return m_tokenType;
+  }
+
+  skipWhitespace();
+
+  if (m_containers.isEmpty()) {
+    if (m_documentRead) {
+      return m_tokenType = EndDocument;
+    }
+    else if (m_position >= m_end) {
+      return raiseError(QSL("Document is empty."));
+    }
+
+    m_nameBegin = nullptr;
+    m_nameLength = 0;
+  }
+  else {
+    if (m_position >= m_end) {
+      return raiseError(QSL("Unexpected end of document."));
+    }
+
+    const char container = m_containers.last();
+
+    if ((container == '{' && *m_position == '}') || (container == '[' && *m_position == ']')) {
+      // Current container ends.
+      m_position++;
+      m_containers.removeLast();
+      m_afterValue = true;
+      m_documentRead = m_containers.isEmpty();
+      m_nameBegin = nullptr;
+      m_nameLength = 0;
+
+      return m_tokenType = (container == '{' ? EndObject : EndArray);
+    }
+
+    if (m_afterValue) {
+      if (*m_position != ',') {
+        return raiseError(QSL("Expected ',' separator."));
+      }
+
+      m_position++;
+      skipWhitespace();
+    }
+
+    if (container == '{') {
+      // Member name goes first.
+      if (m_position >= m_end || *m_position != '"' || !scanString(&m_nameBegin, &m_nameLength, &m_nameEscaped)) {
+        return raiseError(QSL("Expected name of object member."));
+      }
+
+      skipWhitespace();
+
+      if (m_position >= m_end || *m_position != ':') {
+        return raiseError(QSL("Expected ':' separator."));
+      }
+
+      m_position++;
+      skipWhitespace();
+    }
+    else {
+      m_nameBegin = nullptr;
+      m_nameLength = 0;
+    }
+  }
+
+  if (m_position >= m_end) {
+    return raiseError(QSL("Unexpected end of document."));
+  }
+
+  m_valueBegin = m_position;
+  m_valueLength = 0;
+  m_valueEscaped = false;
+  m_afterValue = true;
+
+  switch (*m_position) {
+    case '{':
+    case '[':
+      m_containers.append(*m_position);
+      m_position++;
+      m_afterValue = false;
+      return m_tokenType = (m_containers.last() == '{' ? StartObject : StartArray);
+
+    case '"':
+      if (!scanString(&m_valueBegin, &m_valueLength, &m_valueEscaped)) {
+        return raiseError(QSL("Unterminated string."));
+      }
+
+      m_tokenType = String;
+      break;
+
+    case 't':
+      if (!scanLiteral("true", 4)) {
+        return raiseError(QSL("Invalid literal."));
+      }
+
+      m_tokenType = Bool;
+      break;
+
+    case 'f':
+      if (!scanLiteral("false", 5)) {
+        return raiseError(QSL("Invalid literal."));
+      }
+
+      m_tokenType = Bool;
+      break;
+
+    case 'n':
+      if (!scanLiteral("null", 4)) {
+        return raiseError(QSL("Invalid literal."));
+      }
+
+      m_tokenType = Null;
+      break;
+
+    default:
+      while (m_position < m_end && ((*m_position >= '0' && *m_position <= '9') || *m_position == '-' ||
+                                    *m_position == '+' || *m_position == '.' ||
+                                    *m_position == 'e' || *m_position == 'E')) {
+        m_position++;
+      }
+
+      m_valueLength = m_position - m_valueBegin;
+
+      if (m_valueLength == 0) {
+        return raiseError(QSL("Unexpected character."));
+      }
+
+      m_tokenType = Number;
+      break;
+  }
+
+  m_documentRead = m_containers.isEmpty();
+  return m_tokenType;
+}
+
+JsonReader::TokenType JsonReader::tokenType() const {
+  return m_tokenType;
+}
+
+bool JsonReader::atEnd() const {
+  return m_tokenType == EndDocument || m_tokenType == Invalid;
+}
+
+bool JsonReader::hasError() const {
+  return m_tokenType == Invalid;
+}
+
+QString JsonReader::errorString() const {
+  return m_errorString;
+}
+
+QString JsonReader::name() const {
+  return m_nameBegin == nullptr ? QString() : decodeString(m_nameBegin, m_nameLength, m_nameEscaped);
+}
+
+bool JsonReader::isName(const char *name) const {
+  if (m_nameBegin == nullptr) {
+    return false;
+  }
+  else if (m_nameEscaped) {
+    return this->name() == QLatin1String(name);
+  }
+  else {
+    return (int) qstrlen(name) == m_nameLength && memcmp(name, m_nameBegin, m_nameLength) == 0;
+  }
+}
+
+QString JsonReader::text() const {
+  switch (m_tokenType) {
+    case String:
+      return decodeString(m_valueBegin, m_valueLength, m_valueEscaped);
+
+    case Number:
+    case Bool:
+      return QString::fromLatin1(m_valueBegin, m_valueLength);
+
+    default:
+      return QString();
+  }
+}
+
+double JsonReader::number() const {
+  if (m_tokenType == Number) {
+    return QByteArray::fromRawData(m_valueBegin, m_valueLength).toDouble();
+  }
+  else {
+    return 0.0;
+  }
+}
+
+bool JsonReader::boolean() const {
+  return m_tokenType == Bool && m_valueLength == 4;
+}
+
+void JsonReader::skipCurrentValue() {
+  if (m_tokenType != StartObject && m_tokenType != StartArray) {
+    return;
+  }
+
+  const int depth = m_containers.size();
+
+  while (readNext() != Invalid) {
+    if ((m_tokenType == EndObject || m_tokenType == EndArray) && m_containers.size() < depth) {
+      break;
+    }
+  }
+}
+
+QJsonValue JsonReader::readValue() {
+  switch (m_tokenType) {
+    case String:
+      return QJsonValue(text());
+
+    case Number:
+      return QJsonValue(number());
+
+    case Bool:
+      return QJsonValue(boolean());
+
+    case StartObject: {
+      QJsonObject object;
+
+      while (readNext() != EndObject && !hasError()) {
+        const QString member_name = name();
+        object.insert(member_name, readValue());
+      }
+
+      return object;
+    }
+
+    case StartArray: {
+      QJsonArray array;
+
+      while (readNext() != EndArray && !hasError()) {
+        array.append(readValue());
+      }
+
+      return array;
+    }
+
+    case Null:
+      return QJsonValue(QJsonValue::Null);
+
+    default:
+      return QJsonValue(QJsonValue::Undefined);
+  }
+}
+
+JsonReader::TokenType JsonReader::raiseError(const QString &error) {
+  m_errorString = error;
+  m_containers.clear();
+
+  qWarning("Error when reading JSON data at offset %d: '%s'.",
+           int(m_position - m_data.constData()), qPrintable(error));
+  return m_tokenType = Invalid;
+}
+
+void JsonReader::skipWhitespace() {
+  while (m_position < m_end && (*m_position == ' ' || *m_position == '\n' || *m_position == '\r' || *m_position == '\t')) {
+    m_position++;
+  }
+}
+
+bool JsonReader::scanString(const char **begin, int *length, bool *escaped) {
+  // Skip opening quote.
+  const char *start = ++m_position;
+
+  *escaped = false;
+
+  while (m_position < m_end) {
+    if (*m_position == '"') {
+      *begin = start;
+      *length = m_position - start;
+
+      // Skip closing quote.
+      m_position++;
+      return true;
+    }
+    else if (*m_position == '\\') {
+      *escaped = true;
+      m_position += 2;
+    }
+    else {
+      m_position++;
+    }
+  }
+
+  m_position = m_end;
+  return false;
+}
+
+bool JsonReader::scanLiteral(const char *literal, int length) {
+  if (m_end - m_position >= length && memcmp(m_position, literal, length) == 0) {
+    m_valueLength = length;
+    m_position += length;
+    return true;
+  }
+  else {
+    return false;
+  }
+}
+
+QString JsonReader::decodeString(const char *begin, int length, bool escaped) {
+  if (!escaped) {
+    return QString::fromUtf8(begin, length);
+  }
+
+  QString result;
+  const char *end = begin + length;
+  const char *chunk = begin;
+  const char *position = begin;
+
+  result.reserve(length);
+
+  while (position < end) {
+    if (*position != '\\') {
+      position++;
+      continue;
+    }
+
+    result.append(QString::fromUtf8(chunk, position - chunk));
+
+    if (++position >= end) {
+      chunk = end;
+      break;
+    }
+
+    switch (*position) {
+      case 'b':
+        result.append(QL1C('\b'));
+        break;
+
+      case 'f':
+        result.append(QL1C('\f'));
+        break;
+
+      case 'n':
+        result.append(QL1C('\n'));
+        break;
+
+      case 'r':
+        result.append(QL1C('\r'));
+        break;
+
+      case 't':
+        result.append(QL1C('\t'));
+        break;
+
+      case 'u': {
+        if (end - position > 4) {
+          bool ok;
+          const ushort code_unit = QByteArray::fromRawData(position + 1, 4).toUShort(&ok, 16);
+
+          // NOTE: Surrogate pairs are stored as two code units, so
+          // they form valid UTF-16 sequence in resulting string.
+          result.append(ok ? QChar(code_unit) : QChar(QChar::ReplacementCharacter));
+          position += 4;
+        }
+
+        break;
+      }
+
+      default:
+        // Quotes, slashes and backslashes.
+        result.append(QL1C(*position));
+        break;
+    }
+
+    chunk = ++position;
+  }
+
+  if (chunk < end) {
+    result.append(QString::fromUtf8(chunk, end - chunk));
+  }
+
+  return result;
+}
@@ -0,0 +1,130 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef JSONREADER_H
+#define JSONREADER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QJsonValue>
+#include <QVector>
+
+
+// Forward-only, pull-based JSON reader which works directly
+// on top of UTF-8 encoded raw data.
+//
+// Unlike QJsonDocument, no DOM is built, so large responses
+// can be processed with memory footprint independent of their size.
+// Strings are decoded only when their value is asked for.
+//
+// Typical usage:
+//   JsonReader reader(data);
+//
+//   if (reader.readNext() == JsonReader::StartObject) {
+//     while (reader.readNext() != JsonReader::EndObject && !reader.hasError()) {
+//       if (reader.isName("title")) {
+//         title = reader.text();
+//       }
+//
+//       // Skips nested objects/arrays which were not processed.
+//       reader.skipCurrentValue();
+//     }
+//   }
+class JsonReader {
+  public:
+    enum TokenType {
+      NoToken     = 0,
+      Invalid     = 1,
+      StartObject = 2,
+      EndObject   = 3,
+      StartArray  = 4,
+      EndArray    = 5,
+      String      = 6,
+      Number      = 7,
+      Bool        = 8,
+      Null        = 9,
+      EndDocument = 10
+    };
+
+    explicit JsonReader(const QByteArray &data);
+    virtual ~JsonReader();
+
+    // Reads next token and returns its type.
+    // If current token is value of object member, then
+    // member name can be obtained via name() or isName().
+    TokenType readNext();
+    TokenType tokenType() const;
+
+    bool atEnd() const;
+    bool hasError() const;
+    QString errorString() const;
+
+    // Name of object member which holds current value.
+    QString name() const;
+
+    // Fast check for member name, does not allocate anything.
+    bool isName(const char *name) const;
+
+    // Returns decoded string value. Raw textual representation is returned for numbers
+    // and booleans, empty string is returned for other tokens.
+    QString text() const;
+
+    // Returns numeric value of current token, zero is returned if
+    // token is not a number.
+    double number() const;
+
+    // Returns boolean value of current token, false is returned if
+    // token is not a boolean.
+    bool boolean() const;
+
+    // If current token starts object or array, then the reader skips
+    // the whole object or array. Does nothing for any other token.
+    void skipCurrentValue();
+
+    // Reads whole current value (including nested objects/arrays) into DOM.
+    // NOTE: Use only for small subtrees.
+    QJsonValue readValue();
+
+  private:
+    TokenType raiseError(const QString &error);
+    void skipWhitespace();
+    bool scanString(const char **begin, int *length, bool *escaped);
+    bool scanLiteral(const char *literal, int length);
+
+    static QString decodeString(const char *begin, int length, bool escaped);
+
+    QByteArray m_data;
+    const char *m_position;
+    const char *m_end;
+
+    // Holds '{' and '[' of currently opened containers.
+    QVector<char> m_containers;
+    bool m_afterValue;
+    bool m_documentRead;
+
+    TokenType m_tokenType;
+    const char *m_nameBegin;
+    int m_nameLength;
+    bool m_nameEscaped;
+    const char *m_valueBegin;
+    int m_valueLength;
+    bool m_valueEscaped;
+    QString m_errorString;
+};
+
+#endif // JSONREADER_H
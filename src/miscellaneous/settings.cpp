@@ -240,6 +240,18 @@ DVALUE(int) Database::MySQLPortDef        = APP_DB_MYSQL_PORT;
 DKEY Database::ActiveDriver               = "database_driver";
 DVALUE(char*) Database::ActiveDriverDef   = APP_DB_SQLITE_DRIVER;
 
+DKEY Database::SlowQueryThreshold             = "slow_query_threshold";
+DVALUE(int) Database::SlowQueryThresholdDef   = SLOW_QUERY_THRESHOLD;
+
+DKEY Database::CompressContents               = "compress_message_contents";
+DVALUE(bool) Database::CompressContentsDef    = false;
+
+DKEY Database::ArchiveMessages                = "archive_messages";
+DVALUE(bool) Database::ArchiveMessagesDef     = false;
+
+DKEY Database::ArchiveAfterDays               = "archive_after_days";
+DVALUE(int) Database::ArchiveAfterDaysDef     = DEFAULT_DAYS_TO_ARCHIVE_MSG;
+
 // Keyboard.
 DKEY Keyboard::ID = "keyboard";
 
@@ -265,6 +265,18 @@ namespace Database {
 
   KEY ActiveDriver;
   VALUE(char*) ActiveDriverDef;
+
+  KEY SlowQueryThreshold;
+  VALUE(int) SlowQueryThresholdDef;
+
+  KEY CompressContents;
+  VALUE(bool) CompressContentsDef;
+
+  KEY ArchiveMessages;
+  VALUE(bool) ArchiveMessagesDef;
+
+  KEY ArchiveAfterDays;
+  VALUE(int) ArchiveAfterDaysDef;
 }
 
 // Keyboard.
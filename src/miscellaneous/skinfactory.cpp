@@ -25,6 +25,52 @@
 #include <QDomElement>
 
 
+SkinTemplate::SkinTemplate(const QString &markup, int argument_count) : m_tokens(QList<Token>()), m_literalSize(0) {
+  const int length = markup.size();
+  int chunk_start = 0;
+  int position = markup.indexOf(QL1C('%'));
+
+  while (position >= 0 && position < length - 1) {
+    // Placeholder number has at most two digits, same as in QString::arg().
+    int end = position + 1;
+    int number = 0;
+
+    while (end < length && end - position <= 2 && markup.at(end).isDigit()) {
+      number = number * 10 + markup.at(end).digitValue();
+      end++;
+    }
+
+    if (number >= 1 && number <= argument_count) {
+      if (position > chunk_start) {
+        const Token literal = { markup.mid(chunk_start, position - chunk_start), -1 };
+
+        m_tokens.append(literal);
+        m_literalSize += literal.m_text.size();
+      }
+
+      const Token slot = { QString(), number - 1 };
+
+      m_tokens.append(slot);
+      chunk_start = end;
+    }
+
+    position = markup.indexOf(QL1C('%'), qMax(end, position + 1));
+  }
+
+  if (chunk_start < length) {
+    const Token literal = { markup.mid(chunk_start), -1 };
+
+    m_tokens.append(literal);
+    m_literalSize += literal.m_text.size();
+  }
+}
+
+void SkinTemplate::render(QString &output, const QString *arguments) const {
+  foreach (const Token &token, m_tokens) {
+    output.append(token.m_slot < 0 ? token.m_text : arguments[token.m_slot]);
+  }
+}
+
 SkinFactory::SkinFactory(QObject *parent) : QObject(parent) {
 }
 
@@ -136,17 +182,14 @@ Skin SkinFactory::skinInfo(const QString &skin_name, bool *ok) const {
       // replaced by fully absolute path and target file can
       // be safely loaded.
 
-      skin.m_layoutMarkupWrapper = QString::fromUtf8(IOFactory::readTextFile(skin_folder + QL1S("html_wrapper.html")));
-      skin.m_layoutMarkupWrapper = skin.m_layoutMarkupWrapper.replace(QSL("##"), APP_SKIN_PATH + QL1S("/") + skin_name);
-
-      skin.m_enclosureImageMarkup = QString::fromUtf8(IOFactory::readTextFile(skin_folder + QL1S("html_enclosure_image.html")));
-      skin.m_enclosureImageMarkup = skin.m_enclosureImageMarkup.replace(QSL("##"), APP_SKIN_PATH + QL1S("/") + skin_name);
-
-      skin.m_layoutMarkup = QString::fromUtf8(IOFactory::readTextFile(skin_folder + QL1S("html_single_message.html")));
-      skin.m_layoutMarkup = skin.m_layoutMarkup.replace(QSL("##"), APP_SKIN_PATH + QL1S("/") + skin_name);
-
-      skin.m_enclosureMarkup = QString::fromUtf8(IOFactory::readTextFile(skin_folder + QL1S("html_enclosure_every.html")));
-      skin.m_enclosureMarkup = skin.m_enclosureMarkup.replace(QSL("##"), APP_SKIN_PATH + QL1S("/") + skin_name);
+      skin.m_layoutMarkupWrapper = loadSkinTemplate(skin_folder, skin_name, QSL("html_wrapper.html"),
+                                                    Skin::WrapperSlotCount);
+      skin.m_enclosureImageMarkup = loadSkinTemplate(skin_folder, skin_name, QSL("html_enclosure_image.html"),
+                                                     Skin::EnclosureImageSlotCount);
+      skin.m_layoutMarkup = loadSkinTemplate(skin_folder, skin_name, QSL("html_single_message.html"),
+                                             Skin::MessageSlotCount);
+      skin.m_enclosureMarkup = loadSkinTemplate(skin_folder, skin_name, QSL("html_enclosure_every.html"),
+                                                Skin::EnclosureSlotCount);
 
       skin.m_rawData = QString::fromUtf8(IOFactory::readTextFile(skin_folder + QL1S("theme.css")));
       skin.m_rawData = skin.m_rawData.replace(QSL("##"), APP_SKIN_PATH + QL1S("/") + skin_name);
@@ -164,6 +207,14 @@ Skin SkinFactory::skinInfo(const QString &skin_name, bool *ok) const {
   return skin;
 }
 
+SkinTemplate SkinFactory::loadSkinTemplate(const QString &skin_folder, const QString &skin_name,
+                                           const QString &file_name, int argument_count) {
+  QString markup = QString::fromUtf8(IOFactory::readTextFile(skin_folder + file_name));
+
+  markup.replace(QSL("##"), APP_SKIN_PATH + QL1S("/") + skin_name);
+  return SkinTemplate(markup, argument_count);
+}
+
 QList<Skin> SkinFactory::installedSkins() const {
   QList<Skin> skins;
   bool skin_load_ok;
@@ -24,17 +24,90 @@
 #include <QMetaType>
 
 
+// Skin markup split once into literal chunks and "%n" placeholders,
+// so that messages can be rendered into single buffer without
+// repeated calls to QString::arg().
+class SkinTemplate {
+  public:
+    // Only placeholders "%1" to "%<argument_count>" are treated as slots,
+    // all other percent sequences (for example "%3C" in inline SVG) are
+    // kept as they are, just like QString::arg() does.
+    explicit SkinTemplate(const QString &markup = QString(), int argument_count = 0);
+
+    // Appends template with slots filled from given arguments to output.
+    // Argument for slot "%n" is arguments[n - 1].
+    void render(QString &output, const QString *arguments) const;
+
+    // Returns total length of literal parts of the template.
+    inline int literalSize() const {
+      return m_literalSize;
+    }
+
+    inline bool isEmpty() const {
+      return m_tokens.isEmpty();
+    }
+
+  private:
+    struct Token {
+        QString m_text;
+
+        // Zero-based argument index, -1 for literal text.
+        int m_slot;
+    };
+
+    QList<Token> m_tokens;
+    int m_literalSize;
+};
+
 struct Skin {
+    // Slots of single message template.
+    enum MessageSlot {
+      MessageTitle = 0,
+      MessageAuthor,
+      MessageUrl,
+      MessageContents,
+      MessageCreated,
+      MessageEnclosures,
+      MessageReadAction,
+      MessageImportantAction,
+      MessageId,
+      MessageEnclosureImages,
+      MessageSlotCount
+    };
+
+    // Slots of enclosure template.
+    enum EnclosureSlot {
+      EnclosureUrl = 0,
+      EnclosureTitle,
+      EnclosureMimeType,
+      EnclosureSlotCount
+    };
+
+    // Slots of enclosure image template.
+    enum EnclosureImageSlot {
+      EnclosureImageUrl = 0,
+      EnclosureImageMimeType,
+      EnclosureImageHeight,
+      EnclosureImageSlotCount
+    };
+
+    // Slots of wrapper template.
+    enum WrapperSlot {
+      WrapperTitle = 0,
+      WrapperMessages,
+      WrapperSlotCount
+    };
+
     QString m_baseName;
     QString m_visibleName;
     QString m_author;
     QString m_email;
     QString m_version;
     QString m_rawData;
-    QString m_layoutMarkupWrapper;
-    QString m_enclosureImageMarkup;
-    QString m_layoutMarkup;
-    QString m_enclosureMarkup;
+    SkinTemplate m_layoutMarkupWrapper;
+    SkinTemplate m_enclosureImageMarkup;
+    SkinTemplate m_layoutMarkup;
+    SkinTemplate m_enclosureMarkup;
 };
 
 Q_DECLARE_METATYPE(Skin)
@@ -72,6 +145,9 @@ class SkinFactory : public QObject {
     QString getUserSkinBaseFolder() const;
 
   private:
+    // Reads markup file of the skin and compiles it.
+    static SkinTemplate loadSkinTemplate(const QString &skin_folder, const QString &skin_name,
+                                         const QString &file_name, int argument_count);
 
     // Loads the skin from give skin_data.
     void loadSkinFromData(const Skin &skin);
@@ -0,0 +1,293 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#include "miscellaneous/sqlitebackup.h"
+
+#include "definitions/definitions.h"
+#include "miscellaneous/sqlquery.h"
+
+#include <QObject>
+#include <QSqlError>
+#include <QtEndian>
+
+#if defined(USE_SQLITE_BACKUP)
+#include <sqlite3.h>
+#endif
+
+
+SqliteBackup::SqliteBackup(const QString &source_file_path, const QString &target_file_path,
+                           const QSqlDatabase &lock_database, const QString &lock_schema)
+  : m_sourceFilePath(source_file_path), m_targetFilePath(target_file_path), m_errorString(QString()),
+    m_finished(false), m_pageCount(0), m_remainingPages(0), m_restartCount(0)
+#if defined(USE_SQLITE_BACKUP)
+  , m_source(nullptr), m_target(nullptr), m_backup(nullptr)
+#else
+  , m_lockDatabase(lock_database), m_lockSchema(lock_schema.isEmpty() ? QSL("main") : lock_schema),
+    m_started(false), m_locked(false), m_changeCounter(0), m_sourceFile(source_file_path), m_targetFile(target_file_path)
+#endif
+{
+#if defined(USE_SQLITE_BACKUP)
+  // Online backup reads consistent pages itself, no lock is needed.
+  Q_UNUSED(lock_database)
+  Q_UNUSED(lock_schema)
+
+  // Backup uses its own connections, so it does not interfere
+  // with connections (and their transactions) used by the application.
+  if (sqlite3_open_v2(m_sourceFilePath.toUtf8().constData(), &m_source, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK) {
+    m_errorString = QString::fromUtf8(sqlite3_errmsg(m_source));
+  }
+  else if (sqlite3_open_v2(m_targetFilePath.toUtf8().constData(), &m_target, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr) != SQLITE_OK) {
+    m_errorString = QString::fromUtf8(sqlite3_errmsg(m_target));
+  }
+  else if ((m_backup = sqlite3_backup_init(m_target, "main", m_source, "main")) == nullptr) {
+    m_errorString = QString::fromUtf8(sqlite3_errmsg(m_target));
+  }
+
+  if (!m_errorString.isEmpty()) {
+    qWarning("Backup of SQLite database '%s' was not started: '%s'.", qPrintable(m_sourceFilePath), qPrintable(m_errorString));
+  }
+#endif
+}
+
+SqliteBackup::~SqliteBackup() {
+#if defined(USE_SQLITE_BACKUP)
+  if (m_backup != nullptr) {
+    sqlite3_backup_finish(m_backup);
+  }
+
+  // NOTE: Closing of null handles is harmless.
+  sqlite3_close(m_target);
+  sqlite3_close(m_source);
+#else
+  releaseLock();
+#endif
+}
+
+bool SqliteBackup::step(int page_count) {
+  if (m_finished) {
+    return true;
+  }
+
+#if defined(USE_SQLITE_BACKUP)
+  if (m_backup == nullptr) {
+    return false;
+  }
+
+  if (m_restartCount >= BACKUP_MAX_RESTARTS) {
+    // Database is changed too often, copy the rest while holding
+    // read lock, so that backup finishes at all.
+    page_count = -1;
+  }
+
+  const int previous_remaining_pages = m_remainingPages;
+  const int result = sqlite3_backup_step(m_backup, page_count);
+
+  m_pageCount = sqlite3_backup_pagecount(m_backup);
+  m_remainingPages = sqlite3_backup_remaining(m_backup);
+
+  if (result == SQLITE_OK && m_remainingPages > previous_remaining_pages && previous_remaining_pages > 0) {
+    // Source was changed by other connection and copying started again.
+    m_restartCount++;
+    qDebug("Backup of SQLite database '%s' was restarted (%d).", qPrintable(m_sourceFilePath), m_restartCount);
+  }
+
+  switch (result) {
+    case SQLITE_DONE:
+      m_finished = true;
+      return true;
+
+    case SQLITE_OK:
+    case SQLITE_BUSY:
+    case SQLITE_LOCKED:
+      // Some pages were copied or database is locked by other connection
+      // at the moment, caller will try it again later.
+      return true;
+
+    default:
+      m_errorString = QString::fromUtf8(sqlite3_errmsg(m_target));
+      qWarning("Backup of SQLite database '%s' failed: '%s'.", qPrintable(m_sourceFilePath), qPrintable(m_errorString));
+      return false;
+  }
+#else
+  if (!m_started && !start()) {
+    return false;
+  }
+
+  if (m_restartCount >= BACKUP_MAX_RESTARTS) {
+    // Database is changed too often, copy it at once while holding
+    // read lock, so that backup finishes at all.
+    return acquireLock() && restart() && copyPages(-1) && finish();
+  }
+
+  if (!copyPages(page_count)) {
+    return false;
+  }
+  else if (changeCounter() != m_changeCounter) {
+    // Source was changed by other connection, copied pages are useless.
+    m_restartCount++;
+    qDebug("Backup of SQLite database '%s' was restarted (%d).", qPrintable(m_sourceFilePath), m_restartCount);
+    return restart();
+  }
+  else if (m_remainingPages > 0) {
+    return true;
+  }
+  else if (!acquireLock()) {
+    return false;
+  }
+  else if (changeCounter() != m_changeCounter || m_sourceFile.size() != m_targetFile.size()) {
+    // Writers are finished while read lock is held, so only now we know
+    // that no change was being written while the last pages were copied.
+    releaseLock();
+    m_restartCount++;
+    qDebug("Backup of SQLite database '%s' was restarted (%d).", qPrintable(m_sourceFilePath), m_restartCount);
+    return restart();
+  }
+  else {
+    return finish();
+  }
+#endif
+}
+
+#if !defined(USE_SQLITE_BACKUP)
+bool SqliteBackup::start() {
+  m_started = true;
+
+  if (!m_sourceFile.open(QIODevice::ReadOnly) || !m_targetFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    setError(QObject::tr("Database file was not copied to target location."));
+    return false;
+  }
+
+  return restart();
+}
+
+bool SqliteBackup::restart() {
+  if (!m_sourceFile.seek(0) || !m_targetFile.seek(0) || !m_targetFile.resize(0)) {
+    setError(QObject::tr("Database file was not copied to target location."));
+    return false;
+  }
+
+  m_changeCounter = changeCounter();
+  m_pageCount = int((m_sourceFile.size() + BACKUP_FALLBACK_PAGE_SIZE - 1) / BACKUP_FALLBACK_PAGE_SIZE);
+  m_remainingPages = m_pageCount;
+  return true;
+}
+
+bool SqliteBackup::copyPages(int page_count) {
+  for (int i = 0; (page_count < 0 || i < page_count) && !m_sourceFile.atEnd(); i++) {
+    const QByteArray page = m_sourceFile.read(BACKUP_FALLBACK_PAGE_SIZE);
+
+    if (page.isEmpty() || m_targetFile.write(page) != page.size()) {
+      setError(QObject::tr("Database file was not copied to target location."));
+      return false;
+    }
+  }
+
+  m_remainingPages = int((m_sourceFile.size() - m_sourceFile.pos() + BACKUP_FALLBACK_PAGE_SIZE - 1) / BACKUP_FALLBACK_PAGE_SIZE);
+  return true;
+}
+
+bool SqliteBackup::finish() {
+  m_sourceFile.close();
+
+  if (!m_targetFile.flush()) {
+    setError(QObject::tr("Database file was not copied to target location."));
+    return false;
+  }
+
+  m_targetFile.close();
+  releaseLock();
+  m_remainingPages = 0;
+  m_finished = true;
+  return true;
+}
+
+quint32 SqliteBackup::changeCounter() {
+  // Counter is 4-byte big-endian integer at offset 24 of the header, it is
+  // increased by each transaction which changes the file in rollback journal modes.
+  const qint64 position = m_sourceFile.pos();
+  QByteArray counter;
+
+  if (m_sourceFile.seek(24)) {
+    counter = m_sourceFile.read(4);
+  }
+
+  m_sourceFile.seek(position);
+  return counter.size() == 4 ? qFromBigEndian<quint32>(reinterpret_cast<const uchar*>(counter.constData())) : 0;
+}
+
+bool SqliteBackup::acquireLock() {
+  if (m_locked || !m_lockDatabase.isValid() || !m_lockDatabase.isOpen()) {
+    return true;
+  }
+
+  SqlQuery query_lock(m_lockDatabase, Q_FUNC_INFO);
+
+  // Transaction is deferred, shared lock of database file is acquired by the
+  // first read and it is held until the transaction ends. Writers wait meanwhile.
+  if (!m_lockDatabase.transaction()) {
+    setError(m_lockDatabase.lastError().text());
+    return false;
+  }
+
+  m_locked = true;
+
+  if (!query_lock.exec(QString("SELECT COUNT(*) FROM %1.sqlite_master;").arg(m_lockSchema))) {
+    setError(query_lock.lastError().text());
+    return false;
+  }
+
+  return true;
+}
+
+void SqliteBackup::releaseLock() {
+  if (m_locked) {
+    m_locked = false;
+
+    // Nothing was written, so commit just releases the lock.
+    m_lockDatabase.commit();
+  }
+}
+
+void SqliteBackup::setError(const QString &error_string) {
+  m_errorString = error_string;
+  m_sourceFile.close();
+  m_targetFile.close();
+  releaseLock();
+
+  qWarning("Backup of SQLite database '%s' failed: '%s'.", qPrintable(m_sourceFilePath), qPrintable(m_errorString));
+}
+#endif
+
+bool SqliteBackup::isFinished() const {
+  return m_finished;
+}
+
+int SqliteBackup::progress() const {
+  if (m_finished) {
+    return 100;
+  }
+  else if (m_pageCount <= 0) {
+    return 0;
+  }
+  else {
+    return int(qint64(100) * (m_pageCount - m_remainingPages) / m_pageCount);
+  }
+}
+
+QString SqliteBackup::errorString() const {
+  return m_errorString;
+}
@@ -0,0 +1,111 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SQLITEBACKUP_H
+#define SQLITEBACKUP_H
+
+#include <QString>
+
+#include <QSqlDatabase>
+
+#if defined(USE_SQLITE_BACKUP)
+struct sqlite3;
+struct sqlite3_backup;
+#else
+#include <QFile>
+#endif
+
+
+// Copies SQLite database file into another file in steps of given number of pages,
+// other connections can read and write the database between the steps.
+// NOTE: Without USE_SQLITE_BACKUP, the file is copied in chunks of pages and file change
+// counter from its header tells whether other connection changed it meanwhile. If "lock_database"
+// is given, its read transaction on "lock_schema" is held only while the counter is
+// checked after the last chunk or during the final pass after too many restarts.
+class SqliteBackup {
+  public:
+    // Constructors and destructors.
+    explicit SqliteBackup(const QString &source_file_path, const QString &target_file_path,
+                          const QSqlDatabase &lock_database = QSqlDatabase(),
+                          const QString &lock_schema = QString());
+    virtual ~SqliteBackup();
+
+    // Copies next "page_count" pages of database, all remaining pages
+    // are copied if "page_count" is negative. Returns false on error.
+    // NOTE: If source database is locked, nothing is copied and true is returned,
+    // if it is changed by other connection, backup starts from the beginning.
+    // After BACKUP_MAX_RESTARTS restarts, all remaining pages are copied at once.
+    bool step(int page_count);
+
+    bool isFinished() const;
+
+    // Returns percentage of already copied pages.
+    int progress() const;
+
+    QString errorString() const;
+
+  private:
+#if !defined(USE_SQLITE_BACKUP)
+    // Opens both files.
+    bool start();
+
+    // Copies the file from the beginning again.
+    bool restart();
+
+    // Copies at most "page_count" pages, all remaining pages if it is negative.
+    bool copyPages(int page_count);
+
+    // Closes both files and releases the lock.
+    bool finish();
+
+    // Returns change counter stored in header of source file.
+    quint32 changeCounter();
+
+    // Starts read transaction of lock database, writers wait until it ends.
+    bool acquireLock();
+
+    // Ends read transaction of lock database, if it is running.
+    void releaseLock();
+
+    void setError(const QString &error_string);
+#endif
+
+    QString m_sourceFilePath;
+    QString m_targetFilePath;
+    QString m_errorString;
+    bool m_finished;
+    int m_pageCount;
+    int m_remainingPages;
+    int m_restartCount;
+
+#if defined(USE_SQLITE_BACKUP)
+    sqlite3 *m_source;
+    sqlite3 *m_target;
+    sqlite3_backup *m_backup;
+#else
+    QSqlDatabase m_lockDatabase;
+    QString m_lockSchema;
+    bool m_started;
+    bool m_locked;
+    quint32 m_changeCounter;
+
+    QFile m_sourceFile;
+    QFile m_targetFile;
+#endif
+};
+
+#endif // SQLITEBACKUP_H
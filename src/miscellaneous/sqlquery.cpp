@@ -0,0 +1,139 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "miscellaneous/sqlquery.h"
+
+#include "definitions/definitions.h"
+#include "miscellaneous/sqlstatistics.h"
+
+#include <QElapsedTimer>
+#include <QSqlError>
+#include <QSqlRecord>
+#include <QStringList>
+
+
+SqlQuery::SqlQuery(QSqlDatabase db, const char *caller)
+  : QSqlQuery(db), m_database(db), m_caller(caller), m_lastQuery(QString()), m_lastStatement(QString()) {
+}
+
+SqlQuery::SqlQuery(const QString &query, QSqlDatabase db, const char *caller)
+  : QSqlQuery(db), m_database(db), m_caller(caller), m_lastQuery(QString()), m_lastStatement(QString()) {
+  if (!query.isEmpty()) {
+    exec(query);
+  }
+}
+
+bool SqlQuery::exec() {
+  QElapsedTimer timer;
+
+  timer.start();
+  const bool result = QSqlQuery::exec();
+
+  recordExecution(timer.elapsed());
+  return result;
+}
+
+bool SqlQuery::exec(const QString &query) {
+  QElapsedTimer timer;
+
+  timer.start();
+  const bool result = QSqlQuery::exec(query);
+
+  recordExecution(timer.elapsed());
+  return result;
+}
+
+bool SqlQuery::execBatch(BatchExecutionMode mode) {
+  QElapsedTimer timer;
+
+  timer.start();
+  const bool result = QSqlQuery::execBatch(mode);
+
+  recordExecution(timer.elapsed());
+  return result;
+}
+
+void SqlQuery::recordExecution(qint64 elapsed) {
+  const QString query = lastQuery();
+  const int rows = isSelect() ? size() : numRowsAffected();
+
+  if (query != m_lastQuery) {
+    m_lastQuery = query;
+    m_lastStatement = SqlStatistics::normalizeStatement(query);
+  }
+
+  SqlStatistics::recordQuery(m_lastStatement, m_caller, elapsed, rows);
+
+  const int threshold = SqlStatistics::slowQueryThreshold();
+
+  if (threshold > 0 && elapsed >= threshold) {
+    qWarning("Slow SQL query (%lld ms, %d rows) in '%s':\n%s\nPlan:\n%s",
+             elapsed, rows, m_caller, qPrintable(query.simplified()), qPrintable(explainQueryPlan()));
+  }
+}
+
+QString SqlQuery::explainQueryPlan() {
+  const QString statement = m_lastQuery.trimmed();
+  const QString verb = statement.section(QL1C(' '), 0, 0).toUpper();
+
+  if (verb != QL1S("SELECT") && verb != QL1S("INSERT") && verb != QL1S("UPDATE") && verb != QL1S("DELETE")) {
+    // EXPLAIN is not supported for the rest of statements.
+    return QSL("n/a");
+  }
+
+  const bool sqlite = m_database.driverName() == QL1S(APP_DB_SQLITE_DRIVER);
+  QSqlQuery explain(m_database);
+  QStringList plan;
+
+  if (!explain.prepare((sqlite ? QSL("EXPLAIN QUERY PLAN ") : QSL("EXPLAIN ")) + statement)) {
+    return explain.lastError().text();
+  }
+
+  const QMap<QString, QVariant> bound_values = boundValues();
+
+  for (QMap<QString, QVariant>::const_iterator i = bound_values.constBegin(); i != bound_values.constEnd(); i++) {
+    if (statement.contains(i.key())) {
+      explain.bindValue(i.key(), i.value());
+    }
+    else {
+      explain.addBindValue(i.value());
+    }
+  }
+
+  if (!explain.exec()) {
+    return explain.lastError().text();
+  }
+
+  while (explain.next()) {
+    if (sqlite) {
+      // Last column of SQLite plan contains readable description.
+      plan.append(explain.value(explain.record().count() - 1).toString());
+    }
+    else {
+      QStringList columns;
+
+      for (int i = 0; i < explain.record().count(); i++) {
+        columns.append(explain.record().fieldName(i) + QL1C('=') + explain.value(i).toString());
+      }
+
+      plan.append(columns.join(QSL(", ")));
+    }
+  }
+
+  return plan.join(QL1C('\n'));
+}
@@ -0,0 +1,55 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef SQLQUERY_H
+#define SQLQUERY_H
+
+#include <QSqlQuery>
+
+#include <QSqlDatabase>
+
+
+// Thin wrapper of QSqlQuery which measures each execution,
+// feeds SqlStatistics and logs slow queries together with their plan.
+// Pass Q_FUNC_INFO as "caller".
+class SqlQuery : public QSqlQuery {
+  public:
+    explicit SqlQuery(QSqlDatabase db, const char *caller);
+
+    // Executes the query right away, just like QSqlQuery does.
+    explicit SqlQuery(const QString &query, QSqlDatabase db, const char *caller);
+
+    // Hide QSqlQuery methods which execute statements.
+    bool exec();
+    bool exec(const QString &query);
+    bool execBatch(BatchExecutionMode mode = ValuesAsRows);
+
+  private:
+    void recordExecution(qint64 elapsed);
+    QString explainQueryPlan();
+
+    QSqlDatabase m_database;
+    const char *m_caller;
+
+    // Cache of normalized statement, so that repeated executions
+    // of prepared query do not normalize it again.
+    QString m_lastQuery;
+    QString m_lastStatement;
+};
+
+#endif // SQLQUERY_H
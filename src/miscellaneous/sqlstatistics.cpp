@@ -0,0 +1,115 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "miscellaneous/sqlstatistics.h"
+
+#include "miscellaneous/application.h"
+
+#include <QMutexLocker>
+#include <QRegularExpression>
+
+
+QMutex SqlStatistics::s_mutex;
+QHash<QString, SqlStatementStatistics> SqlStatistics::s_statements;
+int SqlStatistics::s_slowQueryThreshold = -1;
+
+SqlStatementStatistics::SqlStatementStatistics()
+  : m_statement(QString()), m_caller(QString()), m_count(0), m_totalTime(0), m_maxTime(0), m_rows(0),
+    m_histogram(QVector<int>(histogramBounds().size() + 1, 0)) {
+}
+
+QList<int> SqlStatementStatistics::histogramBounds() {
+  return QList<int>() << 1 << 10 << 100 << 1000;
+}
+
+SqlStatistics::SqlStatistics() {
+}
+
+void SqlStatistics::recordQuery(const QString &statement, const char *caller, qint64 elapsed, int rows) {
+  static const QList<int> bounds = SqlStatementStatistics::histogramBounds();
+  const QString caller_name = QString::fromLatin1(caller);
+  const QString key = caller_name + QL1C('\n') + statement;
+  QMutexLocker locker(&s_mutex);
+
+  if (!s_statements.contains(key) && s_statements.size() >= SQL_STATISTICS_MAX_STATEMENTS) {
+    // Do not let dynamically assembled statements eat the memory.
+    return;
+  }
+
+  SqlStatementStatistics &stats = s_statements[key];
+  int bucket = 0;
+
+  while (bucket < bounds.size() && elapsed >= bounds.at(bucket)) {
+    bucket++;
+  }
+
+  stats.m_statement = statement;
+  stats.m_caller = caller_name;
+  stats.m_count++;
+  stats.m_totalTime += elapsed;
+  stats.m_maxTime = qMax(stats.m_maxTime, elapsed);
+  stats.m_rows += qMax(rows, 0);
+  stats.m_histogram[bucket]++;
+}
+
+QList<SqlStatementStatistics> SqlStatistics::statements() {
+  QMutexLocker locker(&s_mutex);
+  QList<SqlStatementStatistics> statements = s_statements.values();
+
+  locker.unlock();
+  qSort(statements.begin(), statements.end(), SqlStatistics::lessThan);
+
+  return statements;
+}
+
+void SqlStatistics::reset() {
+  QMutexLocker locker(&s_mutex);
+  s_statements.clear();
+}
+
+int SqlStatistics::slowQueryThreshold() {
+  QMutexLocker locker(&s_mutex);
+
+  if (s_slowQueryThreshold < 0) {
+    s_slowQueryThreshold = qApp->settings()->value(GROUP(Database), SETTING(Database::SlowQueryThreshold)).toInt();
+  }
+
+  return s_slowQueryThreshold;
+}
+
+void SqlStatistics::setSlowQueryThreshold(int threshold) {
+  QMutexLocker locker(&s_mutex);
+  s_slowQueryThreshold = qMax(threshold, 0);
+}
+
+QString SqlStatistics::normalizeStatement(const QString &statement) {
+  static const QRegularExpression string_literal(QSL("'(?:[^']|'')*'"));
+  static const QRegularExpression number_literal(QSL("\\b\\d+(?:\\.\\d+)?\\b"));
+  static const QRegularExpression value_list(QSL("\\(\\s*\\?(?:\\s*,\\s*\\?)+\\s*\\)"));
+  QString normalized = statement.simplified();
+
+  normalized.replace(string_literal, QSL("?"));
+  normalized.replace(number_literal, QSL("?"));
+  normalized.replace(value_list, QSL("(?, ...)"));
+
+  return normalized;
+}
+
+bool SqlStatistics::lessThan(const SqlStatementStatistics &lhs, const SqlStatementStatistics &rhs) {
+  return lhs.m_totalTime > rhs.m_totalTime;
+}
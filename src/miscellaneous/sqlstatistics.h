@@ -0,0 +1,79 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef SQLSTATISTICS_H
+#define SQLSTATISTICS_H
+
+#include <QHash>
+#include <QMutex>
+#include <QStringList>
+#include <QVector>
+
+
+// Aggregated measurements of single SQL statement
+// executed from single function.
+class SqlStatementStatistics {
+  public:
+    explicit SqlStatementStatistics();
+
+    // Upper bounds (in milliseconds) of histogram buckets,
+    // last bucket holds all slower executions.
+    static QList<int> histogramBounds();
+
+    QString m_statement;
+    QString m_caller;
+    int m_count;
+    qint64 m_totalTime;
+    qint64 m_maxTime;
+    qint64 m_rows;
+    QVector<int> m_histogram;
+};
+
+// Collects timings of all SQL queries executed via SqlQuery.
+// NOTE: All methods are thread-safe.
+class SqlStatistics {
+  private:
+    // Constructor.
+    explicit SqlStatistics();
+
+  public:
+    // Records one execution of the statement.
+    static void recordQuery(const QString &statement, const char *caller, qint64 elapsed, int rows);
+
+    // Returns statistics of all statements sorted by total time.
+    static QList<SqlStatementStatistics> statements();
+    static void reset();
+
+    // Queries slower than this threshold (in milliseconds) are
+    // logged together with their execution plan, 0 disables logging.
+    static int slowQueryThreshold();
+    static void setSlowQueryThreshold(int threshold);
+
+    // Replaces literal values in statement with "?" so that
+    // statements assembled with different values are grouped together.
+    static QString normalizeStatement(const QString &statement);
+
+  private:
+    static bool lessThan(const SqlStatementStatistics &lhs, const SqlStatementStatistics &rhs);
+
+    static QMutex s_mutex;
+    static QHash<QString, SqlStatementStatistics> s_statements;
+    static int s_slowQueryThreshold;
+};
+
+#endif // SQLSTATISTICS_H
@@ -30,6 +30,8 @@
 
 
 quint64 TextFactory::s_encryptionKey = 0x0;
+QScopedPointer<SimpleCrypt> TextFactory::s_crypt;
+QMutex TextFactory::s_cryptMutex;
 
 TextFactory::TextFactory() {
 }
@@ -55,20 +57,327 @@ int TextFactory::stringWidth(const QString &string, const QFontMetrics &metrics)
 }
 
 QDateTime TextFactory::parseDateTime(const QString &date_time) {
+  const ushort *begin = date_time.utf16();
+  const ushort *end = begin + date_time.size();
+  QDateTime dt;
+
+  // Try fast parsers for most common formats first.
+  if (parseIso8601DateTime(begin, end, dt) || parseRfc822DateTime(begin, end, dt)) {
+    return dt;
+  }
+  else {
+    return parseDateTimeByPatterns(date_time);
+  }
+}
+
+bool TextFactory::parseRfc822DateTime(const ushort *pos, const ushort *end, QDateTime &output) {
+  // Format is "[Www,] d[d] Mmm [yy]yy [hh:mm[:ss] [zone]]".
+  skipSpaces(pos, end);
+
+  if (pos < end && isLetter(*pos)) {
+    // Skip name of the day.
+    while (pos < end && isLetter(*pos)) {
+      pos++;
+    }
+
+    if (pos < end && *pos == ',') {
+      pos++;
+    }
+
+    skipSpaces(pos, end);
+  }
+
+  const int day = parseNumber(pos, end, 1, 2);
+
+  if (day < 0 || pos == end || (*pos != ' ' && *pos != '-')) {
+    return false;
+  }
+
+  pos++;
+  skipSpaces(pos, end);
+
+  const int month = parseMonth(pos, end);
+
+  if (month == 0 || pos == end || (*pos != ' ' && *pos != '-')) {
+    return false;
+  }
+
+  pos++;
+  skipSpaces(pos, end);
+
+  const ushort *year_start = pos;
+  int year = parseNumber(pos, end, 2, 4);
+
+  if (year < 0) {
+    return false;
+  }
+  else if (pos - year_start == 2) {
+    // Two-digit year.
+    year += year < 50 ? 2000 : 1900;
+  }
+  else if (pos - year_start == 3) {
+    // Obsolete three-digit year.
+    year += 1900;
+  }
+
+  int hour = 0, minute = 0, second = 0, msec = 0, offset = 0;
+
+  skipSpaces(pos, end);
+
+  if (pos < end && isDigit(*pos)) {
+    hour = parseNumber(pos, end, 1, 2);
+
+    if (hour < 0 || pos == end || *pos++ != ':' || (minute = parseNumber(pos, end, 2, 2)) < 0) {
+      return false;
+    }
+
+    if (pos < end && *pos == ':') {
+      pos++;
+
+      if ((second = parseNumber(pos, end, 2, 2)) < 0) {
+        return false;
+      }
+
+      msec = parseFraction(pos, end);
+    }
+
+    skipSpaces(pos, end);
+
+    if (pos < end && *pos != '(' && !parseTimeZone(pos, end, offset)) {
+      return false;
+    }
+
+    skipSpaces(pos, end);
+  }
+
+  // Only comment, for example "(PST)", can follow.
+  if (pos < end && *pos != '(') {
+    return false;
+  }
+
+  return makeUtcDateTime(year, month, day, hour, minute, second, msec, offset, output);
+}
+
+bool TextFactory::parseIso8601DateTime(const ushort *pos, const ushort *end, QDateTime &output) {
+  // Format is "yyyy[-MM[-dd[Thh:mm[:ss[.zzz]][zone]]]]".
+  skipSpaces(pos, end);
+
+  const int year = parseNumber(pos, end, 4, 4);
+  int month = 1, day = 1, hour = 0, minute = 0, second = 0, msec = 0, offset = 0;
+
+  if (year < 0) {
+    return false;
+  }
+
+  if (pos < end && *pos == '-') {
+    pos++;
+
+    if ((month = parseNumber(pos, end, 2, 2)) < 0) {
+      return false;
+    }
+
+    if (pos < end && *pos == '-') {
+      pos++;
+
+      if ((day = parseNumber(pos, end, 2, 2)) < 0) {
+        return false;
+      }
+
+      if (pos < end && (*pos == 'T' || *pos == 't' || *pos == ' ') && pos + 1 < end && isDigit(*(pos + 1))) {
+        pos++;
+
+        if ((hour = parseNumber(pos, end, 2, 2)) < 0 || pos == end || *pos++ != ':' ||
+            (minute = parseNumber(pos, end, 2, 2)) < 0) {
+          return false;
+        }
+
+        if (pos < end && *pos == ':') {
+          pos++;
+
+          if ((second = parseNumber(pos, end, 2, 2)) < 0) {
+            return false;
+          }
+
+          msec = parseFraction(pos, end);
+        }
+
+        skipSpaces(pos, end);
+
+        if (pos < end && !parseTimeZone(pos, end, offset)) {
+          return false;
+        }
+      }
+    }
+  }
+
+  skipSpaces(pos, end);
+
+  if (pos != end) {
+    return false;
+  }
+
+  return makeUtcDateTime(year, month, day, hour, minute, second, msec, offset, output);
+}
+
+bool TextFactory::parseTimeZone(const ushort *&pos, const ushort *end, int &offset) {
+  if (*pos == '+' || *pos == '-') {
+    // Numeric zone, "+hh[[:]mm]".
+    const int sign = *pos++ == '+' ? 1 : -1;
+    const int hours = parseNumber(pos, end, 2, 2);
+    int minutes = 0;
+
+    if (hours < 0) {
+      return false;
+    }
+
+    if (pos < end && *pos == ':') {
+      pos++;
+
+      if ((minutes = parseNumber(pos, end, 2, 2)) < 0) {
+        return false;
+      }
+    }
+    else if (pos < end && isDigit(*pos) && (minutes = parseNumber(pos, end, 2, 2)) < 0) {
+      return false;
+    }
+
+    offset = sign * (hours * 3600 + minutes * 60);
+    return true;
+  }
+  else if (isLetter(*pos)) {
+    // Named zone.
+    static const struct {
+      const char *m_name;
+      int m_offset;
+    } zones[] = {
+      { "z", 0 }, { "ut", 0 }, { "utc", 0 }, { "gmt", 0 },
+      { "est", -5 }, { "edt", -4 }, { "cst", -6 }, { "cdt", -5 },
+      { "mst", -7 }, { "mdt", -6 }, { "pst", -8 }, { "pdt", -7 },
+      { "bst", 1 }, { "cet", 1 }, { "cest", 2 }, { "eet", 2 }, { "eest", 3 },
+      { "msk", 3 }, { "jst", 9 }
+    };
+
+    const ushort *name_start = pos;
+
+    while (pos < end && isLetter(*pos)) {
+      pos++;
+    }
+
+    const int name_length = pos - name_start;
+
+    // Unknown zones are considered to be UTC.
+    offset = 0;
+
+    for (unsigned i = 0; i < sizeof(zones) / sizeof(zones[0]); i++) {
+      const char *name = zones[i].m_name;
+      int j = 0;
+
+      while (j < name_length && name[j] != '\0' && (name_start[j] | 0x20) == name[j]) {
+        j++;
+      }
+
+      if (j == name_length && name[j] == '\0') {
+        offset = zones[i].m_offset * 3600;
+        break;
+      }
+    }
+
+    return true;
+  }
+  else {
+    return false;
+  }
+}
+
+int TextFactory::parseNumber(const ushort *&pos, const ushort *end, int min_digits, int max_digits) {
+  int number = 0;
+  int digits = 0;
+
+  while (pos < end && digits < max_digits && isDigit(*pos)) {
+    number = number * 10 + (*pos++ - '0');
+    digits++;
+  }
+
+  return digits < min_digits ? -1 : number;
+}
+
+int TextFactory::parseFraction(const ushort *&pos, const ushort *end) {
+  int msec = 0;
+
+  if (pos < end && (*pos == '.' || *pos == ',')) {
+    int digits = 0;
+
+    for (pos++; pos < end && isDigit(*pos); pos++, digits++) {
+      if (digits < 3) {
+        msec = msec * 10 + (*pos - '0');
+      }
+    }
+
+    for (; digits < 3; digits++) {
+      msec *= 10;
+    }
+  }
+
+  return msec;
+}
+
+int TextFactory::parseMonth(const ushort *&pos, const ushort *end) {
+  static const char months[] = "janfebmaraprmayjunjulaugsepoctnovdec";
+
+  if (end - pos < 3) {
+    return 0;
+  }
+
+  for (int i = 0; i < 12; i++) {
+    if ((pos[0] | 0x20) == months[i * 3] && (pos[1] | 0x20) == months[i * 3 + 1] && (pos[2] | 0x20) == months[i * 3 + 2]) {
+      // Skip rest of full month name, if any.
+      pos += 3;
+
+      while (pos < end && (isLetter(*pos) || *pos == '.')) {
+        pos++;
+      }
+
+      return i + 1;
+    }
+  }
+
+  return 0;
+}
+
+void TextFactory::skipSpaces(const ushort *&pos, const ushort *end) {
+  while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\r' || *pos == '\n')) {
+    pos++;
+  }
+}
+
+bool TextFactory::makeUtcDateTime(int year, int month, int day, int hour, int minute,
+                                  int second, int msec, int offset, QDateTime &output) {
+  const QDate date(year, month, day);
+  const QTime time(hour, minute, second == 60 ? 59 : second, msec);
+
+  if (!date.isValid() || !time.isValid()) {
+    return false;
+  }
+
+  output = QDateTime(date, time, Qt::UTC).addSecs(-offset);
+  return true;
+}
+
+QDateTime TextFactory::parseDateTimeByPatterns(const QString &date_time) {
   const QString input_date = date_time.simplified();
   QDateTime dt;
   QTime time_zone_offset;
   const QLocale locale(QLocale::C);
   bool positive_time_zone_offset = false;
 
-  QStringList date_patterns; date_patterns << QSL("yyyy-MM-ddTHH:mm:ss") << QSL("MMM dd yyyy hh:mm:ss") <<
-                                              QSL("MMM d yyyy hh:mm:ss") << QSL("ddd, dd MMM yyyy HH:mm:ss") <<
-                                              QSL("dd MMM yyyy") << QSL("yyyy-MM-dd HH:mm:ss.z") << QSL("yyyy-MM-dd") <<
-                                              QSL("yyyy") << QSL("yyyy-MM") << QSL("yyyy-MM-dd") << QSL("yyyy-MM-ddThh:mm") <<
-                                              QSL("yyyy-MM-ddThh:mm:ss");
+  static const QStringList date_patterns = QStringList() << QSL("yyyy-MM-ddTHH:mm:ss") << QSL("MMM dd yyyy hh:mm:ss") <<
+                                            QSL("MMM d yyyy hh:mm:ss") << QSL("ddd, dd MMM yyyy HH:mm:ss") <<
+                                            QSL("dd MMM yyyy") << QSL("yyyy-MM-dd HH:mm:ss.z") << QSL("yyyy-MM-dd") <<
+                                            QSL("yyyy") << QSL("yyyy-MM") << QSL("yyyy-MM-dd") << QSL("yyyy-MM-ddThh:mm") <<
+                                            QSL("yyyy-MM-ddThh:mm:ss");
 
-  QStringList timezone_offset_patterns; timezone_offset_patterns << QSL("+hh:mm") << QSL("-hh:mm") << QSL("+hhmm")
-                                                                 << QSL("-hhmm") << QSL("+hh") << QSL("-hh");
+  static const QStringList timezone_offset_patterns = QStringList() << QSL("+hh:mm") << QSL("-hh:mm") << QSL("+hhmm")
+                                                                    << QSL("-hhmm") << QSL("+hh") << QSL("-hh");
 
   if (input_date.size() >= TIMEZONE_OFFSET_LIMIT) {
     foreach (const QString &pattern, timezone_offset_patterns) {
@@ -115,12 +424,26 @@ QDateTime TextFactory::parseDateTime(qint64 milis_from_epoch) {
   return QDateTime::fromMSecsSinceEpoch(milis_from_epoch);
 }
 
-QString TextFactory::encrypt(const QString &text) { 
-  return SimpleCrypt(initializeSecretEncryptionKey()).encryptToString(text);
+QString TextFactory::encrypt(const QString &text) {
+  QMutexLocker locker(&s_cryptMutex);
+  return crypt()->encryptToString(text);
 }
 
 QString TextFactory::decrypt(const QString &text) {
-  return SimpleCrypt(initializeSecretEncryptionKey()).decryptToString(text);
+  if (text.isEmpty()) {
+    return QString();
+  }
+
+  QMutexLocker locker(&s_cryptMutex);
+  return crypt()->decryptToString(text);
+}
+
+SimpleCrypt *TextFactory::crypt() {
+  if (s_crypt.isNull()) {
+    s_crypt.reset(new SimpleCrypt(initializeSecretEncryptionKey()));
+  }
+
+  return s_crypt.data();
 }
 
 QString TextFactory::shorten(const QString &input, int text_length_limit) {
@@ -22,8 +22,12 @@
 
 #include <QDateTime>
 #include <QFontMetrics>
+#include <QMutex>
+#include <QScopedPointer>
 
 
+class SimpleCrypt;
+
 class TextFactory {
   private:
     // Constructors and destructors.
@@ -47,6 +51,8 @@ class TextFactory {
     // NOTE: This apparently returns date/time in localtime.
     static QDateTime parseDateTime(qint64 milis_from_epoch);
 
+    // Encrypts/decrypts sensitive data, these are thread-safe
+    // and share one cipher instance.
     static QString encrypt(const QString &text);
     static QString decrypt(const QString &text);
 
@@ -54,10 +60,39 @@ class TextFactory {
     static QString shorten(const QString &input, int text_length_limit = TEXT_TITLE_LIMIT);
 
   private:
+    // Fast parsers of RFC 822 and ISO 8601 formats, they do not allocate anything.
+    // False is returned if input does not conform to the format.
+    static bool parseRfc822DateTime(const ushort *pos, const ushort *end, QDateTime &output);
+    static bool parseIso8601DateTime(const ushort *pos, const ushort *end, QDateTime &output);
+    static bool parseTimeZone(const ushort *&pos, const ushort *end, int &offset);
+    static int parseNumber(const ushort *&pos, const ushort *end, int min_digits, int max_digits);
+    static int parseFraction(const ushort *&pos, const ushort *end);
+    static int parseMonth(const ushort *&pos, const ushort *end);
+    static void skipSpaces(const ushort *&pos, const ushort *end);
+    static bool makeUtcDateTime(int year, int month, int day, int hour, int minute,
+                                int second, int msec, int offset, QDateTime &output);
+
+    static inline bool isDigit(ushort character) {
+      return character >= '0' && character <= '9';
+    }
+
+    static inline bool isLetter(ushort character) {
+      return (character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z');
+    }
+
+    // Slow parser which tries many date/time patterns. Used as fallback
+    // for formats which fast parsers do not understand.
+    static QDateTime parseDateTimeByPatterns(const QString &date_time);
+
+    // Returns shared cipher, caller must hold s_cryptMutex.
+    static SimpleCrypt *crypt();
+
     static quint64 initializeSecretEncryptionKey();
     static quint64 generateSecretEncryptionKey();
 
     static quint64 s_encryptionKey;
+    static QScopedPointer<SimpleCrypt> s_crypt;
+    static QMutex s_cryptMutex;
 };
 
 #endif // TEXTFACTORY_H
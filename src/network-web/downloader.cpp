@@ -26,7 +26,8 @@ Downloader::Downloader(QObject *parent)
   : QObject(parent), m_activeReply(nullptr), m_downloadManager(new SilentNetworkAccessManager(this)),
     m_timer(new QTimer(this)), m_customHeaders(QHash<QByteArray, QByteArray>()), m_inputData(QByteArray()),
     m_targetProtected(false), m_targetUsername(QString()), m_targetPassword(QString()),
-    m_lastOutputData(QByteArray()), m_lastOutputError(QNetworkReply::NoError), m_lastContentType(QVariant()) {
+    m_lastOutputData(QByteArray()), m_lastOutputError(QNetworkReply::NoError), m_lastContentType(QVariant()),
+    m_lastTimings(NetworkTimings()) {
 
   m_timer->setInterval(DOWNLOAD_TIMEOUT);
   m_timer->setSingleShot(true);
@@ -74,6 +75,10 @@ void Downloader::manipulateData(const QString &url, QNetworkAccessManager::Opera
   m_targetUsername = username;
   m_targetPassword = password;
 
+  // Timings are measured across all redirections of the operation.
+  m_lastTimings = NetworkTimings();
+  m_operationTimer.start();
+
   if (operation == QNetworkAccessManager::PostOperation) {
     runPostRequest(request, m_inputData);
   }
@@ -131,6 +136,8 @@ void Downloader::finished() {
     m_lastOutputData = reply->readAll();
     m_lastContentType = reply->header(QNetworkRequest::ContentTypeHeader);
     m_lastOutputError = reply->error();
+    m_lastTimings.m_finished = m_operationTimer.elapsed();
+    m_lastTimings.m_bytes = m_lastOutputData.size();
 
     m_activeReply->deleteLater();
     m_activeReply = nullptr;
@@ -151,6 +158,16 @@ void Downloader::timeout() {
   cancel();
 }
 
+void Downloader::onEncrypted() {
+  m_lastTimings.m_encrypted = m_operationTimer.elapsed();
+}
+
+void Downloader::onMetaDataChanged() {
+  // Only the final (non-redirected) response counts,
+  // so later replies overwrite earlier values.
+  m_lastTimings.m_firstByte = m_operationTimer.elapsed();
+}
+
 void Downloader::runDeleteRequest(const QNetworkRequest &request) {
   m_timer->start();
   m_activeReply = m_downloadManager->deleteResource(request);
@@ -160,6 +177,8 @@ void Downloader::runDeleteRequest(const QNetworkRequest &request) {
   m_activeReply->setProperty("password", m_targetPassword);
 
   connect(m_activeReply, SIGNAL(downloadProgress(qint64,qint64)), this, SLOT(progressInternal(qint64,qint64)));
+  connect(m_activeReply, SIGNAL(encrypted()), this, SLOT(onEncrypted()));
+  connect(m_activeReply, SIGNAL(metaDataChanged()), this, SLOT(onMetaDataChanged()));
   connect(m_activeReply, SIGNAL(finished()), this, SLOT(finished()));
 }
 
@@ -172,6 +191,8 @@ void Downloader::runPutRequest(const QNetworkRequest &request, const QByteArray
   m_activeReply->setProperty("password", m_targetPassword);
 
   connect(m_activeReply, SIGNAL(downloadProgress(qint64,qint64)), this, SLOT(progressInternal(qint64,qint64)));
+  connect(m_activeReply, SIGNAL(encrypted()), this, SLOT(onEncrypted()));
+  connect(m_activeReply, SIGNAL(metaDataChanged()), this, SLOT(onMetaDataChanged()));
   connect(m_activeReply, SIGNAL(finished()), this, SLOT(finished()));
 }
 
@@ -184,6 +205,8 @@ void Downloader::runPostRequest(const QNetworkRequest &request, const QByteArray
   m_activeReply->setProperty("password", m_targetPassword);
 
   connect(m_activeReply, SIGNAL(downloadProgress(qint64,qint64)), this, SLOT(progressInternal(qint64,qint64)));
+  connect(m_activeReply, SIGNAL(encrypted()), this, SLOT(onEncrypted()));
+  connect(m_activeReply, SIGNAL(metaDataChanged()), this, SLOT(onMetaDataChanged()));
   connect(m_activeReply, SIGNAL(finished()), this, SLOT(finished()));
 }
 
@@ -196,6 +219,8 @@ void Downloader::runGetRequest(const QNetworkRequest &request) {
   m_activeReply->setProperty("password", m_targetPassword);
 
   connect(m_activeReply, SIGNAL(downloadProgress(qint64,qint64)), this, SLOT(progressInternal(qint64,qint64)));
+  connect(m_activeReply, SIGNAL(encrypted()), this, SLOT(onEncrypted()));
+  connect(m_activeReply, SIGNAL(metaDataChanged()), this, SLOT(onMetaDataChanged()));
   connect(m_activeReply, SIGNAL(finished()), this, SLOT(finished()));
 }
 
@@ -203,6 +228,10 @@ QVariant Downloader::lastContentType() const {
   return m_lastContentType;
 }
 
+NetworkTimings Downloader::lastTimings() const {
+  return m_lastTimings;
+}
+
 void Downloader::cancel() {
   if (m_activeReply != nullptr) {
     // Download action timed-out, too slow connection or target is not reachable.
@@ -223,3 +252,6 @@ QNetworkReply::NetworkError Downloader::lastOutputError() const {
 QByteArray Downloader::lastOutputData() const {
   return m_lastOutputData;
 }
+
+NetworkTimings::NetworkTimings() : m_encrypted(-1), m_firstByte(-1), m_finished(-1), m_bytes(0) {
+}
@@ -24,11 +24,33 @@
 
 #include <QNetworkReply>
 #include <QSslError>
+#include <QElapsedTimer>
 
 
 class SilentNetworkAccessManager;
 class QTimer;
 
+// Timings of single network operation. All values are in milliseconds
+// since the operation was fired, -1 means that the phase was not observed.
+// NOTE: QNetworkReply does not expose DNS lookup and TCP connect separately,
+// they are included in "encrypted" (HTTPS) or in "first byte" (HTTP).
+class NetworkTimings {
+  public:
+    explicit NetworkTimings();
+
+    // Connection is established and TLS handshake is finished.
+    qint64 m_encrypted;
+
+    // Response headers were received.
+    qint64 m_firstByte;
+
+    // Whole response was received.
+    qint64 m_finished;
+
+    // Size of received response body.
+    qint64 m_bytes;
+};
+
 class Downloader : public QObject {
     Q_OBJECT
 
@@ -41,6 +63,7 @@ class Downloader : public QObject {
     QByteArray lastOutputData() const;
     QNetworkReply::NetworkError lastOutputError() const;
     QVariant lastContentType() const;
+    NetworkTimings lastTimings() const;
 
   public slots:
     void cancel();
@@ -78,6 +101,10 @@ class Downloader : public QObject {
     // Called when current operation times out.
     void timeout();
 
+    // Record timings of particular phases of current reply.
+    void onEncrypted();
+    void onMetaDataChanged();
+
   private:
     void runDeleteRequest(const QNetworkRequest &request);
     void runPutRequest(const QNetworkRequest &request, const QByteArray &data);
@@ -88,6 +115,7 @@ class Downloader : public QObject {
     QNetworkReply *m_activeReply;
     QScopedPointer<SilentNetworkAccessManager> m_downloadManager;
     QTimer *m_timer;
+    QElapsedTimer m_operationTimer;
     QHash<QByteArray, QByteArray> m_customHeaders;
     QByteArray m_inputData;
 
@@ -99,6 +127,7 @@ class Downloader : public QObject {
     QByteArray m_lastOutputData;
     QNetworkReply::NetworkError m_lastOutputError;
     QVariant m_lastContentType;
+    NetworkTimings m_lastTimings;
 };
 
 #endif // DOWNLOADER_H
@@ -0,0 +1,266 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#include "network-web/faviconfetcher.h"
+
+#include "miscellaneous/application.h"
+#include "miscellaneous/iconfactory.h"
+#include "network-web/silentnetworkaccessmanager.h"
+
+#include <QDir>
+#include <QNetworkDiskCache>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QPixmap>
+#include <QRegExp>
+#include <QSettings>
+#include <QTimer>
+
+
+QPointer<FaviconFetcher> FaviconFetcher::s_instance;
+
+FaviconFetcher::FaviconFetcher(QObject *parent)
+  : QObject(parent), m_network(new SilentNetworkAccessManager(this)), m_index(nullptr),
+    m_cache(QHash<QString,CachedIcon>()), m_jobs(QHash<QString,FetchJob>()) {
+  const QString cache_folder = qApp->settings()->userSettingsRootFolder() + QDir::separator() + FAVICON_CACHE_FOLDER;
+  QNetworkDiskCache *disk_cache = new QNetworkDiskCache(m_network);
+
+  disk_cache->setCacheDirectory(cache_folder);
+  disk_cache->setMaximumCacheSize(FAVICON_CACHE_DISK_SIZE);
+  m_network->setCache(disk_cache);
+
+  m_index = new QSettings(cache_folder + QDir::separator() + FAVICON_CACHE_INDEX, QSettings::IniFormat, this);
+  loadIndex();
+}
+
+FaviconFetcher::~FaviconFetcher() {
+  qDebug("Destroying FaviconFetcher instance.");
+}
+
+FaviconFetcher *FaviconFetcher::instance() {
+  if (s_instance.isNull()) {
+    s_instance = new FaviconFetcher(qApp);
+  }
+
+  return s_instance;
+}
+
+QIcon FaviconFetcher::cachedIcon(const QUrl &url) const {
+  return m_cache.value(hostKey(url)).m_icon;
+}
+
+bool FaviconFetcher::needsRefresh(const QUrl &url) const {
+  const QString host = hostKey(url);
+
+  return !m_cache.contains(host) || m_cache.value(host).m_expires < QDateTime::currentDateTimeUtc();
+}
+
+bool FaviconFetcher::isFetching(const QUrl &url) const {
+  return m_jobs.contains(hostKey(url));
+}
+
+void FaviconFetcher::fetchIcon(const QUrl &url, const QUrl &feed_icon_url, bool force, const QString &current_hash) {
+  const QString host = hostKey(url);
+
+  if (host.isEmpty() || m_jobs.contains(host) || (!force && !needsRefresh(url))) {
+    return;
+  }
+
+  const QUrl site_url = url.resolved(QUrl(QSL("/")));
+  FetchJob &job = m_jobs[host];
+
+  job.m_currentHash = current_hash;
+  job.m_timer = new QTimer(this);
+  job.m_timer->setSingleShot(true);
+  job.m_timer->setInterval(DOWNLOAD_TIMEOUT);
+  job.m_timer->setProperty("host", host);
+  connect(job.m_timer, SIGNAL(timeout()), this, SLOT(onFetchTimeout()));
+
+  if (feed_icon_url.isValid() && !feed_icon_url.isRelative()) {
+    startRequest(host, feed_icon_url, FeedIcon, false);
+  }
+
+  // Homepage is searched for linked icon, linked icon is then
+  // downloaded with the same priority.
+  startRequest(host, site_url, LinkedIcon, true);
+  startRequest(host, site_url.resolved(QUrl(QSL("/favicon.ico"))), FaviconIco, false);
+
+  job.m_timer->start();
+}
+
+void FaviconFetcher::startRequest(const QString &host, const QUrl &url, IconSource source, bool is_page) {
+  QNetworkRequest request(url);
+
+  // Cached data are revalidated with the server, so that icons
+  // which did not change are not downloaded again.
+  request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferNetwork);
+
+#if QT_VERSION >= 0x050600
+  request.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
+#endif
+
+  QNetworkReply *reply = m_network->get(request);
+
+  reply->setProperty("host", host);
+  reply->setProperty("source", (int) source);
+  reply->setProperty("page", is_page);
+  connect(reply, SIGNAL(finished()), this, SLOT(onReplyFinished()));
+
+  m_jobs[host].m_replies.append(reply);
+}
+
+void FaviconFetcher::onReplyFinished() {
+  QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
+
+  if (reply == nullptr) {
+    return;
+  }
+
+  reply->deleteLater();
+
+  const QString host = reply->property("host").toString();
+
+  if (!m_jobs.contains(host)) {
+    // Fetching was already finished, this is just leftover.
+    return;
+  }
+
+  FetchJob &job = m_jobs[host];
+
+  job.m_replies.removeAll(reply);
+
+  if (reply->error() == QNetworkReply::NoError) {
+    const int source = reply->property("source").toInt();
+
+    if (reply->property("page").toBool()) {
+      const QUrl icon_url = extractIconLink(reply->url(), QString::fromUtf8(reply->readAll()));
+
+      if (icon_url.isValid()) {
+        startRequest(host, icon_url, static_cast<IconSource>(source), false);
+      }
+    }
+    else {
+      QPixmap pixmap;
+
+      if (pixmap.loadFromData(reply->readAll()) && !pixmap.isNull() && !job.m_icons.contains(source)) {
+        job.m_icons.insert(source, QIcon(pixmap));
+      }
+    }
+  }
+  else {
+    qDebug("Icon candidate '%s' was not fetched, error: '%s'.",
+           qPrintable(reply->url().toString()), qPrintable(reply->errorString()));
+  }
+
+  if (job.m_replies.isEmpty() || hasBestIcon(job)) {
+    finishFetch(host);
+  }
+}
+
+void FaviconFetcher::onFetchTimeout() {
+  QTimer *timer = qobject_cast<QTimer*>(sender());
+
+  if (timer != nullptr && m_jobs.contains(timer->property("host").toString())) {
+    finishFetch(timer->property("host").toString());
+  }
+}
+
+void FaviconFetcher::finishFetch(const QString &host) {
+  const FetchJob job = m_jobs.take(host);
+
+  job.m_timer->deleteLater();
+
+  // Remaining downloads are not needed anymore.
+  foreach (QNetworkReply *reply, job.m_replies) {
+    reply->abort();
+  }
+
+  CachedIcon &cached = m_cache[host];
+  const QString replaced_hash = cached.m_hash.isEmpty() ? job.m_currentHash : cached.m_hash;
+
+  if (job.m_icons.isEmpty()) {
+    // Keep previous icon if there is any, but do not try again too soon.
+    cached.m_expires = QDateTime::currentDateTimeUtc().addSecs(FAVICON_FAILURE_EXPIRY);
+    saveIndex(host, cached);
+
+    qDebug("No icon was fetched for host '%s'.", qPrintable(host));
+    emit fetchFailed(host);
+  }
+  else {
+    cached.m_icon = job.m_icons.first();
+    cached.m_hash = IconFactory::iconHash(qApp->icons()->toByteArray(cached.m_icon));
+    cached.m_expires = QDateTime::currentDateTimeUtc().addSecs(FAVICON_EXPIRY);
+    saveIndex(host, cached);
+
+    emit iconFetched(host, cached.m_icon, replaced_hash);
+  }
+}
+
+bool FaviconFetcher::hasBestIcon(const FetchJob &job) {
+  if (job.m_icons.isEmpty()) {
+    return false;
+  }
+
+  const int best_source = job.m_icons.firstKey();
+
+  foreach (QNetworkReply *reply, job.m_replies) {
+    if (reply->property("source").toInt() < best_source) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void FaviconFetcher::loadIndex() {
+  foreach (const QString &host, m_index->childKeys()) {
+    const QStringList entry = m_index->value(host).toStringList();
+
+    if (entry.size() == 2) {
+      CachedIcon cached;
+
+      cached.m_expires = QDateTime::fromMSecsSinceEpoch(entry.at(0).toLongLong()).toUTC();
+      cached.m_hash = entry.at(1);
+      m_cache.insert(host, cached);
+    }
+  }
+}
+
+void FaviconFetcher::saveIndex(const QString &host, const CachedIcon &cached) {
+  m_index->setValue(host, QStringList() << QString::number(cached.m_expires.toMSecsSinceEpoch()) << cached.m_hash);
+}
+
+QString FaviconFetcher::hostKey(const QUrl &url) {
+  return url.host().toLower();
+}
+
+QUrl FaviconFetcher::extractIconLink(const QUrl &page_url, const QString &html) {
+  const int head_end = html.indexOf(QL1S("</head>"), 0, Qt::CaseInsensitive);
+  const QString head = head_end < 0 ? html : html.left(head_end);
+  const QRegExp rx(FAVICON_LINK_REGEX_MATCHER, Qt::CaseInsensitive);
+  const QRegExp rx_href(FAVICON_HREF_REGEX_MATCHER, Qt::CaseInsensitive);
+
+  for (int pos = 0; (pos = rx.indexIn(head, pos)) != -1; pos += rx.matchedLength()) {
+    if (rx_href.indexIn(rx.cap(0)) != -1) {
+      QString href = rx_href.cap(1);
+
+      return page_url.resolved(QUrl(href.replace(QL1S("&amp;"), QL1S("&"))));
+    }
+  }
+
+  return QUrl();
+}
@@ -0,0 +1,129 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef FAVICONFETCHER_H
+#define FAVICONFETCHER_H
+
+#include <QObject>
+
+#include <QDateTime>
+#include <QHash>
+#include <QIcon>
+#include <QList>
+#include <QMap>
+#include <QPointer>
+#include <QUrl>
+
+
+class QNetworkReply;
+class QSettings;
+class QTimer;
+class SilentNetworkAccessManager;
+
+// Resolves icons of web sites in background.
+//
+// Icon declared by the feed itself, icon linked from homepage of
+// the site and "/favicon.ico" are downloaded in parallel and the best
+// available one is used. Results are cached per host and refreshed once
+// they expire. Downloaded data are kept in disk cache, so refreshing
+// of unchanged icons is cheap revalidation.
+class FaviconFetcher : public QObject {
+    Q_OBJECT
+
+  public:
+    // Constructors and destructors.
+    explicit FaviconFetcher(QObject *parent = 0);
+    virtual ~FaviconFetcher();
+
+    // Returns icon of site given URL belongs to, if it was
+    // fetched in this session, otherwise null icon is returned.
+    QIcon cachedIcon(const QUrl &url) const;
+
+    // Returns true if icon of site given URL belongs to was
+    // never fetched or if its cached copy is expired.
+    bool needsRefresh(const QUrl &url) const;
+
+    // Returns true if icon of site given URL belongs to is being fetched.
+    bool isFetching(const QUrl &url) const;
+
+    // Starts fetching of icon of site given URL belongs to and returns immediately,
+    // iconFetched() or fetchFailed() is emitted once all candidates are tried.
+    // Icon declared by feed itself is preferred if feed_icon_url is given.
+    // Nothing is done if cached icon is not expired, unless force is true.
+    // If icon of the site was never fetched before, current_hash is reported
+    // as replaced hash, so that icon stored before can be refreshed.
+    void fetchIcon(const QUrl &url, const QUrl &feed_icon_url = QUrl(), bool force = false,
+                   const QString &current_hash = QString());
+
+    // Returns key of site given URL belongs to, as used in signals.
+    static QString hostKey(const QUrl &url);
+
+    // Returns pointer to global favicon fetcher.
+    static FaviconFetcher *instance();
+
+  signals:
+    // Emitted when icon for given host is fetched, replaced_hash is hash
+    // of icon previously fetched for the host or empty string.
+    void iconFetched(const QString &host, const QIcon &icon, const QString &replaced_hash);
+    void fetchFailed(const QString &host);
+
+  private slots:
+    void onReplyFinished();
+    void onFetchTimeout();
+
+  private:
+    // Candidate sources of icons, lower value means better icon.
+    enum IconSource {
+      FeedIcon    = 0,
+      LinkedIcon  = 1,
+      FaviconIco  = 2
+    };
+
+    struct FetchJob {
+      QList<QNetworkReply*> m_replies;
+      QMap<int,QIcon> m_icons;
+      QTimer *m_timer;
+      QString m_currentHash;
+    };
+
+    struct CachedIcon {
+      QIcon m_icon;
+      QString m_hash;
+      QDateTime m_expires;
+    };
+
+    void startRequest(const QString &host, const QUrl &url, IconSource source, bool is_page);
+    void finishFetch(const QString &host);
+
+    void loadIndex();
+    void saveIndex(const QString &host, const CachedIcon &cached);
+
+    // Returns true if job contains icon which cannot be beaten by
+    // any of pending downloads.
+    static bool hasBestIcon(const FetchJob &job);
+
+    static QUrl extractIconLink(const QUrl &page_url, const QString &html);
+
+    SilentNetworkAccessManager *m_network;
+    QSettings *m_index;
+    QHash<QString,CachedIcon> m_cache;
+    QHash<QString,FetchJob> m_jobs;
+
+    static QPointer<FaviconFetcher> s_instance;
+};
+
+#endif // FAVICONFETCHER_H
@@ -0,0 +1,182 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#include "network-web/imageloader.h"
+
+#include "miscellaneous/application.h"
+#include "network-web/silentnetworkaccessmanager.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QNetworkDiskCache>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QRunnable>
+#include <QThreadPool>
+
+
+// Decodes downloaded image data and downscales the image
+// outside of the GUI thread.
+class ImageDecodeTask : public QRunnable {
+  public:
+    explicit ImageDecodeTask(ImageLoader *loader, const QString &key, const QUrl &url,
+                             const QByteArray &data, int max_width)
+      : m_loader(loader), m_key(key), m_url(url), m_data(data), m_maxWidth(max_width) {
+    }
+
+    void run() {
+      QImage image = QImage::fromData(m_data);
+
+      if (!image.isNull() && image.width() > m_maxWidth) {
+        image = image.scaledToWidth(m_maxWidth, Qt::SmoothTransformation);
+      }
+
+      if (!m_loader.isNull()) {
+        QMetaObject::invokeMethod(m_loader.data(), "onImageDecoded", Qt::QueuedConnection,
+                                  Q_ARG(QString, m_key), Q_ARG(QUrl, m_url), Q_ARG(QImage, image));
+      }
+    }
+
+  private:
+    QPointer<ImageLoader> m_loader;
+    QString m_key;
+    QUrl m_url;
+    QByteArray m_data;
+    int m_maxWidth;
+};
+
+QPointer<ImageLoader> ImageLoader::s_instance;
+
+ImageLoader::ImageLoader(QObject *parent)
+  : QObject(parent), m_network(new SilentNetworkAccessManager(this)), m_memoryCache(IMAGE_CACHE_MEMORY_SIZE),
+    m_pendingImages(QHash<QString, QUrl>()), m_failedImages(QHash<QString, qint64>()),
+    m_retryInterval(IMAGE_RETRY_INTERVAL) {
+  QNetworkDiskCache *disk_cache = new QNetworkDiskCache(m_network);
+
+  disk_cache->setCacheDirectory(qApp->settings()->userSettingsRootFolder() + QDir::separator() + IMAGE_CACHE_FOLDER);
+  disk_cache->setMaximumCacheSize(IMAGE_CACHE_DISK_SIZE);
+  m_network->setCache(disk_cache);
+}
+
+ImageLoader::~ImageLoader() {
+  qDebug("Destroying ImageLoader instance.");
+}
+
+ImageLoader *ImageLoader::instance() {
+  if (s_instance.isNull()) {
+    s_instance = new ImageLoader(qApp);
+  }
+
+  return s_instance;
+}
+
+QPixmap ImageLoader::image(const QUrl &url, int max_width) {
+  if (url.isRelative() || max_width <= 0) {
+    return QPixmap();
+  }
+
+  const QString key = cacheKey(url, max_width);
+  const QPixmap *cached = m_memoryCache.object(key);
+
+  if (cached != nullptr) {
+    return *cached;
+  }
+
+  if (m_failedImages.contains(key)) {
+    if (m_failedImages.value(key) > QDateTime::currentMSecsSinceEpoch()) {
+      // Do not hammer the server with requests for broken image.
+      return QPixmap();
+    }
+
+    m_failedImages.remove(key);
+  }
+
+  if (!m_pendingImages.contains(key)) {
+    QNetworkRequest request(url);
+
+    // Images do not change, so use cached data whenever possible.
+    request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferCache);
+
+#if QT_VERSION >= 0x050600
+    request.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
+#endif
+
+    QNetworkReply *reply = m_network->get(request);
+
+    reply->setProperty("key", key);
+    reply->setProperty("max_width", max_width);
+    connect(reply, SIGNAL(finished()), this, SLOT(onReplyFinished()));
+
+    m_pendingImages.insert(key, url);
+  }
+
+  return QPixmap();
+}
+
+void ImageLoader::setRetryInterval(int interval) {
+  m_retryInterval = interval;
+}
+
+void ImageLoader::onReplyFinished() {
+  QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
+
+  if (reply == nullptr) {
+    return;
+  }
+
+  const QString key = reply->property("key").toString();
+
+  if (reply->error() == QNetworkReply::NoError) {
+    QThreadPool::globalInstance()->start(new ImageDecodeTask(this, key, m_pendingImages.value(key), reply->readAll(),
+                                                             reply->property("max_width").toInt()));
+  }
+  else {
+    qWarning("Image '%s' was not loaded, error: '%s'.",
+             qPrintable(reply->url().toString()), qPrintable(reply->errorString()));
+    setFailed(key, m_pendingImages.value(key));
+  }
+
+  reply->deleteLater();
+}
+
+void ImageLoader::onImageDecoded(const QString &key, const QUrl &url, const QImage &image) {
+  if (image.isNull()) {
+    qWarning("Image '%s' cannot be decoded.", qPrintable(url.toString()));
+    setFailed(key, url);
+    return;
+  }
+
+  QPixmap *pixmap = new QPixmap(QPixmap::fromImage(image));
+
+  m_memoryCache.insert(key, pixmap, pixmap->width() * pixmap->height() * pixmap->depth() / 8);
+  m_pendingImages.remove(key);
+
+  emit imageLoaded(url);
+}
+
+void ImageLoader::setFailed(const QString &key, const QUrl &url) {
+  // Image is requested again once retry interval passes, so
+  // that transient failure does not block it for the whole session.
+  m_pendingImages.remove(key);
+  m_failedImages.insert(key, QDateTime::currentMSecsSinceEpoch() + m_retryInterval);
+
+  emit imageFailed(url);
+}
+
+QString ImageLoader::cacheKey(const QUrl &url, int max_width) {
+  return QString::number(max_width) + QL1C('@') + url.toString();
+}
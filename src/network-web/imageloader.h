@@ -0,0 +1,92 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef IMAGELOADER_H
+#define IMAGELOADER_H
+
+#include <QObject>
+
+#include <QCache>
+#include <QHash>
+#include <QImage>
+#include <QPixmap>
+#include <QPointer>
+#include <QUrl>
+
+
+class QNetworkReply;
+class SilentNetworkAccessManager;
+
+// Loads remote images for message previews.
+//
+// Images are fetched asynchronously, decoded and downscaled in
+// worker threads and kept in LRU memory cache. Raw downloaded data
+// are stored in size-limited disk cache, so images are not downloaded
+// again when message is reopened, even after application restart.
+class ImageLoader : public QObject {
+    Q_OBJECT
+
+  public:
+    // Constructors and destructors.
+    explicit ImageLoader(QObject *parent = 0);
+    virtual ~ImageLoader();
+
+    // Returns image from memory cache. If image is not cached yet, then
+    // null pixmap is returned and loading of the image is started,
+    // imageLoaded() is emitted once the image is available.
+    // Images wider than max_width are downscaled.
+    QPixmap image(const QUrl &url, int max_width);
+
+    // Sets how long (in milliseconds) images which failed to load
+    // are not requested again, IMAGE_RETRY_INTERVAL is default.
+    void setRetryInterval(int interval);
+
+    // Returns pointer to global image loader.
+    static ImageLoader *instance();
+
+  signals:
+    void imageLoaded(const QUrl &url);
+
+    // Emitted when image cannot be downloaded or decoded, such
+    // image is not requested again until retry interval passes.
+    void imageFailed(const QUrl &url);
+
+  private slots:
+    void onReplyFinished();
+    void onImageDecoded(const QString &key, const QUrl &url, const QImage &image);
+
+  private:
+    static QString cacheKey(const QUrl &url, int max_width);
+
+    void setFailed(const QString &key, const QUrl &url);
+
+    SilentNetworkAccessManager *m_network;
+    QCache<QString, QPixmap> m_memoryCache;
+
+    // Keys of images which are being loaded, so that they are not
+    // requested more than once.
+    QHash<QString, QUrl> m_pendingImages;
+
+    // Keys of images which failed to load, values are times (in
+    // milliseconds since epoch) when they can be requested again.
+    QHash<QString, qint64> m_failedImages;
+    int m_retryInterval;
+
+    static QPointer<ImageLoader> s_instance;
+};
+
+#endif // IMAGELOADER_H
@@ -24,8 +24,6 @@
 
 #include <QEventLoop>
 #include <QTimer>
-#include <QIcon>
-#include <QPixmap>
 #include <QTextDocument>
 
 
@@ -128,26 +126,6 @@ QString NetworkFactory::networkErrorText(QNetworkReply::NetworkError error_code)
   }
 }
 
-QNetworkReply::NetworkError NetworkFactory::downloadIcon(const QList<QString> &urls, int timeout, QIcon &output) {
-  QNetworkReply::NetworkError network_result = QNetworkReply::UnknownNetworkError;
-
-  foreach (const QString &url, urls) {
-    const QString google_s2_with_url = QString("http://www.google.com/s2/favicons?domain=%1").arg(QUrl(url).host());
-    QByteArray icon_data;
-    network_result =  performNetworkOperation(google_s2_with_url, timeout, QByteArray(), QString(), icon_data,
-                                              QNetworkAccessManager::GetOperation).first;
-
-    if (network_result == QNetworkReply::NoError) {
-      QPixmap icon_pixmap;
-      icon_pixmap.loadFromData(icon_data);
-      output = QIcon(icon_pixmap);
-      break;
-    }
-  }
-
-  return network_result;
-}
-
 NetworkResult NetworkFactory::performNetworkOperation(const QString &url, int timeout, const QByteArray &input_data,
                                                       const QString &input_content_type, QByteArray &output,
                                                       QNetworkAccessManager::Operation operation, bool protected_contents,
@@ -179,7 +157,8 @@ NetworkResult NetworkFactory::performNetworkOperation(const QString &url, int ti
 
 NetworkResult NetworkFactory::downloadFeedFile(const QString &url, int timeout,
                                                QByteArray &output, bool protected_contents,
-                                               const QString &username, const QString &password) {
+                                               const QString &username, const QString &password,
+                                               NetworkTimings *timings) {
   // Here, we want to achieve "synchronous" approach because we want synchronout download API for
   // some use-cases too.
   Downloader downloader;
@@ -197,5 +176,9 @@ NetworkResult NetworkFactory::downloadFeedFile(const QString &url, int timeout,
   result.first = downloader.lastOutputError();
   result.second = downloader.lastContentType();
 
+  if (timings != nullptr) {
+    *timings = downloader.lastTimings();
+  }
+
   return result;
 }
@@ -26,6 +26,8 @@
 
 typedef QPair<QNetworkReply::NetworkError, QVariant> NetworkResult;
 
+class NetworkTimings;
+
 class NetworkFactory {
     Q_DECLARE_TR_FUNCTIONS(NetworkFactory)
 
@@ -39,19 +41,17 @@ class NetworkFactory {
     // Returns human readable text for given network error.
     static QString networkErrorText(QNetworkReply::NetworkError error_code);
 
-    // Performs SYNCHRONOUS download if favicon for the site,
-    // given URL belongs to.
-    static QNetworkReply::NetworkError downloadIcon(const QList<QString> &urls, int timeout, QIcon &output);
-
     static NetworkResult performNetworkOperation(const QString &url, int timeout, const QByteArray &input_data,
                                                  const QString &input_content_type, QByteArray &output,
                                                  QNetworkAccessManager::Operation operation,
                                                  bool protected_contents = false, const QString &username = QString(),
                                                  const QString &password = QString(), bool set_basic_header = false);
 
+    // Downloads feed file, timings of the download are
+    // stored into "timings" if it is provided.
     static NetworkResult downloadFeedFile(const QString &url, int timeout, QByteArray &output,
                                           bool protected_contents = false, const QString &username = QString(),
-                                          const QString &password = QString());
+                                          const QString &password = QString(), NetworkTimings *timings = nullptr);
 };
 
 #endif // NETWORKFACTORY_H
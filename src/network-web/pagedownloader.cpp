@@ -0,0 +1,143 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#include "network-web/pagedownloader.h"
+
+#include "network-web/downloader.h"
+
+
+PageDownloader::PageDownloader(int parallel_requests, QObject *parent)
+  : QObject(parent), m_parallelRequests(qMax(1, parallel_requests)), m_timeout(DOWNLOAD_TIMEOUT),
+    m_operation(QNetworkAccessManager::GetOperation), m_contentType(QString()), m_protected(false),
+    m_username(QString()), m_password(QString()), m_setBasicHeader(false), m_activeRequests(QHash<Downloader*,int>()),
+    m_finishedPages(QMap<int,QByteArray>()), m_nextRequestedPage(0), m_nextDeliveredPage(0), m_stopped(false),
+    m_error(QNetworkReply::NoError) {
+}
+
+PageDownloader::~PageDownloader() {
+}
+
+void PageDownloader::setOperation(QNetworkAccessManager::Operation operation, const QString &content_type,
+                                  bool protected_contents, const QString &username, const QString &password,
+                                  bool set_basic_header) {
+  m_operation = operation;
+  m_contentType = content_type;
+  m_protected = protected_contents;
+  m_username = username;
+  m_password = password;
+  m_setBasicHeader = set_basic_header;
+}
+
+void PageDownloader::setTimeout(int timeout) {
+  m_timeout = timeout;
+}
+
+QNetworkReply::NetworkError PageDownloader::downloadPages(int first_page, const RequestBuilder &builder,
+                                                          const PageConsumer &consumer) {
+  m_builder = builder;
+  m_consumer = consumer;
+  m_finishedPages.clear();
+  m_nextRequestedPage = first_page;
+  m_nextDeliveredPage = first_page;
+  m_stopped = false;
+  m_error = QNetworkReply::NoError;
+
+  requestNextPages();
+
+  if (!m_activeRequests.isEmpty()) {
+    m_loop.exec();
+  }
+
+  m_finishedPages.clear();
+  return m_error;
+}
+
+void PageDownloader::pageCompleted(QNetworkReply::NetworkError status, const QByteArray &contents) {
+  Downloader *downloader = qobject_cast<Downloader*>(sender());
+
+  if (downloader == nullptr || !m_activeRequests.contains(downloader)) {
+    return;
+  }
+
+  const int page = m_activeRequests.take(downloader);
+
+  downloader->deleteLater();
+
+  if (!m_stopped) {
+    if (status != QNetworkReply::NoError) {
+      qWarning("Download of page %d failed with error %d.", page, status);
+      m_error = status;
+      stop();
+    }
+    else {
+      m_finishedPages.insert(page, contents);
+      deliverPages();
+      requestNextPages();
+    }
+  }
+
+  if (m_activeRequests.isEmpty()) {
+    m_loop.quit();
+  }
+}
+
+void PageDownloader::requestNextPages() {
+  while (!m_stopped && m_activeRequests.size() + m_finishedPages.size() < m_parallelRequests) {
+    const int page = m_nextRequestedPage++;
+    const QPair<QString,QByteArray> request = m_builder(page);
+    Downloader *downloader = new Downloader(this);
+
+    downloader->appendRawHeader("Content-Type", m_contentType.toLocal8Bit());
+
+    if (m_setBasicHeader) {
+      QString basic_value = m_username + ":" + m_password;
+      QString header_value = QString("Basic ") + QString(basic_value.toUtf8().toBase64());
+
+      downloader->appendRawHeader("Authorization", header_value.toLocal8Bit());
+    }
+
+    connect(downloader, SIGNAL(completed(QNetworkReply::NetworkError,QByteArray)),
+            this, SLOT(pageCompleted(QNetworkReply::NetworkError,QByteArray)));
+
+    m_activeRequests.insert(downloader, page);
+    downloader->manipulateData(request.first, m_operation, request.second, m_timeout,
+                               m_protected, m_username, m_password);
+  }
+}
+
+void PageDownloader::deliverPages() {
+  // Hand over all pages which are ready and continuous.
+  while (!m_stopped && m_finishedPages.contains(m_nextDeliveredPage)) {
+    const int page = m_nextDeliveredPage++;
+
+    if (!m_consumer(page, m_finishedPages.take(page))) {
+      // No more pages are needed.
+      stop();
+    }
+  }
+}
+
+void PageDownloader::stop() {
+  m_stopped = true;
+  m_finishedPages.clear();
+
+  // Abort requests for pages which are not needed anymore,
+  // their completion is ignored.
+  foreach (Downloader *downloader, m_activeRequests.keys()) {
+    downloader->cancel();
+  }
+}
@@ -0,0 +1,104 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef PAGEDOWNLOADER_H
+#define PAGEDOWNLOADER_H
+
+#include <QObject>
+
+#include <QEventLoop>
+#include <QHash>
+#include <QMap>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+
+#include <functional>
+
+
+class Downloader;
+
+// Downloads pages of paginated API, several page requests
+// are kept running in parallel. Downloaded pages are handed over
+// to consumer strictly in ascending order.
+//
+// Example:
+//   PageDownloader downloader(4);
+//   downloader.downloadPages(1, [&](int page) {
+//     return qMakePair(url, request_body_for(page));
+//   }, [&](int page, const QByteArray &contents) {
+//     // Returns true if more pages can follow.
+//     return process(contents) == page_size;
+//   });
+class PageDownloader : public QObject {
+    Q_OBJECT
+
+  public:
+    // Returns URL and request body for page with given index.
+    typedef std::function<QPair<QString,QByteArray>(int page)> RequestBuilder;
+
+    // Processes contents of downloaded page, returns false if
+    // there are no more pages to download (for example page was short or invalid).
+    typedef std::function<bool(int page, const QByteArray &contents)> PageConsumer;
+
+    // Constructors and destructors.
+    explicit PageDownloader(int parallel_requests, QObject *parent = 0);
+    virtual ~PageDownloader();
+
+    // Sets up parameters which are shared by all page requests.
+    void setOperation(QNetworkAccessManager::Operation operation, const QString &content_type = QString(),
+                      bool protected_contents = false, const QString &username = QString(),
+                      const QString &password = QString(), bool set_basic_header = false);
+
+    void setTimeout(int timeout);
+
+    // Performs SYNCHRONOUS download of pages, starting with "first_page".
+    // Stops when consumer rejects page or when any request fails, pages
+    // which were requested in advance but are not needed are thrown away.
+    // Returns error of first failed request.
+    QNetworkReply::NetworkError downloadPages(int first_page, const RequestBuilder &builder,
+                                              const PageConsumer &consumer);
+
+  private slots:
+    void pageCompleted(QNetworkReply::NetworkError status, const QByteArray &contents);
+
+  private:
+    void requestNextPages();
+    void deliverPages();
+    void stop();
+
+    int m_parallelRequests;
+    int m_timeout;
+    QNetworkAccessManager::Operation m_operation;
+    QString m_contentType;
+    bool m_protected;
+    QString m_username;
+    QString m_password;
+    bool m_setBasicHeader;
+
+    RequestBuilder m_builder;
+    PageConsumer m_consumer;
+    QEventLoop m_loop;
+    QHash<Downloader*,int> m_activeRequests;
+    QMap<int,QByteArray> m_finishedPages;
+    int m_nextRequestedPage;
+    int m_nextDeliveredPage;
+    bool m_stopped;
+    QNetworkReply::NetworkError m_error;
+};
+
+#endif // PAGEDOWNLOADER_H
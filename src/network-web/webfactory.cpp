@@ -19,17 +19,18 @@
 
 #include "miscellaneous/application.h"
 
-#include <QRegExp>
 #include <QProcess>
 #include <QUrl>
 #include <QDesktopServices>
 
+// Longest entity reference we decode, including "&" and ";".
+#define HTML_ENTITY_MAX_LENGTH 12
+
 
 QPointer<WebFactory> WebFactory::s_instance;
 
 WebFactory::WebFactory(QObject *parent)
-  : QObject(parent), m_escapes(QMap<QString, QString>()),
-    m_deEscapes(QMap<QString, QString>()) {
+  : QObject(parent) {
 }
 
 WebFactory::~WebFactory() {
@@ -82,32 +83,135 @@ WebFactory *WebFactory::instance() {
 }
 
 QString WebFactory::stripTags(QString text) {
-  return text.remove(QRegExp(QSL("<[^>]*>")));
+  int tag_start = text.indexOf(QL1C('<'));
+
+  if (tag_start < 0) {
+    // Nothing to strip.
+    return text;
+  }
+
+  const int length = text.size();
+  QString output;
+  int chunk_start = 0;
+
+  output.reserve(length);
+
+  while (tag_start >= 0) {
+    output.append(text.constData() + chunk_start, tag_start - chunk_start);
+
+    if (text.midRef(tag_start, 4) == QL1S("<!--")) {
+      // Comment, skip it completely.
+      const int comment_end = text.indexOf(QL1S("-->"), tag_start + 4);
+
+      if (comment_end >= 0) {
+        chunk_start = comment_end + 3;
+        tag_start = text.indexOf(QL1C('<'), chunk_start);
+        continue;
+      }
+    }
+    else if (text.midRef(tag_start, 9) == QL1S("<![CDATA[")) {
+      // Character data section, keep its contents.
+      const int cdata_end = text.indexOf(QL1S("]]>"), tag_start + 9);
+
+      if (cdata_end >= 0) {
+        output.append(text.constData() + tag_start + 9, cdata_end - tag_start - 9);
+        chunk_start = cdata_end + 3;
+        tag_start = text.indexOf(QL1C('<'), chunk_start);
+        continue;
+      }
+    }
+
+    const int tag_end = text.indexOf(QL1C('>'), tag_start + 1);
+
+    if (tag_end < 0) {
+      // Tag is not closed, keep the rest as it is.
+      chunk_start = tag_start;
+      break;
+    }
+
+    chunk_start = tag_end + 1;
+    tag_start = text.indexOf(QL1C('<'), chunk_start);
+  }
+
+  output.append(text.constData() + chunk_start, length - chunk_start);
+  return output;
 }
 
 QString WebFactory::escapeHtml(const QString &html) {
-  if (m_escapes.isEmpty()) {
-    generetaEscapes();
+  int entity_start = html.indexOf(QL1C('&'));
+
+  if (entity_start < 0) {
+    // Nothing to decode.
+    return html;
   }
 
-  QString output = html;
+  const QChar *data = html.constData();
+  const int length = html.size();
+  QString output;
+  int chunk_start = 0;
+
+  output.reserve(length);
+
+  while (entity_start >= 0) {
+    output.append(data + chunk_start, entity_start - chunk_start);
+
+    const int entity_end = decodeEntity(data, entity_start, length, output);
 
-  foreach (const QString &key, m_escapes.keys()) {
-    output = output.replace(key, m_escapes.value(key));
+    if (entity_end > entity_start) {
+      chunk_start = entity_end;
+    }
+    else {
+      // This is not valid entity, keep the ampersand.
+      output.append(QL1C('&'));
+      chunk_start = entity_start + 1;
+    }
+
+    entity_start = html.indexOf(QL1C('&'), chunk_start);
   }
 
+  output.append(data + chunk_start, length - chunk_start);
   return output;
 }
 
 QString WebFactory::deEscapeHtml(const QString &text) {
-  if (m_deEscapes.isEmpty()) {
-    generateDeescapes();
-  }
+  QString output;
+
+  output.reserve(text.size() + text.size() / 8);
+
+  foreach (const QChar &character, text) {
+    switch (character.unicode()) {
+      case '<':
+        output.append(QL1S("&lt;"));
+        break;
 
-  QString output = text;
+      case '>':
+        output.append(QL1S("&gt;"));
+        break;
 
-  foreach (const QString &key, m_deEscapes.keys()) {
-    output = output.replace(key, m_deEscapes.value(key));
+      case '&':
+        output.append(QL1S("&amp;"));
+        break;
+
+      case '\"':
+        output.append(QL1S("&quot;"));
+        break;
+
+      case '\'':
+        output.append(QL1S("&#039;"));
+        break;
+
+      case 0x00B1:
+        output.append(QL1S("&plusmn;"));
+        break;
+
+      case 0x00D7:
+        output.append(QL1S("&times;"));
+        break;
+
+      default:
+        output.append(character);
+        break;
+    }
   }
 
   return output;
@@ -134,23 +238,136 @@ QString WebFactory::toSecondLevelDomain(const QUrl &url) {
   return domain + top_level_domain;
 }
 
-void WebFactory::generetaEscapes() {
-  m_escapes[QSL("&lt;")]     = QL1C('<');
-  m_escapes[QSL("&gt;")]     = QL1C('>');
-  m_escapes[QSL("&amp;")]    = QL1C('&');
-  m_escapes[QSL("&quot;")]   = QL1C('\"');
-  m_escapes[QSL("&nbsp;")]   = QL1C(' ');
-  m_escapes[QSL("&plusmn;")]	= QSL("±");
-  m_escapes[QSL("&times;")]  = QSL("×");
-  m_escapes[QSL("&#039;")]   = QL1C('\'');
-}
+int WebFactory::decodeEntity(const QChar *data, int position, int length, QString &output) {
+  // Entity is "&name;", "&#dddd;" or "&#xhhhh;", name of entity is short.
+  const int max_end = qMin(length, position + HTML_ENTITY_MAX_LENGTH);
+  int end = position + 1;
+
+  if (end < max_end && data[end] == QL1C('#')) {
+    const bool hexadecimal = end + 1 < max_end && (data[end + 1] == QL1C('x') || data[end + 1] == QL1C('X'));
+    uint code_point = 0;
+    int digits = 0;
+
+    for (end += hexadecimal ? 2 : 1; end < max_end; end++, digits++) {
+      const ushort character = data[end].unicode();
+
+      if (character >= '0' && character <= '9') {
+        code_point = code_point * (hexadecimal ? 16 : 10) + (character - '0');
+      }
+      else if (hexadecimal && (character | 0x20) >= 'a' && (character | 0x20) <= 'f') {
+        code_point = code_point * 16 + ((character | 0x20) - 'a' + 10);
+      }
+      else {
+        break;
+      }
+    }
+
+    if (digits == 0 || end == max_end || data[end] != QL1C(';') ||
+        code_point == 0 || code_point > 0x10FFFF || (code_point >= 0xD800 && code_point <= 0xDFFF)) {
+      return position;
+    }
+
+    if (QChar::requiresSurrogates(code_point)) {
+      output.append(QChar(QChar::highSurrogate(code_point)));
+      output.append(QChar(QChar::lowSurrogate(code_point)));
+    }
+    else {
+      output.append(QChar(code_point));
+    }
+
+    return end + 1;
+  }
+
+  // Named entity, table is sorted by names.
+  static const struct {
+    const char *m_name;
+    ushort m_codePoint;
+  } entities[] = {
+      { "AElig", 198 }, { "Aacute", 193 }, { "Acirc", 194 }, { "Agrave", 192 }, { "Alpha", 913 },
+      { "Aring", 197 }, { "Atilde", 195 }, { "Auml", 196 }, { "Beta", 914 }, { "Ccedil", 199 },
+      { "Chi", 935 }, { "Dagger", 8225 }, { "Delta", 916 }, { "ETH", 208 }, { "Eacute", 201 },
+      { "Ecirc", 202 }, { "Egrave", 200 }, { "Epsilon", 917 }, { "Eta", 919 }, { "Euml", 203 },
+      { "Gamma", 915 }, { "Iacute", 205 }, { "Icirc", 206 }, { "Igrave", 204 }, { "Iota", 921 },
+      { "Iuml", 207 }, { "Kappa", 922 }, { "Lambda", 923 }, { "Mu", 924 }, { "Ntilde", 209 }, { "Nu", 925 },
+      { "OElig", 338 }, { "Oacute", 211 }, { "Ocirc", 212 }, { "Ograve", 210 }, { "Omega", 937 },
+      { "Omicron", 927 }, { "Oslash", 216 }, { "Otilde", 213 }, { "Ouml", 214 }, { "Phi", 934 },
+      { "Pi", 928 }, { "Prime", 8243 }, { "Psi", 936 }, { "Rho", 929 }, { "Scaron", 352 }, { "Sigma", 931 },
+      { "THORN", 222 }, { "Tau", 932 }, { "Theta", 920 }, { "Uacute", 218 }, { "Ucirc", 219 },
+      { "Ugrave", 217 }, { "Upsilon", 933 }, { "Uuml", 220 }, { "Xi", 926 }, { "Yacute", 221 },
+      { "Yuml", 376 }, { "Zeta", 918 }, { "aacute", 225 }, { "acirc", 226 }, { "acute", 180 },
+      { "aelig", 230 }, { "agrave", 224 }, { "alefsym", 8501 }, { "alpha", 945 }, { "amp", 38 },
+      { "and", 8743 }, { "ang", 8736 }, { "apos", 39 }, { "aring", 229 }, { "asymp", 8776 },
+      { "atilde", 227 }, { "auml", 228 }, { "bdquo", 8222 }, { "beta", 946 }, { "brvbar", 166 },
+      { "bull", 8226 }, { "cap", 8745 }, { "ccedil", 231 }, { "cedil", 184 }, { "cent", 162 }, { "chi", 967 },
+      { "circ", 710 }, { "clubs", 9827 }, { "cong", 8773 }, { "copy", 169 }, { "crarr", 8629 },
+      { "cup", 8746 }, { "curren", 164 }, { "dArr", 8659 }, { "dagger", 8224 }, { "darr", 8595 },
+      { "deg", 176 }, { "delta", 948 }, { "diams", 9830 }, { "divide", 247 }, { "eacute", 233 },
+      { "ecirc", 234 }, { "egrave", 232 }, { "empty", 8709 }, { "emsp", 8195 }, { "ensp", 8194 },
+      { "epsilon", 949 }, { "equiv", 8801 }, { "eta", 951 }, { "eth", 240 }, { "euml", 235 },
+      { "euro", 8364 }, { "exist", 8707 }, { "fnof", 402 }, { "forall", 8704 }, { "frac12", 189 },
+      { "frac14", 188 }, { "frac34", 190 }, { "frasl", 8260 }, { "gamma", 947 }, { "ge", 8805 }, { "gt", 62 },
+      { "hArr", 8660 }, { "harr", 8596 }, { "hearts", 9829 }, { "hellip", 8230 }, { "iacute", 237 },
+      { "icirc", 238 }, { "iexcl", 161 }, { "igrave", 236 }, { "image", 8465 }, { "infin", 8734 },
+      { "int", 8747 }, { "iota", 953 }, { "iquest", 191 }, { "isin", 8712 }, { "iuml", 239 },
+      { "kappa", 954 }, { "lArr", 8656 }, { "lambda", 955 }, { "lang", 9001 }, { "laquo", 171 },
+      { "larr", 8592 }, { "lceil", 8968 }, { "ldquo", 8220 }, { "le", 8804 }, { "lfloor", 8970 },
+      { "lowast", 8727 }, { "loz", 9674 }, { "lrm", 8206 }, { "lsaquo", 8249 }, { "lsquo", 8216 },
+      { "lt", 60 }, { "macr", 175 }, { "mdash", 8212 }, { "micro", 181 }, { "middot", 183 },
+      { "minus", 8722 }, { "mu", 956 }, { "nabla", 8711 }, { "nbsp", 160 }, { "ndash", 8211 }, { "ne", 8800 },
+      { "ni", 8715 }, { "not", 172 }, { "notin", 8713 }, { "nsub", 8836 }, { "ntilde", 241 }, { "nu", 957 },
+      { "oacute", 243 }, { "ocirc", 244 }, { "oelig", 339 }, { "ograve", 242 }, { "oline", 8254 },
+      { "omega", 969 }, { "omicron", 959 }, { "oplus", 8853 }, { "or", 8744 }, { "ordf", 170 },
+      { "ordm", 186 }, { "oslash", 248 }, { "otilde", 245 }, { "otimes", 8855 }, { "ouml", 246 },
+      { "para", 182 }, { "part", 8706 }, { "permil", 8240 }, { "perp", 8869 }, { "phi", 966 }, { "pi", 960 },
+      { "piv", 982 }, { "plusmn", 177 }, { "pound", 163 }, { "prime", 8242 }, { "prod", 8719 },
+      { "prop", 8733 }, { "psi", 968 }, { "quot", 34 }, { "rArr", 8658 }, { "radic", 8730 }, { "rang", 9002 },
+      { "raquo", 187 }, { "rarr", 8594 }, { "rceil", 8969 }, { "rdquo", 8221 }, { "real", 8476 },
+      { "reg", 174 }, { "rfloor", 8971 }, { "rho", 961 }, { "rlm", 8207 }, { "rsaquo", 8250 },
+      { "rsquo", 8217 }, { "sbquo", 8218 }, { "scaron", 353 }, { "sdot", 8901 }, { "sect", 167 },
+      { "shy", 173 }, { "sigma", 963 }, { "sigmaf", 962 }, { "sim", 8764 }, { "spades", 9824 },
+      { "sub", 8834 }, { "sube", 8838 }, { "sum", 8721 }, { "sup", 8835 }, { "sup1", 185 }, { "sup2", 178 },
+      { "sup3", 179 }, { "supe", 8839 }, { "szlig", 223 }, { "tau", 964 }, { "there4", 8756 },
+      { "theta", 952 }, { "thetasym", 977 }, { "thinsp", 8201 }, { "thorn", 254 }, { "tilde", 732 },
+      { "times", 215 }, { "trade", 8482 }, { "uArr", 8657 }, { "uacute", 250 }, { "uarr", 8593 },
+      { "ucirc", 251 }, { "ugrave", 249 }, { "uml", 168 }, { "upsih", 978 }, { "upsilon", 965 },
+      { "uuml", 252 }, { "weierp", 8472 }, { "xi", 958 }, { "yacute", 253 }, { "yen", 165 }, { "yuml", 255 },
+      { "zeta", 950 }, { "zwj", 8205 }, { "zwnj", 8204 }
+  };
+
+  char name[HTML_ENTITY_MAX_LENGTH];
+  int name_length = 0;
+
+  while (end < max_end && ((data[end].unicode() >= 'a' && data[end].unicode() <= 'z') ||
+                           (data[end].unicode() >= 'A' && data[end].unicode() <= 'Z') ||
+                           (data[end].unicode() >= '0' && data[end].unicode() <= '9'))) {
+    name[name_length++] = (char) data[end++].unicode();
+  }
+
+  if (name_length == 0 || end == max_end || data[end] != QL1C(';')) {
+    return position;
+  }
+
+  name[name_length] = '\0';
+
+  int low = 0;
+  int high = sizeof(entities) / sizeof(entities[0]) - 1;
+
+  while (low <= high) {
+    const int middle = (low + high) / 2;
+    const int comparison = qstrcmp(entities[middle].m_name, name);
+
+    if (comparison < 0) {
+      low = middle + 1;
+    }
+    else if (comparison > 0) {
+      high = middle - 1;
+    }
+    else {
+      // NOTE: Non-breaking space is intentionally decoded as plain space.
+      output.append(entities[middle].m_codePoint == 0x00A0 ? QChar(QL1C(' ')) : QChar(entities[middle].m_codePoint));
+      return end + 1;
+    }
+  }
 
-void WebFactory::generateDeescapes() {
-  m_deEscapes[QSL("<")]  = QSL("&lt;");
-  m_deEscapes[QSL(">")]  = QSL("&gt;");
-  m_deEscapes[QSL("&")]  = QSL("&amp;");
-  m_deEscapes[QSL("\"")]	= QSL("&quot;");
-  m_deEscapes[QSL("±")]  = QSL("&plusmn;");
-  m_deEscapes[QSL("×")]  = QSL("&times;");
-  m_deEscapes[QSL("\'")] = QSL("&#039;");
+  return position;
 }
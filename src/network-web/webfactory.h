@@ -23,7 +23,6 @@
 #include "core/messagesmodel.h"
 
 #include <QPointer>
-#include <QMap>
 
 
 class QWebEngineSettings;
@@ -38,7 +37,8 @@ class WebFactory : public QObject {
     // Strips "<....>" (HTML, XML) tags from given text.
     QString stripTags(QString text);
 
-    // HTML entity escaping.
+    // HTML entity escaping, both methods work in single pass.
+    // NOTE: escapeHtml() decodes entities, deEscapeHtml() encodes them.
     QString escapeHtml(const QString &html);
     QString deEscapeHtml(const QString &text);
 
@@ -58,12 +58,10 @@ class WebFactory : public QObject {
     // Constructor.
     explicit WebFactory(QObject *parent = 0);
 
-    // Escape sequences generators.
-    void generetaEscapes();
-    void generateDeescapes();
-
-    QMap<QString, QString> m_escapes;
-    QMap<QString, QString> m_deEscapes;
+    // Decodes entity reference starting at "&" on given position and appends
+    // it to output. Returns position after the reference or given position
+    // if there is no valid reference.
+    static int decodeEntity(const QChar *data, int position, int length, QString &output);
 
     // Singleton.
     static QPointer<WebFactory> s_instance;
@@ -62,7 +62,7 @@ void WebPage::javaScriptAlert(const QUrl &securityOrigin, const QString &msg) {
 
 bool WebPage::acceptNavigationRequest(const QUrl &url, NavigationType type, bool isMainFrame) {
   if (url.host() == INTERNAL_URL_MESSAGE_HOST) {
-    setHtml(view()->messageContents(), QUrl(INTERNAL_URL_MESSAGE));
+    view()->displayMessage();
     return true;
   }
   else {
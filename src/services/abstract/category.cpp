@@ -23,13 +23,34 @@
 #include "services/abstract/feed.h"
 
 
-Category::Category(RootItem *parent) : RootItem(parent) {
+Category::Category(RootItem *parent) : RootItem(parent), m_retentionPolicy(RetentionPolicy()) {
   setKind(RootItemKind::Category);
 }
 
 Category::~Category() {
 }
 
+RetentionPolicy Category::retentionPolicy() const {
+  return m_retentionPolicy;
+}
+
+void Category::setRetentionPolicy(const RetentionPolicy &retention_policy) {
+  m_retentionPolicy = retention_policy;
+}
+
+bool Category::editRetentionPolicy(const RetentionPolicy &retention_policy) {
+  QSqlDatabase database = qApp->database()->connection(metaObject()->className(), DatabaseFactory::FromSettings);
+
+  if (DatabaseQueries::editCategoryRetentionPolicy(database, id(), retention_policy)) {
+    setRetentionPolicy(retention_policy);
+    return true;
+  }
+  else {
+    qWarning("Retention policy of category '%d' was not saved.", id());
+    return false;
+  }
+}
+
 void Category::updateCounts(bool including_total_count) {
   QList<Feed*> feeds;
 
@@ -20,6 +20,8 @@
 
 #include "services/abstract/rootitem.h"
 
+#include "core/retentionpolicy.h"
+
 
 class Category : public RootItem {
     Q_OBJECT
@@ -29,6 +31,17 @@ class Category : public RootItem {
     virtual ~Category();
 
     void updateCounts(bool including_total_count);
+
+    // Retention policy is inherited by feeds and categories
+    // which do not have their own policy.
+    RetentionPolicy retentionPolicy() const;
+    void setRetentionPolicy(const RetentionPolicy &retention_policy);
+
+    // Stores new retention policy of the category.
+    bool editRetentionPolicy(const RetentionPolicy &retention_policy);
+
+  private:
+    RetentionPolicy m_retentionPolicy;
 };
 
 #endif // CATEGORY_H
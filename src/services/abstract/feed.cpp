@@ -30,7 +30,7 @@
 Feed::Feed(RootItem *parent)
   : RootItem(parent), m_url(QString()), m_status(Normal), m_autoUpdateType(DefaultAutoUpdate),
     m_autoUpdateInitialInterval(DEFAULT_AUTO_UPDATE_INTERVAL), m_autoUpdateRemainingInterval(DEFAULT_AUTO_UPDATE_INTERVAL),
-    m_totalCount(0), m_unreadCount(0) {
+    m_totalCount(0), m_unreadCount(0), m_retentionPolicy(RetentionPolicy()), m_updateStatistics(FeedUpdateStatistics()) {
   setKind(RootItemKind::Feed);
   setAutoDelete(false);
 }
@@ -127,12 +127,43 @@ void Feed::setUrl(const QString &url) {
   m_url = url;
 }
 
+RetentionPolicy Feed::retentionPolicy() const {
+  return m_retentionPolicy;
+}
+
+void Feed::setRetentionPolicy(const RetentionPolicy &retention_policy) {
+  m_retentionPolicy = retention_policy;
+}
+
+QImage Feed::iconImage() const {
+  return m_iconImage;
+}
+
+void Feed::setIconImage(const QImage &icon_image) {
+  m_iconImage = icon_image;
+}
+
+bool Feed::editRetentionPolicy(const RetentionPolicy &retention_policy) {
+  QSqlDatabase database = qApp->database()->connection(metaObject()->className(), DatabaseFactory::FromSettings);
+
+  if (DatabaseQueries::editFeedRetentionPolicy(database, id(), retention_policy)) {
+    setRetentionPolicy(retention_policy);
+    return true;
+  }
+  else {
+    qWarning("Retention policy of feed '%d' was not saved.", id());
+    return false;
+  }
+}
+
 void Feed::updateCounts(bool including_total_count) {
   bool is_main_thread = QThread::currentThread() == qApp->thread();
   QSqlDatabase database = is_main_thread ?
                             qApp->database()->connection(metaObject()->className(), DatabaseFactory::FromSettings) :
                             qApp->database()->connection(QSL("feed_upd"), DatabaseFactory::FromSettings);
   int account_id = getParentServiceRoot()->accountId();
+
+  getParentServiceRoot()->discardPendingRecounts();
   
   if (including_total_count) {
     setCountOfAllMessages(DatabaseQueries::getMessageCountsForFeed(database, customId(), account_id, true));
@@ -141,14 +172,40 @@ void Feed::updateCounts(bool including_total_count) {
   setCountOfUnreadMessages(DatabaseQueries::getMessageCountsForFeed(database, customId(), account_id, false));
 }
 
+void Feed::markQueuedForUpdate() {
+  m_updateStatistics = FeedUpdateStatistics();
+  m_updateStatistics.m_feedId = id();
+  m_updateStatistics.m_feedTitle = title();
+  m_updateStatistics.m_feedUrl = url();
+  m_queueTimer.start();
+}
+
+FeedUpdateStatistics Feed::updateStatistics() const {
+  return m_updateStatistics;
+}
+
+FeedUpdateStatistics &Feed::currentUpdateStatistics() {
+  return m_updateStatistics;
+}
+
 void Feed::run() {
   qDebug().nospace() << "Downloading new messages for feed "
                      << customId() << " in thread: \'"
                      << QThread::currentThreadId() << "\'.";
+
+  if (m_queueTimer.isValid()) {
+    m_updateStatistics.m_queueWait = m_queueTimer.elapsed();
+  }
+
+  QElapsedTimer obtaining_timer;
+  obtaining_timer.start();
   
   bool error_during_obtaining;
   QList<Message> msgs = obtainNewMessages(&error_during_obtaining);
 
+  m_updateStatistics.m_obtaining = obtaining_timer.elapsed();
+  m_updateStatistics.m_obtainedMessages = msgs.size();
+
   qDebug().nospace() << "Downloaded " << msgs.size() << " messages for feed "
                      << customId() << " in thread: \'"
                      << QThread::currentThreadId() << "\'.";
@@ -169,20 +226,40 @@ int Feed::updateMessages(const QList<Message> &messages, bool error_during_obtai
   bool is_main_thread = QThread::currentThread() == qApp->thread();
 
   qDebug("Updating messages in DB. Main thread: '%s'.", qPrintable(is_main_thread ? "true" : "false"));
+
+  m_updateStatistics.m_error = error_during_obtaining;
   
   if (!error_during_obtaining) {
+    QElapsedTimer stage_timer;
     bool anything_updated = false;
     bool ok = true;
+    const RetentionPolicy retention_policy = RetentionPolicy::effectivePolicy(this);
+    const QList<Message> retained_messages = retention_policy.filterMessages(messages);
+
+    stage_timer.start();
 
-    if (!messages.isEmpty()) {
+    if (!retained_messages.isEmpty() || retention_policy.isEnforced()) {
       int custom_id = customId();
       int account_id = getParentServiceRoot()->accountId();
       QSqlDatabase database = is_main_thread ?
                                 qApp->database()->connection(metaObject()->className(), DatabaseFactory::FromSettings) :
                                 qApp->database()->connection(QSL("feed_upd"), DatabaseFactory::FromSettings);
-      updated_messages = DatabaseQueries::updateMessages(database, messages, custom_id, account_id, url(), &anything_updated, &ok);
+
+      if (!retained_messages.isEmpty()) {
+        updated_messages = DatabaseQueries::updateMessages(database, retained_messages, custom_id, account_id, url(), &anything_updated, &ok);
+      }
+
+      // Keep the feed within its retention limits, only rows of this feed are touched.
+      if (ok && retention_policy.isEnforced() &&
+          DatabaseQueries::enforceRetentionPolicy(database, custom_id, account_id, retention_policy) > 0) {
+        anything_updated = true;
+      }
     }
 
+    m_updateStatistics.m_storing = stage_timer.restart();
+    m_updateStatistics.m_newMessages = updated_messages;
+    m_updateStatistics.m_error = !ok;
+
     if (ok) {
       setStatus(updated_messages > 0 ? NewMessages : Normal);
       updateCounts(true);
@@ -191,6 +268,8 @@ int Feed::updateMessages(const QList<Message> &messages, bool error_during_obtai
         getParentServiceRoot()->recycleBin()->updateCounts(true);
         items_to_update.append(getParentServiceRoot()->recycleBin());
       }
+
+      m_updateStatistics.m_countsRefresh = stage_timer.elapsed();
     }
   }
 
@@ -21,9 +21,13 @@
 #include "services/abstract/rootitem.h"
 
 #include "core/message.h"
+#include "core/feedupdatestatistics.h"
+#include "core/retentionpolicy.h"
 
 #include <QVariant>
 #include <QRunnable>
+#include <QElapsedTimer>
+#include <QImage>
 
 
 // Base class for "feed" nodes.
@@ -78,6 +82,24 @@ class Feed : public RootItem, public QRunnable {
     QString url() const;
     void setUrl(const QString &url);
 
+    RetentionPolicy retentionPolicy() const;
+    void setRetentionPolicy(const RetentionPolicy &retention_policy);
+
+    // Icon decoded in background thread, QIcon can be created from
+    // it only in GUI thread, see ServiceRoot::applyNewTreeForSyncIn().
+    QImage iconImage() const;
+    void setIconImage(const QImage &icon_image);
+
+    // Stores new retention policy of the feed.
+    bool editRetentionPolicy(const RetentionPolicy &retention_policy);
+
+    // Resets update statistics and starts measuring
+    // time the feed spends in update queue.
+    void markQueuedForUpdate();
+
+    // Measurements of the last update of this feed.
+    FeedUpdateStatistics updateStatistics() const;
+
     // Runs update in thread (thread pooled).
     void run();
 
@@ -88,6 +110,11 @@ class Feed : public RootItem, public QRunnable {
   signals:
     void messagesObtained(QList<Message> messages, bool error_during_obtaining);
 
+  protected:
+    // Allows subclasses to record timings of particular
+    // stages of obtaining new messages.
+    FeedUpdateStatistics &currentUpdateStatistics();
+
   private:
     // Performs synchronous obtaining of new messages for this feed.
     virtual QList<Message> obtainNewMessages(bool *error_during_obtaining) = 0;
@@ -100,6 +127,10 @@ class Feed : public RootItem, public QRunnable {
     int m_autoUpdateRemainingInterval;
     int m_totalCount;
     int m_unreadCount;
+    RetentionPolicy m_retentionPolicy;
+    FeedUpdateStatistics m_updateStatistics;
+    QElapsedTimer m_queueTimer;
+    QImage m_iconImage;
 };
 
 Q_DECLARE_METATYPE(Feed::AutoUpdateType)
@@ -26,6 +26,7 @@
 #include "miscellaneous/textfactory.h"
 #include "miscellaneous/iconfactory.h"
 #include "network-web/networkfactory.h"
+#include "network-web/faviconfetcher.h"
 #include "gui/baselineedit.h"
 #include "gui/messagebox.h"
 #include "gui/systemtrayicon.h"
@@ -43,7 +44,8 @@
 FormFeedDetails::FormFeedDetails(ServiceRoot *service_root, QWidget *parent)
   : QDialog(parent),
     m_editableFeed(nullptr),
-    m_serviceRoot(service_root) {
+    m_serviceRoot(service_root),
+    m_iconHost(QString()) {
   initialize();
   createConnections();
 
@@ -218,8 +220,8 @@ void FormFeedDetails::guessFeed() {
                                                                                       m_ui->m_txtPassword->lineEdit()->text());
 
   if (result.first != nullptr) {
-    // Icon or whole feed was guessed.
-    m_ui->m_btnIcon->setIcon(result.first->icon());
+    // Whole feed was guessed, icon is maybe still being fetched.
+    setGuessedIcon(result.first->icon());
     m_ui->m_txtTitle->lineEdit()->setText(result.first->title());
     m_ui->m_txtDescription->lineEdit()->setText(result.first->description());
     m_ui->m_cmbType->setCurrentIndex(m_ui->m_cmbType->findData(QVariant::fromValue((int) result.first->type())));
@@ -234,7 +236,12 @@ void FormFeedDetails::guessFeed() {
                                                                          Qt::MatchFixedString));
     }
 
-    if (result.second == QNetworkReply::NoError) {
+    if (result.second == QNetworkReply::NoError && !m_iconHost.isEmpty()) {
+      m_ui->m_lblFetchMetadata->setStatus(WidgetWithStatus::Progress,
+                                          tr("Feed metadata fetched, fetching icon..."),
+                                          tr("Feed metadata fetched, icon is being fetched."));
+    }
+    else if (result.second == QNetworkReply::NoError) {
       m_ui->m_lblFetchMetadata->setStatus(WidgetWithStatus::Ok,
                                           tr("All metadata fetched successfully."),
                                           tr("Feed and icon metadata fetched."));
@@ -262,10 +269,15 @@ void FormFeedDetails::guessIconOnly() {
                                                                                      m_ui->m_txtPassword->lineEdit()->text());
 
   if (result.first != nullptr) {
-    // Icon or whole feed was guessed.
-    m_ui->m_btnIcon->setIcon(result.first->icon());
+    // Whole feed was guessed, icon is maybe still being fetched.
+    setGuessedIcon(result.first->icon());
 
-    if (result.second == QNetworkReply::NoError) {
+    if (result.second == QNetworkReply::NoError && !m_iconHost.isEmpty()) {
+      m_ui->m_lblFetchMetadata->setStatus(WidgetWithStatus::Progress,
+                                          tr("Fetching icon..."),
+                                          tr("Icon is being fetched."));
+    }
+    else if (result.second == QNetworkReply::NoError) {
       m_ui->m_lblFetchMetadata->setStatus(WidgetWithStatus::Ok,
                                           tr("Icon fetched successfully."),
                                           tr("Icon metadata fetched."));
@@ -287,8 +299,40 @@ void FormFeedDetails::guessIconOnly() {
   }
 }
 
+void FormFeedDetails::setGuessedIcon(const QIcon &icon) {
+  if (icon.isNull()) {
+    // Current icon is kept until the fetched one arrives.
+    m_iconHost = FaviconFetcher::hostKey(QUrl(m_ui->m_txtUrl->lineEdit()->text()));
+  }
+  else {
+    m_iconHost.clear();
+    m_ui->m_btnIcon->setIcon(icon);
+  }
+}
+
+void FormFeedDetails::onIconFetched(const QString &host, const QIcon &icon) {
+  if (!m_iconHost.isEmpty() && host == m_iconHost) {
+    m_iconHost.clear();
+    m_ui->m_btnIcon->setIcon(icon);
+    m_ui->m_lblFetchMetadata->setStatus(WidgetWithStatus::Ok,
+                                        tr("Icon fetched successfully."),
+                                        tr("Icon metadata fetched."));
+  }
+}
+
+void FormFeedDetails::onIconFetchFailed(const QString &host) {
+  if (!m_iconHost.isEmpty() && host == m_iconHost) {
+    m_iconHost.clear();
+    m_ui->m_lblFetchMetadata->setStatus(WidgetWithStatus::Warning,
+                                        tr("Icon was not fetched."),
+                                        tr("Icon metadata not fetched."));
+  }
+}
+
 void FormFeedDetails::createConnections() {
   // General connections.
+  connect(FaviconFetcher::instance(), SIGNAL(iconFetched(QString,QIcon,QString)), this, SLOT(onIconFetched(QString,QIcon)));
+  connect(FaviconFetcher::instance(), SIGNAL(fetchFailed(QString)), this, SLOT(onIconFetchFailed(QString)));
   connect(m_ui->m_buttonBox, SIGNAL(accepted()), this, SLOT(apply()));
   connect(m_ui->m_txtTitle->lineEdit(), SIGNAL(textChanged(QString)), this, SLOT(onTitleChanged(QString)));
   connect(m_ui->m_txtDescription->lineEdit(), SIGNAL(textChanged(QString)), this, SLOT(onDescriptionChanged(QString)));
@@ -316,6 +360,27 @@ void FormFeedDetails::setEditableFeed(Feed *editable_feed) {
   m_ui->m_txtUrl->lineEdit()->setText(editable_feed->url());
   m_ui->m_cmbAutoUpdateType->setCurrentIndex(m_ui->m_cmbAutoUpdateType->findData(QVariant::fromValue((int) editable_feed->autoUpdateType())));
   m_ui->m_spinAutoUpdateInterval->setValue(editable_feed->autoUpdateInitialInterval());
+
+  const RetentionPolicy retention_policy = editable_feed->retentionPolicy();
+
+  m_ui->m_gbRetention->setChecked(!retention_policy.isInherited());
+
+  if (!retention_policy.isInherited()) {
+    m_ui->m_spinRetentionMaxCount->setValue(retention_policy.m_maxCount);
+    m_ui->m_spinRetentionMaxAge->setValue(retention_policy.m_maxAge);
+    m_ui->m_checkRetentionKeepStarred->setChecked(retention_policy.m_keepStarred);
+  }
+}
+
+RetentionPolicy FormFeedDetails::retentionPolicy() const {
+  if (m_ui->m_gbRetention->isChecked()) {
+    return RetentionPolicy(m_ui->m_spinRetentionMaxCount->value(),
+                           m_ui->m_spinRetentionMaxAge->value(),
+                           m_ui->m_checkRetentionKeepStarred->isChecked());
+  }
+  else {
+    return RetentionPolicy();
+  }
 }
 
 void FormFeedDetails::initialize() {
@@ -409,6 +474,10 @@ void FormFeedDetails::initialize() {
   setTabOrder(m_ui->m_btnIcon, m_ui->m_gbAuthentication);
   setTabOrder(m_ui->m_gbAuthentication, m_ui->m_txtUsername->lineEdit());
   setTabOrder(m_ui->m_txtUsername->lineEdit(), m_ui->m_txtPassword->lineEdit());
+  setTabOrder(m_ui->m_txtPassword->lineEdit(), m_ui->m_gbRetention);
+  setTabOrder(m_ui->m_gbRetention, m_ui->m_spinRetentionMaxCount);
+  setTabOrder(m_ui->m_spinRetentionMaxCount, m_ui->m_spinRetentionMaxAge);
+  setTabOrder(m_ui->m_spinRetentionMaxAge, m_ui->m_checkRetentionKeepStarred);
 
   m_ui->m_txtUrl->lineEdit()->setFocus(Qt::TabFocusReason);
 }
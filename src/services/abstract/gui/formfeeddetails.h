@@ -22,6 +22,8 @@
 
 #include "ui_formfeeddetails.h"
 
+#include "core/retentionpolicy.h"
+
 
 namespace Ui {
   class FormFeedDetails;
@@ -67,6 +69,10 @@ class FormFeedDetails : public QDialog {
     void onLoadIconFromFile();
     void onUseDefaultIcon();
 
+    // Sets icon which was fetched in background after metadata were guessed.
+    void onIconFetched(const QString &host, const QIcon &icon);
+    void onIconFetchFailed(const QString &host);
+
   protected:
     // Sets the feed which will be edited.
     // NOTE: This must be reimplemented in subclasses. Also this
@@ -76,12 +82,18 @@ class FormFeedDetails : public QDialog {
     // Creates needed connections.
     void createConnections();
 
+    // Shows guessed icon or remembers that icon is being fetched.
+    void setGuessedIcon(const QIcon &icon);
+
     // Initializes the dialog.
     void initialize();
 
     // Loads categories into the dialog from the model.
     void loadCategories(const QList<Category*> categories, RootItem *root_item);
 
+    // Returns retention policy as set in the dialog.
+    RetentionPolicy retentionPolicy() const;
+
   protected:
     QScopedPointer<Ui::FormFeedDetails> m_ui;
     Feed *m_editableFeed;
@@ -92,6 +104,9 @@ class FormFeedDetails : public QDialog {
     QAction *m_actionUseDefaultIcon;
     QAction *m_actionFetchIcon;
     QAction *m_actionNoIcon;
+
+    // Host of the feed whose icon is being fetched.
+    QString m_iconHost;
 };
 
 #endif // FORMFEEDDETAILS_H
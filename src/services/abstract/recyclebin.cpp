@@ -47,12 +47,19 @@ int RecycleBin::countOfAllMessages() const {
   return m_totalCount;
 }
 
+void RecycleBin::setCounts(int unread_count, int total_count) {
+  m_unreadCount = unread_count;
+  m_totalCount = total_count;
+}
+
 void RecycleBin::updateCounts(bool update_total_count) {
   bool is_main_thread = QThread::currentThread() == qApp->thread();
   QSqlDatabase database = is_main_thread ?
                             qApp->database()->connection(metaObject()->className(), DatabaseFactory::FromSettings) :
                             qApp->database()->connection(QSL("feed_upd"), DatabaseFactory::FromSettings);
 
+  getParentServiceRoot()->discardPendingRecounts();
+
   m_unreadCount = DatabaseQueries::getMessageCountsForBin(database, getParentServiceRoot()->accountId(), false);
 
   if (update_total_count) {
@@ -40,6 +40,7 @@ class RecycleBin : public RootItem {
     int countOfAllMessages() const;
 
     void updateCounts(bool update_total_count);
+    void setCounts(int unread_count, int total_count);
 
   public slots:
     /////////////////////////////////////////
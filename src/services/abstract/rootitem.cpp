@@ -36,7 +36,12 @@ RootItem::RootItem(RootItem *parent_item)
     m_icon(QIcon()),
     m_creationDate(QDateTime()),
     m_childItems(QList<RootItem*>()),
-    m_parentItem(parent_item) {
+    m_parentItem(parent_item),
+    m_subTreeCacheMutex(),
+    m_subTreeFeedsValid(false),
+    m_hashedSubTreeFeedsValid(false),
+    m_subTreeFeeds(QList<Feed*>()),
+    m_hashedSubTreeFeeds(QHash<int,Feed*>()) {
   setupFonts();
 }
 
@@ -322,43 +327,58 @@ QHash<int,Category*> RootItem::getHashedSubTreeCategories() const {
 }
 
 QHash<int,Feed*> RootItem::getHashedSubTreeFeeds() const {
-  QHash<int,Feed*> children;
-  QList<RootItem*> traversable_items;
+  const QList<Feed*> feeds = getSubTreeFeeds();
+  QMutexLocker locker(&m_subTreeCacheMutex);
 
-  traversable_items.append(const_cast<RootItem* const>(this));
+  if (!m_hashedSubTreeFeedsValid) {
+    m_hashedSubTreeFeeds.clear();
+    m_hashedSubTreeFeeds.reserve(feeds.size());
 
-  // Iterate all nested items.
-  while (!traversable_items.isEmpty()) {
-    RootItem *active_item = traversable_items.takeFirst();
-
-    if (active_item->kind() == RootItemKind::Feed && !children.contains(active_item->customId())) {
-      children.insert(active_item->customId(), active_item->toFeed());
+    foreach (Feed *feed, feeds) {
+      if (!m_hashedSubTreeFeeds.contains(feed->customId())) {
+        m_hashedSubTreeFeeds.insert(feed->customId(), feed);
+      }
     }
 
-    traversable_items.append(active_item->childItems());
+    m_hashedSubTreeFeedsValid = true;
   }
 
-  return children;
+  return m_hashedSubTreeFeeds;
 }
 
 QList<Feed*> RootItem::getSubTreeFeeds() const {
-  QList<Feed*> children;
-  QList<RootItem*> traversable_items;
+  QMutexLocker locker(&m_subTreeCacheMutex);
 
-  traversable_items.append(const_cast<RootItem* const>(this));
+  if (!m_subTreeFeedsValid) {
+    QList<RootItem*> traversable_items;
 
-  // Iterate all nested items.
-  while (!traversable_items.isEmpty()) {
-    RootItem *active_item = traversable_items.takeFirst();
+    m_subTreeFeeds.clear();
+    traversable_items.append(const_cast<RootItem* const>(this));
 
-    if (active_item->kind() == RootItemKind::Feed) {
-      children.append(active_item->toFeed());
+    // Iterate all nested items.
+    while (!traversable_items.isEmpty()) {
+      RootItem *active_item = traversable_items.takeFirst();
+
+      if (active_item->kind() == RootItemKind::Feed) {
+        m_subTreeFeeds.append(active_item->toFeed());
+      }
+
+      traversable_items.append(active_item->childItems());
     }
 
-    traversable_items.append(active_item->childItems());
+    m_subTreeFeedsValid = true;
   }
 
-  return children;
+  return m_subTreeFeeds;
+}
+
+void RootItem::invalidateSubTreeCache() {
+  for (RootItem *item = this; item != nullptr; item = item->parent()) {
+    QMutexLocker locker(&item->m_subTreeCacheMutex);
+
+    item->m_subTreeFeedsValid = false;
+    item->m_hashedSubTreeFeedsValid = false;
+  }
 }
 
 ServiceRoot *RootItem::getParentServiceRoot() const {
@@ -382,6 +402,7 @@ RootItemKind::Kind RootItem::kind() const {
 
 void RootItem::setKind(RootItemKind::Kind kind) {
   m_kind = kind;
+  invalidateSubTreeCache();
 }
 
 QIcon RootItem::icon() const {
@@ -441,7 +462,13 @@ void RootItem::setBoldFont(const QFont &bold_font) {
 }
 
 bool RootItem::removeChild(RootItem *child) {
-  return m_childItems.removeOne(child);
+  const bool removed = m_childItems.removeOne(child);
+
+  if (removed) {
+    invalidateSubTreeCache();
+  }
+
+  return removed;
 }
 
 int RootItem::customId() const {
@@ -450,6 +477,9 @@ int RootItem::customId() const {
 
 void RootItem::setCustomId(int custom_id) {
   m_customId = custom_id;
+
+  // Hashed feeds are keyed by custom IDs.
+  invalidateSubTreeCache();
 }
 
 Category *RootItem::toCategory() const {
@@ -477,6 +507,7 @@ int RootItem::countOfUnreadMessages() const {
 bool RootItem::removeChild(int index) {
   if (index >= 0 && index < m_childItems.size()) {
     m_childItems.removeAt(index);
+    invalidateSubTreeCache();
     return true;
   }
   else {
@@ -23,6 +23,7 @@
 #include <QIcon>
 #include <QDateTime>
 #include <QFont>
+#include <QMutex>
 
 
 class Category;
@@ -139,6 +140,7 @@ class RootItem : public QObject {
     inline void appendChild(RootItem *child) {
       m_childItems.append(child);
       child->setParent(this);
+      invalidateSubTreeCache();
     }
 
     // Access to children.
@@ -150,10 +152,12 @@ class RootItem : public QObject {
     // NOTE: Children are NOT freed from the memory.
     inline void clearChildren() {
       m_childItems.clear();
+      invalidateSubTreeCache();
     }
 
     inline void setChildItems(QList<RootItem*> child_items) {
       m_childItems = child_items;
+      invalidateSubTreeCache();
     }
 
     // Removes particular child at given index.
@@ -174,6 +178,9 @@ class RootItem : public QObject {
     QList<RootItem*> getSubTree(RootItemKind::Kind kind_of_item) const;
     QList<Category*> getSubTreeCategories() const;
     QHash<int,Category*> getHashedSubTreeCategories() const;
+
+    // NOTE: Lists of feeds are cached and rebuilt only
+    // when structure of the subtree changes.
     QHash<int,Feed*> getHashedSubTreeFeeds() const;
     QList<Feed*> getSubTreeFeeds() const;
 
@@ -220,6 +227,9 @@ class RootItem : public QObject {
   private:
     void setupFonts();
 
+    // Marks cached lists of this item and all its parents as outdated.
+    void invalidateSubTreeCache();
+
     RootItemKind::Kind m_kind;
     int m_id;
     int m_customId;
@@ -233,6 +243,12 @@ class RootItem : public QObject {
 
     QList<RootItem*> m_childItems;
     RootItem *m_parentItem;
+
+    mutable QMutex m_subTreeCacheMutex;
+    mutable bool m_subTreeFeedsValid;
+    mutable bool m_hashedSubTreeFeedsValid;
+    mutable QList<Feed*> m_subTreeFeeds;
+    mutable QHash<int,Feed*> m_hashedSubTreeFeeds;
 };
 
 #endif // ROOTITEM_H
@@ -22,14 +22,94 @@
 #include "miscellaneous/iconfactory.h"
 #include "miscellaneous/textfactory.h"
 #include "miscellaneous/databasequeries.h"
+#include "miscellaneous/debugging.h"
+#include "miscellaneous/mutex.h"
 #include "services/abstract/category.h"
 #include "services/abstract/feed.h"
 #include "services/abstract/recyclebin.h"
 
+#include <QPointer>
+#include <QRunnable>
+#include <QSet>
 #include <QSqlTableModel>
+#include <QThreadPool>
+#include <QTimer>
 
 
-ServiceRoot::ServiceRoot(RootItem *parent) : RootItem(parent), m_accountId(NO_PARENT_CATEGORY) {
+// Obtains new tree of the account in background thread
+// and hands it over to the account.
+class SyncInTask : public QRunnable {
+  public:
+    explicit SyncInTask(ServiceRoot *root) : QRunnable(), m_root(root) {
+    }
+
+    void run() {
+      RootItem *new_tree = m_root.isNull() ? nullptr : m_root->obtainNewTreeForSyncIn();
+
+      if (m_root.isNull()) {
+        // Account was removed meanwhile, only release the lock
+        // in the thread which acquired it.
+        delete new_tree;
+        QMetaObject::invokeMethod(qApp->feedUpdateLock(), "unlock", Qt::QueuedConnection);
+        return;
+      }
+
+      if (new_tree != nullptr) {
+        // Items were created in this thread, they must
+        // live in the same thread as the account.
+        foreach (RootItem *item, new_tree->getSubTree()) {
+          item->moveToThread(m_root->thread());
+        }
+      }
+
+      QMetaObject::invokeMethod(m_root.data(), "applyNewTreeForSyncIn", Qt::QueuedConnection, Q_ARG(RootItem*, new_tree));
+    }
+
+  private:
+    QPointer<ServiceRoot> m_root;
+};
+
+// Counts messages of the account in background thread
+// and hands the counts over to the account.
+class RecountTask : public QRunnable {
+  public:
+    explicit RecountTask(ServiceRoot *root, int generation)
+      : QRunnable(), m_root(root), m_accountId(root->accountId()), m_generation(generation) {
+    }
+
+    void run() {
+      const QString connection_name = QSL("recount_%1").arg(m_accountId);
+      MessageCounts feed_counts;
+      int bin_unread_count, bin_total_count;
+      bool ok_feeds, ok_bin_unread, ok_bin_total;
+
+      {
+        QSqlDatabase database = qApp->database()->connection(connection_name, DatabaseFactory::FromSettings);
+
+        feed_counts = DatabaseQueries::getMessageCountsForAccount(database, m_accountId, true, &ok_feeds);
+        bin_unread_count = DatabaseQueries::getMessageCountsForBin(database, m_accountId, false, &ok_bin_unread);
+        bin_total_count = DatabaseQueries::getMessageCountsForBin(database, m_accountId, true, &ok_bin_total);
+      }
+
+      // Connection was used only by this thread.
+      qApp->database()->removeConnection(connection_name);
+
+      if (ok_feeds && ok_bin_unread && ok_bin_total && !m_root.isNull()) {
+        QMetaObject::invokeMethod(m_root.data(), "applyRecountedCounts", Qt::QueuedConnection,
+                                  Q_ARG(MessageCounts, feed_counts), Q_ARG(int, bin_unread_count),
+                                  Q_ARG(int, bin_total_count), Q_ARG(int, m_generation));
+      }
+    }
+
+  private:
+    QPointer<ServiceRoot> m_root;
+    int m_accountId;
+    int m_generation;
+};
+
+ServiceRoot::ServiceRoot(RootItem *parent)
+  : RootItem(parent), m_accountId(NO_PARENT_CATEGORY), m_iconBeforeSyncIn(QIcon()), m_syncInScheduled(false),
+    m_countsGeneration(0) {
   setKind(RootItemKind::ServiceRoot);
   setCreationDate(QDateTime::currentDateTime());
 }
@@ -76,15 +156,13 @@ QList<QAction*> ServiceRoot::serviceMenu() {
 }
 
 void ServiceRoot::updateCounts(bool including_total_count) {
-  QList<Feed*> feeds;
+  QList<Feed*> feeds = getSubTreeFeeds();
+  RecycleBin *bin = recycleBin();
 
-  foreach (RootItem *child, getSubTree()) {
-    if (child->kind() == RootItemKind::Feed) {
-      feeds.append(child->toFeed());
-    }
-    else if (child->kind() != RootItemKind::Category && child->kind() != RootItemKind::ServiceRoot) {
-      child->updateCounts(including_total_count);
-    }
+  discardPendingRecounts();
+
+  if (bin != nullptr) {
+    bin->updateCounts(including_total_count);
   }
 
   if (feeds.isEmpty()) {
@@ -115,6 +193,61 @@ void ServiceRoot::updateCounts(bool including_total_count) {
   }
 }
 
+void ServiceRoot::setCounts(const MessageCounts &feed_counts, int bin_unread_count, int bin_total_count) {
+  RecycleBin *bin = recycleBin();
+
+  if (bin != nullptr) {
+    bin->setCounts(bin_unread_count, bin_total_count);
+  }
+
+  foreach (Feed *feed, getSubTreeFeeds()) {
+    const QPair<int,int> counts = feed_counts.value(feed->customId(), QPair<int,int>(0, 0));
+
+    feed->setCountOfUnreadMessages(counts.first);
+    feed->setCountOfAllMessages(counts.second);
+  }
+}
+
+MessageCounts ServiceRoot::feedCounts() const {
+  MessageCounts counts;
+
+  foreach (const Feed *feed, getSubTreeFeeds()) {
+    counts.insert(feed->customId(), QPair<int,int>(feed->countOfUnreadMessages(), feed->countOfAllMessages()));
+  }
+
+  return counts;
+}
+
+void ServiceRoot::updateCountsInBackground() {
+  if (qApp->database()->activeDatabaseDriver() == DatabaseFactory::SQLITE_MEMORY) {
+    // In-memory database cannot be reached from other threads,
+    // but it is fast enough anyway.
+    updateCounts(true);
+    itemChanged(getSubTree());
+  }
+  else {
+    QThreadPool::globalInstance()->start(new RecountTask(this, m_countsGeneration.fetchAndAddOrdered(1) + 1));
+  }
+}
+
+void ServiceRoot::discardPendingRecounts() {
+  m_countsGeneration.fetchAndAddOrdered(1);
+}
+
+void ServiceRoot::applyRecountedCounts(const MessageCounts &feed_counts, int bin_unread_count, int bin_total_count,
+                                       int generation) {
+  if (generation != m_countsGeneration.loadAcquire()) {
+    // Counts were updated meanwhile, these ones are older.
+    qDebug("Dropping stale recounted counts of account %d.", accountId());
+    return;
+  }
+
+  setCounts(feed_counts, bin_unread_count, bin_total_count);
+  itemChanged(getSubTree());
+
+  Debugging::logStartupStage(QSL("messages of account %1 recounted").arg(accountId()));
+}
+
 void ServiceRoot::completelyRemoveAllData() {
   // Purge old data from SQL and clean all model items.
   removeOldFeedTree(true);
@@ -166,20 +299,6 @@ bool ServiceRoot::cleanFeeds(QList<Feed*> items, bool clean_read_only) {
   }
 }
 
-void ServiceRoot::storeNewFeedTree(RootItem *root) {
-  QSqlDatabase database = qApp->database()->connection(metaObject()->className(), DatabaseFactory::FromSettings);
-
-  if (DatabaseQueries::storeAccountTree(database, root, accountId())) {
-    RecycleBin *bin = recycleBin();
-
-    if (bin != nullptr && !childItems().contains(bin)) {
-      // As the last item, add recycle bin, which is needed.
-      appendChild(bin);
-      bin->updateCounts(true);
-    }
-  }
-}
-
 void ServiceRoot::removeLeftOverMessages() {
   QSqlDatabase database = qApp->database()->connection(metaObject()->className(), DatabaseFactory::FromSettings);
 
@@ -217,64 +336,174 @@ void ServiceRoot::requestItemRemoval(RootItem *item) {
 }
 
 void ServiceRoot::syncIn() {
-  QIcon original_icon = icon();
+  if (!qApp->feedUpdateLock()->tryLock()) {
+    // Lock was not obtained because
+    // it is used probably by feed updater or application
+    // is quitting. Try it again later.
+    if (!m_syncInScheduled) {
+      m_syncInScheduled = true;
+      qDebug("Sync-in of account %d is postponed because another critical operation is ongoing.", accountId());
+      QTimer::singleShot(SYNC_IN_RETRY_INTERVAL, this, SLOT(retrySyncIn()));
+    }
+
+    return;
+  }
+
+  m_iconBeforeSyncIn = icon();
 
   setIcon(qApp->icons()->fromTheme(QSL("view-refresh")));
   itemChanged(QList<RootItem*>() << this);
 
-  RootItem *new_tree = obtainNewTreeForSyncIn();
+  // Lock is released when new tree is applied.
+  QThreadPool::globalInstance()->start(new SyncInTask(this));
+}
+
+void ServiceRoot::retrySyncIn() {
+  m_syncInScheduled = false;
+  syncIn();
+}
 
+void ServiceRoot::applyNewTreeForSyncIn(RootItem *new_tree) {
   if (new_tree != nullptr) {
-    // Purge old data from SQL and clean all model items.
-    requestItemExpandStateSave(this);
+    QHash<int,Category*> old_categories = getHashedSubTreeCategories();
+    QHash<int,Feed*> old_feeds = getHashedSubTreeFeeds();
+    QList<RootItem*> new_items = new_tree->getSubTree();
+    QHash<RootItem*,RootItem*> new_parents;
+    QHash<RootItem*,RootItem*> live_items;
+    QList<RootItem*> added_items;
+    QList<RootItem*> changed_items;
+    QList<RootItem*> removed_items;
+    QList<RootItem*> obsolete_items;
+
+    // Disassemble new tree, its items are then matched with existing
+    // items one by one, parents always go before their children.
+    new_items.removeFirst();
+    live_items.insert(new_tree, this);
+
+    foreach (RootItem *item, new_items) {
+      new_parents.insert(item, item->parent());
+      item->clearChildren();
+      item->setParent(nullptr);
+
+      if (item->kind() == RootItemKind::Feed && !item->toFeed()->iconImage().isNull()) {
+        // Icons can be created only here in GUI thread.
+        item->setIcon(QIcon(QPixmap::fromImage(item->toFeed()->iconImage())));
+        item->toFeed()->setIconImage(QImage());
+      }
+    }
+
+    new_tree->clearChildren();
+
+    foreach (RootItem *item, new_items) {
+      RootItem *live_parent = live_items.value(new_parents.value(item));
+      RootItem *old_item = nullptr;
+
+      if (item->kind() == RootItemKind::Category) {
+        old_item = old_categories.take(item->customId());
+      }
+      else if (item->kind() == RootItemKind::Feed) {
+        old_item = old_feeds.take(item->customId());
+      }
+
+      if (old_item == nullptr) {
+        // This item is new, place it into the tree.
+        requestItemReassignment(item, live_parent);
+        live_items.insert(item, item);
+        added_items.append(item);
+      }
+      else {
+        // Item exists, transfer changed attributes only.
+        bool changed = false;
 
-    QMap<int,QVariant> feed_custom_data = storeCustomFeedsData();
+        if (old_item->title() != item->title()) {
+          old_item->setTitle(item->title());
+          changed = true;
+        }
 
-    removeOldFeedTree(false);
-    cleanAllItems();
-    restoreCustomFeedsData(feed_custom_data, new_tree->getHashedSubTreeFeeds());
+        if (old_item->kind() == RootItemKind::Feed && !item->icon().isNull() &&
+            qApp->icons()->toByteArray(old_item->icon()) != qApp->icons()->toByteArray(item->icon())) {
+          old_item->setIcon(item->icon());
+          changed = true;
+        }
 
-    // Model is clean, now store new tree into DB and
-    // set primary IDs of the items.
-    storeNewFeedTree(new_tree);
+        if (old_item->parent() != live_parent) {
+          requestItemReassignment(old_item, live_parent);
+          changed = true;
+        }
 
-    // We have new feed, some feeds were maybe removed,
-    // so remove left over messages.
-    removeLeftOverMessages();
+        if (changed) {
+          changed_items.append(old_item);
+        }
 
-    foreach (RootItem *top_level_item, new_tree->childItems()) {
-      top_level_item->setParent(nullptr);
-      requestItemReassignment(top_level_item, this);
+        live_items.insert(item, old_item);
+        obsolete_items.append(item);
+      }
     }
 
-    updateCounts(true);
+    // Items which were not matched, are not present on server anymore.
+    QSet<RootItem*> unmatched_items;
 
-    new_tree->clearChildren();
-    new_tree->deleteLater();
+    foreach (Category *category, old_categories.values()) {
+      unmatched_items.insert(category);
+    }
 
-    QList<RootItem*> all_items = getSubTree();
+    foreach (Feed *feed, old_feeds.values()) {
+      unmatched_items.insert(feed);
+    }
 
-    itemChanged(all_items);
-    requestReloadMessageList(true);
+    foreach (RootItem *item, unmatched_items) {
+      if (!unmatched_items.contains(item->parent())) {
+        removed_items.append(item);
+      }
+    }
 
-    // Now we must refresh expand states.
+    QSqlDatabase database = qApp->database()->connection(metaObject()->className(), DatabaseFactory::FromSettings);
+
+    if (!DatabaseQueries::updateAccountTree(database, added_items, changed_items, removed_items, accountId())) {
+      qCritical("Failed to store synchronized tree of account %d.", accountId());
+    }
+
+    foreach (RootItem *item, removed_items) {
+      requestItemRemoval(item);
+    }
+
+    if (!removed_items.isEmpty()) {
+      // Some feeds were maybe removed, so remove left over messages.
+      removeLeftOverMessages();
+    }
+
+    qDebug("Sync-in of account %d added %d, changed %d and removed %d items.",
+           accountId(), added_items.size(), changed_items.size(), removed_items.size());
+
+    qDeleteAll(obsolete_items);
+    new_tree->deleteLater();
+
+    if (!added_items.isEmpty() || !removed_items.isEmpty()) {
+      updateCounts(true);
+      requestReloadMessageList(false);
+    }
+
+    // Now we must refresh expand states of new categories.
     QList<RootItem*> items_to_expand;
 
-    foreach (RootItem *item, all_items) {
-      if (qApp->settings()->value(GROUP(CategoriesExpandStates), item->hashCode(), item->childCount() > 0).toBool()) {
+    foreach (RootItem *item, added_items) {
+      if (item->kind() == RootItemKind::Category &&
+          qApp->settings()->value(GROUP(CategoriesExpandStates), item->hashCode(), item->childCount() > 0).toBool()) {
         items_to_expand.append(item);
       }
     }
 
-    if (!items_to_expand.contains(this)) {
-      items_to_expand.prepend(this);
+    if (!items_to_expand.isEmpty()) {
+      requestItemExpand(items_to_expand, true);
     }
 
-    requestItemExpand(items_to_expand, true);
+    itemChanged(changed_items);
   }
 
-  setIcon(original_icon);
+  setIcon(m_iconBeforeSyncIn);
   itemChanged(QList<RootItem*>() << this);
+
+  qApp->feedUpdateLock()->unlock();
 }
 
 RootItem *ServiceRoot::obtainNewTreeForSyncIn() const {
@@ -22,6 +22,8 @@
 
 #include "core/message.h"
 
+#include <QAtomicInt>
+#include <QMap>
 #include <QPair>
 
 
@@ -35,6 +37,9 @@ typedef QList<QPair<int,RootItem*> > Assignment;
 typedef QPair<int,RootItem*> AssignmentItem;
 typedef QPair<Message,RootItem::Importance> ImportanceChange;
 
+// Unread and total counts of messages, keys are custom IDs of feeds.
+typedef QMap<int,QPair<int,int> > MessageCounts;
+
 // THIS IS the root node of the service.
 // NOTE: The root usually contains some core functionality of the
 // service like service account username/password etc.
@@ -71,6 +76,19 @@ class ServiceRoot : public RootItem {
 
     void updateCounts(bool including_total_count);
 
+    // Sets counts of messages of feeds and of recycle bin without touching
+    // database. Feeds which are not in feed_counts have no messages.
+    void setCounts(const MessageCounts &feed_counts, int bin_unread_count, int bin_total_count);
+    MessageCounts feedCounts() const;
+
+    // Obtains exact counts of messages in background thread,
+    // counts are then set and displayed.
+    void updateCountsInBackground();
+
+    // Counts of background recounts which were started before this call
+    // are stale and will be dropped. Called when counts are updated directly.
+    void discardPendingRecounts();
+
     QList<Message> undeletedMessages() const;
 
     // Start/stop services.
@@ -171,12 +189,12 @@ class ServiceRoot : public RootItem {
   protected:
     // This method should obtain new tree of feed/messages/etc to perform
     // sync in.
+    // NOTE: This method is called from background thread.
     virtual RootItem *obtainNewTreeForSyncIn() const;
 
     // Removes all messages/categories/feeds which are
     // associated with this account.
     void removeOldFeedTree(bool including_messages);
-    void storeNewFeedTree(RootItem *root);
     void cleanAllItems();
 
     // Removes messages which do not belong to any
@@ -204,11 +222,26 @@ class ServiceRoot : public RootItem {
     void itemReassignmentRequested(RootItem *item, RootItem *new_parent);
     void itemRemovalRequested(RootItem *item);
 
+  private slots:
+    // Performs sync-in which was postponed because feed update lock was not free.
+    void retrySyncIn();
+
+    // Reconciles current tree of this account with new tree
+    // obtained in background by sync-in. Only differences are applied.
+    void applyNewTreeForSyncIn(RootItem *new_tree);
+
+    void applyRecountedCounts(const MessageCounts &feed_counts, int bin_unread_count, int bin_total_count, int generation);
+
   private:
-    virtual QMap<int,QVariant> storeCustomFeedsData() = 0;
-    virtual void restoreCustomFeedsData(const QMap<int,QVariant> &data, const QHash<int,Feed*> &feeds) = 0;
+    friend class SyncInTask;
 
     int m_accountId;
+    QIcon m_iconBeforeSyncIn;
+    bool m_syncInScheduled;
+
+    // Increased whenever counts are updated directly or new background
+    // recount starts, only the newest recount is applied.
+    QAtomicInt m_countsGeneration;
 };
 
 #endif // SERVICEROOT_H
@@ -23,6 +23,8 @@
 #include "miscellaneous/iconfactory.h"
 #include "network-web/networkfactory.h"
 
+#include <QTimer>
+
 
 FormEditOwnCloudAccount::FormEditOwnCloudAccount(QWidget *parent)
   : QDialog(parent), m_ui(new Ui::FormEditOwnCloudAccount), m_editableRoot(nullptr) {
@@ -148,7 +150,8 @@ void FormEditOwnCloudAccount::onClickedOk() {
 
   if (editing_account) {
     m_editableRoot->completelyRemoveAllData();
-    m_editableRoot->syncIn();
+    // Sync-in needs critical lock, which is held by caller now.
+    QTimer::singleShot(0, m_editableRoot, SLOT(syncIn()));
   }
 }
 
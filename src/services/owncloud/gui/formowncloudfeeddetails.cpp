@@ -58,6 +58,7 @@ void FormOwnCloudFeedDetails::apply() {
     new_feed_data->setAutoUpdateInitialInterval(m_ui->m_spinAutoUpdateInterval->value());
 
     qobject_cast<OwnCloudFeed*>(m_editableFeed)->editItself(new_feed_data);
+    m_editableFeed->editRetentionPolicy(retentionPolicy());
 
     delete new_feed_data;
 
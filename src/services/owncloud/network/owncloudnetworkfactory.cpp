@@ -20,6 +20,7 @@
 #include "services/owncloud/definitions.h"
 #include "network-web/networkfactory.h"
 #include "miscellaneous/application.h"
+#include "miscellaneous/jsonreader.h"
 #include "miscellaneous/settings.h"
 #include "miscellaneous/textfactory.h"
 #include "services/abstract/rootitem.h"
@@ -34,8 +35,8 @@
 
 OwnCloudNetworkFactory::OwnCloudNetworkFactory()
   : m_url(QString()), m_fixedUrl(QString()), m_forceServerSideUpdate(false),
-    m_authUsername(QString()), m_authPassword(QString()), m_urlUser(QString()), m_urlStatus(QString()),
-    m_urlFolders(QString()), m_urlFeeds(QString()), m_urlMessages(QString()), m_urlFeedsUpdate(QString()),
+    m_authUsername(QString()), m_encryptedAuthPassword(QString()), m_urlUser(QString()), m_urlStatus(QString()),
+    m_urlFolders(QString()), m_urlFeeds(QString()), m_urlMessages(QString()), m_urlUpdatedMessages(QString()), m_urlFeedsUpdate(QString()),
     m_urlDeleteFeed(QString()), m_urlRenameFeed(QString()), m_userId(QString()) {
 }
 
@@ -62,6 +63,7 @@ void OwnCloudNetworkFactory::setUrl(const QString &url) {
   m_urlFolders = m_fixedUrl + API_PATH + "folders";
   m_urlFeeds = m_fixedUrl + API_PATH + "feeds";
   m_urlMessages = m_fixedUrl + API_PATH + "items?id=%1&batchSize=%2&type=%3";
+  m_urlUpdatedMessages = m_fixedUrl + API_PATH + "items/updated?lastModified=%1&type=3&id=0";
   m_urlFeedsUpdate = m_fixedUrl + API_PATH + "feeds/update?userId=%1&feedId=%2";
   m_urlDeleteFeed = m_fixedUrl + API_PATH + "feeds/%1";
   m_urlRenameFeed = m_fixedUrl + API_PATH + "feeds/%1/rename";
@@ -88,11 +90,15 @@ void OwnCloudNetworkFactory::setAuthUsername(const QString &auth_username) {
 }
 
 QString OwnCloudNetworkFactory::authPassword() const {
-  return m_authPassword;
+  return TextFactory::decrypt(m_encryptedAuthPassword);
 }
 
 void OwnCloudNetworkFactory::setAuthPassword(const QString &auth_password) {
-  m_authPassword = auth_password;
+  setEncryptedAuthPassword(TextFactory::encrypt(auth_password));
+}
+
+void OwnCloudNetworkFactory::setEncryptedAuthPassword(const QString &encrypted_auth_password) {
+  m_encryptedAuthPassword = encrypted_auth_password;
 
   setUserId(QString());
 }
@@ -108,9 +114,9 @@ OwnCloudUserResponse OwnCloudNetworkFactory::userInfo() {
                                                                                                 SETTING(Feeds::UpdateTimeout)).toInt(),
                                                                         QByteArray(), QString(), result_raw,
                                                                         QNetworkAccessManager::GetOperation,
-                                                                        true, m_authUsername, m_authPassword,
+                                                                        true, m_authUsername, authPassword(),
                                                                         true);
-  OwnCloudUserResponse user_response(QString::fromUtf8(result_raw));
+  OwnCloudUserResponse user_response(result_raw);
 
   if (network_reply.first != QNetworkReply::NoError) {
     qWarning("ownCloud: Obtaining user info failed with error %d.", network_reply.first);
@@ -127,9 +133,9 @@ OwnCloudStatusResponse OwnCloudNetworkFactory::status() {
                                                                                                 SETTING(Feeds::UpdateTimeout)).toInt(),
                                                                         QByteArray(), QString(), result_raw,
                                                                         QNetworkAccessManager::GetOperation,
-                                                                        true, m_authUsername, m_authPassword,
+                                                                        true, m_authUsername, authPassword(),
                                                                         true);
-  OwnCloudStatusResponse status_response(QString::fromUtf8(result_raw));
+  OwnCloudStatusResponse status_response(result_raw);
 
   if (network_reply.first != QNetworkReply::NoError) {
     qWarning("ownCloud: Obtaining status info failed with error %d.", network_reply.first);
@@ -146,7 +152,7 @@ OwnCloudGetFeedsCategoriesResponse OwnCloudNetworkFactory::feedsCategories() {
                                                                                                 SETTING(Feeds::UpdateTimeout)).toInt(),
                                                                         QByteArray(), QString(), result_raw,
                                                                         QNetworkAccessManager::GetOperation,
-                                                                        true, m_authUsername, m_authPassword,
+                                                                        true, m_authUsername, authPassword(),
                                                                         true);
   if (network_reply.first != QNetworkReply::NoError) {
     qWarning("ownCloud: Obtaining of categories failed with error %d.", network_reply.first);
@@ -155,7 +161,7 @@ OwnCloudGetFeedsCategoriesResponse OwnCloudNetworkFactory::feedsCategories() {
     return OwnCloudGetFeedsCategoriesResponse();
   }
 
-  QString content_categories = QString::fromUtf8(result_raw);
+  QByteArray content_categories = result_raw;
 
   // Now, obtain feeds.
   network_reply = NetworkFactory::performNetworkOperation(m_urlFeeds,
@@ -163,7 +169,7 @@ OwnCloudGetFeedsCategoriesResponse OwnCloudNetworkFactory::feedsCategories() {
                                                                                   SETTING(Feeds::UpdateTimeout)).toInt(),
                                                           QByteArray(), QString(), result_raw,
                                                           QNetworkAccessManager::GetOperation,
-                                                          true, m_authUsername, m_authPassword,
+                                                          true, m_authUsername, authPassword(),
                                                           true);
   if (network_reply.first != QNetworkReply::NoError) {
     qWarning("ownCloud: Obtaining of feeds failed with error %d.", network_reply.first);
@@ -171,7 +177,7 @@ OwnCloudGetFeedsCategoriesResponse OwnCloudNetworkFactory::feedsCategories() {
     return OwnCloudGetFeedsCategoriesResponse();
   }
 
-  QString content_feeds = QString::fromUtf8(result_raw);
+  QByteArray content_feeds = result_raw;
   m_lastError = network_reply.first;
 
   return OwnCloudGetFeedsCategoriesResponse(content_categories, content_feeds);
@@ -185,7 +191,7 @@ bool OwnCloudNetworkFactory::deleteFeed(int feed_id) {
                                                                                                 SETTING(Feeds::UpdateTimeout)).toInt(),
                                                                         QByteArray(), QString(),
                                                                         raw_output, QNetworkAccessManager::DeleteOperation,
-                                                                        true, m_authUsername, m_authPassword, true);
+                                                                        true, m_authUsername, authPassword(), true);
 
   m_lastError = network_reply.first;
 
@@ -212,7 +218,7 @@ bool OwnCloudNetworkFactory::createFeed(const QString &url, int parent_id) {
                                                                         QSL("application/json"),
                                                                         result_raw,
                                                                         QNetworkAccessManager::PostOperation,
-                                                                        true, m_authUsername, m_authPassword, true);
+                                                                        true, m_authUsername, authPassword(), true);
 
   m_lastError = network_reply.first;
 
@@ -238,7 +244,7 @@ bool OwnCloudNetworkFactory::renameFeed(const QString &new_name, int feed_id) {
                                                                         QJsonDocument(json).toJson(QJsonDocument::Compact),
                                                                         QSL("application/json"), result_raw,
                                                                         QNetworkAccessManager::PutOperation,
-                                                                        true, m_authUsername, m_authPassword,
+                                                                        true, m_authUsername, authPassword(),
                                                                         true);
   m_lastError = network_reply.first;
 
@@ -265,9 +271,9 @@ OwnCloudGetMessagesResponse OwnCloudNetworkFactory::getMessages(int feed_id) {
                                                                                                 SETTING(Feeds::UpdateTimeout)).toInt(),
                                                                         QByteArray(), QString(), result_raw,
                                                                         QNetworkAccessManager::GetOperation,
-                                                                        true, m_authUsername, m_authPassword,
+                                                                        true, m_authUsername, authPassword(),
                                                                         true);
-  OwnCloudGetMessagesResponse msgs_response(QString::fromUtf8(result_raw));
+  OwnCloudGetMessagesResponse msgs_response(result_raw);
 
   if (network_reply.first != QNetworkReply::NoError) {
     qWarning("ownCloud: Obtaining messages failed with error %d.", network_reply.first);
@@ -277,6 +283,26 @@ OwnCloudGetMessagesResponse OwnCloudNetworkFactory::getMessages(int feed_id) {
   return msgs_response;
 }
 
+OwnCloudGetMessagesResponse OwnCloudNetworkFactory::getUpdatedMessages(qint64 last_modified) {
+  QString final_url = m_urlUpdatedMessages.arg(QString::number(last_modified));
+  QByteArray result_raw;
+  NetworkResult network_reply = NetworkFactory::performNetworkOperation(final_url,
+                                                                        qApp->settings()->value(GROUP(Feeds),
+                                                                                                SETTING(Feeds::UpdateTimeout)).toInt(),
+                                                                        QByteArray(), QString(), result_raw,
+                                                                        QNetworkAccessManager::GetOperation,
+                                                                        true, m_authUsername, authPassword(),
+                                                                        true);
+  OwnCloudGetMessagesResponse msgs_response(result_raw);
+
+  if (network_reply.first != QNetworkReply::NoError) {
+    qWarning("ownCloud: Obtaining updated messages failed with error %d.", network_reply.first);
+  }
+
+  m_lastError = network_reply.first;
+  return msgs_response;
+}
+
 QNetworkReply::NetworkError OwnCloudNetworkFactory::triggerFeedUpdate(int feed_id) {
   if (userId().isEmpty()) {
     // We need to get user ID first.
@@ -299,7 +325,7 @@ QNetworkReply::NetworkError OwnCloudNetworkFactory::triggerFeedUpdate(int feed_i
                                                                                                 SETTING(Feeds::UpdateTimeout)).toInt(),
                                                                         QByteArray(), QString(), raw_output,
                                                                         QNetworkAccessManager::GetOperation,
-                                                                        true, m_authUsername, m_authPassword,
+                                                                        true, m_authUsername, authPassword(),
                                                                         true);
 
   if (network_reply.first != QNetworkReply::NoError) {
@@ -337,7 +363,7 @@ QNetworkReply::NetworkError OwnCloudNetworkFactory::markMessagesRead(RootItem::R
                                                                         QSL("application/json"),
                                                                         raw_output,
                                                                         QNetworkAccessManager::PutOperation,
-                                                                        true, m_authUsername, m_authPassword,
+                                                                        true, m_authUsername, authPassword(),
                                                                         true);
 
   if (network_reply.first != QNetworkReply::NoError) {
@@ -380,7 +406,7 @@ QNetworkReply::NetworkError OwnCloudNetworkFactory::markMessagesStarred(RootItem
                                                                         "application/json",
                                                                         raw_output,
                                                                         QNetworkAccessManager::PutOperation,
-                                                                        true, m_authUsername, m_authPassword,
+                                                                        true, m_authUsername, authPassword(),
                                                                         true);
 
   if (network_reply.first != QNetworkReply::NoError) {
@@ -398,8 +424,8 @@ void OwnCloudNetworkFactory::setUserId(const QString &userId) {
   m_userId = userId;
 }
 
-OwnCloudResponse::OwnCloudResponse(const QString &raw_content) {
-  m_rawContent = QJsonDocument::fromJson(raw_content.toUtf8()).object();
+OwnCloudResponse::OwnCloudResponse(const QByteArray &raw_content) {
+  m_rawContent = QJsonDocument::fromJson(raw_content).object();
 }
 
 OwnCloudResponse::~OwnCloudResponse() {
@@ -413,7 +439,7 @@ QString OwnCloudResponse::toString() const {
   return QJsonDocument(m_rawContent).toJson(QJsonDocument::Compact);
 }
 
-OwnCloudUserResponse::OwnCloudUserResponse(const QString &raw_content) : OwnCloudResponse(raw_content) {
+OwnCloudUserResponse::OwnCloudUserResponse(const QByteArray &raw_content) : OwnCloudResponse(raw_content) {
 }
 
 OwnCloudUserResponse::~OwnCloudUserResponse() {
@@ -450,10 +476,10 @@ QIcon OwnCloudUserResponse::avatar() const {
   if (isLoaded()) {
     QString image_data = m_rawContent["avatar"].toObject()["data"].toString();
     QByteArray decoded_data = QByteArray::fromBase64(image_data.toLocal8Bit());
-    QPixmap image;
+    QImage image;
 
     if (image.loadFromData(decoded_data)) {
-      return QIcon(image);
+      return QIcon(QPixmap::fromImage(image));
     }
   }
 
@@ -461,7 +487,7 @@ QIcon OwnCloudUserResponse::avatar() const {
 }
 
 
-OwnCloudStatusResponse::OwnCloudStatusResponse(const QString &raw_content) : OwnCloudResponse(raw_content) {
+OwnCloudStatusResponse::OwnCloudStatusResponse(const QByteArray &raw_content) : OwnCloudResponse(raw_content) {
 }
 
 OwnCloudStatusResponse::~OwnCloudStatusResponse() {
@@ -486,8 +512,8 @@ bool OwnCloudStatusResponse::misconfiguredCron() const {
 }
 
 
-OwnCloudGetFeedsCategoriesResponse::OwnCloudGetFeedsCategoriesResponse(const QString &raw_categories,
-                                                                       const QString &raw_feeds)
+OwnCloudGetFeedsCategoriesResponse::OwnCloudGetFeedsCategoriesResponse(const QByteArray &raw_categories,
+                                                                       const QByteArray &raw_feeds)
   : m_contentCategories(raw_categories), m_contentFeeds(raw_feeds) {
 }
 
@@ -501,7 +527,7 @@ RootItem *OwnCloudGetFeedsCategoriesResponse::feedsCategories(bool obtain_icons)
   cats.insert(0, parent);
 
   // Process categories first, then process feeds.
-  foreach (QJsonValue cat, QJsonDocument::fromJson(m_contentCategories.toUtf8()).object()["folders"].toArray()) {
+  foreach (QJsonValue cat, QJsonDocument::fromJson(m_contentCategories).object()["folders"].toArray()) {
     QJsonObject item = cat.toObject();
     OwnCloudCategory *category = new OwnCloudCategory();
 
@@ -515,7 +541,7 @@ RootItem *OwnCloudGetFeedsCategoriesResponse::feedsCategories(bool obtain_icons)
   }
 
   // We have categories added, now add all feeds.
-  foreach (QJsonValue fed, QJsonDocument::fromJson(m_contentFeeds.toUtf8()).object()["feeds"].toArray()) {
+  foreach (QJsonValue fed, QJsonDocument::fromJson(m_contentFeeds).object()["feeds"].toArray()) {
     QJsonObject item = fed.toObject();
     OwnCloudFeed *feed = new OwnCloudFeed();
 
@@ -528,10 +554,12 @@ RootItem *OwnCloudGetFeedsCategoriesResponse::feedsCategories(bool obtain_icons)
         if (NetworkFactory::performNetworkOperation(icon_path, DOWNLOAD_TIMEOUT,
                                                     QByteArray(), QString(), icon_data,
                                                     QNetworkAccessManager::GetOperation).first == QNetworkReply::NoError) {
-          // Icon downloaded, set it up.
-          QPixmap icon_pixmap;
-          icon_pixmap.loadFromData(icon_data);
-          feed->setIcon(QIcon(icon_pixmap));
+          // Icon downloaded, only decode it here, this runs in background thread.
+          QImage icon_image;
+
+          if (icon_image.loadFromData(icon_data)) {
+            feed->setIconImage(icon_image);
+          }
         }
       }
     }
@@ -547,45 +575,102 @@ RootItem *OwnCloudGetFeedsCategoriesResponse::feedsCategories(bool obtain_icons)
 }
 
 
-OwnCloudGetMessagesResponse::OwnCloudGetMessagesResponse(const QString &raw_content) : OwnCloudResponse(raw_content) {
+OwnCloudGetMessagesResponse::OwnCloudGetMessagesResponse(const QByteArray &raw_content)
+  : OwnCloudResponse(), m_messages(QList<Message>()), m_lastModified(0) {
+  JsonReader reader(raw_content);
+
+  if (reader.readNext() != JsonReader::StartObject) {
+    return;
+  }
+
+  while (reader.readNext() != JsonReader::EndObject && !reader.hasError()) {
+    if (reader.isName("items") && reader.tokenType() == JsonReader::StartArray) {
+      // Process items one by one.
+      while (reader.readNext() != JsonReader::EndArray && !reader.hasError()) {
+        if (reader.tokenType() == JsonReader::StartObject) {
+          m_messages.append(readMessage(reader));
+        }
+        else {
+          reader.skipCurrentValue();
+        }
+      }
+    }
+    else {
+      const QString member_name = reader.name();
+      m_rawContent.insert(member_name, reader.readValue());
+    }
+  }
+
+  if (reader.hasError()) {
+    qWarning("ownCloud: Messages response is not valid JSON: '%s'.", qPrintable(reader.errorString()));
+  }
 }
 
 OwnCloudGetMessagesResponse::~OwnCloudGetMessagesResponse() {
 }
 
 QList<Message> OwnCloudGetMessagesResponse::messages() const {
-  QList<Message> msgs;
-
-  foreach (QJsonValue message, m_rawContent["items"].toArray()) {
-    QJsonObject message_map = message.toObject();
-    Message msg;
-
-    msg.m_author = message_map["author"].toString();
-    msg.m_contents = message_map["body"].toString();
-    msg.m_created = TextFactory::parseDateTime(message_map["pubDate"].toDouble() * 1000);
-    msg.m_createdFromFeed = true;
-    msg.m_customId = QString::number(message_map["id"].toInt());
-    msg.m_customHash = message_map["guidHash"].toString();
+  return m_messages;
+}
 
-    QString enclosure_link = message_map["enclosureLink"].toString();
+qint64 OwnCloudGetMessagesResponse::lastModified() const {
+  return m_lastModified;
+}
 
-    if (!enclosure_link.isEmpty()) {
-      Enclosure enclosure;
+Message OwnCloudGetMessagesResponse::readMessage(JsonReader &reader) {
+  Message msg;
+  Enclosure enclosure;
 
-      enclosure.m_mimeType = message_map["enclosureMime"].toString();
-      enclosure.m_url = enclosure_link;
+  msg.m_createdFromFeed = true;
 
-      msg.m_enclosures.append(enclosure);
+  while (reader.readNext() != JsonReader::EndObject && !reader.hasError()) {
+    if (reader.isName("author")) {
+      msg.m_author = reader.text();
+    }
+    else if (reader.isName("body")) {
+      msg.m_contents = reader.text();
+    }
+    else if (reader.isName("pubDate")) {
+      msg.m_created = TextFactory::parseDateTime(reader.number() * 1000);
+    }
+    else if (reader.isName("id")) {
+      msg.m_customId = QString::number((int) reader.number());
+    }
+    else if (reader.isName("guidHash")) {
+      msg.m_customHash = reader.text();
+    }
+    else if (reader.isName("enclosureLink")) {
+      enclosure.m_url = reader.text();
+    }
+    else if (reader.isName("enclosureMime")) {
+      enclosure.m_mimeType = reader.text();
+    }
+    else if (reader.isName("feedId")) {
+      msg.m_feedId = QString::number((int) reader.number());
+    }
+    else if (reader.isName("starred")) {
+      msg.m_isImportant = reader.boolean();
+    }
+    else if (reader.isName("unread")) {
+      msg.m_isRead = !reader.boolean();
+    }
+    else if (reader.isName("title")) {
+      msg.m_title = reader.text();
+    }
+    else if (reader.isName("url")) {
+      msg.m_url = reader.text();
+    }
+    else if (reader.isName("lastModified")) {
+      m_lastModified = qMax(m_lastModified, (qint64) reader.number());
     }
 
-    msg.m_feedId = QString::number(message_map["feedId"].toInt());
-    msg.m_isImportant = message_map["starred"].toBool();
-    msg.m_isRead = !message_map["unread"].toBool();
-    msg.m_title = message_map["title"].toString();
-    msg.m_url = message_map["url"].toString();
+    // Skip all unprocessed nested values.
+    reader.skipCurrentValue();
+  }
 
-    msgs.append(msg);
+  if (!enclosure.m_url.isEmpty()) {
+    msg.m_enclosures.append(enclosure);
   }
 
-  return msgs;
+  return msg;
 }
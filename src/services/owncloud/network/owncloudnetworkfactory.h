@@ -28,9 +28,11 @@
 #include <QJsonObject>
 
 
+class JsonReader;
+
 class OwnCloudResponse {
   public:
-    explicit OwnCloudResponse(const QString &raw_content = QString());
+    explicit OwnCloudResponse(const QByteArray &raw_content = QByteArray());
     virtual ~OwnCloudResponse();
 
     bool isLoaded() const;
@@ -42,7 +44,7 @@ class OwnCloudResponse {
 
 class OwnCloudUserResponse : public OwnCloudResponse {
   public:
-    explicit OwnCloudUserResponse(const QString &raw_content = QString());
+    explicit OwnCloudUserResponse(const QByteArray &raw_content = QByteArray());
     virtual ~OwnCloudUserResponse();
 
     QString userId() const;
@@ -51,17 +53,29 @@ class OwnCloudUserResponse : public OwnCloudResponse {
     QIcon avatar() const;
 };
 
+// NOTE: Items are read directly from raw response data
+// in one pass, no intermediate JSON document is built for them.
 class OwnCloudGetMessagesResponse : public OwnCloudResponse {
   public:
-    explicit OwnCloudGetMessagesResponse(const QString &raw_content = QString());
+    explicit OwnCloudGetMessagesResponse(const QByteArray &raw_content = QByteArray());
     virtual ~OwnCloudGetMessagesResponse();
 
     QList<Message> messages() const;
+
+    // Returns highest "lastModified" stamp of all contained items
+    // or zero if there are no items.
+    qint64 lastModified() const;
+
+  private:
+    Message readMessage(JsonReader &reader);
+
+    QList<Message> m_messages;
+    qint64 m_lastModified;
 };
 
 class OwnCloudStatusResponse : public OwnCloudResponse {
   public:
-    explicit OwnCloudStatusResponse(const QString &raw_content = QString());
+    explicit OwnCloudStatusResponse(const QByteArray &raw_content = QByteArray());
     virtual ~OwnCloudStatusResponse();
 
     QString version() const;
@@ -72,8 +86,8 @@ class RootItem;
 
 class OwnCloudGetFeedsCategoriesResponse {
   public:
-    explicit OwnCloudGetFeedsCategoriesResponse(const QString &raw_categories = QString(),
-                                                const QString &raw_feeds = QString());
+    explicit OwnCloudGetFeedsCategoriesResponse(const QByteArray &raw_categories = QByteArray(),
+                                                const QByteArray &raw_feeds = QByteArray());
     virtual ~OwnCloudGetFeedsCategoriesResponse();
 
     // Returns tree of feeds/categories.
@@ -82,8 +96,8 @@ class OwnCloudGetFeedsCategoriesResponse {
     RootItem *feedsCategories(bool obtain_icons) const;
 
   private:
-    QString m_contentCategories;
-    QString m_contentFeeds;
+    QByteArray m_contentCategories;
+    QByteArray m_contentFeeds;
 };
 
 class OwnCloudNetworkFactory {
@@ -100,8 +114,11 @@ class OwnCloudNetworkFactory {
     QString authUsername() const;
     void setAuthUsername(const QString &auth_username);
 
+    // Password is kept encrypted in memory and it is
+    // decrypted only when request is issued.
     QString authPassword() const;
     void setAuthPassword(const QString &auth_password);
+    void setEncryptedAuthPassword(const QString &encrypted_auth_password);
 
     QString userId() const;
     void setUserId(const QString &userId);
@@ -127,6 +144,11 @@ class OwnCloudNetworkFactory {
     // Get messages for given feed.
     OwnCloudGetMessagesResponse getMessages(int feed_id);
 
+    // Get all messages of the account which were changed or created
+    // since given "last_modified" stamp (in seconds).
+    // NOTE: Zero stamp yields all messages of the account.
+    OwnCloudGetMessagesResponse getUpdatedMessages(qint64 last_modified);
+
     // Misc methods.
     QNetworkReply::NetworkError triggerFeedUpdate(int feed_id);
     QNetworkReply::NetworkError markMessagesRead(RootItem::ReadStatus status, const QStringList &custom_ids);
@@ -138,7 +160,7 @@ class OwnCloudNetworkFactory {
     QString m_fixedUrl;
     bool m_forceServerSideUpdate;
     QString m_authUsername;
-    QString m_authPassword;
+    QString m_encryptedAuthPassword;
     QNetworkReply::NetworkError m_lastError;
 
     // Endpoints.
@@ -147,6 +169,7 @@ class OwnCloudNetworkFactory {
     QString m_urlFolders;
     QString m_urlFeeds;
     QString m_urlMessages;
+    QString m_urlUpdatedMessages;
     QString m_urlFeedsUpdate;
     QString m_urlDeleteFeed;
     QString m_urlRenameFeed;
@@ -31,6 +31,7 @@ OwnCloudCategory::OwnCloudCategory(const QSqlRecord &record) : Category(nullptr)
   setId(record.value(CAT_DB_ID_INDEX).toInt());
   setTitle(record.value(CAT_DB_TITLE_INDEX).toString());
   setCustomId(record.value(CAT_DB_CUSTOM_ID_INDEX).toInt());
+  setRetentionPolicy(RetentionPolicy::fromRecord(record, CAT_DB_RETENTION_INDEX));
 }
 
 OwnCloudCategory::~OwnCloudCategory() {
@@ -32,10 +32,11 @@ OwnCloudFeed::OwnCloudFeed(RootItem *parent) : Feed(parent) {
 OwnCloudFeed::OwnCloudFeed(const QSqlRecord &record) : Feed(nullptr) {
   setTitle(record.value(FDS_DB_TITLE_INDEX).toString());
   setId(record.value(FDS_DB_ID_INDEX).toInt());
-  setIcon(qApp->icons()->fromByteArray(record.value(FDS_DB_ICON_INDEX).toByteArray()));
+  setIcon(qApp->icons()->storedIcon(record.value(FDS_DB_ICON_INDEX).toString()));
   setAutoUpdateType(static_cast<Feed::AutoUpdateType>(record.value(FDS_DB_UPDATE_TYPE_INDEX).toInt()));
   setAutoUpdateInitialInterval(record.value(FDS_DB_UPDATE_INTERVAL_INDEX).toInt());
   setCustomId(record.value(FDS_DB_CUSTOM_ID_INDEX).toInt());
+  setRetentionPolicy(RetentionPolicy::fromRecord(record, FDS_DB_RETENTION_INDEX));
 }
 
 OwnCloudFeed::~OwnCloudFeed() {
@@ -109,18 +110,18 @@ OwnCloudServiceRoot *OwnCloudFeed::serviceRoot() const {
 }
 
 QList<Message> OwnCloudFeed::obtainNewMessages(bool *error_during_obtaining) {
-  OwnCloudGetMessagesResponse messages = serviceRoot()->network()->getMessages(customId());
+  if (serviceRoot()->network()->forceServerSideUpdate()) {
+    serviceRoot()->network()->triggerFeedUpdate(customId());
+  }
+
+  QList<Message> messages = serviceRoot()->obtainNewMessagesForFeed(customId(), error_during_obtaining);
 
-  if (serviceRoot()->network()->lastError() != QNetworkReply::NoError) {
+  if (*error_during_obtaining) {
     setStatus(Feed::NetworkError);
-    *error_during_obtaining = true;
     serviceRoot()->itemChanged(QList<RootItem*>() << this);
     return QList<Message>();
   }
   else {
-    *error_during_obtaining = false;
-    return messages.messages();
+    return messages;
   }
-
-  return QList<Message>();
 }
@@ -23,6 +23,7 @@
 #include "miscellaneous/textfactory.h"
 #include "miscellaneous/iconfactory.h"
 #include "miscellaneous/mutex.h"
+#include "miscellaneous/feedreader.h"
 #include "services/owncloud/owncloudserviceentrypoint.h"
 #include "services/owncloud/owncloudrecyclebin.h"
 #include "services/owncloud/owncloudfeed.h"
@@ -34,7 +35,9 @@
 
 OwnCloudServiceRoot::OwnCloudServiceRoot(RootItem *parent)
   : ServiceRoot(parent), m_recycleBin(new OwnCloudRecycleBin(this)),
-    m_actionSyncIn(nullptr), m_serviceMenu(QList<QAction*>()), m_network(new OwnCloudNetworkFactory()) {
+    m_actionSyncIn(nullptr), m_serviceMenu(QList<QAction*>()), m_network(new OwnCloudNetworkFactory()),
+    m_syncMutex(), m_lastModified(0), m_fetchedLastModified(0), m_fetchedAnything(false),
+    m_pendingMessages(QHash<int,QList<Message> >()), m_servedFeeds(QSet<int>()) {
   setIcon(OwnCloudServiceEntryPoint().icon());
 }
 
@@ -96,6 +99,10 @@ void OwnCloudServiceRoot::start(bool freshly_activated) {
 
   loadFromDatabase();
 
+  // Fetched changes are confirmed once all feeds stored them.
+  connect(qApp->feedReader(), &FeedReader::feedUpdatesFinished, this, &OwnCloudServiceRoot::onFeedUpdatesFinished,
+          Qt::UniqueConnection);
+
   if (qApp->isFirstRun(QSL("3.1.1")) || (childCount() == 1 && child(0)->kind() == RootItemKind::Bin)) {
     syncIn();
   }
@@ -175,6 +182,10 @@ void OwnCloudServiceRoot::saveAccountDataToDatabase() {
     if (DatabaseQueries::overwriteOwnCloudAccount(database, m_network->authUsername(),
                                                   m_network->authPassword(), m_network->url(),
                                                   m_network->forceServerSideUpdate(), accountId())) {
+      // Edited accounts get all their local data purged, so
+      // incremental sync must start from scratch.
+      setLastModified(0);
+      saveLastModifiedToDatabase();
       updateTitle();
       itemChanged(QList<RootItem*>() << this);
     }
@@ -195,6 +206,124 @@ void OwnCloudServiceRoot::saveAccountDataToDatabase() {
   }
 }
 
+qint64 OwnCloudServiceRoot::lastModified() const {
+  QMutexLocker locker(&m_syncMutex);
+
+  return m_lastModified;
+}
+
+void OwnCloudServiceRoot::setLastModified(qint64 last_modified) {
+  QMutexLocker locker(&m_syncMutex);
+
+  m_lastModified = m_fetchedLastModified = last_modified;
+  m_fetchedAnything = false;
+  m_pendingMessages.clear();
+  m_servedFeeds.clear();
+}
+
+QList<Message> OwnCloudServiceRoot::obtainNewMessagesForFeed(int feed_custom_id, bool *error_during_obtaining) {
+  QMutexLocker locker(&m_syncMutex);
+
+  if (!m_fetchedAnything) {
+    // This is the first feed of this update, we need to ask server for changes.
+    OwnCloudGetMessagesResponse response = m_network->getUpdatedMessages(m_lastModified);
+
+    if (m_network->lastError() != QNetworkReply::NoError) {
+      *error_during_obtaining = true;
+      return QList<Message>();
+    }
+
+    // Distribute changed messages among feeds.
+    QHash<int,Feed*> feeds = getHashedSubTreeFeeds();
+
+    foreach (const Message &msg, response.messages()) {
+      int msg_feed_id = msg.m_feedId.toInt();
+
+      if (feeds.contains(msg_feed_id)) {
+        m_pendingMessages[msg_feed_id].append(msg);
+      }
+    }
+
+    m_fetchedLastModified = qMax(m_lastModified, response.lastModified());
+    m_fetchedAnything = true;
+
+    qDebug("ownCloud: Account %d has changed messages in %d feeds since stamp %lld.",
+           accountId(), m_pendingMessages.size(), m_lastModified);
+  }
+  else if (m_servedFeeds.contains(feed_custom_id)) {
+    // Feed is updated again before messages of this update are stored,
+    // its newer changes are downloaded by the next update.
+    *error_during_obtaining = false;
+    return QList<Message>();
+  }
+
+  m_servedFeeds.insert(feed_custom_id);
+  *error_during_obtaining = false;
+
+  return m_pendingMessages.take(feed_custom_id);
+}
+
+void OwnCloudServiceRoot::onFeedUpdatesFinished() {
+  QMutexLocker locker(&m_syncMutex);
+
+  if (!m_fetchedAnything) {
+    return;
+  }
+
+  QHash<int,Feed*> feeds = getHashedSubTreeFeeds();
+  bool stored = true;
+
+  foreach (int feed_custom_id, m_servedFeeds) {
+    Feed *feed = feeds.value(feed_custom_id);
+
+    if (feed != nullptr && feed->updateStatistics().m_error) {
+      stored = false;
+    }
+  }
+
+  // Feeds which were not updated (manual or disabled updates) did not
+  // pick up their changes, no other update is running now, so store them.
+  foreach (int feed_custom_id, m_pendingMessages.keys()) {
+    Feed *feed = feeds.value(feed_custom_id);
+
+    if (feed != nullptr) {
+      qDebug("ownCloud: Storing %d changed messages of feed %d which was not updated.",
+             m_pendingMessages.value(feed_custom_id).size(), feed_custom_id);
+      feed->updateMessages(m_pendingMessages.value(feed_custom_id), false);
+      stored &= !feed->updateStatistics().m_error;
+    }
+  }
+
+  if (stored) {
+    // All fetched changes are in local database, we can
+    // now safely move our stamp forward.
+    advanceLastModified();
+  }
+  else {
+    qWarning("ownCloud: Not all changes of account %d were stored, they will be downloaded again.", accountId());
+  }
+
+  m_fetchedLastModified = m_lastModified;
+  m_fetchedAnything = false;
+  m_pendingMessages.clear();
+  m_servedFeeds.clear();
+}
+
+void OwnCloudServiceRoot::advanceLastModified() {
+  if (m_lastModified != m_fetchedLastModified) {
+    m_lastModified = m_fetchedLastModified;
+    QMetaObject::invokeMethod(this, "saveLastModifiedToDatabase", Qt::QueuedConnection);
+  }
+}
+
+void OwnCloudServiceRoot::saveLastModifiedToDatabase() {
+  QSqlDatabase database = qApp->database()->connection(metaObject()->className(), DatabaseFactory::FromSettings);
+
+  if (accountId() != NO_PARENT_CATEGORY) {
+    DatabaseQueries::overwriteOwnCloudLastModified(database, lastModified(), accountId());
+  }
+}
+
 void OwnCloudServiceRoot::addNewFeed(const QString &url) {
   if (!qApp->feedUpdateLock()->tryLock()) {
     // Lock was not obtained because
@@ -216,33 +345,6 @@ void OwnCloudServiceRoot::addNewFeed(const QString &url) {
 void OwnCloudServiceRoot::addNewCategory() {
 }
 
-QMap<int,QVariant> OwnCloudServiceRoot::storeCustomFeedsData() {
-  QMap<int,QVariant> custom_data;
-
-  foreach (const Feed *feed, getSubTreeFeeds()) {
-    QVariantMap feed_custom_data;
-
-    feed_custom_data.insert(QSL("auto_update_interval"), feed->autoUpdateInitialInterval());
-    feed_custom_data.insert(QSL("auto_update_type"), feed->autoUpdateType());
-
-    custom_data.insert(feed->customId(), feed_custom_data);
-  }
-
-  return custom_data;
-}
-
-void OwnCloudServiceRoot::restoreCustomFeedsData(const QMap<int,QVariant> &data, const QHash<int,Feed*> &feeds) {
-  foreach (int custom_id, data.keys()) {
-    if (feeds.contains(custom_id)) {
-      Feed *feed = feeds.value(custom_id);
-      QVariantMap feed_custom_data = data.value(custom_id).toMap();
-
-      feed->setAutoUpdateInitialInterval(feed_custom_data.value(QSL("auto_update_interval")).toInt());
-      feed->setAutoUpdateType(static_cast<Feed::AutoUpdateType>(feed_custom_data.value(QSL("auto_update_type")).toInt()));
-    }
-  }
-}
-
 RootItem *OwnCloudServiceRoot::obtainNewTreeForSyncIn() const {
   OwnCloudGetFeedsCategoriesResponse feed_cats_response = m_network->feedsCategories();
 
@@ -264,6 +366,6 @@ void OwnCloudServiceRoot::loadFromDatabase() {
   assembleFeeds(feeds);
 
   // As the last item, add recycle bin, which is needed.
+  // NOTE: Counts of messages are loaded by the model.
   appendChild(m_recycleBin);
-  updateCounts(true);
 }
@@ -20,6 +20,9 @@
 
 #include "services/abstract/serviceroot.h"
 
+#include <QMutex>
+#include <QSet>
+
 
 class OwnCloudNetworkFactory;
 class OwnCloudRecycleBin;
@@ -51,21 +54,49 @@ class OwnCloudServiceRoot : public ServiceRoot {
     void updateTitle();
     void saveAccountDataToDatabase();
 
+    // Last-modified stamp (in seconds) of the newest server-side
+    // change which is safely stored in local database.
+    qint64 lastModified() const;
+    void setLastModified(qint64 last_modified);
+
+    // Returns messages which changed on server since the last sync for given feed.
+    // All changed messages of the account are downloaded in one call performed
+    // by the first feed of each update, other feeds then pick up their parts.
+    // Watermark moves forward only after all feeds stored their parts.
+    // NOTE: This method is thread-safe.
+    QList<Message> obtainNewMessagesForFeed(int feed_custom_id, bool *error_during_obtaining);
+
   public slots:
     void addNewFeed(const QString &url);
     void addNewCategory();
 
+  private slots:
+    void saveLastModifiedToDatabase();
+
+    // Stores parts of feeds which were not updated and moves
+    // watermark forward if all fetched changes were stored.
+    void onFeedUpdatesFinished();
+
   private:
-    QMap<int,QVariant> storeCustomFeedsData();
-    void restoreCustomFeedsData(const QMap<int,QVariant> &data, const QHash<int,Feed*> &feeds);
     RootItem *obtainNewTreeForSyncIn() const;
 
+    // Must be called with m_syncMutex locked.
+    void advanceLastModified();
+
     void loadFromDatabase();
 
     OwnCloudRecycleBin *m_recycleBin;
     QAction *m_actionSyncIn;
     QList<QAction*> m_serviceMenu;
     OwnCloudNetworkFactory *m_network;
+
+    // Incremental sync state.
+    mutable QMutex m_syncMutex;
+    qint64 m_lastModified;
+    qint64 m_fetchedLastModified;
+    bool m_fetchedAnything;
+    QHash<int,QList<Message> > m_pendingMessages;
+    QSet<int> m_servedFeeds;
 };
 
 #endif // OWNCLOUDSERVICEROOT_H
@@ -72,6 +72,27 @@ void FormStandardCategoryDetails::setEditableCategory(StandardCategory *editable
   m_ui->m_txtTitle->lineEdit()->setText(editable_category->title());
   m_ui->m_txtDescription->lineEdit()->setText(editable_category->description());
   m_ui->m_btnIcon->setIcon(editable_category->icon());
+
+  const RetentionPolicy retention_policy = editable_category->retentionPolicy();
+
+  m_ui->m_gbRetention->setChecked(!retention_policy.isInherited());
+
+  if (!retention_policy.isInherited()) {
+    m_ui->m_spinRetentionMaxCount->setValue(retention_policy.m_maxCount);
+    m_ui->m_spinRetentionMaxAge->setValue(retention_policy.m_maxAge);
+    m_ui->m_checkRetentionKeepStarred->setChecked(retention_policy.m_keepStarred);
+  }
+}
+
+RetentionPolicy FormStandardCategoryDetails::retentionPolicy() const {
+  if (m_ui->m_gbRetention->isChecked()) {
+    return RetentionPolicy(m_ui->m_spinRetentionMaxCount->value(),
+                           m_ui->m_spinRetentionMaxAge->value(),
+                           m_ui->m_checkRetentionKeepStarred->isChecked());
+  }
+  else {
+    return RetentionPolicy();
+  }
 }
 
 int FormStandardCategoryDetails::exec(StandardCategory *input_category, RootItem *parent_to_select) {
@@ -122,6 +143,7 @@ void FormStandardCategoryDetails::apply() {
   if (m_editableCategory == nullptr) {
     // Add the category.
     if (new_category->addItself(parent)) {
+      new_category->editRetentionPolicy(retentionPolicy());
       m_serviceRoot->requestItemReassignment(new_category, parent);
       accept();
     }
@@ -136,7 +158,8 @@ void FormStandardCategoryDetails::apply() {
   else {
     new_category->setParent(parent);
 
-    bool edited = m_editableCategory->editItself(new_category);
+    bool edited = m_editableCategory->editItself(new_category) &&
+                  m_editableCategory->editRetentionPolicy(retentionPolicy());
 
     if (edited) {
       m_serviceRoot->requestItemReassignment(m_editableCategory, new_category->parent());
@@ -20,6 +20,8 @@
 
 #include "ui_formstandardcategorydetails.h"
 
+#include "core/retentionpolicy.h"
+
 #include <QDialog>
 
 
@@ -70,6 +72,9 @@ class FormStandardCategoryDetails : public QDialog {
     // Initializes the dialog.
     void initialize();
 
+    // Returns retention policy as set in the dialog.
+    RetentionPolicy retentionPolicy() const;
+
     // Loads categories into the dialog + give root "category"
     // and make sure that no childs of input category (including)
     // input category are loaded.
@@ -48,6 +48,7 @@ void FormStandardFeedDetails::apply() {
   if (m_editableFeed == nullptr) {
     // Add the feed.
     if (new_feed->addItself(parent)) {
+      new_feed->editRetentionPolicy(retentionPolicy());
       m_serviceRoot->requestItemReassignment(new_feed, parent);
       accept();
     }
@@ -62,7 +63,8 @@ void FormStandardFeedDetails::apply() {
     new_feed->setParent(parent);
 
     // Edit the feed.
-    bool edited = qobject_cast<StandardFeed*>(m_editableFeed)->editItself(new_feed);
+    bool edited = qobject_cast<StandardFeed*>(m_editableFeed)->editItself(new_feed) &&
+                  m_editableFeed->editRetentionPolicy(retentionPolicy());
 
     if (edited) {
       m_serviceRoot->requestItemReassignment(m_editableFeed, new_feed->parent());
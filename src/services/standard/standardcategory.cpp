@@ -43,6 +43,7 @@ StandardCategory::StandardCategory(const StandardCategory &other)
   setDescription(other.description());
   setIcon(other.icon());
   setCreationDate(other.creationDate());
+  setRetentionPolicy(other.retentionPolicy());
   setChildItems(other.childItems());
   setParent(other.parent());
 }
@@ -190,5 +191,6 @@ StandardCategory::StandardCategory(const QSqlRecord &record) : Category(nullptr)
   setTitle(record.value(CAT_DB_TITLE_INDEX).toString());
   setDescription(record.value(CAT_DB_DESCRIPTION_INDEX).toString());
   setCreationDate(TextFactory::parseDateTime(record.value(CAT_DB_DCREATED_INDEX).value<qint64>()).toLocalTime());
-  setIcon(qApp->icons()->fromByteArray(record.value(CAT_DB_ICON_INDEX).toByteArray()));
+  setIcon(qApp->icons()->storedIcon(record.value(CAT_DB_ICON_INDEX).toString()));
+  setRetentionPolicy(RetentionPolicy::fromRecord(record, CAT_DB_RETENTION_INDEX));
 }
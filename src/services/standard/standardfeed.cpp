@@ -26,6 +26,8 @@
 #include "miscellaneous/iconfactory.h"
 #include "miscellaneous/simplecrypt/simplecrypt.h"
 #include "network-web/networkfactory.h"
+#include "network-web/downloader.h"
+#include "network-web/faviconfetcher.h"
 #include "gui/feedmessageviewer.h"
 #include "gui/feedsview.h"
 #include "services/abstract/recyclebin.h"
@@ -39,13 +41,14 @@
 #include <QDomNode>
 #include <QDomElement>
 #include <QXmlStreamReader>
+#include <QElapsedTimer>
 
 
 StandardFeed::StandardFeed(RootItem *parent_item)
   : Feed(parent_item) {
   m_passwordProtected = false;
   m_username = QString();
-  m_password = QString();
+  m_encryptedPassword = QString();
   m_networkError = QNetworkReply::NoError;
   m_type = Rss0X;
   m_encoding = QString();
@@ -55,7 +58,7 @@ StandardFeed::StandardFeed(const StandardFeed &other)
   : Feed(nullptr) {
   m_passwordProtected = other.passwordProtected();
   m_username = other.username();
-  m_password = other.password();
+  m_encryptedPassword = other.m_encryptedPassword;
   m_networkError = other.networkError();
   m_type = other.type();
   m_encoding = other.encoding();
@@ -68,6 +71,7 @@ StandardFeed::StandardFeed(const StandardFeed &other)
   setAutoUpdateType(other.autoUpdateType());
   setAutoUpdateInitialInterval(other.autoUpdateInitialInterval());
   setAutoUpdateRemainingInterval(other.autoUpdateRemainingInterval());
+  setRetentionPolicy(other.retentionPolicy());
 
   setTitle(other.title());
   setId(other.id());
@@ -185,6 +189,11 @@ void StandardFeed::fetchMetadataForItself() {
 
   if (metadata.first != nullptr && metadata.second == QNetworkReply::NoError) {
     // Some properties are not updated when new metadata are fetched.
+    // Icon which is still being fetched is set once it is fetched.
+    if (metadata.first->icon().isNull()) {
+      metadata.first->setIcon(icon());
+    }
+
     metadata.first->setParent(parent());
     metadata.first->setUrl(url());
     metadata.first->setPasswordProtected(passwordProtected());
@@ -279,9 +288,8 @@ QPair<StandardFeed*,QNetworkReply::NetworkError> StandardFeed::guessFeed(const Q
 
     QDomElement root_element = xml_document.documentElement();
     QString root_tag_name = root_element.tagName();
-    QList<QString> icon_possible_locations;
-
-    icon_possible_locations.append(url);
+    QString site_url = url;
+    QString feed_icon_url;
 
     if (root_tag_name == QL1S("rdf:RDF")) {
       // We found RDF feed.
@@ -290,11 +298,12 @@ QPair<StandardFeed*,QNetworkReply::NetworkError> StandardFeed::guessFeed(const Q
       result.first->setType(Rdf);
       result.first->setTitle(channel_element.namedItem(QSL("title")).toElement().text());
       result.first->setDescription(channel_element.namedItem(QSL("description")).toElement().text());
+      feed_icon_url = root_element.namedItem(QSL("image")).namedItem(QSL("url")).toElement().text();
 
       QString source_link = channel_element.namedItem(QSL("link")).toElement().text();
 
       if (!source_link.isEmpty()) {
-        icon_possible_locations.prepend(source_link);
+        site_url = source_link;
       }
     }
     else if (root_tag_name == QL1S("rss")) {
@@ -312,11 +321,12 @@ QPair<StandardFeed*,QNetworkReply::NetworkError> StandardFeed::guessFeed(const Q
 
       result.first->setTitle(channel_element.namedItem(QSL("title")).toElement().text());
       result.first->setDescription(channel_element.namedItem(QSL("description")).toElement().text());
+      feed_icon_url = channel_element.namedItem(QSL("image")).namedItem(QSL("url")).toElement().text();
 
       QString source_link = channel_element.namedItem(QSL("link")).toElement().text();
 
       if (!source_link.isEmpty()) {
-        icon_possible_locations.prepend(source_link);
+        site_url = source_link;
       }
     }
     else if (root_tag_name == QL1S("feed")) {
@@ -324,11 +334,16 @@ QPair<StandardFeed*,QNetworkReply::NetworkError> StandardFeed::guessFeed(const Q
       result.first->setType(Atom10);
       result.first->setTitle(root_element.namedItem(QSL("title")).toElement().text());
       result.first->setDescription(root_element.namedItem(QSL("subtitle")).toElement().text());
+      feed_icon_url = root_element.namedItem(QSL("icon")).toElement().text();
+
+      if (feed_icon_url.isEmpty()) {
+        feed_icon_url = root_element.namedItem(QSL("logo")).toElement().text();
+      }
 
       QString source_link = root_element.namedItem(QSL("link")).toElement().text();
 
       if (!source_link.isEmpty()) {
-        icon_possible_locations.prepend(source_link);
+        site_url = source_link;
       }
     }
     else {
@@ -337,14 +352,24 @@ QPair<StandardFeed*,QNetworkReply::NetworkError> StandardFeed::guessFeed(const Q
       result.second = QNetworkReply::UnknownContentError;
     }
 
-    // Try to obtain icon.
-    QIcon icon_data;
+    // Icon is fetched in background, feeds of the site get it once
+    // it is fetched. Icons are recognized by host of the feed URL.
+    FaviconFetcher *fetcher = FaviconFetcher::instance();
+    const QIcon cached_icon = fetcher->cachedIcon(QUrl(url));
 
-    if ((result.second = NetworkFactory::downloadIcon(icon_possible_locations,
-                                                      DOWNLOAD_TIMEOUT,
-                                                      icon_data)) == QNetworkReply::NoError) {
-      // Icon for feed was downloaded and is stored now in _icon_data.
-      result.first->setIcon(icon_data);
+    if (!feed_icon_url.isEmpty()) {
+      feed_icon_url = QUrl(site_url).resolved(QUrl(feed_icon_url.trimmed())).toString();
+    }
+    else if (FaviconFetcher::hostKey(QUrl(site_url)) != FaviconFetcher::hostKey(QUrl(url))) {
+      // Feed is served from different host than its site.
+      feed_icon_url = QUrl(site_url).resolved(QUrl(QSL("/favicon.ico"))).toString();
+    }
+
+    if (cached_icon.isNull()) {
+      fetcher->fetchIcon(QUrl(url), QUrl(feed_icon_url), true);
+    }
+    else {
+      result.first->setIcon(cached_icon);
     }
   }
 
@@ -377,6 +402,11 @@ bool StandardFeed::removeItself() {
 }
 
 bool StandardFeed::addItself(RootItem *parent) {
+  if (icon().isNull()) {
+    // Icon could be fetched in background meanwhile.
+    setIcon(FaviconFetcher::instance()->cachedIcon(QUrl(url())));
+  }
+
   // Now, add feed to persistent storage.
   QSqlDatabase database = qApp->database()->connection(metaObject()->className(), DatabaseFactory::FromSettings);
   bool ok;
@@ -432,9 +462,16 @@ bool StandardFeed::editItself(StandardFeed *new_feed_data) {
 
 QList<Message> StandardFeed::obtainNewMessages(bool *error_during_obtaining) {
   QByteArray feed_contents;
+  NetworkTimings timings;
+  FeedUpdateStatistics &statistics = currentUpdateStatistics();
   int download_timeout = qApp->settings()->value(GROUP(Feeds), SETTING(Feeds::UpdateTimeout)).toInt();
   m_networkError = NetworkFactory::downloadFeedFile(url(), download_timeout, feed_contents,
-                                                    passwordProtected(), username(), password()).first;
+                                                    passwordProtected(), username(), password(), &timings).first;
+
+  statistics.m_connection = timings.m_encrypted;
+  statistics.m_firstByte = timings.m_firstByte;
+  statistics.m_download = timings.m_finished;
+  statistics.m_bytes = timings.m_bytes;
 
   if (m_networkError != QNetworkReply::NoError) {
     qWarning("Error during fetching of new messages for feed '%s' (id %d).", qPrintable(url()), id());
@@ -447,6 +484,9 @@ QList<Message> StandardFeed::obtainNewMessages(bool *error_during_obtaining) {
     *error_during_obtaining = false;
   }
 
+  QElapsedTimer stage_timer;
+  stage_timer.start();
+
   // Encode downloaded data for further parsing.
   QTextCodec *codec = QTextCodec::codecForName(encoding().toLocal8Bit());
   QString formatted_feed_contents;
@@ -460,6 +500,8 @@ QList<Message> StandardFeed::obtainNewMessages(bool *error_during_obtaining) {
     formatted_feed_contents = codec->toUnicode(feed_contents);
   }
 
+  statistics.m_decoding = stage_timer.restart();
+
   // Feed data are downloaded and encoded.
   // Parse data and obtain messages.
   QList<Message> messages;
@@ -481,9 +523,22 @@ QList<Message> StandardFeed::obtainNewMessages(bool *error_during_obtaining) {
       break;
   }
 
+  statistics.m_parsing = stage_timer.elapsed();
   return messages;
 }
 
+QString StandardFeed::password() const {
+  return TextFactory::decrypt(m_encryptedPassword);
+}
+
+void StandardFeed::setPassword(const QString &password) {
+  m_encryptedPassword = password.isEmpty() ? QString() : TextFactory::encrypt(password);
+}
+
+void StandardFeed::setEncryptedPassword(const QString &encrypted_password) {
+  m_encryptedPassword = encrypted_password;
+}
+
 QNetworkReply::NetworkError StandardFeed::networkError() const {
   return m_networkError;
 }
@@ -494,21 +549,16 @@ StandardFeed::StandardFeed(const QSqlRecord &record) : Feed(nullptr) {
   setCustomId(id());
   setDescription(record.value(FDS_DB_DESCRIPTION_INDEX).toString());
   setCreationDate(TextFactory::parseDateTime(record.value(FDS_DB_DCREATED_INDEX).value<qint64>()).toLocalTime());
-  setIcon(qApp->icons()->fromByteArray(record.value(FDS_DB_ICON_INDEX).toByteArray()));
+  setIcon(qApp->icons()->storedIcon(record.value(FDS_DB_ICON_INDEX).toString()));
   setEncoding(record.value(FDS_DB_ENCODING_INDEX).toString());
   setUrl(record.value(FDS_DB_URL_INDEX).toString());
   setPasswordProtected(record.value(FDS_DB_PROTECTED_INDEX).toBool());
   setUsername(record.value(FDS_DB_USERNAME_INDEX).toString());
-
-  if (record.value(FDS_DB_PASSWORD_INDEX).toString().isEmpty()) {
-    setPassword(record.value(FDS_DB_PASSWORD_INDEX).toString());
-  }
-  else {
-    setPassword(TextFactory::decrypt(record.value(FDS_DB_PASSWORD_INDEX).toString()));
-  }
+  setEncryptedPassword(record.value(FDS_DB_PASSWORD_INDEX).toString());
 
   setAutoUpdateType(static_cast<Feed::AutoUpdateType>(record.value(FDS_DB_UPDATE_TYPE_INDEX).toInt()));
   setAutoUpdateInitialInterval(record.value(FDS_DB_UPDATE_INTERVAL_INDEX).toInt());
+  setRetentionPolicy(RetentionPolicy::fromRecord(record, FDS_DB_RETENTION_INDEX));
 
   m_networkError = QNetworkReply::NoError;
 }
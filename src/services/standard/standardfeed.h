@@ -107,13 +107,11 @@ class StandardFeed : public Feed {
       m_username = username;
     }
 
-    inline QString password() const {
-      return m_password;
-    }
-
-    inline void setPassword(const QString &password) {
-      m_password = password;
-    }
+    // Password is kept encrypted in memory and it is
+    // decrypted only when it is really needed.
+    QString password() const;
+    void setPassword(const QString &password);
+    void setEncryptedPassword(const QString &encrypted_password);
 
     inline QString encoding() const {
       return m_encoding;
@@ -130,6 +128,8 @@ class StandardFeed : public Feed {
     // Returns pointer to guessed feed (if at least partially
     // guessed) and retrieved error/status code from network layer
     // or NULL feed.
+    // NOTE: Icon of the feed is fetched in background, returned
+    // feed has it only if it was fetched before.
     static QPair<StandardFeed*,QNetworkReply::NetworkError> guessFeed(const QString &url,
                                                                       const QString &username = QString(),
                                                                       const QString &password = QString());
@@ -147,7 +147,7 @@ class StandardFeed : public Feed {
   private:
     bool m_passwordProtected;
     QString m_username;
-    QString m_password;
+    QString m_encryptedPassword;
 
     Type m_type;
     QNetworkReply::NetworkError m_networkError;
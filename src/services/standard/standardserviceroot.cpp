@@ -25,6 +25,7 @@
 #include "miscellaneous/mutex.h"
 #include "core/feedsmodel.h"
 #include "gui/messagebox.h"
+#include "network-web/faviconfetcher.h"
 #include "exceptions/applicationexception.h"
 #include "services/abstract/recyclebin.h"
 #include "services/standard/standardserviceentrypoint.h"
@@ -59,6 +60,9 @@ StandardServiceRoot::~StandardServiceRoot() {
 void StandardServiceRoot::start(bool freshly_activated) {
   loadFromDatabase();
 
+  connect(FaviconFetcher::instance(), SIGNAL(iconFetched(QString,QIcon,QString)),
+          this, SLOT(onFaviconFetched(QString,QIcon,QString)), Qt::UniqueConnection);
+
   if (freshly_activated) {
     // In other words, if there are no feeds or categories added.
     if (MessageBox::show(qApp->mainFormWidget(), QMessageBox::Question, QObject::tr("Load initial set of feeds"),
@@ -94,6 +98,7 @@ void StandardServiceRoot::start(bool freshly_activated) {
   }
 
   checkArgumentsForFeedAdding();
+  refreshFeedIcons();
 }
 
 void StandardServiceRoot::stop() {
@@ -175,23 +180,57 @@ void StandardServiceRoot::loadFromDatabase(){
   assembleFeeds(feeds);
 
   // As the last item, add recycle bin, which is needed.
+  // NOTE: Counts of messages are loaded by the model.
   appendChild(m_recycleBin);
-  updateCounts(true);
 }
 
-void StandardServiceRoot::checkArgumentsForFeedAdding() {
-  foreach (QString arg, qApp->arguments().mid(1)) {
-    checkArgumentForFeedAdding(arg);
+void StandardServiceRoot::refreshFeedIcons() {
+  FaviconFetcher *fetcher = FaviconFetcher::instance();
+
+  // Fetcher ignores sites with icons which are not expired yet. Icons stored
+  // before the site was fetched for the first time are refreshed too.
+  foreach (Feed *feed, getSubTreeFeeds()) {
+    fetcher->fetchIcon(QUrl(feed->url()), QUrl(), false, qApp->icons()->storedIconHash(feed->icon()));
   }
 }
 
-QMap<int,QVariant> StandardServiceRoot::storeCustomFeedsData() {
-  return QMap<int,QVariant>();
+void StandardServiceRoot::onFaviconFetched(const QString &host, const QIcon &icon, const QString &replaced_hash) {
+  QSqlDatabase database = qApp->database()->connection(metaObject()->className(), DatabaseFactory::FromSettings);
+  QList<RootItem*> changed_items;
+  QString icon_hash;
+
+  foreach (Feed *feed, getSubTreeFeeds()) {
+    if (FaviconFetcher::hostKey(QUrl(feed->url())) != host) {
+      continue;
+    }
+
+    // Only feeds without icon or with icon fetched before for the same site
+    // get new icon, icons chosen by user are never replaced.
+    const QString feed_icon_hash = qApp->icons()->storedIconHash(feed->icon());
+
+    if (!feed->icon().isNull() && (replaced_hash.isEmpty() || feed_icon_hash != replaced_hash)) {
+      continue;
+    }
+
+    if (icon_hash.isEmpty() && (icon_hash = DatabaseQueries::storeIcon(database, icon)).isEmpty()) {
+      return;
+    }
+
+    if (feed_icon_hash != icon_hash && DatabaseQueries::editFeedIcon(database, feed->id(), icon_hash)) {
+      feed->setIcon(qApp->icons()->storedIcon(icon_hash));
+      changed_items.append(feed);
+    }
+  }
+
+  if (!changed_items.isEmpty()) {
+    itemChanged(changed_items);
+  }
 }
 
-void StandardServiceRoot::restoreCustomFeedsData(const QMap<int,QVariant> &data, const QHash<int,Feed*> &feeds) {
-  Q_UNUSED(feeds)
-  Q_UNUSED(data)
+void StandardServiceRoot::checkArgumentsForFeedAdding() {
+  foreach (QString arg, qApp->arguments().mid(1)) {
+    checkArgumentForFeedAdding(arg);
+  }
 }
 
 QString StandardServiceRoot::processFeedUrl(const QString &feed_url) {
@@ -21,6 +21,7 @@
 #include "services/abstract/serviceroot.h"
 
 #include <QCoreApplication>
+#include <QIcon>
 #include <QPair>
 
 
@@ -75,19 +76,23 @@ class StandardServiceRoot : public ServiceRoot {
     void importFeeds();
     void exportFeeds();
 
+  private slots:
+    // Sets new icon to feeds from given site.
+    void onFaviconFetched(const QString &host, const QIcon &icon, const QString &replaced_hash);
+
   private:
     QString processFeedUrl(const QString &feed_url);
     void checkArgumentsForFeedAdding();
 
+    // Starts background refresh of expired icons of feeds.
+    void refreshFeedIcons();
+
     RecycleBin *m_recycleBin;
     QAction *m_actionExportFeeds;
     QAction *m_actionImportFeeds;
     QList<QAction*> m_serviceMenu;
     QList<QAction*> m_feedContextMenu;
     QAction *m_actionFeedFetchMetadata;
-
-    QMap<int,QVariant> storeCustomFeedsData();
-    void restoreCustomFeedsData(const QMap<int,QVariant> &data, const QHash<int,Feed*> &feeds);
 };
 
 #endif // STANDARDSERVICEROOT_H
@@ -30,6 +30,7 @@
 
 // Limitations
 #define MAX_MESSAGES      200
+#define PARALLEL_PAGE_REQUESTS  4
 
 // General return status codes.
 #define API_STATUS_OK     0
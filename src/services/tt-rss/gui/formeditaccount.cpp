@@ -24,6 +24,8 @@
 #include "miscellaneous/iconfactory.h"
 #include "network-web/networkfactory.h"
 
+#include <QTimer>
+
 
 FormEditAccount::FormEditAccount(QWidget *parent)
   : QDialog(parent), m_ui(new Ui::FormEditAccount), m_editableRoot(nullptr) {
@@ -196,7 +198,8 @@ void FormEditAccount::onClickedOk() {
   if (editing_account) {
     m_editableRoot->network()->logout();
     m_editableRoot->completelyRemoveAllData();
-    m_editableRoot->syncIn();
+    // Sync-in needs critical lock, which is held by caller now.
+    QTimer::singleShot(0, m_editableRoot, SLOT(syncIn()));
   }
 }
 
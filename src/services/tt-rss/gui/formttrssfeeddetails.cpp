@@ -48,6 +48,7 @@ void FormTtRssFeedDetails::apply() {
     new_feed_data->setAutoUpdateInitialInterval(m_ui->m_spinAutoUpdateInterval->value());
 
     qobject_cast<TtRssFeed*>(m_editableFeed)->editItself(new_feed_data);
+    m_editableFeed->editRetentionPolicy(retentionPolicy());
 
     delete new_feed_data;
   }
@@ -24,8 +24,10 @@
 #include "services/tt-rss/ttrsscategory.h"
 #include "miscellaneous/application.h"
 #include "miscellaneous/iconfactory.h"
+#include "miscellaneous/jsonreader.h"
 #include "miscellaneous/textfactory.h"
 #include "network-web/networkfactory.h"
+#include "network-web/pagedownloader.h"
 
 #include <QJsonDocument>
 #include <QJsonArray>
@@ -34,8 +36,8 @@
 
 
 TtRssNetworkFactory::TtRssNetworkFactory()
-  : m_bareUrl(QString()), m_fullUrl(QString()), m_username(QString()), m_password(QString()), m_forceServerSideUpdate(false), m_authIsUsed(false),
-    m_authUsername(QString()), m_authPassword(QString()), m_sessionId(QString()),
+  : m_bareUrl(QString()), m_fullUrl(QString()), m_username(QString()), m_encryptedPassword(QString()), m_forceServerSideUpdate(false), m_authIsUsed(false),
+    m_authUsername(QString()), m_encryptedAuthPassword(QString()), m_sessionId(QString()),
     m_lastLoginTime(QDateTime()), m_lastError(QNetworkReply::NoError) {
 }
 
@@ -70,11 +72,15 @@ void TtRssNetworkFactory::setUsername(const QString &username) {
 }
 
 QString TtRssNetworkFactory::password() const {
-  return m_password;
+  return TextFactory::decrypt(m_encryptedPassword);
 }
 
 void TtRssNetworkFactory::setPassword(const QString &password) {
-  m_password = password;
+  m_encryptedPassword = TextFactory::encrypt(password);
+}
+
+void TtRssNetworkFactory::setEncryptedPassword(const QString &encrypted_password) {
+  m_encryptedPassword = encrypted_password;
 }
 
 QDateTime TtRssNetworkFactory::lastLoginTime() const {
@@ -95,15 +101,15 @@ TtRssLoginResponse TtRssNetworkFactory::login() {
   QJsonObject json;
   json["op"] = QSL("login");
   json["user"] = m_username;
-  json["password"] = m_password;
+  json["password"] = password();
 
   QByteArray result_raw;
   NetworkResult network_reply = NetworkFactory::performNetworkOperation(m_fullUrl, qApp->settings()->value(GROUP(Feeds),
                                                                                           SETTING(Feeds::UpdateTimeout)).toInt(),
                                                            QJsonDocument(json).toJson(QJsonDocument::Compact), CONTENT_TYPE, result_raw,
                                                            QNetworkAccessManager::PostOperation,
-                                                           m_authIsUsed, m_authUsername, m_authPassword);
-  TtRssLoginResponse login_response(QString::fromUtf8(result_raw));
+                                                           m_authIsUsed, m_authUsername, authPassword());
+  TtRssLoginResponse login_response(result_raw);
 
   if (network_reply.first == QNetworkReply::NoError) {
     m_sessionId = login_response.sessionId();
@@ -129,7 +135,7 @@ TtRssResponse TtRssNetworkFactory::logout() {
                                                                                             SETTING(Feeds::UpdateTimeout)).toInt(),
                                                              QJsonDocument(json).toJson(QJsonDocument::Compact), CONTENT_TYPE, result_raw,
                                                              QNetworkAccessManager::PostOperation,
-                                                             m_authIsUsed, m_authUsername, m_authPassword);
+                                                             m_authIsUsed, m_authUsername, authPassword());
 
     m_lastError = network_reply.first;
 
@@ -140,7 +146,7 @@ TtRssResponse TtRssNetworkFactory::logout() {
       qWarning("TT-RSS: Logout failed with error %d.", network_reply.first);
     }
 
-    return TtRssResponse(QString::fromUtf8(result_raw));
+    return TtRssResponse(result_raw);
   }
   else {
     qWarning("TT-RSS: Cannot logout because session ID is empty.");
@@ -161,8 +167,8 @@ TtRssGetFeedsCategoriesResponse TtRssNetworkFactory::getFeedsCategories() {
   NetworkResult network_reply = NetworkFactory::performNetworkOperation(m_fullUrl, timeout, QJsonDocument(json).toJson(QJsonDocument::Compact),
                                                            CONTENT_TYPE, result_raw,
                                                            QNetworkAccessManager::PostOperation,
-                                                           m_authIsUsed, m_authUsername, m_authPassword);
-  TtRssGetFeedsCategoriesResponse result(QString::fromUtf8(result_raw));
+                                                           m_authIsUsed, m_authUsername, authPassword());
+  TtRssGetFeedsCategoriesResponse result(result_raw);
 
   if (result.isNotLoggedIn()) {
     // We are not logged in.
@@ -171,8 +177,8 @@ TtRssGetFeedsCategoriesResponse TtRssNetworkFactory::getFeedsCategories() {
 
     network_reply = NetworkFactory::performNetworkOperation(m_fullUrl, timeout, QJsonDocument(json).toJson(QJsonDocument::Compact), CONTENT_TYPE, result_raw,
                                                QNetworkAccessManager::PostOperation,
-                                               m_authIsUsed, m_authUsername, m_authPassword);
-    result = TtRssGetFeedsCategoriesResponse(QString::fromUtf8(result_raw));
+                                               m_authIsUsed, m_authUsername, authPassword());
+    result = TtRssGetFeedsCategoriesResponse(result_raw);
   }
 
   if (network_reply.first != QNetworkReply::NoError) {
@@ -202,8 +208,8 @@ TtRssGetHeadlinesResponse TtRssNetworkFactory::getHeadlines(int feed_id, int lim
   NetworkResult network_reply = NetworkFactory::performNetworkOperation(m_fullUrl, timeout, QJsonDocument(json).toJson(QJsonDocument::Compact),
                                                            CONTENT_TYPE, result_raw,
                                                            QNetworkAccessManager::PostOperation,
-                                                           m_authIsUsed, m_authUsername, m_authPassword);
-  TtRssGetHeadlinesResponse result(QString::fromUtf8(result_raw));
+                                                           m_authIsUsed, m_authUsername, authPassword());
+  TtRssGetHeadlinesResponse result(result_raw);
 
   if (result.isNotLoggedIn()) {
     // We are not logged in.
@@ -212,12 +218,10 @@ TtRssGetHeadlinesResponse TtRssNetworkFactory::getHeadlines(int feed_id, int lim
 
     network_reply = NetworkFactory::performNetworkOperation(m_fullUrl, timeout, QJsonDocument(json).toJson(QJsonDocument::Compact), CONTENT_TYPE, result_raw,
                                                QNetworkAccessManager::PostOperation,
-                                               m_authIsUsed, m_authUsername, m_authPassword);
-    result = TtRssGetHeadlinesResponse(QString::fromUtf8(result_raw));
+                                               m_authIsUsed, m_authUsername, authPassword());
+    result = TtRssGetHeadlinesResponse(result_raw);
   }
 
-  IOFactory::writeTextFile("aaa", result_raw);
-
   if (network_reply.first != QNetworkReply::NoError) {
     qWarning("TT-RSS: getHeadlines failed with error %d.", network_reply.first);
   }
@@ -226,6 +230,69 @@ TtRssGetHeadlinesResponse TtRssNetworkFactory::getHeadlines(int feed_id, int lim
   return result;
 }
 
+QList<Message> TtRssNetworkFactory::getAllHeadlines(int feed_id, int limit, bool show_content,
+                                                   bool include_attachments, bool sanitize) {
+  // First page is obtained alone, it takes care of logging in. Server can
+  // return less headlines than requested, because it caps the limit, so size
+  // of the first page is used as size of all following pages.
+  TtRssGetHeadlinesResponse first_page = getHeadlines(feed_id, limit, 0, show_content, include_attachments, sanitize);
+  QList<Message> messages = first_page.messages();
+  const int stride = messages.size();
+
+  if (m_lastError != QNetworkReply::NoError || stride == 0) {
+    return messages;
+  }
+
+  QJsonObject json;
+  json["op"] = QSL("getHeadlines");
+  json["sid"] = m_sessionId;
+  json["feed_id"] = feed_id;
+  json["force_update"] = false;
+  json["limit"] = limit;
+  json["show_content"] = show_content;
+  json["include_attachments"] = include_attachments;
+  json["sanitize"] = sanitize;
+
+  bool not_logged_in = false;
+  PageDownloader downloader(PARALLEL_PAGE_REQUESTS);
+
+  downloader.setOperation(QNetworkAccessManager::PostOperation, CONTENT_TYPE,
+                          m_authIsUsed, m_authUsername, authPassword());
+  downloader.setTimeout(qApp->settings()->value(GROUP(Feeds), SETTING(Feeds::UpdateTimeout)).toInt());
+
+  QNetworkReply::NetworkError error = downloader.downloadPages(1, [&](int page) {
+    json["skip"] = page * stride;
+    return qMakePair(m_fullUrl, QJsonDocument(json).toJson(QJsonDocument::Compact));
+  }, [&](int page, const QByteArray &contents) {
+    Q_UNUSED(page)
+
+    TtRssGetHeadlinesResponse headlines(contents);
+
+    if (headlines.isNotLoggedIn()) {
+      // Session expired in the middle of pagination.
+      not_logged_in = true;
+      return false;
+    }
+
+    const QList<Message> new_messages = headlines.messages();
+
+    // Empty or shorter page is the last one.
+    messages.append(new_messages);
+    return new_messages.size() >= stride;
+  });
+
+  if (error == QNetworkReply::NoError && not_logged_in) {
+    error = QNetworkReply::AuthenticationRequiredError;
+  }
+
+  if (error != QNetworkReply::NoError) {
+    qWarning("TT-RSS: getHeadlines failed with error %d.", error);
+  }
+
+  m_lastError = error;
+  return messages;
+}
+
 TtRssUpdateArticleResponse TtRssNetworkFactory::updateArticles(const QStringList &ids,
                                                                UpdateArticle::OperatingField field,
                                                                UpdateArticle::Mode mode) {
@@ -241,8 +308,8 @@ TtRssUpdateArticleResponse TtRssNetworkFactory::updateArticles(const QStringList
   NetworkResult network_reply = NetworkFactory::performNetworkOperation(m_fullUrl, timeout, QJsonDocument(json).toJson(QJsonDocument::Compact),
                                                            CONTENT_TYPE, result_raw,
                                                            QNetworkAccessManager::PostOperation,
-                                                           m_authIsUsed, m_authUsername, m_authPassword);
-  TtRssUpdateArticleResponse result(QString::fromUtf8(result_raw));
+                                                           m_authIsUsed, m_authUsername, authPassword());
+  TtRssUpdateArticleResponse result(result_raw);
 
   if (result.isNotLoggedIn()) {
     // We are not logged in.
@@ -252,8 +319,8 @@ TtRssUpdateArticleResponse TtRssNetworkFactory::updateArticles(const QStringList
     network_reply = NetworkFactory::performNetworkOperation(m_fullUrl, timeout, QJsonDocument(json).toJson(QJsonDocument::Compact),
                                                CONTENT_TYPE, result_raw,
                                                QNetworkAccessManager::PostOperation,
-                                               m_authIsUsed, m_authUsername, m_authPassword);
-    result = TtRssUpdateArticleResponse(QString::fromUtf8(result_raw));
+                                               m_authIsUsed, m_authUsername, authPassword());
+    result = TtRssUpdateArticleResponse(result_raw);
   }
 
   if (network_reply.first != QNetworkReply::NoError) {
@@ -283,8 +350,8 @@ TtRssSubscribeToFeedResponse TtRssNetworkFactory::subscribeToFeed(const QString
   NetworkResult network_reply = NetworkFactory::performNetworkOperation(m_fullUrl, timeout, QJsonDocument(json).toJson(QJsonDocument::Compact),
                                                            CONTENT_TYPE, result_raw,
                                                            QNetworkAccessManager::PostOperation,
-                                                           m_authIsUsed, m_authUsername, m_authPassword);
-  TtRssSubscribeToFeedResponse result(QString::fromUtf8(result_raw));
+                                                           m_authIsUsed, m_authUsername, authPassword());
+  TtRssSubscribeToFeedResponse result(result_raw);
 
   if (result.isNotLoggedIn()) {
     // We are not logged in.
@@ -294,8 +361,8 @@ TtRssSubscribeToFeedResponse TtRssNetworkFactory::subscribeToFeed(const QString
     network_reply = NetworkFactory::performNetworkOperation(m_fullUrl, timeout, QJsonDocument(json).toJson(QJsonDocument::Compact),
                                                CONTENT_TYPE, result_raw,
                                                QNetworkAccessManager::PostOperation,
-                                               m_authIsUsed, m_authUsername, m_authPassword);
-    result = TtRssSubscribeToFeedResponse(QString::fromUtf8(result_raw));
+                                               m_authIsUsed, m_authUsername, authPassword());
+    result = TtRssSubscribeToFeedResponse(result_raw);
   }
 
   if (network_reply.first != QNetworkReply::NoError) {
@@ -316,8 +383,8 @@ TtRssUnsubscribeFeedResponse TtRssNetworkFactory::unsubscribeFeed(int feed_id) {
   QByteArray result_raw;
   NetworkResult network_reply = NetworkFactory::performNetworkOperation(m_fullUrl, timeout, QJsonDocument(json).toJson(QJsonDocument::Compact), CONTENT_TYPE, result_raw,
                                                            QNetworkAccessManager::PostOperation,
-                                                           m_authIsUsed, m_authUsername, m_authPassword);
-  TtRssUnsubscribeFeedResponse result(QString::fromUtf8(result_raw));
+                                                           m_authIsUsed, m_authUsername, authPassword());
+  TtRssUnsubscribeFeedResponse result(result_raw);
 
   if (result.isNotLoggedIn()) {
     // We are not logged in.
@@ -326,8 +393,8 @@ TtRssUnsubscribeFeedResponse TtRssNetworkFactory::unsubscribeFeed(int feed_id) {
 
     network_reply = NetworkFactory::performNetworkOperation(m_fullUrl, timeout, QJsonDocument(json).toJson(QJsonDocument::Compact), CONTENT_TYPE, result_raw,
                                                QNetworkAccessManager::PostOperation,
-                                               m_authIsUsed, m_authUsername, m_authPassword);
-    result = TtRssUnsubscribeFeedResponse(QString::fromUtf8(result_raw));
+                                               m_authIsUsed, m_authUsername, authPassword());
+    result = TtRssUnsubscribeFeedResponse(result_raw);
   }
 
   if (network_reply.first != QNetworkReply::NoError) {
@@ -363,15 +430,19 @@ void TtRssNetworkFactory::setAuthUsername(const QString &auth_username) {
 }
 
 QString TtRssNetworkFactory::authPassword() const {
-  return m_authPassword;
+  return TextFactory::decrypt(m_encryptedAuthPassword);
 }
 
 void TtRssNetworkFactory::setAuthPassword(const QString &auth_password) {
-  m_authPassword = auth_password;
+  m_encryptedAuthPassword = TextFactory::encrypt(auth_password);
 }
 
-TtRssResponse::TtRssResponse(const QString &raw_content) {
-  m_rawContent = QJsonDocument::fromJson(raw_content.toUtf8()).object();
+void TtRssNetworkFactory::setEncryptedAuthPassword(const QString &encrypted_auth_password) {
+  m_encryptedAuthPassword = encrypted_auth_password;
+}
+
+TtRssResponse::TtRssResponse(const QByteArray &raw_content) {
+  m_rawContent = QJsonDocument::fromJson(raw_content).object();
 }
 
 TtRssResponse::~TtRssResponse() {
@@ -407,7 +478,7 @@ QString TtRssResponse::toString() const {
   return QJsonDocument(m_rawContent).toJson(QJsonDocument::Compact);
 }
 
-TtRssLoginResponse::TtRssLoginResponse(const QString &raw_content) : TtRssResponse(raw_content) {
+TtRssLoginResponse::TtRssLoginResponse(const QByteArray &raw_content) : TtRssResponse(raw_content) {
 }
 
 TtRssLoginResponse::~TtRssLoginResponse() {
@@ -450,7 +521,7 @@ bool TtRssResponse::hasError() const {
 }
 
 
-TtRssGetFeedsCategoriesResponse::TtRssGetFeedsCategoriesResponse(const QString &raw_content) : TtRssResponse(raw_content) {
+TtRssGetFeedsCategoriesResponse::TtRssGetFeedsCategoriesResponse(const QByteArray &raw_content) : TtRssResponse(raw_content) {
 
 }
 
@@ -521,10 +592,12 @@ RootItem *TtRssGetFeedsCategoriesResponse::feedsCategories(bool obtain_icons, QS
               if (NetworkFactory::performNetworkOperation(full_icon_address, DOWNLOAD_TIMEOUT,
                                                           QByteArray(), QString(), icon_data,
                                                           QNetworkAccessManager::GetOperation).first == QNetworkReply::NoError) {
-                // Icon downloaded, set it up.
-                QPixmap icon_pixmap;
-                icon_pixmap.loadFromData(icon_data);
-                feed->setIcon(QIcon(icon_pixmap));
+                // Icon downloaded, only decode it here, this runs in background thread.
+                QImage icon_image;
+
+                if (icon_image.loadFromData(icon_data)) {
+                  feed->setIconImage(icon_image);
+                }
               }
             }
           }
@@ -541,53 +614,115 @@ RootItem *TtRssGetFeedsCategoriesResponse::feedsCategories(bool obtain_icons, QS
 }
 
 
-TtRssGetHeadlinesResponse::TtRssGetHeadlinesResponse(const QString &raw_content) : TtRssResponse(raw_content) {
+TtRssGetHeadlinesResponse::TtRssGetHeadlinesResponse(const QByteArray &raw_content)
+  : TtRssResponse(), m_messages(QList<Message>()) {
+  JsonReader reader(raw_content);
+
+  if (reader.readNext() != JsonReader::StartObject) {
+    return;
+  }
+
+  while (reader.readNext() != JsonReader::EndObject && !reader.hasError()) {
+    if (reader.isName("content") && reader.tokenType() == JsonReader::StartArray) {
+      // Process headlines one by one.
+      while (reader.readNext() != JsonReader::EndArray && !reader.hasError()) {
+        if (reader.tokenType() == JsonReader::StartObject) {
+          m_messages.append(readMessage(reader));
+        }
+        else {
+          reader.skipCurrentValue();
+        }
+      }
+    }
+    else {
+      // Other members are small, keep them for generic
+      // status/error checking.
+      const QString member_name = reader.name();
+      m_rawContent.insert(member_name, reader.readValue());
+    }
+  }
+
+  if (reader.hasError()) {
+    qWarning("TT-RSS: Headlines response is not valid JSON: '%s'.", qPrintable(reader.errorString()));
+  }
 }
 
 TtRssGetHeadlinesResponse::~TtRssGetHeadlinesResponse() {
 }
 
 QList<Message> TtRssGetHeadlinesResponse::messages() const {
-  QList<Message> messages;
-
-  foreach (QJsonValue item, m_rawContent["content"].toArray()) {
-    QJsonObject mapped = item.toObject();
-    Message message;
-
-    message.m_author = mapped["author"].toString();
-    message.m_isRead = !mapped["unread"].toBool();
-    message.m_isImportant = mapped["marked"].toBool();
-    message.m_contents = mapped["content"].toString();
-
-    // Multiply by 1000 because Tiny Tiny RSS API does not include miliseconds in Unix
-    // date/time number.
-    message.m_created = TextFactory::parseDateTime(mapped["updated"].toDouble() * 1000);
-    message.m_createdFromFeed = true;
-    message.m_customId = QString::number(mapped["id"].toInt());
-    message.m_feedId = mapped["feed_id"].toString();
-    message.m_title = mapped["title"].toString();
-    message.m_url = mapped["link"].toString();
-
-    if (mapped.contains(QSL("attachments"))) {
+  return m_messages;
+}
+
+Message TtRssGetHeadlinesResponse::readMessage(JsonReader &reader) {
+  Message message;
+
+  message.m_createdFromFeed = true;
+
+  while (reader.readNext() != JsonReader::EndObject && !reader.hasError()) {
+    if (reader.isName("author")) {
+      message.m_author = reader.text();
+    }
+    else if (reader.isName("unread")) {
+      message.m_isRead = !reader.boolean();
+    }
+    else if (reader.isName("marked")) {
+      message.m_isImportant = reader.boolean();
+    }
+    else if (reader.isName("content")) {
+      message.m_contents = reader.text();
+    }
+    else if (reader.isName("updated")) {
+      // Multiply by 1000 because Tiny Tiny RSS API does not include miliseconds in Unix
+      // date/time number.
+      message.m_created = TextFactory::parseDateTime(reader.number() * 1000);
+    }
+    else if (reader.isName("id")) {
+      message.m_customId = QString::number((int) reader.number());
+    }
+    else if (reader.isName("feed_id")) {
+      message.m_feedId = reader.text();
+    }
+    else if (reader.isName("title")) {
+      message.m_title = reader.text();
+    }
+    else if (reader.isName("link")) {
+      message.m_url = reader.text();
+    }
+    else if (reader.isName("attachments") && reader.tokenType() == JsonReader::StartArray) {
       // Process enclosures.
-      foreach (QJsonValue attachment, mapped["attachments"].toArray()) {
-        QJsonObject mapped_attachemnt = attachment.toObject();
+      while (reader.readNext() != JsonReader::EndArray && !reader.hasError()) {
+        if (reader.tokenType() != JsonReader::StartObject) {
+          reader.skipCurrentValue();
+          continue;
+        }
+
         Enclosure enclosure;
 
-        enclosure.m_mimeType = mapped_attachemnt["content_type"].toString();
-        enclosure.m_url = mapped_attachemnt["content_url"].toString();
+        while (reader.readNext() != JsonReader::EndObject && !reader.hasError()) {
+          if (reader.isName("content_type")) {
+            enclosure.m_mimeType = reader.text();
+          }
+          else if (reader.isName("content_url")) {
+            enclosure.m_url = reader.text();
+          }
+
+          reader.skipCurrentValue();
+        }
+
         message.m_enclosures.append(enclosure);
       }
     }
 
-    messages.append(message);
+    // Skip all unprocessed nested values.
+    reader.skipCurrentValue();
   }
 
-  return messages;
+  return message;
 }
 
 
-TtRssUpdateArticleResponse::TtRssUpdateArticleResponse(const QString &raw_content) : TtRssResponse(raw_content) {
+TtRssUpdateArticleResponse::TtRssUpdateArticleResponse(const QByteArray &raw_content) : TtRssResponse(raw_content) {
 }
 
 TtRssUpdateArticleResponse::~TtRssUpdateArticleResponse() {
@@ -611,7 +746,7 @@ int TtRssUpdateArticleResponse::articlesUpdated() const {
   }
 }
 
-TtRssSubscribeToFeedResponse::TtRssSubscribeToFeedResponse(const QString &raw_content) : TtRssResponse(raw_content) {
+TtRssSubscribeToFeedResponse::TtRssSubscribeToFeedResponse(const QByteArray &raw_content) : TtRssResponse(raw_content) {
 }
 
 TtRssSubscribeToFeedResponse::~TtRssSubscribeToFeedResponse() {
@@ -627,7 +762,7 @@ int TtRssSubscribeToFeedResponse::code() const {
 }
 
 
-TtRssUnsubscribeFeedResponse::TtRssUnsubscribeFeedResponse(const QString &raw_content) : TtRssResponse(raw_content) {
+TtRssUnsubscribeFeedResponse::TtRssUnsubscribeFeedResponse(const QByteArray &raw_content) : TtRssResponse(raw_content) {
 }
 
 TtRssUnsubscribeFeedResponse::~TtRssUnsubscribeFeedResponse() {
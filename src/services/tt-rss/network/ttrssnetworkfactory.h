@@ -28,10 +28,11 @@
 
 class RootItem;
 class TtRssFeed;
+class JsonReader;
 
 class TtRssResponse {
   public:
-    explicit TtRssResponse(const QString &raw_content = QString());
+    explicit TtRssResponse(const QByteArray &raw_content = QByteArray());
     virtual ~TtRssResponse();
 
     bool isLoaded() const;
@@ -49,7 +50,7 @@ class TtRssResponse {
 
 class TtRssLoginResponse : public TtRssResponse {
   public:
-    explicit TtRssLoginResponse(const QString &raw_content = QString());
+    explicit TtRssLoginResponse(const QByteArray &raw_content = QByteArray());
     virtual ~TtRssLoginResponse();
 
     int apiLevel() const;
@@ -58,7 +59,7 @@ class TtRssLoginResponse : public TtRssResponse {
 
 class TtRssGetFeedsCategoriesResponse : public TtRssResponse {
   public:
-    explicit TtRssGetFeedsCategoriesResponse(const QString &raw_content = QString());
+    explicit TtRssGetFeedsCategoriesResponse(const QByteArray &raw_content = QByteArray());
     virtual ~TtRssGetFeedsCategoriesResponse();
 
     // Returns tree of feeds/categories.
@@ -67,17 +68,24 @@ class TtRssGetFeedsCategoriesResponse : public TtRssResponse {
     RootItem *feedsCategories(bool obtain_icons, QString base_address = QString()) const;
 };
 
+// NOTE: Headlines are read directly from raw response data
+// in one pass, no intermediate JSON document is built for them.
 class TtRssGetHeadlinesResponse : public TtRssResponse {
   public:
-    explicit TtRssGetHeadlinesResponse(const QString &raw_content = QString());
+    explicit TtRssGetHeadlinesResponse(const QByteArray &raw_content = QByteArray());
     virtual ~TtRssGetHeadlinesResponse();
 
     QList<Message> messages() const;
+
+  private:
+    static Message readMessage(JsonReader &reader);
+
+    QList<Message> m_messages;
 };
 
 class TtRssUpdateArticleResponse : public TtRssResponse {
   public:
-    explicit TtRssUpdateArticleResponse(const QString &raw_content = QString());
+    explicit TtRssUpdateArticleResponse(const QByteArray &raw_content = QByteArray());
     virtual ~TtRssUpdateArticleResponse();
 
     QString updateStatus() const;
@@ -86,7 +94,7 @@ class TtRssUpdateArticleResponse : public TtRssResponse {
 
 class TtRssSubscribeToFeedResponse : public TtRssResponse {
   public:
-    explicit TtRssSubscribeToFeedResponse(const QString &raw_content = QString());
+    explicit TtRssSubscribeToFeedResponse(const QByteArray &raw_content = QByteArray());
     virtual ~TtRssSubscribeToFeedResponse();
 
     int code() const;
@@ -94,7 +102,7 @@ class TtRssSubscribeToFeedResponse : public TtRssResponse {
 
 class TtRssUnsubscribeFeedResponse : public TtRssResponse {
   public:
-    explicit TtRssUnsubscribeFeedResponse(const QString &raw_content = QString());
+    explicit TtRssUnsubscribeFeedResponse(const QByteArray &raw_content = QByteArray());
     virtual ~TtRssUnsubscribeFeedResponse();
 
     QString code() const;
@@ -125,8 +133,11 @@ class TtRssNetworkFactory {
     QString username() const;
     void setUsername(const QString &username);
 
+    // Passwords are kept encrypted in memory and they are
+    // decrypted only when request is issued.
     QString password() const;
     void setPassword(const QString &password);
+    void setEncryptedPassword(const QString &encrypted_password);
 
     bool authIsUsed() const;
     void setAuthIsUsed(bool auth_is_used);
@@ -136,6 +147,7 @@ class TtRssNetworkFactory {
 
     QString authPassword() const;
     void setAuthPassword(const QString &auth_password);
+    void setEncryptedAuthPassword(const QString &encrypted_auth_password);
 
     bool forceServerSideUpdate() const;
     void setForceServerSideUpdate(bool force_server_side_update);
@@ -160,6 +172,12 @@ class TtRssNetworkFactory {
                                            bool show_content, bool include_attachments,
                                            bool sanitize);
 
+    // Gets all headlines of given feed. First page is obtained alone, remaining
+    // pages of the same size are then downloaded in parallel until first empty
+    // or shorter page is received. Server may return less than "limit" headlines.
+    QList<Message> getAllHeadlines(int feed_id, int limit, bool show_content,
+                                   bool include_attachments, bool sanitize);
+
     TtRssUpdateArticleResponse updateArticles(const QStringList &ids, UpdateArticle::OperatingField field,
                                               UpdateArticle::Mode mode);
 
@@ -174,11 +192,11 @@ class TtRssNetworkFactory {
     QString m_bareUrl;
     QString m_fullUrl;
     QString m_username;
-    QString m_password;
+    QString m_encryptedPassword;
     bool m_forceServerSideUpdate;
     bool m_authIsUsed;
     QString m_authUsername;
-    QString m_authPassword;
+    QString m_encryptedAuthPassword;
     QString m_sessionId;
     QDateTime m_lastLoginTime;
     QNetworkReply::NetworkError m_lastError;
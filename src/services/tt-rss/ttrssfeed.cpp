@@ -38,10 +38,11 @@ TtRssFeed::TtRssFeed(RootItem *parent)
 TtRssFeed::TtRssFeed(const QSqlRecord &record) : Feed(nullptr) {
   setTitle(record.value(FDS_DB_TITLE_INDEX).toString());
   setId(record.value(FDS_DB_ID_INDEX).toInt());
-  setIcon(qApp->icons()->fromByteArray(record.value(FDS_DB_ICON_INDEX).toByteArray()));
+  setIcon(qApp->icons()->storedIcon(record.value(FDS_DB_ICON_INDEX).toString()));
   setAutoUpdateType(static_cast<Feed::AutoUpdateType>(record.value(FDS_DB_UPDATE_TYPE_INDEX).toInt()));
   setAutoUpdateInitialInterval(record.value(FDS_DB_UPDATE_INTERVAL_INDEX).toInt());
   setCustomId(record.value(FDS_DB_CUSTOM_ID_INDEX).toInt());
+  setRetentionPolicy(RetentionPolicy::fromRecord(record, FDS_DB_RETENTION_INDEX));
 }
 
 TtRssFeed::~TtRssFeed() {
@@ -157,30 +158,14 @@ bool TtRssFeed::editItself(TtRssFeed *new_feed_data) {
 }
 
 QList<Message> TtRssFeed::obtainNewMessages(bool *error_during_obtaining) {
-  QList<Message> messages;
-  int newly_added_messages = 0;
-  int limit = MAX_MESSAGES;
-  int skip = 0;
-
-  do {
-    TtRssGetHeadlinesResponse headlines = serviceRoot()->network()->getHeadlines(customId(), limit, skip,
-                                                                                 true, true, false);
-
-    if (serviceRoot()->network()->lastError() != QNetworkReply::NoError) {
-      setStatus(Feed::NetworkError);
-      *error_during_obtaining = true;
-      serviceRoot()->itemChanged(QList<RootItem*>() << this);
-      return QList<Message>();
-    }
-    else {
-      QList<Message> new_messages = headlines.messages();
-
-      messages.append(new_messages);
-      newly_added_messages = new_messages.size();
-      skip += newly_added_messages;
-    }
+  QList<Message> messages = serviceRoot()->network()->getAllHeadlines(customId(), MAX_MESSAGES, true, true, false);
+
+  if (serviceRoot()->network()->lastError() != QNetworkReply::NoError) {
+    setStatus(Feed::NetworkError);
+    *error_during_obtaining = true;
+    serviceRoot()->itemChanged(QList<RootItem*>() << this);
+    return QList<Message>();
   }
-  while (newly_added_messages > 0);
 
   *error_during_obtaining = false;
   return messages;
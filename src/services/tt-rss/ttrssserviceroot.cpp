@@ -256,8 +256,8 @@ void TtRssServiceRoot::loadFromDatabase() {
   assembleFeeds(feeds);
 
   // As the last item, add recycle bin, which is needed.
+  // NOTE: Counts of messages are loaded by the model.
   appendChild(m_recycleBin);
-  updateCounts(true);
 }
 
 void TtRssServiceRoot::updateTitle() {
@@ -281,29 +281,3 @@ RootItem *TtRssServiceRoot::obtainNewTreeForSyncIn() const {
   }
 }
 
-QMap<int,QVariant> TtRssServiceRoot::storeCustomFeedsData() {
-  QMap<int,QVariant> custom_data;
-
-  foreach (const Feed *feed, getSubTreeFeeds()) {
-    QVariantMap feed_custom_data;
-
-    feed_custom_data.insert(QSL("auto_update_interval"), feed->autoUpdateInitialInterval());
-    feed_custom_data.insert(QSL("auto_update_type"), feed->autoUpdateType());
-
-    custom_data.insert(feed->customId(), feed_custom_data);
-  }
-
-  return custom_data;
-}
-
-void TtRssServiceRoot::restoreCustomFeedsData(const QMap<int,QVariant> &data, const QHash<int,Feed*> &feeds) {
-  foreach (int custom_id, data.keys()) {
-    if (feeds.contains(custom_id)) {
-      Feed *feed = feeds.value(custom_id);
-      QVariantMap feed_custom_data = data.value(custom_id).toMap();
-
-      feed->setAutoUpdateInitialInterval(feed_custom_data.value(QSL("auto_update_interval")).toInt());
-      feed->setAutoUpdateType(static_cast<Feed::AutoUpdateType>(feed_custom_data.value(QSL("auto_update_type")).toInt()));
-    }
-  }
-}
@@ -64,8 +64,6 @@ class TtRssServiceRoot : public ServiceRoot {
 
   private:
     RootItem *obtainNewTreeForSyncIn() const;
-    QMap<int,QVariant> storeCustomFeedsData();
-    void restoreCustomFeedsData(const QMap<int,QVariant> &data, const QHash<int,Feed*> &feeds);
 
     void loadFromDatabase();
 
@@ -0,0 +1,139 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#include "accounttreetest.h"
+
+#include "definitions/definitions.h"
+#include "miscellaneous/application.h"
+#include "miscellaneous/databasefactory.h"
+#include "miscellaneous/databasequeries.h"
+#include "miscellaneous/mutex.h"
+#include "services/tt-rss/ttrsscategory.h"
+#include "services/tt-rss/ttrssfeed.h"
+#include "services/tt-rss/ttrssserviceroot.h"
+
+#include <QSet>
+#include <QtTest>
+
+
+// Account which obtains fixed tree instead of asking the server,
+// items are placed into the tree as FeedsModel would do it.
+class FixedTreeServiceRoot : public TtRssServiceRoot {
+  public:
+    explicit FixedTreeServiceRoot(int account_id) : TtRssServiceRoot() {
+      setId(account_id);
+      setAccountId(account_id);
+
+      connect(this, &ServiceRoot::itemReassignmentRequested, [](RootItem *item, RootItem *new_parent) {
+        if (item->parent() != nullptr) {
+          item->parent()->removeChild(item);
+        }
+
+        new_parent->appendChild(item);
+      });
+    }
+
+    // Loads tree from database, returns false if some category
+    // refers to parent which does not exist.
+    bool loadTree(QSqlDatabase db) {
+      bool ok_categories, ok_feeds;
+      Assignment categories = DatabaseQueries::getTtRssCategories(db, accountId(), &ok_categories);
+      Assignment feeds = DatabaseQueries::getTtRssFeeds(db, accountId(), &ok_feeds);
+      QSet<int> category_ids;
+
+      category_ids.insert(NO_PARENT_CATEGORY);
+
+      foreach (const AssignmentItem &category, categories) {
+        category_ids.insert(category.second->id());
+      }
+
+      foreach (const AssignmentItem &category, categories) {
+        if (!category_ids.contains(category.first)) {
+          // Assembling would never finish.
+          qDeleteAll(categories.constBegin(), categories.constEnd());
+          return false;
+        }
+      }
+
+      assembleCategories(categories);
+      assembleFeeds(feeds);
+      return ok_categories && ok_feeds;
+    }
+
+  private:
+    RootItem *obtainNewTreeForSyncIn() const {
+      RootItem *tree = new RootItem();
+      TtRssCategory *top = new TtRssCategory();
+      TtRssCategory *nested = new TtRssCategory();
+      TtRssFeed *nested_feed = new TtRssFeed();
+      TtRssFeed *top_feed = new TtRssFeed();
+
+      top->setCustomId(1);
+      top->setTitle(QSL("Top"));
+      nested->setCustomId(2);
+      nested->setTitle(QSL("Nested"));
+      nested_feed->setCustomId(3);
+      nested_feed->setTitle(QSL("Nested feed"));
+      top_feed->setCustomId(4);
+      top_feed->setTitle(QSL("Top feed"));
+
+      tree->appendChild(top);
+      tree->appendChild(top_feed);
+      top->appendChild(nested);
+      nested->appendChild(nested_feed);
+      return tree;
+    }
+};
+
+void AccountTreeTest::initTestCase() {
+  m_database = qApp->database()->connection(metaObject()->className(), DatabaseFactory::FromSettings);
+}
+
+void AccountTreeTest::syncInAndReload() {
+  bool ok = false;
+  const int account_id = DatabaseQueries::createAccount(m_database, SERVICE_CODE_TT_RSS, &ok);
+
+  QVERIFY(ok);
+
+  FixedTreeServiceRoot synced_root(account_id);
+
+  synced_root.syncIn();
+
+  // Lock is released when new tree is applied.
+  QVERIFY(qApp->feedUpdateLock()->isLocked());
+  QTRY_VERIFY(!qApp->feedUpdateLock()->isLocked());
+  QCOMPARE(synced_root.getSubTreeFeeds().size(), 2);
+
+  FixedTreeServiceRoot loaded_root(account_id);
+
+  QVERIFY(loaded_root.loadTree(m_database));
+  QCOMPARE(loaded_root.childCount(), 2);
+
+  const QHash<int,Category*> categories = loaded_root.getHashedSubTreeCategories();
+  const QHash<int,Feed*> feeds = loaded_root.getHashedSubTreeFeeds();
+
+  QCOMPARE(categories.size(), 2);
+  QCOMPARE(feeds.size(), 2);
+  QVERIFY(categories.contains(1) && categories.contains(2));
+  QVERIFY(feeds.contains(3) && feeds.contains(4));
+  QVERIFY(categories.value(1)->parent() == &loaded_root);
+  QVERIFY(categories.value(2)->parent() == categories.value(1));
+  QVERIFY(feeds.value(3)->parent() == categories.value(2));
+  QVERIFY(feeds.value(4)->parent() == &loaded_root);
+  QCOMPARE(categories.value(2)->title(), QSL("Nested"));
+  QCOMPARE(feeds.value(4)->title(), QSL("Top feed"));
+}
@@ -0,0 +1,131 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#include "faviconfetchertest.h"
+
+#include "definitions/definitions.h"
+#include "miscellaneous/application.h"
+#include "miscellaneous/iconfactory.h"
+#include "network-web/faviconfetcher.h"
+#include "services/standard/standardfeed.h"
+#include "httpstandin.h"
+
+#include <QtTest>
+
+
+// Serves homepage which links icon of given size and "/favicon.ico" of size 16.
+static void addSite(HttpStandIn &server, int linked_icon_size) {
+  server.setResource(QSL("/"), "<html><head><title>Site</title>"
+                               "<link rel=\"icon\" href=\"/linked.png\"></head><body></body></html>",
+                     "text/html");
+  server.setResource(QSL("/linked.png"), HttpStandIn::pngData(linked_icon_size), "image/png");
+  server.setResource(QSL("/favicon.ico"), HttpStandIn::pngData(16), "image/x-icon");
+}
+
+static QSize iconSize(const QIcon &icon) {
+  return icon.availableSizes().isEmpty() ? QSize() : icon.availableSizes().first();
+}
+
+void FaviconFetcherTest::replacedHash() {
+  HttpStandIn server;
+  FaviconFetcher fetcher;
+  QSignalSpy spy(&fetcher, SIGNAL(iconFetched(QString,QIcon,QString)));
+
+  addSite(server, 32);
+
+  // Site was never fetched, so hash of icon stored before is replaced.
+  fetcher.fetchIcon(server.url(QSL("/feed.xml")), QUrl(), true, QSL("stored-hash"));
+  QTRY_COMPARE(spy.count(), 1);
+  QCOMPARE(spy.at(0).at(2).toString(), QSL("stored-hash"));
+
+  const QIcon first_icon = spy.at(0).at(1).value<QIcon>();
+
+  // Now the previously fetched icon is replaced.
+  fetcher.fetchIcon(server.url(QSL("/feed.xml")), QUrl(), true, QSL("stored-hash"));
+  QTRY_COMPARE(spy.count(), 2);
+  QCOMPARE(spy.at(1).at(2).toString(), IconFactory::iconHash(qApp->icons()->toByteArray(first_icon)));
+}
+
+void FaviconFetcherTest::linkedIconIsPreferred() {
+  HttpStandIn server;
+  FaviconFetcher fetcher;
+  QSignalSpy spy(&fetcher, SIGNAL(iconFetched(QString,QIcon,QString)));
+
+  addSite(server, 32);
+  fetcher.fetchIcon(server.url(QSL("/feed.xml")), QUrl(), true);
+
+  QVERIFY(fetcher.isFetching(server.url(QSL("/"))));
+  QTRY_COMPARE(spy.count(), 1);
+  QCOMPARE(spy.at(0).at(0).toString(), FaviconFetcher::hostKey(server.url(QSL("/"))));
+  QCOMPARE(iconSize(spy.at(0).at(1).value<QIcon>()), QSize(32, 32));
+  QCOMPARE(iconSize(fetcher.cachedIcon(server.url(QSL("/other.xml")))), QSize(32, 32));
+  QVERIFY(!fetcher.needsRefresh(server.url(QSL("/"))));
+}
+
+void FaviconFetcherTest::feedIconIsPreferred() {
+  HttpStandIn server;
+  FaviconFetcher fetcher;
+  QSignalSpy spy(&fetcher, SIGNAL(iconFetched(QString,QIcon,QString)));
+
+  addSite(server, 32);
+  server.setResource(QSL("/feed-icon.png"), HttpStandIn::pngData(48), "image/png");
+  fetcher.fetchIcon(server.url(QSL("/feed.xml")), server.url(QSL("/feed-icon.png")), true);
+
+  QTRY_COMPARE(spy.count(), 1);
+  QCOMPARE(iconSize(spy.at(0).at(1).value<QIcon>()), QSize(48, 48));
+}
+
+void FaviconFetcherTest::missingIconFails() {
+  HttpStandIn server;
+  FaviconFetcher fetcher;
+  QSignalSpy spy_fetched(&fetcher, SIGNAL(iconFetched(QString,QIcon,QString)));
+  QSignalSpy spy_failed(&fetcher, SIGNAL(fetchFailed(QString)));
+
+  fetcher.fetchIcon(server.url(QSL("/feed.xml")), QUrl(), true);
+
+  QTRY_COMPARE(spy_failed.count(), 1);
+  QCOMPARE(spy_fetched.count(), 0);
+  QVERIFY(server.requestCount(QSL("/favicon.ico")) > 0);
+  QVERIFY(!fetcher.isFetching(server.url(QSL("/"))));
+}
+
+void FaviconFetcherTest::guessFeedDoesNotWait() {
+  HttpStandIn server;
+  QSignalSpy spy(FaviconFetcher::instance(), SIGNAL(iconFetched(QString,QIcon,QString)));
+
+  addSite(server, 32);
+  server.setResource(QSL("/feed-icon.png"), HttpStandIn::pngData(48), "image/png");
+  server.setResource(QSL("/feed.xml"),
+                     "<?xml version=\"1.0\" encoding=\"UTF-8\"?><rss version=\"2.0\"><channel>"
+                     "<title>Feed</title><description>Description</description><link>" +
+                     server.url(QSL("/")).toString().toUtf8() + "</link>"
+                     "<image><url>/feed-icon.png</url></image></channel></rss>",
+                     "application/rss+xml");
+
+  QPair<StandardFeed*,QNetworkReply::NetworkError> guessed = StandardFeed::guessFeed(server.url(QSL("/feed.xml")).toString());
+  QScopedPointer<StandardFeed> feed(guessed.first);
+
+  // Feed is guessed right away, icon arrives later.
+  QCOMPARE(guessed.second, QNetworkReply::NoError);
+  QVERIFY(!feed.isNull());
+  QCOMPARE(feed->title(), QSL("Feed"));
+  QVERIFY(feed->icon().isNull());
+
+  QTRY_COMPARE(spy.count(), 1);
+  QCOMPARE(spy.at(0).at(0).toString(), FaviconFetcher::hostKey(server.url(QSL("/"))));
+  QCOMPARE(iconSize(spy.at(0).at(1).value<QIcon>()), QSize(48, 48));
+}
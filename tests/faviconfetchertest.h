@@ -0,0 +1,37 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef FAVICONFETCHERTEST_H
+#define FAVICONFETCHERTEST_H
+
+#include <QObject>
+
+
+// Checks that FaviconFetcher picks the best icon of site served
+// by local HTTP stand-in and that feed guessing does not wait for it.
+class FaviconFetcherTest : public QObject {
+    Q_OBJECT
+
+  private slots:
+    void replacedHash();
+    void linkedIconIsPreferred();
+    void feedIconIsPreferred();
+    void missingIconFails();
+    void guessFeedDoesNotWait();
+};
+
+#endif // FAVICONFETCHERTEST_H
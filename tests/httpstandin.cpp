@@ -0,0 +1,115 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#include "httpstandin.h"
+
+#include "definitions/definitions.h"
+
+#include <QBuffer>
+#include <QImage>
+#include <QTcpSocket>
+
+
+HttpStandIn::HttpStandIn(QObject *parent)
+  : QTcpServer(parent), m_resources(QHash<QString,Resource>()), m_requestCounts(QHash<QString,int>()) {
+  connect(this, SIGNAL(newConnection()), this, SLOT(onNewConnection()));
+
+  if (!listen(QHostAddress::LocalHost)) {
+    qWarning("HTTP stand-in cannot listen: '%s'.", qPrintable(errorString()));
+  }
+}
+
+HttpStandIn::~HttpStandIn() {
+}
+
+void HttpStandIn::setResource(const QString &path, const QByteArray &data, const QByteArray &content_type) {
+  Resource resource;
+
+  resource.m_data = data;
+  resource.m_contentType = content_type;
+  m_resources.insert(path, resource);
+}
+
+void HttpStandIn::removeResource(const QString &path) {
+  m_resources.remove(path);
+}
+
+QUrl HttpStandIn::url(const QString &path) const {
+  return QUrl(QSL("http://127.0.0.1:%1%2").arg(QString::number(serverPort()), path));
+}
+
+int HttpStandIn::requestCount(const QString &path) const {
+  return m_requestCounts.value(path);
+}
+
+QByteArray HttpStandIn::pngData(int size) {
+  QImage image(size, size, QImage::Format_ARGB32);
+  QByteArray data;
+  QBuffer buffer(&data);
+
+  image.fill(Qt::darkGreen);
+  buffer.open(QIODevice::WriteOnly);
+  image.save(&buffer, "PNG");
+  return data;
+}
+
+void HttpStandIn::onNewConnection() {
+  while (hasPendingConnections()) {
+    QTcpSocket *socket = nextPendingConnection();
+
+    connect(socket, SIGNAL(readyRead()), this, SLOT(onReadyRead()));
+    connect(socket, SIGNAL(disconnected()), socket, SLOT(deleteLater()));
+  }
+}
+
+void HttpStandIn::onReadyRead() {
+  QTcpSocket *socket = qobject_cast<QTcpSocket*>(sender());
+
+  if (socket == nullptr) {
+    return;
+  }
+
+  const QByteArray request = socket->property("request").toByteArray() + socket->readAll();
+
+  if (!request.contains("\r\n\r\n")) {
+    // Headers are not complete yet.
+    socket->setProperty("request", request);
+    return;
+  }
+
+  // Request line is "GET /path?query HTTP/1.1".
+  const QList<QByteArray> request_line = request.left(request.indexOf("\r\n")).split(' ');
+  const QString path = request_line.size() > 1 ? QString::fromUtf8(request_line.at(1)).section(QL1C('?'), 0, 0) : QString();
+  QByteArray response;
+
+  m_requestCounts[path]++;
+
+  if (m_resources.contains(path)) {
+    const Resource resource = m_resources.value(path);
+
+    response = "HTTP/1.1 200 OK\r\nContent-Type: " + resource.m_contentType +
+               "\r\nContent-Length: " + QByteArray::number(resource.m_data.size()) +
+               "\r\nCache-Control: no-cache\r\nConnection: close\r\n\r\n" + resource.m_data;
+  }
+  else {
+    response = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+  }
+
+  disconnect(socket, SIGNAL(readyRead()), this, SLOT(onReadyRead()));
+  socket->write(response);
+  socket->disconnectFromHost();
+}
@@ -0,0 +1,65 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HTTPSTANDIN_H
+#define HTTPSTANDIN_H
+
+#include <QTcpServer>
+
+#include <QByteArray>
+#include <QHash>
+#include <QUrl>
+
+
+// Minimal HTTP server listening on localhost, it serves fixed resources
+// so that network code can be tested without real servers.
+class HttpStandIn : public QTcpServer {
+    Q_OBJECT
+
+  public:
+    // Constructors and destructors.
+    explicit HttpStandIn(QObject *parent = 0);
+    virtual ~HttpStandIn();
+
+    // Serves given data under given path, other paths get "404 Not Found".
+    void setResource(const QString &path, const QByteArray &data, const QByteArray &content_type);
+    void removeResource(const QString &path);
+
+    // Returns URL of given path on this server.
+    QUrl url(const QString &path) const;
+
+    // Returns number of requests of given path.
+    int requestCount(const QString &path) const;
+
+    // Returns PNG image of given size.
+    static QByteArray pngData(int size);
+
+  private slots:
+    void onNewConnection();
+    void onReadyRead();
+
+  private:
+    struct Resource {
+      QByteArray m_data;
+      QByteArray m_contentType;
+    };
+
+    QHash<QString,Resource> m_resources;
+    QHash<QString,int> m_requestCounts;
+};
+
+#endif // HTTPSTANDIN_H
@@ -0,0 +1,65 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#include "imageloadertest.h"
+
+#include "definitions/definitions.h"
+#include "network-web/imageloader.h"
+#include "httpstandin.h"
+
+#include <QtTest>
+
+
+void ImageLoaderTest::loadsImage() {
+  HttpStandIn server;
+  ImageLoader loader;
+  QSignalSpy spy(&loader, SIGNAL(imageLoaded(QUrl)));
+  const QUrl url = server.url(QSL("/image.png"));
+
+  server.setResource(QSL("/image.png"), HttpStandIn::pngData(64), "image/png");
+
+  // Image is loaded in background and it is downscaled.
+  QVERIFY(loader.image(url, 32).isNull());
+  QVERIFY(loader.image(url, 32).isNull());
+  QTRY_COMPARE(spy.count(), 1);
+  QCOMPARE(spy.at(0).at(0).toUrl(), url);
+  QCOMPARE(loader.image(url, 32).width(), 32);
+
+  // Loaded image is served from memory, pending one was requested once.
+  QCOMPARE(server.requestCount(QSL("/image.png")), 1);
+}
+
+void ImageLoaderTest::retriesFailedImage() {
+  HttpStandIn server;
+  ImageLoader loader;
+  QSignalSpy spy(&loader, SIGNAL(imageFailed(QUrl)));
+  const QUrl url = server.url(QSL("/failing.png"));
+
+  loader.setRetryInterval(200);
+
+  QVERIFY(loader.image(url, 32).isNull());
+  QTRY_COMPARE(spy.count(), 1);
+
+  // Failed image is not requested again right away.
+  QVERIFY(loader.image(url, 32).isNull());
+  QCOMPARE(server.requestCount(QSL("/failing.png")), 1);
+
+  // Once the image is available, it is loaded after retry interval.
+  server.setResource(QSL("/failing.png"), HttpStandIn::pngData(16), "image/png");
+  QTRY_COMPARE(loader.image(url, 32).width(), 16);
+  QCOMPARE(server.requestCount(QSL("/failing.png")), 2);
+}
@@ -0,0 +1,84 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#include "legacy/legacytextfactory.h"
+
+#include "definitions/definitions.h"
+
+#include <QLocale>
+#include <QStringList>
+
+
+LegacyTextFactory::LegacyTextFactory() {
+}
+
+QDateTime LegacyTextFactory::parseDateTime(const QString &date_time) {
+  const QString input_date = date_time.simplified();
+  QDateTime dt;
+  QTime time_zone_offset;
+  const QLocale locale(QLocale::C);
+  bool positive_time_zone_offset = false;
+
+  QStringList date_patterns; date_patterns << QSL("yyyy-MM-ddTHH:mm:ss") << QSL("MMM dd yyyy hh:mm:ss") <<
+                                              QSL("MMM d yyyy hh:mm:ss") << QSL("ddd, dd MMM yyyy HH:mm:ss") <<
+                                              QSL("dd MMM yyyy") << QSL("yyyy-MM-dd HH:mm:ss.z") << QSL("yyyy-MM-dd") <<
+                                              QSL("yyyy") << QSL("yyyy-MM") << QSL("yyyy-MM-dd") << QSL("yyyy-MM-ddThh:mm") <<
+                                              QSL("yyyy-MM-ddThh:mm:ss");
+
+  QStringList timezone_offset_patterns; timezone_offset_patterns << QSL("+hh:mm") << QSL("-hh:mm") << QSL("+hhmm")
+                                                                 << QSL("-hhmm") << QSL("+hh") << QSL("-hh");
+
+  if (input_date.size() >= TIMEZONE_OFFSET_LIMIT) {
+    foreach (const QString &pattern, timezone_offset_patterns) {
+      time_zone_offset = QTime::fromString(input_date.right(pattern.size()), pattern);
+
+      if (time_zone_offset.isValid()) {
+        positive_time_zone_offset = pattern.at(0) == QL1C('+');
+        break;
+      }
+    }
+  }
+
+  // Iterate over patterns and check if input date/time matches the pattern.
+  foreach (const QString &pattern, date_patterns) {
+    dt = locale.toDateTime(input_date.left(pattern.size()), pattern);
+
+    if (dt.isValid()) {
+      // Make sure that this date/time is considered UTC.
+      dt.setTimeSpec(Qt::UTC);
+
+      if (time_zone_offset.isValid()) {
+        // Time zone offset was detected.
+        if (positive_time_zone_offset) {
+          // Offset is positive, so we have to subtract it to get
+          // the original UTC.
+          return dt.addSecs(- QTime(0, 0, 0, 0).secsTo(time_zone_offset));
+        }
+        else {
+          // Vice versa.
+          return dt.addSecs(QTime(0, 0, 0, 0).secsTo(time_zone_offset));
+        }
+      }
+      else {
+        return dt;
+      }
+    }
+  }
+
+  // Parsing failed, return invalid datetime.
+  return QDateTime();
+}
@@ -0,0 +1,35 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef LEGACYTEXTFACTORY_H
+#define LEGACYTEXTFACTORY_H
+
+#include <QDateTime>
+
+
+// Pattern-based parsing of dates used by TextFactory before
+// hand-written parsers were added. It is kept as reference
+// for conformance tests and benchmarks.
+class LegacyTextFactory {
+  public:
+    static QDateTime parseDateTime(const QString &date_time);
+
+  private:
+    explicit LegacyTextFactory();
+};
+
+#endif // LEGACYTEXTFACTORY_H
@@ -0,0 +1,82 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#include "legacy/legacywebfactory.h"
+
+#include "definitions/definitions.h"
+
+#include <QMap>
+#include <QRegExp>
+
+
+static QMap<QString,QString> escapes() {
+  QMap<QString,QString> escapes;
+
+  escapes[QSL("&lt;")]     = QL1C('<');
+  escapes[QSL("&gt;")]     = QL1C('>');
+  escapes[QSL("&amp;")]    = QL1C('&');
+  escapes[QSL("&quot;")]   = QL1C('\"');
+  escapes[QSL("&nbsp;")]   = QL1C(' ');
+  escapes[QSL("&plusmn;")] = QSL("±");
+  escapes[QSL("&times;")]  = QSL("×");
+  escapes[QSL("&#039;")]   = QL1C('\'');
+  return escapes;
+}
+
+static QMap<QString,QString> deEscapes() {
+  QMap<QString,QString> de_escapes;
+
+  de_escapes[QSL("<")]  = QSL("&lt;");
+  de_escapes[QSL(">")]  = QSL("&gt;");
+  de_escapes[QSL("&")]  = QSL("&amp;");
+  de_escapes[QSL("\"")] = QSL("&quot;");
+  de_escapes[QSL("±")]  = QSL("&plusmn;");
+  de_escapes[QSL("×")]  = QSL("&times;");
+  de_escapes[QSL("\'")] = QSL("&#039;");
+  return de_escapes;
+}
+
+LegacyWebFactory::LegacyWebFactory() {
+}
+
+QString LegacyWebFactory::stripTags(QString text) {
+  return text.remove(QRegExp(QSL("<[^>]*>")));
+}
+
+QString LegacyWebFactory::escapeHtml(const QString &html) {
+  // Tables were filled lazily by WebFactory, here they are
+  // filled once so that benchmarks measure only replacing.
+  static const QMap<QString,QString> table = escapes();
+  QString output = html;
+
+  foreach (const QString &key, table.keys()) {
+    output = output.replace(key, table.value(key));
+  }
+
+  return output;
+}
+
+QString LegacyWebFactory::deEscapeHtml(const QString &text) {
+  static const QMap<QString,QString> table = deEscapes();
+  QString output = text;
+
+  foreach (const QString &key, table.keys()) {
+    output = output.replace(key, table.value(key));
+  }
+
+  return output;
+}
@@ -0,0 +1,38 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef LEGACYWEBFACTORY_H
+#define LEGACYWEBFACTORY_H
+
+#include <QString>
+
+
+// Regular expression based stripping of tags and replacement based
+// (de)escaping of entities used by WebFactory before single-pass
+// implementations were added. It is kept as reference for tests
+// and benchmarks.
+class LegacyWebFactory {
+  public:
+    static QString stripTags(QString text);
+    static QString escapeHtml(const QString &html);
+    static QString deEscapeHtml(const QString &text);
+
+  private:
+    explicit LegacyWebFactory();
+};
+
+#endif // LEGACYWEBFACTORY_H
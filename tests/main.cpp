@@ -0,0 +1,71 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#include "definitions/definitions.h"
+#include "miscellaneous/application.h"
+#include "accounttreetest.h"
+#include "faviconfetchertest.h"
+#include "imageloadertest.h"
+#include "messagecontentstest.h"
+#include "testdata.h"
+#include "textfactorytest.h"
+#include "webfactorytest.h"
+
+#include <QTemporaryDir>
+#include <QtTest>
+
+
+// Runs all tests, each test object gets the same arguments.
+// Some tests use settings and database, so they run with
+// throwaway profile and profile of the user is never touched.
+int main(int argc, char *argv[]) {
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+  }
+
+  QTemporaryDir home_folder;
+
+  if (!home_folder.isValid() || !TestData::prepareProfile(home_folder.path())) {
+    qWarning("Cannot prepare temporary profile for tests.");
+    return EXIT_FAILURE;
+  }
+
+  Application application(QSL(APP_LOW_NAME "-tests"), argc, argv);
+
+  if (!TestData::usesProfile(home_folder.path())) {
+    qWarning("Application does not use temporary profile '%s', tests are not started.",
+             qPrintable(home_folder.path()));
+    return EXIT_FAILURE;
+  }
+
+  TextFactoryTest text_factory_test;
+  WebFactoryTest web_factory_test;
+  MessageContentsTest message_contents_test;
+  AccountTreeTest account_tree_test;
+  FaviconFetcherTest favicon_fetcher_test;
+  ImageLoaderTest image_loader_test;
+  int result = 0;
+
+  result |= QTest::qExec(&text_factory_test, argc, argv);
+  result |= QTest::qExec(&web_factory_test, argc, argv);
+  result |= QTest::qExec(&message_contents_test, argc, argv);
+  result |= QTest::qExec(&account_tree_test, argc, argv);
+  result |= QTest::qExec(&favicon_fetcher_test, argc, argv);
+  result |= QTest::qExec(&image_loader_test, argc, argv);
+
+  return result;
+}
@@ -0,0 +1,74 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#include "messagecontentstest.h"
+
+#include "definitions/definitions.h"
+#include "core/message.h"
+
+#include <QtTest>
+
+
+void MessageContentsTest::roundTrip_data() {
+  QTest::addColumn<QString>("contents");
+  QTest::addColumn<bool>("binary_storage");
+  QTest::addColumn<bool>("compressed");
+
+  const QString short_contents = QSL("<p>Short message.</p>");
+  const QString long_contents = QSL("<p>Repeated paragraph of message, ±×.</p>").repeated(50);
+  const QString prefixed_contents = QSL(CONTENTS_COMPRESSED_PREFIX) + long_contents;
+
+  QTest::newRow("short-text") << short_contents << false << false;
+  QTest::newRow("short-blob") << short_contents << true << false;
+  QTest::newRow("long-text") << long_contents << false << true;
+  QTest::newRow("long-blob") << long_contents << true << true;
+  QTest::newRow("prefixed-text") << prefixed_contents << false << true;
+  QTest::newRow("prefixed-blob") << prefixed_contents << true << true;
+}
+
+void MessageContentsTest::roundTrip() {
+  QFETCH(QString, contents);
+  QFETCH(bool, binary_storage);
+  QFETCH(bool, compressed);
+
+  const QVariant stored = MessageContents::encode(contents, true, binary_storage);
+
+  QCOMPARE(MessageContents::isCompressed(stored), compressed);
+  QCOMPARE(MessageContents::decode(stored), contents);
+  QCOMPARE(MessageContents::plainSize(stored), (qint64) contents.toUtf8().size());
+  QCOMPARE(MessageContents::decode(MessageContents::convert(stored, MessageContents::Decompress, binary_storage)), contents);
+}
+
+void MessageContentsTest::plainWithPrefix_data() {
+  QTest::addColumn<QVariant>("stored");
+
+  QTest::newRow("text") << QVariant(QSL("RGZ: this is not compressed"));
+  QTest::newRow("text-empty") << QVariant(QSL("RGZ:"));
+  QTest::newRow("text-base64-zero-size") << QVariant(QSL("RGZ:AAAAAGFiY2Rl"));
+  QTest::newRow("text-base64-huge-size") << QVariant(QSL("RGZ:f////2FiY2Rl"));
+  QTest::newRow("text-base64-not-zlib") << QVariant(QSL("RGZ:AAAABWFiY2Rl"));
+  QTest::newRow("text-non-latin") << QVariant(QSL("RGZ:ěščřžýáíé"));
+  QTest::newRow("blob") << QVariant(QByteArray("RGZ:not compressed"));
+  QTest::newRow("blob-not-zlib") << QVariant(QByteArray("RGZ:\x00\x00\x00\x05" "abcde", 13));
+}
+
+void MessageContentsTest::plainWithPrefix() {
+  QFETCH(QVariant, stored);
+
+  QCOMPARE(MessageContents::decode(stored), stored.toString());
+  QCOMPARE(MessageContents::decode(MessageContents::convert(stored, MessageContents::Decompress, false)), stored.toString());
+}
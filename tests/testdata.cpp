@@ -0,0 +1,71 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#include "testdata.h"
+
+#include "definitions/definitions.h"
+#include "miscellaneous/application.h"
+#include "miscellaneous/settings.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+
+TestData::TestData() {
+}
+
+bool TestData::prepareProfile(const QString &home_folder) {
+  // Existing settings file in HOME takes precedence over portable settings.
+  const QString config_folder = home_folder + QL1S("/" APP_LOW_H_NAME "/data/" APP_CFG_PATH);
+  QFile config_file(config_folder + QL1S("/" APP_CFG_FILE));
+
+  if (!QDir().mkpath(config_folder) || !config_file.open(QIODevice::WriteOnly)) {
+    return false;
+  }
+
+  config_file.close();
+
+  qputenv("HOME", QFile::encodeName(home_folder));
+  qputenv("USERPROFILE", QFile::encodeName(home_folder));
+  return true;
+}
+
+bool TestData::usesProfile(const QString &home_folder) {
+  const QString settings_file = QFileInfo(qApp->settings()->fileName()).canonicalFilePath();
+  const QString home = QDir(home_folder).canonicalPath();
+
+  return !home.isEmpty() && settings_file.startsWith(home + QL1C('/'));
+}
+
+QList<QStringList> TestData::rows(const QString &file_name) {
+  QFile file(QSL(TESTS_DATA_PATH) + QL1C('/') + file_name);
+  QList<QStringList> rows;
+
+  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    qWarning("Cannot open test data file '%s'.", qPrintable(file.fileName()));
+    return rows;
+  }
+
+  foreach (const QString &line, QString::fromUtf8(file.readAll()).split(QL1C('\n'))) {
+    if (!line.trimmed().isEmpty() && !line.startsWith(QL1C('#'))) {
+      rows.append(line.split(QL1C('\t')));
+    }
+  }
+
+  return rows;
+}
@@ -0,0 +1,45 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef TESTDATA_H
+#define TESTDATA_H
+
+#include <QList>
+#include <QStringList>
+
+
+// Access to files in "tests/data" folder and throwaway profile,
+// which are shared by tests and benchmarks.
+class TestData {
+  public:
+    // Points HOME to given folder and creates empty settings file in it,
+    // application then creates its whole profile there.
+    // NOTE: Must be called before Application instance is created.
+    static bool prepareProfile(const QString &home_folder);
+
+    // Returns true if application really uses profile from given folder.
+    static bool usesProfile(const QString &home_folder);
+
+    // Returns tab-separated columns of all lines of given file,
+    // empty lines and lines starting with "#" are skipped.
+    static QList<QStringList> rows(const QString &file_name);
+
+  private:
+    explicit TestData();
+};
+
+#endif // TESTDATA_H
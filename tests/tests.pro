@@ -0,0 +1,104 @@
+#################################################################
+#
+# This file is part of RSS Guard.
+#
+# Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+#
+# RSS Guard is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# RSS Guard is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with RSS Guard. If not, see <http:# www.gnu.org/licenses/>.
+#
+#
+#  This is RSS Guard tests compilation script for qmake.
+#
+#  Tests link the same sources as application and check parsing
+#  of dates against corpus in "data" folder, stripping of HTML tags
+#  and (de)escaping of entities. Results are compared with former
+#  implementations kept in "legacy" folder. Storing of compressed
+#  message contents and of synchronized account tree is checked too,
+#  fetching of favicons and loading of images in message previews run
+#  against local HTTP stand-in. Tests always run with throwaway profile
+#  in temporary folder.
+#
+# Usage:
+#     cd ../build-dir-tests
+#     qmake ../rssguard-dir/tests/tests.pro
+#     make
+#     make check
+#
+#################################################################
+
+TEMPLATE    = app
+TARGET      = rssguard-tests
+
+message(rssguard-tests: Welcome RSS Guard tests qmake script.)
+
+# Internal web browser is not needed, text previewer is linked instead.
+USE_WEBENGINE = false
+
+include(../rssguard.pri)
+
+QT += testlib
+
+CONFIG -= debug_and_release app_bundle
+CONFIG += console testcase
+
+DESTDIR = $$OUT_PWD/bin
+MOC_DIR = $$OUT_PWD/moc
+RCC_DIR = $$OUT_PWD/rcc
+UI_DIR = $$OUT_PWD/ui
+
+DEFINES += TESTS_DATA_PATH='"\\\"$$PWD/data\\\""'
+
+INCLUDEPATH +=  $$PWD
+
+# Database initialization scripts are looked up relatively
+# to executable, see APP_MISC_PATH.
+win32 {
+  misc_sql.path = $$DESTDIR/misc
+}
+
+mac {
+  misc_sql.path = $$OUT_PWD/Resources/misc
+}
+
+unix:!mac {
+  misc_sql.path = $$OUT_PWD/share/rssguard/misc
+}
+
+misc_sql.files = $$files($$PWD/../resources/misc/*.sql)
+
+CONFIG += file_copies
+COPIES += misc_sql
+
+HEADERS +=  $$PWD/accounttreetest.h \
+            $$PWD/faviconfetchertest.h \
+            $$PWD/httpstandin.h \
+            $$PWD/imageloadertest.h \
+            $$PWD/legacy/legacytextfactory.h \
+            $$PWD/legacy/legacywebfactory.h \
+            $$PWD/messagecontentstest.h \
+            $$PWD/testdata.h \
+            $$PWD/textfactorytest.h \
+            $$PWD/webfactorytest.h
+
+SOURCES +=  $$PWD/accounttreetest.cpp \
+            $$PWD/faviconfetchertest.cpp \
+            $$PWD/httpstandin.cpp \
+            $$PWD/imageloadertest.cpp \
+            $$PWD/legacy/legacytextfactory.cpp \
+            $$PWD/legacy/legacywebfactory.cpp \
+            $$PWD/main.cpp \
+            $$PWD/messagecontentstest.cpp \
+            $$PWD/testdata.cpp \
+            $$PWD/textfactorytest.cpp \
+            $$PWD/webfactorytest.cpp
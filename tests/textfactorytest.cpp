@@ -0,0 +1,88 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#include "textfactorytest.h"
+
+#include "definitions/definitions.h"
+#include "miscellaneous/textfactory.h"
+#include "legacy/legacytextfactory.h"
+#include "testdata.h"
+
+#include <QtTest>
+
+
+// Returns expected result from corpus, "invalid" means that parsing must fail.
+static QDateTime expectedDateTime(const QString &expected) {
+  return expected == QL1S("invalid") ? QDateTime() : QDateTime::fromString(expected, Qt::ISODate);
+}
+
+static bool isCorrect(const QDateTime &parsed, const QDateTime &expected) {
+  return expected.isValid() ? parsed.isValid() && parsed == expected : !parsed.isValid();
+}
+
+void TextFactoryTest::parseDateTime_data() {
+  QTest::addColumn<QString>("input");
+  QTest::addColumn<QDateTime>("expected");
+
+  foreach (const QStringList &row, TestData::rows(QSL("datetimes.txt"))) {
+    QTest::newRow(qPrintable(row.at(0))) << row.at(1) << expectedDateTime(row.at(2));
+  }
+}
+
+void TextFactoryTest::parseDateTime() {
+  QFETCH(QString, input);
+  QFETCH(QDateTime, expected);
+
+  const QDateTime parsed = TextFactory::parseDateTime(input);
+
+  if (expected.isValid()) {
+    QVERIFY(parsed.isValid());
+    QCOMPARE(parsed.toUTC(), expected.toUTC());
+  }
+  else {
+    QVERIFY(!parsed.isValid());
+  }
+}
+
+void TextFactoryTest::parseDateTimeAccuracy() {
+  const QList<QStringList> rows = TestData::rows(QSL("datetimes.txt"));
+  int correct = 0;
+  int legacy_correct = 0;
+
+  QVERIFY(!rows.isEmpty());
+
+  foreach (const QStringList &row, rows) {
+    const QDateTime expected = expectedDateTime(row.at(2));
+
+    if (isCorrect(TextFactory::parseDateTime(row.at(1)), expected)) {
+      correct++;
+    }
+
+    if (isCorrect(LegacyTextFactory::parseDateTime(row.at(1)), expected)) {
+      legacy_correct++;
+    }
+    else {
+      qDebug("Former parsing is wrong for '%s': '%s'.", qPrintable(row.at(0)),
+             qPrintable(LegacyTextFactory::parseDateTime(row.at(1)).toUTC().toString(Qt::ISODate)));
+    }
+  }
+
+  qDebug("Correctly parsed %d of %d dates, formerly %d.", correct, rows.size(), legacy_correct);
+
+  QCOMPARE(correct, rows.size());
+  QVERIFY(correct >= legacy_correct);
+}
@@ -0,0 +1,36 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef TEXTFACTORYTEST_H
+#define TEXTFACTORYTEST_H
+
+#include <QObject>
+
+
+// Checks TextFactory::parseDateTime() against corpus of RFC 822
+// and ISO 8601 dates and against former pattern-based parsing.
+class TextFactoryTest : public QObject {
+    Q_OBJECT
+
+  private slots:
+    void parseDateTime_data();
+    void parseDateTime();
+
+    void parseDateTimeAccuracy();
+};
+
+#endif // TEXTFACTORYTEST_H
@@ -0,0 +1,129 @@
+// This file is part of RSS Guard.
+//
+// Copyright (C) 2011-2016 by Martin Rotter <rotter.martinos@gmail.com>
+//
+// RSS Guard is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RSS Guard is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RSS Guard. If not, see <http://www.gnu.org/licenses/>.
+
+#include "webfactorytest.h"
+
+#include "definitions/definitions.h"
+#include "network-web/webfactory.h"
+#include "legacy/legacywebfactory.h"
+
+#include <QtTest>
+
+
+// Each row tells whether former implementation gives the same result,
+// rows where it does not document intentional changes of behavior.
+void WebFactoryTest::stripTags_data() {
+  QTest::addColumn<QString>("input");
+  QTest::addColumn<QString>("expected");
+  QTest::addColumn<bool>("same_as_legacy");
+
+  QTest::newRow("plain") << QSL("No tags here") << QSL("No tags here") << true;
+  QTest::newRow("empty") << QString() << QString() << true;
+  QTest::newRow("simple") << QSL("<p>Hello <b>world</b></p>") << QSL("Hello world") << true;
+  QTest::newRow("self-closing") << QSL("line<br/>break") << QSL("linebreak") << true;
+  QTest::newRow("attributes") << QSL("<a href=\"https://example.org/?a=1&amp;b=2\" title=\"t\">link</a>")
+                              << QSL("link") << true;
+  QTest::newRow("lt-in-attribute") << QSL("<img alt=\"x < y\" src=\"a.png\">caption") << QSL("caption") << true;
+  QTest::newRow("lt-in-text") << QSL("1 < 2") << QSL("1 < 2") << true;
+  QTest::newRow("unterminated-tag") << QSL("text <b unterminated") << QSL("text <b unterminated") << true;
+  QTest::newRow("unterminated-after-tags") << QSL("<i>a</i> b <c") << QSL("a b <c") << true;
+  QTest::newRow("comment") << QSL("a<!-- comment <b>bold</b> -->b") << QSL("ab") << false;
+  QTest::newRow("unterminated-comment") << QSL("a<!-- comment") << QSL("a<!-- comment") << true;
+  QTest::newRow("cdata") << QSL("a<![CDATA[<b>x</b>]]>b") << QSL("a<b>x</b>b") << false;
+  QTest::newRow("unterminated-cdata") << QSL("a<![CDATA[x") << QSL("a<![CDATA[x") << true;
+}
+
+void WebFactoryTest::stripTags() {
+  QFETCH(QString, input);
+  QFETCH(QString, expected);
+  QFETCH(bool, same_as_legacy);
+
+  QCOMPARE(WebFactory::instance()->stripTags(input), expected);
+  QCOMPARE(LegacyWebFactory::stripTags(input) == expected, same_as_legacy);
+}
+
+void WebFactoryTest::escapeHtml_data() {
+  QTest::addColumn<QString>("input");
+  QTest::addColumn<QString>("expected");
+  QTest::addColumn<bool>("same_as_legacy");
+
+  QTest::newRow("plain") << QSL("No entities") << QSL("No entities") << true;
+  QTest::newRow("empty") << QString() << QString() << true;
+  QTest::newRow("basic") << QSL("&lt;b&gt; &amp; &quot;q&quot; &#039;") << QSL("<b> & \"q\" '") << true;
+  QTest::newRow("nbsp") << QSL("a&nbsp;b") << QSL("a b") << true;
+  QTest::newRow("named") << QSL("&mdash;&hellip;&euro;&copy;&eacute;") << QSL("—…€©é") << false;
+  QTest::newRow("apos") << QSL("&apos;") << QSL("'") << false;
+  QTest::newRow("case-sensitive") << QSL("&AMP; &Eacute;") << QSL("&AMP; É") << false;
+  QTest::newRow("numeric-decimal") << QSL("&#8217;&#39;") << QSL("’'") << false;
+  QTest::newRow("numeric-hex") << QSL("&#x201C;&#X201d;") << QSL("“”") << false;
+  QTest::newRow("numeric-astral") << QSL("&#128512;&#x1F600;") << QSL("😀😀") << false;
+  QTest::newRow("double-escaped") << QSL("&amp;lt;") << QSL("&lt;") << false;
+  QTest::newRow("ampersand-text") << QSL("Tom & Jerry") << QSL("Tom & Jerry") << true;
+  QTest::newRow("unknown-entity") << QSL("&foo; &bar") << QSL("&foo; &bar") << true;
+  QTest::newRow("unterminated-entity") << QSL("&amp") << QSL("&amp") << true;
+  QTest::newRow("too-long-entity") << QSL("&thisisaverylongname;") << QSL("&thisisaverylongname;") << true;
+  QTest::newRow("invalid-numeric") << QSL("&#; &#x; &#0; &#xD800; &#1114112; &#12a;")
+                                   << QSL("&#; &#x; &#0; &#xD800; &#1114112; &#12a;") << true;
+}
+
+void WebFactoryTest::escapeHtml() {
+  QFETCH(QString, input);
+  QFETCH(QString, expected);
+  QFETCH(bool, same_as_legacy);
+
+  QCOMPARE(WebFactory::instance()->escapeHtml(input), expected);
+  QCOMPARE(LegacyWebFactory::escapeHtml(input) == expected, same_as_legacy);
+}
+
+void WebFactoryTest::deEscapeHtml_data() {
+  QTest::addColumn<QString>("input");
+  QTest::addColumn<QString>("expected");
+  QTest::addColumn<bool>("same_as_legacy");
+
+  QTest::newRow("plain") << QSL("No special characters") << QSL("No special characters") << true;
+  QTest::newRow("empty") << QString() << QString() << true;
+  QTest::newRow("special") << QSL("<a href=\"x\">Tom & Jerry's ±×</a>")
+                           << QSL("&lt;a href=&quot;x&quot;&gt;Tom &amp; Jerry&#039;s &plusmn;&times;&lt;/a&gt;") << false;
+  QTest::newRow("entity-like") << QSL("&lt;") << QSL("&amp;lt;") << true;
+}
+
+void WebFactoryTest::deEscapeHtml() {
+  QFETCH(QString, input);
+  QFETCH(QString, expected);
+  QFETCH(bool, same_as_legacy);
+
+  QCOMPARE(WebFactory::instance()->deEscapeHtml(input), expected);
+  QCOMPARE(LegacyWebFactory::deEscapeHtml(input) == expected, same_as_legacy);
+}
+
+void WebFactoryTest::escapeHtmlRoundTrip_data() {
+  QTest::addColumn<QString>("text");
+
+  QTest::newRow("plain") << QSL("No special characters");
+  QTest::newRow("special") << QSL("<a href=\"x\">Tom & Jerry's ±×</a>");
+  QTest::newRow("entity-like") << QSL("&amp;lt; &#39; &foo;");
+  QTest::newRow("astral") << QSL("😀 & 😀");
+}
+
+// Decoding of encoded text must give the text back.
+void WebFactoryTest::escapeHtmlRoundTrip() {
+  QFETCH(QString, text);
+
+  WebFactory *web = WebFactory::instance();
+
+  QCOMPARE(web->escapeHtml(web->deEscapeHtml(text)), text);
+}